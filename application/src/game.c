@@ -11,6 +11,15 @@ bool game_create(game* inst)
     inst->window_title  = "Game Application";
     inst->window_width  = 1024;
     inst->window_height = 768;
+    inst->window_event_thread = true;
+
+    // Запись ввода или воспроизведение записи для повторяемых замеров (например "session.kinput").
+    inst->input_record_path = null;
+    inst->input_replay_path = null;
+
+    // Косвенная отрисовка мира и замер обоих способов отрисовки (например 600 кадров на способ).
+    inst->renderer_indirect_draw = true;
+    inst->draw_benchmark_frames = 0;
 
     inst->initialize = game_initialize;
     inst->update     = game_update;
@@ -0,0 +1,42 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_GOOGLE_include_directive : require
+
+// Вариант для режима текстур без привязки: текстуры берутся из общего массива, данные материала из
+// буфера материалов по индексу материала из push-констант.
+
+layout(push_constant) uniform push_constants {
+    uint material_index; // Индекс материала (элемент буфера материалов).
+} u_push_constants;
+
+// Порядок должен соответствовать uniform-переменным уровня экземпляра в shadercfg, за ними следуют
+// индексы текстур в массиве в порядке сэмплеров экземпляра.
+struct material_data {
+    vec4 diffuse_color; // Цветовой фильтр материала? (заданое в материале RGBA).
+    float shininess;
+    uint texture_indices[3];
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+layout(std430, set = 2, binding = 0) readonly buffer material_buffer {
+    material_data materials[];
+} material_ssbo;
+
+// Данные текущего материала.
+material_data object_ubo;
+
+// Выборка из текстуры материала.
+vec4 sample_texture(int index, vec2 tex_coord)
+{
+    return texture(textures[nonuniformEXT(object_ubo.texture_indices[index])], tex_coord);
+}
+
+#include "Builtin.MaterialShader.lighting.glsl"
+
+// В фрагментном шейдере main применяется к каждому пикселю.
+void main()
+{
+    object_ubo = material_ssbo.materials[u_push_constants.material_index];
+    shade_fragment();
+}
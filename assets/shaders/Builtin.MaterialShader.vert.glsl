@@ -6,6 +6,8 @@ layout(location = 1) in vec3 in_normal;   // Локальные нормали 
 layout(location = 2) in vec2 in_texcoord; // Текстурный координаты.
 layout(location = 3) in vec4 in_color;
 layout(location = 4) in vec3 in_tangent;
+// Атрибут экземпляра: мировая матрица (масштаб, вращение и положение объекта в мире), занимает 4 позиции.
+layout(location = 5) in mat4 in_model;
 
 // Порядок должен соответствовать глобальным uniform-переменным в shadercfg.
 layout(set = 0, binding = 0) uniform global_uniform_object {
@@ -18,7 +20,7 @@ layout(set = 0, binding = 0) uniform global_uniform_object {
 
 layout(push_constant) uniform push_constants {
     // Гарантируется всего 128 байт.
-    mat4 model;         // Мировая матрица (масштаб, вращение и положение объекта в мире).
+    uint material_index; // Индекс материала, записывается один раз на пакет отрисовки.
 } u_push_constants;
 
 layout(location = 0) out int out_mode;
@@ -40,14 +42,14 @@ void main()
 {
     out_dto.tex_coord = in_texcoord;
     out_dto.color = in_color;
-    out_dto.frag_position = vec3(u_push_constants.model * vec4(in_position, 1.0)); // Позиция в мировом пространстве.
+    out_dto.frag_position = vec3(in_model * vec4(in_position, 1.0)); // Позиция в мировом пространстве.
 
-    mat3 m3_model = mat3(u_push_constants.model);
+    mat3 m3_model = mat3(in_model);
     out_dto.normal = normalize(m3_model * in_normal);
     out_dto.tangent = normalize(m3_model * in_tangent);
     out_dto.ambient = global_ubo.ambient_color;
     out_dto.view_position = global_ubo.view_position;
-    gl_Position = global_ubo.projection * global_ubo.view * u_push_constants.model * vec4(in_position, 1.0);
+    gl_Position = global_ubo.projection * global_ubo.view * in_model * vec4(in_position, 1.0);
 
     out_mode = global_ubo.mode;
 }
@@ -0,0 +1,257 @@
+#include "bvh_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <containers/bvh.h>
+#include <memory/memory.h>
+#include <math/kmath.h>
+#include <logger.h>
+
+#define BVH_TEST_COUNT 1000
+#define BVH_TEST_QUERY_COUNT 32
+
+typedef struct bvh_test_context {
+    u8* found;
+    u32 count;
+} bvh_test_context;
+
+// Детерминированный генератор для повторяемых тестов.
+static f32 bvh_test_random(u32* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return ((f32)(*state >> 8) / (f32)(1u << 24)) * 2.0f - 1.0f;
+}
+
+static extents_3d bvh_test_random_box(u32* state)
+{
+    vec3 center = vec3_create(bvh_test_random(state) * 200.0f, bvh_test_random(state) * 20.0f, bvh_test_random(state) * 200.0f);
+    vec3 half = vec3_create(kabs(bvh_test_random(state)) * 3.0f + 0.1f, kabs(bvh_test_random(state)) * 3.0f + 0.1f, kabs(bvh_test_random(state)) * 3.0f + 0.1f);
+    extents_3d box = { vec3_sub(center, half), vec3_add(center, half) };
+    return box;
+}
+
+static bool bvh_test_collect(void* context, u32 proxy_id, void* user_data, u32 user_index)
+{
+    bvh_test_context* ctx = context;
+    // Пользовательский индекс в тестах совпадает с номером объекта.
+    ctx->found[user_index]++;
+    ctx->count++;
+    return true;
+}
+
+static bvh* bvh_test_create(u32 max_count, f32 margin, void** out_memory)
+{
+    bvh_config config = { max_count, margin };
+    u64 memory_requirement = 0;
+    bvh_create(&memory_requirement, null, &config, null);
+    *out_memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+
+    bvh* tree = null;
+    bvh_create(&memory_requirement, *out_memory, &config, &tree);
+    return tree;
+}
+
+static bool bvh_test_ray_box(const extents_3d* box, vec3 origin, vec3 direction, f32 max_distance)
+{
+    f32 t_min = 0.0f, t_max = max_distance;
+    for(u32 i = 0; i < 3; ++i)
+    {
+        f32 t1 = (box->min.elements[i] - origin.elements[i]) / direction.elements[i];
+        f32 t2 = (box->max.elements[i] - origin.elements[i]) / direction.elements[i];
+        t_min = KMAX(t_min, KMIN(t1, t2));
+        t_max = KMIN(t_max, KMAX(t1, t2));
+    }
+    return t_min <= t_max;
+}
+
+// Сравнивает результаты запросов к дереву с полным перебором расширенных прямоугольников.
+static bool bvh_test_compare_queries(bvh* tree, u32* ids, u8* alive, u32 count, u32 seed)
+{
+    u8* found = kallocate_tc(u8, count, MEMORY_TAG_ARRAY);
+    u32 state = seed;
+
+    for(u32 q = 0; q < BVH_TEST_QUERY_COUNT; ++q)
+    {
+        // Усеченная пирамида.
+        vec3 eye = vec3_create(bvh_test_random(&state) * 100.0f, 5.0f, bvh_test_random(&state) * 100.0f);
+        mat4 view = mat4_inverse(mat4_mul(mat4_euler_y(bvh_test_random(&state) * K_PI), mat4_translation(eye)));
+        mat4 projection = mat4_perspective(deg_to_rad(60.0f), 1.5f, 0.1f, 80.0f);
+        frustum f = frustum_from_view_projection(mat4_mul(view, projection));
+
+        // Сфера.
+        vec3 sphere_center = vec3_create(bvh_test_random(&state) * 200.0f, 0.0f, bvh_test_random(&state) * 200.0f);
+        f32 radius = kabs(bvh_test_random(&state)) * 40.0f;
+
+        // Луч.
+        vec3 ray_origin = vec3_create(bvh_test_random(&state) * 200.0f, bvh_test_random(&state) * 10.0f, -250.0f);
+        vec3 ray_direction = vec3_create(bvh_test_random(&state) * 0.2f, bvh_test_random(&state) * 0.05f, 1.0f);
+        f32 ray_length = 500.0f;
+
+        for(u32 type = 0; type < 3; ++type)
+        {
+            kzero_tc(found, u8, count);
+            bvh_test_context ctx = { found, 0 };
+            u32 reported = 0;
+
+            if(type == 0) reported = bvh_query_frustum(tree, &f, bvh_test_collect, &ctx);
+            else if(type == 1) reported = bvh_query_sphere(tree, sphere_center, radius, bvh_test_collect, &ctx);
+            else reported = bvh_query_ray(tree, ray_origin, ray_direction, ray_length, bvh_test_collect, &ctx);
+
+            if(reported != ctx.count)
+            {
+                kerror("Query %u type %u: reported %u, callbacks %u.", q, type, reported, ctx.count);
+                kfree(found, MEMORY_TAG_ARRAY);
+                return false;
+            }
+
+            for(u32 i = 0; i < count; ++i)
+            {
+                bool expected = false;
+                if(alive[i])
+                {
+                    extents_3d box;
+                    bvh_get_extents(tree, ids[i], &box);
+                    vec3 center = vec3_mul_scalar(vec3_add(box.min, box.max), 0.5f);
+                    vec3 half = vec3_mul_scalar(vec3_sub(box.max, box.min), 0.5f);
+
+                    if(type == 0)
+                    {
+                        expected = frustum_intersects_aabb(&f, &center, &half);
+                    }
+                    else if(type == 1)
+                    {
+                        vec3 closest = vec3_min(vec3_max(sphere_center, box.min), box.max);
+                        expected = vec3_distance(closest, sphere_center) <= radius;
+                    }
+                    else
+                    {
+                        expected = bvh_test_ray_box(&box, ray_origin, ray_direction, ray_length);
+                    }
+                }
+
+                if(found[i] != (expected ? 1 : 0))
+                {
+                    kerror("Query %u type %u: object %u expected %u, found %u.", q, type, i, expected, found[i]);
+                    kfree(found, MEMORY_TAG_ARRAY);
+                    return false;
+                }
+            }
+        }
+    }
+
+    kfree(found, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+u8 bvh_test1()
+{
+    void* memory = null;
+    bvh* tree = bvh_test_create(BVH_TEST_COUNT, 0.5f, &memory);
+    expect_to_be_true(tree != null);
+
+    u32 ids[BVH_TEST_COUNT];
+    u8 alive[BVH_TEST_COUNT];
+    u32 state = 12345;
+
+    // Инкрементальная вставка.
+    for(u32 i = 0; i < BVH_TEST_COUNT; ++i)
+    {
+        extents_3d box = bvh_test_random_box(&state);
+        ids[i] = bvh_insert(tree, &box, &ids[i], i);
+        alive[i] = true;
+        expect_should_not_be(INVALID_ID, ids[i]);
+    }
+    expect_should_be(BVH_TEST_COUNT, bvh_get_proxy_count(tree));
+    expect_to_be_true(bvh_get_user_data(tree, ids[10]) == &ids[10]);
+
+    // Балансировка держит высоту близкой к логарифмической.
+    kdebug("BVH height after inserts: %u.", bvh_get_height(tree));
+    expect_to_be_true(bvh_get_height(tree) < 24);
+
+    // Переполнение.
+    extents_3d extra = bvh_test_random_box(&state);
+    kdebug("Note: The following error is intentionally caused by this test.");
+    expect_should_be(INVALID_ID, bvh_insert(tree, &extra, null, 0));
+
+    expect_to_be_true(bvh_test_compare_queries(tree, ids, alive, BVH_TEST_COUNT, 1));
+
+    // Небольшое перемещение внутри запаса не меняет дерево, большое - меняет.
+    extents_3d box;
+    bvh_get_extents(tree, ids[0], &box);
+    extents_3d small = { vec3_add(box.min, vec3_create(0.7f, 0.0f, 0.0f)), vec3_add(box.max, vec3_create(-0.3f, 0.0f, 0.0f)) };
+    expect_to_be_false(bvh_move(tree, ids[0], &small));
+
+    for(u32 i = 0; i < BVH_TEST_COUNT; i += 3)
+    {
+        bvh_get_extents(tree, ids[i], &box);
+        vec3 offset = vec3_create(bvh_test_random(&state) * 30.0f, 0.0f, bvh_test_random(&state) * 30.0f);
+        extents_3d moved = { vec3_add(box.min, offset), vec3_add(box.max, offset) };
+        bvh_move(tree, ids[i], &moved);
+    }
+
+    // Удаление.
+    for(u32 i = 1; i < BVH_TEST_COUNT; i += 5)
+    {
+        bvh_remove(tree, ids[i]);
+        alive[i] = false;
+    }
+    expect_should_be(BVH_TEST_COUNT - BVH_TEST_COUNT / 5, bvh_get_proxy_count(tree));
+    expect_to_be_true(bvh_test_compare_queries(tree, ids, alive, BVH_TEST_COUNT, 2));
+
+    kfree(memory, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+u8 bvh_test2()
+{
+    void* memory = null;
+    bvh* tree = bvh_test_create(BVH_TEST_COUNT, 0.0f, &memory);
+
+    u32 ids[BVH_TEST_COUNT];
+    u8 alive[BVH_TEST_COUNT];
+    u32 state = 777;
+
+    for(u32 i = 0; i < BVH_TEST_COUNT; ++i)
+    {
+        extents_3d box = bvh_test_random_box(&state);
+        ids[i] = bvh_insert(tree, &box, null, i);
+        alive[i] = true;
+    }
+
+    // Полное перестроение по SAH сохраняет идентификаторы и результаты запросов.
+    bvh_rebuild(tree);
+    kdebug("BVH height after rebuild: %u.", bvh_get_height(tree));
+    expect_should_be(BVH_TEST_COUNT, bvh_get_proxy_count(tree));
+    expect_to_be_true(bvh_get_height(tree) < 32);
+    expect_to_be_true(bvh_test_compare_queries(tree, ids, alive, BVH_TEST_COUNT, 3));
+
+    // Вставка и удаление после перестроения.
+    for(u32 i = 0; i < BVH_TEST_COUNT; i += 2)
+    {
+        bvh_remove(tree, ids[i]);
+        extents_3d box = bvh_test_random_box(&state);
+        ids[i] = bvh_insert(tree, &box, null, i);
+    }
+    expect_to_be_true(bvh_test_compare_queries(tree, ids, alive, BVH_TEST_COUNT, 4));
+
+    // Одинаковые прямоугольники (вырожденный случай для SAH).
+    bvh_destroy(tree);
+    kfree(memory, MEMORY_TAG_ARRAY);
+    tree = bvh_test_create(64, 0.0f, &memory);
+    extents_3d same = { vec3_zero(), vec3_one() };
+    for(u32 i = 0; i < 64; ++i)
+    {
+        bvh_insert(tree, &same, null, i);
+    }
+    bvh_rebuild(tree);
+    expect_should_be(6, bvh_get_height(tree));
+
+    kfree(memory, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void bvh_register_tests()
+{
+    test_managet_register_test(bvh_test1, "BVH incremental insert, move and remove should keep queries exact.");
+    test_managet_register_test(bvh_test2, "BVH SAH rebuild should keep ids and queries exact.");
+}
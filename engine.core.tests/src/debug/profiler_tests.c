@@ -0,0 +1,93 @@
+#include "debug/profiler_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <debug/profiler.h>
+#include <platform/time.h>
+#include <memory/memory.h>
+#include <kstring.h>
+
+u8 profiler_test1()
+{
+    u64 frequency = platform_time_ticks_frequency();
+    expect_to_be_true(frequency > 0);
+
+    u64 start = platform_time_ticks();
+    f64 start_time = platform_time_absolute();
+    while(platform_time_absolute() - start_time < 0.002);
+    u64 end = platform_time_ticks();
+
+    expect_to_be_true(end > start);
+
+    // Прошедшее время по счетчику должно совпадать с системным таймером (с запасом на планировщик).
+    f64 elapsed = (f64)(end - start) / (f64)frequency;
+    expect_to_be_true(elapsed >= 0.0015 && elapsed < 0.1);
+    return true;
+}
+
+u8 profiler_test2()
+{
+    profiler_config config;
+    config.max_thread_count = 4;
+    config.max_event_count = 64;
+    config.max_node_count = 16;
+
+    u64 memory_requirement = 0;
+    expect_to_be_true(profiler_initialize(&memory_requirement, null, &config));
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(profiler_initialize(&memory_requirement, memory, &config));
+
+    for(u32 frame = 0; frame < 2; ++frame)
+    {
+        KPROFILE_BEGIN("frame");
+        {
+            KPROFILE_BEGIN("update");
+            KPROFILE_END();
+
+            for(u32 i = 0; i < 3; ++i)
+            {
+                KPROFILE_BEGIN("draw");
+                KPROFILE_END();
+            }
+        }
+        KPROFILE_END();
+        profiler_frame_end();
+    }
+
+    profiler_report report;
+    expect_to_be_true(profiler_get_report(&report));
+    expect_should_be(2, report.frame_count);
+
+    // NOTE: Макросы могут быть отключены (сборка без отладки), тогда узлов нет.
+#if KPROFILER_ENABLED
+    expect_should_be(3, report.node_count);
+
+    const profiler_node* frame = &report.nodes[0];
+    expect_to_be_true(string_equal(frame->name, "frame"));
+    expect_should_be(0, frame->depth);
+    expect_should_be(1, frame->frame_calls);
+
+    const profiler_node* update = &report.nodes[frame->first_child];
+    expect_to_be_true(string_equal(update->name, "update"));
+    expect_should_be(1, update->depth);
+    expect_should_be(1, update->frame_calls);
+
+    const profiler_node* draw = &report.nodes[update->next_sibling];
+    expect_to_be_true(string_equal(draw->name, "draw"));
+    expect_should_be(3, draw->frame_calls);
+    expect_should_be(INVALID_ID, draw->next_sibling);
+
+    // Время дочерних областей входит во время родительской.
+    expect_to_be_true(frame->frame_ticks >= update->frame_ticks + draw->frame_ticks);
+#endif
+
+    profiler_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void profiler_register_tests()
+{
+    test_managet_register_test(profiler_test1, "High resolution ticks should be monotonic and calibrated.");
+    test_managet_register_test(profiler_test2, "Profiler should aggregate nested scopes into hierarchy.");
+}
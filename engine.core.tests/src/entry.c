@@ -10,7 +10,20 @@
 #include "memory/dynamic_allocator_tests.h"
 #include "containers/hashtable_tests.h"
 #include "containers/freelist_test.h"
+#include "containers/bvh_tests.h"
 #include "string/kstring_tests.h"
+#include "string/kstring_view_tests.h"
+#include "debug/profiler_tests.h"
+#include "logger/logger_tests.h"
+#include "event/event_tests.h"
+#include "math/kmath_tests.h"
+#include "math/kmath_simd_tests.h"
+#include "math/geometry_utils_tests.h"
+#include "systems/transform_system_tests.h"
+#include "systems/job_system_tests.h"
+#include "renderer/occlusion_buffer_tests.h"
+#include "renderer/draw_sort_tests.h"
+#include "resources/pak_tests.h"
 
 int main()
 {
@@ -27,8 +40,21 @@ int main()
     linear_allocator_register_tests();
     hashtable_register_tests();
     string_register_tests();
+    string_view_register_tests();
     freelist_register_tests();
+    bvh_register_tests();
     dynamic_allocator_register_tests();
+    profiler_register_tests();
+    logger_register_tests();
+    event_register_tests();
+    kmath_register_tests();
+    kmath_simd_register_tests();
+    geometry_utils_register_tests();
+    transform_system_register_tests();
+    job_system_register_tests();
+    occlusion_buffer_register_tests();
+    draw_sort_register_tests();
+    pak_register_tests();
 
     // INFO: Конец регистрации тестов.
 
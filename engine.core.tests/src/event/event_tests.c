@@ -0,0 +1,181 @@
+#include "event/event_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <event.h>
+#include <memory/memory.h>
+#include <platform/thread.h>
+
+#define EVENT_TEST_THREAD_COUNT 4
+#define EVENT_TEST_THREAD_EVENTS 500
+
+typedef struct event_test_data {
+    u32 call_count;
+    i64 sum;
+    i32 last_x;
+    i32 last_y;
+    u32 finished_threads;
+} event_test_data;
+
+static bool event_test_handler(event_code code, void* sender, void* listener, event_context* context)
+{
+    event_test_data* data = listener;
+    data->call_count++;
+    data->sum += context->i32[0];
+    data->last_x = context->i32[0];
+    data->last_y = context->i32[1];
+    return false;
+}
+
+static bool event_test_handler_consume(event_code code, void* sender, void* listener, event_context* context)
+{
+    event_test_data* data = listener;
+    data->call_count++;
+    return true;
+}
+
+static u32 event_test_thread(void* params)
+{
+    event_test_data* data = params;
+
+    for(i32 i = 1; i <= EVENT_TEST_THREAD_EVENTS; ++i)
+    {
+        event_context context = { .i32[0] = i };
+        event_post(EVENT_CODE_DEBUG_0, null, &context);
+    }
+
+    __atomic_fetch_add(&data->finished_threads, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+static void* event_test_start()
+{
+    u64 memory_requirement = 0;
+    event_system_initialize(&memory_requirement, null);
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    event_system_initialize(&memory_requirement, memory);
+    return memory;
+}
+
+static void event_test_stop(void* memory)
+{
+    event_system_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+}
+
+u8 event_test1()
+{
+    void* memory = event_test_start();
+    event_test_data data0 = {0};
+    event_test_data data1 = {0};
+    event_test_data data2 = {0};
+
+    // Слушатели разных кодов хранятся в одном массиве.
+    expect_to_be_true(event_register(EVENT_CODE_DEBUG_1, &data1, event_test_handler));
+    expect_to_be_true(event_register(EVENT_CODE_DEBUG_0, &data0, event_test_handler));
+    expect_to_be_true(event_register(EVENT_CODE_DEBUG_2, &data2, event_test_handler_consume));
+    expect_to_be_true(event_register(EVENT_CODE_DEBUG_2, &data1, event_test_handler));
+    expect_to_be_false(event_register(EVENT_CODE_DEBUG_0, &data0, event_test_handler));
+
+    event_context context = { .i32[0] = 7 };
+    expect_to_be_false(event_send(EVENT_CODE_DEBUG_0, null, &context));
+    expect_to_be_false(event_send(EVENT_CODE_DEBUG_1, null, &context));
+    expect_to_be_true(event_send(EVENT_CODE_DEBUG_2, null, &context));
+
+    expect_should_be(1, data0.call_count);
+    expect_should_be(1, data1.call_count);
+    expect_should_be(1, data2.call_count);
+
+    // Первый слушатель обрабатывает событие, второй не вызывается.
+    expect_to_be_true(event_unregister(EVENT_CODE_DEBUG_2, &data2, event_test_handler_consume));
+    expect_to_be_false(event_send(EVENT_CODE_DEBUG_2, null, &context));
+    expect_should_be(1, data2.call_count);
+    expect_should_be(2, data1.call_count);
+
+    expect_to_be_true(event_unregister(EVENT_CODE_DEBUG_0, &data0, event_test_handler));
+    expect_to_be_false(event_send(EVENT_CODE_DEBUG_0, null, &context));
+    expect_should_be(1, data0.call_count);
+
+    // Слушатели следующих кодов остаются на своих местах.
+    expect_to_be_false(event_send(EVENT_CODE_DEBUG_1, null, &context));
+    expect_should_be(3, data1.call_count);
+
+    event_test_stop(memory);
+    return true;
+}
+
+u8 event_test2()
+{
+    void* memory = event_test_start();
+    event_test_data data = {0};
+    expect_to_be_true(event_register(EVENT_CODE_DEBUG_0, &data, event_test_handler));
+
+    thread threads[EVENT_TEST_THREAD_COUNT];
+    for(u32 i = 0; i < EVENT_TEST_THREAD_COUNT; ++i)
+    {
+        expect_to_be_true(platform_thread_create(event_test_thread, &data, true, &threads[i]));
+    }
+
+    // Обработка событий по мере поступления, как в основном цикле приложения.
+    u32 waited_ms = 0;
+    while(__atomic_load_n(&data.finished_threads, __ATOMIC_ACQUIRE) < EVENT_TEST_THREAD_COUNT && waited_ms < 5000)
+    {
+        event_system_dispatch();
+        platform_thread_sleep(1);
+        waited_ms++;
+    }
+    event_system_dispatch();
+
+    i64 expected_sum = (i64)EVENT_TEST_THREAD_COUNT * EVENT_TEST_THREAD_EVENTS * (EVENT_TEST_THREAD_EVENTS + 1) / 2;
+    expect_should_be(EVENT_TEST_THREAD_COUNT * EVENT_TEST_THREAD_EVENTS, data.call_count);
+    expect_should_be(expected_sum, data.sum);
+
+    event_test_stop(memory);
+    return true;
+}
+
+u8 event_test3()
+{
+    void* memory = event_test_start();
+    event_test_data moved = {0};
+    event_test_data debug = {0};
+    expect_to_be_true(event_register(EVENT_CODE_MOUSE_MOVED, &moved, event_test_handler));
+    expect_to_be_true(event_register(EVENT_CODE_DEBUG_0, &debug, event_test_handler));
+
+    for(i32 i = 1; i <= 10; ++i)
+    {
+        event_context context = { .i32[0] = i, .i32[1] = -i };
+        expect_to_be_true(event_post(EVENT_CODE_MOUSE_MOVED, null, &context));
+        expect_to_be_true(event_post(EVENT_CODE_DEBUG_0, null, &context));
+    }
+
+    // До обработки очереди обработчики не вызываются.
+    expect_should_be(0, moved.call_count);
+
+    event_system_dispatch();
+    expect_should_be(1, moved.call_count);
+    expect_should_be(10, moved.last_x);
+    expect_should_be(-10, moved.last_y);
+    expect_should_be(10, debug.call_count);
+
+    // Без объединения передаются все события.
+    event_set_coalescing(EVENT_CODE_MOUSE_MOVED, false);
+    for(i32 i = 1; i <= 10; ++i)
+    {
+        event_context context = { .i32[0] = i };
+        expect_to_be_true(event_post(EVENT_CODE_MOUSE_MOVED, null, &context));
+    }
+
+    event_system_dispatch();
+    expect_should_be(11, moved.call_count);
+
+    event_test_stop(memory);
+    return true;
+}
+
+void event_register_tests()
+{
+    test_managet_register_test(event_test1, "Event listeners should be stored flat and dispatched by code.");
+    test_managet_register_test(event_test2, "Events posted from several threads should all be dispatched.");
+    test_managet_register_test(event_test3, "Posted high frequency events should be coalesced.");
+}
@@ -9,7 +9,7 @@
     @param actual Фактическое значение.
 */
 #define expect_should_be(expected, actual)                                                             \
-if(actual != expected)                                                                                 \
+if((actual) != (expected))                                                                             \
 {                                                                                                      \
     kerror("--> Expected %lld, but got: %lld. In %s:%d.", expected, actual, __FILE_NAME__, __LINE__);  \
     return false;                                                                                      \
@@ -21,7 +21,7 @@ if(actual != expected)
     @param actual Фактическое значение.
 */
 #define expect_should_not_be(expected, actual)                                                                  \
-if(actual == expected)                                                                                          \
+if((actual) == (expected))                                                                                      \
 {                                                                                                               \
     kerror("--> Expected %d != %d, but they are equal. In %s:%d.", expected, actual, __FILE_NAME__, __LINE__);  \
     return false;                                                                                               \
@@ -33,9 +33,9 @@ if(actual == expected)
     @param actual Фактическое значение указателя.
 */
 #define expect_pointer_should_be(expected, actual)                                                     \
-if(actual != expected)                                                                                 \
+if((actual) != (expected))                                                                             \
 {                                                                                                      \
-    if(expected != null)                                                                               \
+    if((expected) != null)                                                                             \
     {                                                                                                  \
         kerror("--> Expected %p, but got: %p. In %s:%d.", expected, actual, __FILE_NAME__, __LINE__);  \
     }                                                                                                  \
@@ -52,9 +52,9 @@ if(actual != expected)
     @param actual Фактическое значение указателя.
 */
 #define expect_pointer_should_not_be(expected, actual)                                                            \
-if(actual == expected)                                                                                            \
+if((actual) == (expected))                                                                                        \
 {                                                                                                                 \
-    if(expected != null)                                                                                          \
+    if((expected) != null)                                                                                        \
     {                                                                                                             \
         kerror("--> Expected %p != %p, but they are equal. In %s:%d.", actual, expected, __FILE_NAME__, __LINE__);\
     }                                                                                                             \
@@ -71,7 +71,7 @@ if(actual == expected)
     @param actual Фактическое значение.
 */
 #define expect_float_to_be(expected, actual)                                                       \
-if(kabs(expected - actual) > K_FLOAT_EPSILON)                                                      \
+if(kabs((expected) - (actual)) > K_FLOAT_EPSILON)                                                  \
 {                                                                                                  \
     kerror("--> Expected %f, but got: %f. In %s:%d.", expected, actual, __FILE_NAME__, __LINE__);  \
     return false;                                                                                  \
@@ -82,7 +82,7 @@ if(kabs(expected - actual) > K_FLOAT_EPSILON)
     @param actual Фактическое значение.
 */
 #define expect_to_be_true(actual)                                                    \
-if(actual != true)                                                                   \
+if((actual) != true)                                                                 \
 {                                                                                    \
     kerror("--> Expected true, but got: false. In %s:%d.", __FILE_NAME__, __LINE__); \
     return false;                                                                    \
@@ -93,7 +93,7 @@ if(actual != true)
     @param actual Фактическое значение.
 */
 #define expect_to_be_false(actual)                                                   \
-if(actual != false)                                                                  \
+if((actual) != false)                                                                \
 {                                                                                    \
     kerror("--> Expected false, but got: true. In %s:%d.", __FILE_NAME__, __LINE__); \
     return false;                                                                    \
@@ -0,0 +1,350 @@
+#include "logger/logger_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <memory/memory.h>
+#include <platform/string.h>
+#include <platform/file.h>
+#include <platform/thread.h>
+#include <kstring.h>
+
+// Последнее сообщение, полученное пользовательской функцией (вызывается из потока вывода).
+static char logger_test_message[512];
+static char logger_test_first_message[512];
+static u32 logger_test_message_count = 0;
+
+static void logger_test_hook(log_level level, const char* message)
+{
+    platform_string_format(logger_test_message, sizeof(logger_test_message), "%u:%s", level, message);
+    if(!logger_test_message_count)
+    {
+        platform_string_format(logger_test_first_message, sizeof(logger_test_first_message), "%s", logger_test_message);
+    }
+    logger_test_message_count++;
+}
+
+u8 logger_test1()
+{
+    logger_config config;
+    config.max_thread_count = 2;
+    config.thread_buffer_size = 1 << 16;
+    config.flush_interval_ms = 1;
+    config.file_path = null;
+    config.binary_file_path = null;
+    config.binary_ring_size = 0;
+
+    u64 memory_requirement = 0;
+    expect_to_be_true(logger_initialize(&memory_requirement, null, &config));
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(logger_initialize(&memory_requirement, memory, &config));
+
+    logger_test_message_count = 0;
+    log_output_set_custom_hook(logger_test_hook);
+
+    char expected[512];
+    platform_string_format(
+        expected, sizeof(expected), "2:%s|%5d|%-4u|%llx|%.2f|%*.*s|%c|%%|%p|%hhu|%zu\n", "before", 42, 7u, 0xabcdefull,
+        3.14159, 6, 3, "abcdef", 'z', (void*)0x10, 300, (u64)99
+    );
+
+    // Строка изменяется сразу после вызова: вывод должен содержать значение на момент вызова.
+    char name[16];
+    platform_string_format(name, sizeof(name), "%s", "before");
+
+    i64 big = -1234567890123ll;
+    log_output(
+        LOG_LEVEL_WARNG, "%s|%5d|%-4u|%llx|%.2f|%*.*s|%c|%%|%p|%hhu|%zu", name, 42, 7u, 0xabcdefull, 3.14159,
+        6, 3, "abcdef", 'z', (void*)0x10, 300, (u64)99
+    );
+    platform_string_format(name, sizeof(name), "%s", "after");
+    // Строковый литерал передается без копирования строки формата.
+    klog(LOG_LEVEL_INFOR, "%lld", big);
+
+    logger_flush();
+    u32 count = logger_test_message_count;
+    char last[512];
+    platform_string_format(last, sizeof(last), "%s", logger_test_message);
+
+    log_output_set_default_hook();
+    logger_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+
+    expect_should_be(2, count);
+    expect_to_be_true(string_equal(logger_test_first_message, expected));
+    expect_to_be_true(string_equal(last, "3:-1234567890123\n"));
+    return true;
+}
+
+u8 logger_test2()
+{
+    logger_config config;
+    config.max_thread_count = 1;
+    config.thread_buffer_size = 1 << 16;
+    config.flush_interval_ms = 1;
+    config.file_path = null;
+    config.binary_file_path = null;
+    config.binary_ring_size = 0;
+
+    u64 memory_requirement = 0;
+    expect_to_be_true(logger_initialize(&memory_requirement, null, &config));
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(logger_initialize(&memory_requirement, memory, &config));
+
+    log_output_set_custom_hook(logger_test_hook);
+
+    char expected[512];
+    platform_string_format(
+        expected, sizeof(expected), "2:%s|%5d|%-4u|%llx|%.2f|%*.*s|%c|%%|%p|%hhu|%zu\n", "value", 42, 7u, 0xabcdefull,
+        3.14159, 6, 3, "abcdef", 'z', (void*)0x10, 300, (u64)99
+    );
+
+    // Запись больше буфера потока в сумме: буфер переиспользуется по кругу, сообщения не теряются.
+    logger_test_message_count = 0;
+    for(u32 i = 0; i < 4096; ++i)
+    {
+        log_output(
+            LOG_LEVEL_WARNG, "%s|%5d|%-4u|%llx|%.2f|%*.*s|%c|%%|%p|%hhu|%zu", "value", 42, 7u, 0xabcdefull, 3.14159,
+            6, 3, "abcdef", 'z', (void*)0x10, 300, (u64)99
+        );
+    }
+
+    logger_flush();
+    u32 count = logger_test_message_count;
+    char last[512];
+    platform_string_format(last, sizeof(last), "%s", logger_test_message);
+
+    log_output_set_default_hook();
+    logger_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+
+    expect_should_be(4096, count);
+    expect_to_be_true(string_equal(last, expected));
+    return true;
+}
+
+u8 logger_test3()
+{
+    logger_config config;
+    config.max_thread_count = 1;
+    config.thread_buffer_size = 1 << 16;
+    config.flush_interval_ms = 1;
+    config.file_path = null;
+    config.binary_file_path = "logger_tests.klog";
+    config.binary_ring_size = 1 << 17;
+
+    u64 memory_requirement = 0;
+    expect_to_be_true(logger_initialize(&memory_requirement, null, &config));
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(logger_initialize(&memory_requirement, memory, &config));
+
+    // Сообщений больше, чем вмещает кольцевой буфер журнала: в файле остаются последние.
+    for(u32 i = 0; i < 4096; ++i)
+    {
+        klog(LOG_LEVEL_TRACE, "Frame %u: %s %.1f", i, "entity", i * 0.5);
+    }
+    log_output(LOG_LEVEL_DEBUG, "Last: %s|%5d|%%|%c", "done", -42, 'x');
+
+    logger_flush();
+    logger_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+
+    logger_test_message_count = 0;
+    bool decoded = logger_binary_decode(config.binary_file_path, logger_test_hook);
+    expect_to_be_true(platform_file_delete(config.binary_file_path));
+    expect_to_be_true(decoded);
+
+    char expected[512];
+    platform_string_format(expected, sizeof(expected), "%u:Frame %u: %s %.1f\n", LOG_LEVEL_TRACE, 4095, "entity", 4095 * 0.5);
+
+    expect_to_be_true(logger_test_message_count > 1);
+    expect_to_be_true(logger_test_message_count < 4097);
+    expect_to_be_true(string_equal(logger_test_message, "4:Last: done|  -42|%|x\n"));
+
+    // Первое прочитанное сообщение - самое старое, оставшееся в файле.
+    u32 first_index = 4096 - (logger_test_message_count - 1);
+    platform_string_format(
+        expected, sizeof(expected), "%u:Frame %u: %s %.1f\n", LOG_LEVEL_TRACE, first_index, "entity", first_index * 0.5
+    );
+    expect_to_be_true(string_equal(logger_test_first_message, expected));
+    return true;
+}
+
+#define LOGGER_TEST_THREAD_COUNT  4
+#define LOGGER_TEST_MESSAGE_COUNT 2000
+
+// Следующий ожидаемый номер сообщения каждого потока и количество нарушений порядка.
+static u32 logger_test_next_index[LOGGER_TEST_THREAD_COUNT];
+static u32 logger_test_order_errors = 0;
+
+// Разбирает сообщение вида "<поток> <номер>" (сообщения других уровней, например о создании потоков, пропускаются).
+static void logger_test_order_hook(log_level level, const char* message)
+{
+    if(level != LOG_LEVEL_INFOR)
+    {
+        return;
+    }
+
+    u32 values[2] = {0};
+    u32 value_index = 0;
+    for(const char* c = message; *c && value_index < 2; ++c)
+    {
+        if(*c >= '0' && *c <= '9')
+        {
+            values[value_index] = values[value_index] * 10 + (*c - '0');
+        }
+        else if(*c == ' ')
+        {
+            value_index++;
+        }
+    }
+
+    if(values[0] >= LOGGER_TEST_THREAD_COUNT || logger_test_next_index[values[0]] != values[1])
+    {
+        logger_test_order_errors++;
+        return;
+    }
+
+    logger_test_next_index[values[0]]++;
+    logger_test_message_count++;
+}
+
+static u32 logger_test_thread_run(void* params)
+{
+    u32 index = *(u32*)params;
+    for(u32 i = 0; i < LOGGER_TEST_MESSAGE_COUNT; ++i)
+    {
+        klog(LOG_LEVEL_INFOR, "%u %u", index, i);
+    }
+    return 0;
+}
+
+u8 logger_test4()
+{
+    logger_config config;
+    config.max_thread_count = LOGGER_TEST_THREAD_COUNT;
+    config.thread_buffer_size = 1 << 16;
+    config.flush_interval_ms = 1;
+    config.file_path = null;
+    config.binary_file_path = null;
+    config.binary_ring_size = 0;
+
+    u64 memory_requirement = 0;
+    expect_to_be_true(logger_initialize(&memory_requirement, null, &config));
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(logger_initialize(&memory_requirement, memory, &config));
+
+    logger_test_message_count = 0;
+    logger_test_order_errors = 0;
+    for(u32 i = 0; i < LOGGER_TEST_THREAD_COUNT; ++i)
+    {
+        logger_test_next_index[i] = 0;
+    }
+    log_output_set_custom_hook(logger_test_order_hook);
+
+    thread threads[LOGGER_TEST_THREAD_COUNT];
+    u32 indices[LOGGER_TEST_THREAD_COUNT];
+    u32 started = 0;
+    for(u32 i = 0; i < LOGGER_TEST_THREAD_COUNT; ++i)
+    {
+        indices[i] = i;
+        if(platform_thread_create(logger_test_thread_run, &indices[i], false, &threads[i]))
+        {
+            started++;
+        }
+    }
+
+    for(u32 i = 0; i < started; ++i)
+    {
+        platform_thread_join(&threads[i]);
+    }
+
+    // Остановка без logger_flush: поток вывода должен вывести все накопленные сообщения перед завершением.
+    logger_shutdown();
+    log_output_set_default_hook();
+    kfree(memory, MEMORY_TAG_ARRAY);
+
+    expect_should_be(LOGGER_TEST_THREAD_COUNT, started);
+    expect_should_be(0, logger_test_order_errors);
+    expect_should_be(LOGGER_TEST_THREAD_COUNT * LOGGER_TEST_MESSAGE_COUNT, logger_test_message_count);
+    return true;
+}
+
+// Сообщения, выведенные синхронно в потоке-источнике (без буфера потока).
+static _Thread_local bool logger_test_worker = false;
+static u32 logger_test_sync_count = 0;
+
+static void logger_test_reuse_hook(log_level level, const char* message)
+{
+    if(logger_test_worker)
+    {
+        __atomic_fetch_add(&logger_test_sync_count, 1, __ATOMIC_RELAXED);
+    }
+    logger_test_order_hook(level, message);
+}
+
+static u32 logger_test_reuse_thread_run(void* params)
+{
+    logger_test_worker = true;
+    return logger_test_thread_run(params);
+}
+
+u8 logger_test5()
+{
+    // Буферов меньше, чем потоков за время работы: буфер завершенного потока занимает следующий.
+    logger_config config;
+    config.max_thread_count = 2;
+    config.thread_buffer_size = 1 << 16;
+    config.flush_interval_ms = 1;
+    config.file_path = null;
+    config.binary_file_path = null;
+    config.binary_ring_size = 0;
+
+    u64 memory_requirement = 0;
+    expect_to_be_true(logger_initialize(&memory_requirement, null, &config));
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(logger_initialize(&memory_requirement, memory, &config));
+
+    logger_test_message_count = 0;
+    logger_test_order_errors = 0;
+    logger_test_sync_count = 0;
+    for(u32 i = 0; i < LOGGER_TEST_THREAD_COUNT; ++i)
+    {
+        logger_test_next_index[i] = 0;
+    }
+    log_output_set_custom_hook(logger_test_reuse_hook);
+
+    u32 started = 0;
+    for(u32 i = 0; i < LOGGER_TEST_THREAD_COUNT; ++i)
+    {
+        thread worker;
+        u32 index = i;
+        if(platform_thread_create(logger_test_reuse_thread_run, &index, false, &worker))
+        {
+            platform_thread_join(&worker);
+            started++;
+        }
+    }
+
+    logger_flush();
+    u32 count = logger_test_message_count;
+
+    log_output_set_default_hook();
+    logger_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+
+    expect_should_be(LOGGER_TEST_THREAD_COUNT, started);
+    expect_should_be(0, logger_test_sync_count);
+    expect_should_be(0, logger_test_order_errors);
+    expect_should_be(LOGGER_TEST_THREAD_COUNT * LOGGER_TEST_MESSAGE_COUNT, count);
+    return true;
+}
+
+void logger_register_tests()
+{
+    test_managet_register_test(logger_test1, "Logger should format deferred messages with copied arguments.");
+    test_managet_register_test(logger_test2, "Logger should wrap thread buffer without losing messages.");
+    test_managet_register_test(logger_test3, "Binary log should keep latest messages and decode them back to text.");
+    test_managet_register_test(logger_test4, "Logger shutdown should output all messages of all threads in order.");
+    test_managet_register_test(logger_test5, "Logger should reuse buffers of finished threads.");
+}
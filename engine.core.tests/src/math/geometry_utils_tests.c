@@ -0,0 +1,255 @@
+#include "math/geometry_utils_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <memory/memory.h>
+#include <math/kmath.h>
+#include <math/geometry_utils.h>
+
+#define GEOMETRY_TEST_GRID_SIZE 16
+
+// Плоская сетка в плоскости XY из GEOMETRY_TEST_GRID_SIZE^2 квадратов, нормали вдоль +Z.
+static void geometry_test_grid(vertex_3d** out_vertices, u32* out_vertex_count, u32** out_indices, u32* out_index_count)
+{
+    u32 n = GEOMETRY_TEST_GRID_SIZE;
+    u32 vertex_count = (n + 1) * (n + 1);
+    u32 index_count = n * n * 6;
+
+    vertex_3d* vertices = kallocate_tc(vertex_3d, vertex_count, MEMORY_TAG_ARRAY);
+    u32* indices = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kzero_tc(vertices, vertex_3d, vertex_count);
+
+    for(u32 y = 0; y <= n; ++y)
+    {
+        for(u32 x = 0; x <= n; ++x)
+        {
+            vertex_3d* v = &vertices[y * (n + 1) + x];
+            v->position = vec3_create((f32)x, (f32)y, 0.0f);
+            v->normal = vec3_create(0.0f, 0.0f, 1.0f);
+            v->texcoord = vec2_create((f32)x / n, (f32)y / n);
+        }
+    }
+
+    u32 write = 0;
+    for(u32 y = 0; y < n; ++y)
+    {
+        for(u32 x = 0; x < n; ++x)
+        {
+            u32 i = y * (n + 1) + x;
+            indices[write++] = i;
+            indices[write++] = i + 1;
+            indices[write++] = i + n + 2;
+            indices[write++] = i;
+            indices[write++] = i + n + 2;
+            indices[write++] = i + n + 1;
+        }
+    }
+
+    *out_vertices = vertices;
+    *out_vertex_count = vertex_count;
+    *out_indices = indices;
+    *out_index_count = index_count;
+}
+
+u8 geometry_simplify_test1()
+{
+    // Все временные массивы упрощения должны быть освобождены.
+    ptr array_usage = memory_system_tag_usage(MEMORY_TAG_ARRAY);
+
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    geometry_test_grid(&vertices, &vertex_count, &indices, &index_count);
+
+    u32* result = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    u32 result_count = geometry_simplify(vertex_count, vertices, index_count, indices, index_count / 4, 0.001f, result);
+    kdebug("Grid simplified from %u to %u indices.", index_count, result_count);
+
+    // Плоская сетка упрощается без ошибки, граница неподвижна.
+    expect_to_be_true(result_count <= index_count / 4);
+    expect_to_be_true(result_count > 0 && result_count % 3 == 0);
+
+    f32 area = 0.0f;
+    for(u32 i = 0; i < result_count; i += 3)
+    {
+        expect_to_be_true(result[i] < vertex_count && result[i + 1] < vertex_count && result[i + 2] < vertex_count);
+
+        // Треугольники не переворачиваются.
+        vec3 p0 = vertices[result[i + 0]].position;
+        vec3 p1 = vertices[result[i + 1]].position;
+        vec3 p2 = vertices[result[i + 2]].position;
+        vec3 normal = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+        expect_to_be_true(normal.z > 0.0f);
+        area += normal.z * 0.5f;
+    }
+
+    // Площадь сохраняется: поверхность не потеряла покрытия.
+    f32 expected_area = (f32)(GEOMETRY_TEST_GRID_SIZE * GEOMETRY_TEST_GRID_SIZE);
+    expect_to_be_true(kabs(area - expected_area) < 0.001f);
+
+    // Искривленная поверхность при нулевой допустимой ошибке не упрощается.
+    for(u32 i = 0; i < vertex_count; ++i)
+    {
+        vec3* p = &vertices[i].position;
+        f32 dx = p->x - GEOMETRY_TEST_GRID_SIZE * 0.5f;
+        f32 dy = p->y - GEOMETRY_TEST_GRID_SIZE * 0.5f;
+        p->z = (dx * dx + dy * dy) * 0.1f;
+    }
+    result_count = geometry_simplify(vertex_count, vertices, index_count, indices, 0, 0.0f, result);
+    expect_should_be(index_count, result_count);
+
+    // С допустимой ошибкой упрощается частично.
+    result_count = geometry_simplify(vertex_count, vertices, index_count, indices, 0, 0.02f, result);
+    kdebug("Curved grid simplified from %u to %u indices.", index_count, result_count);
+    expect_to_be_true(result_count > 0 && result_count < index_count);
+
+    kfree(result, MEMORY_TAG_ARRAY);
+    kfree(vertices, MEMORY_TAG_ARRAY);
+    kfree(indices, MEMORY_TAG_ARRAY);
+
+    expect_should_be(array_usage, memory_system_tag_usage(MEMORY_TAG_ARRAY));
+    return true;
+}
+
+u8 geometry_simplify_test2()
+{
+    ptr array_usage = memory_system_tag_usage(MEMORY_TAG_ARRAY);
+
+    // Куб из 6 граней по 4 вершины: все вершины лежат на швах и не перемещаются.
+    vertex_3d vertices[24] = {};
+    u32 indices[36];
+
+    for(u32 f = 0; f < 6; ++f)
+    {
+        u32 axis = f / 2;
+        f32 sign = (f % 2) ? 1.0f : -1.0f;
+        u32 u_axis = (axis + 1) % 3;
+        u32 v_axis = (axis + 2) % 3;
+
+        for(u32 c = 0; c < 4; ++c)
+        {
+            vertex_3d* v = &vertices[f * 4 + c];
+            v->position.elements[axis] = sign;
+            v->position.elements[u_axis] = (c == 1 || c == 2) ? 1.0f : -1.0f;
+            v->position.elements[v_axis] = (c >= 2) ? 1.0f : -1.0f;
+            v->normal.elements[axis] = sign;
+        }
+
+        u32 base = f * 4;
+        u32* tri = &indices[f * 6];
+        tri[0] = base + 0; tri[1] = base + 1; tri[2] = base + 2;
+        tri[3] = base + 0; tri[4] = base + 2; tri[5] = base + 3;
+    }
+
+    u32 result[36];
+    u32 result_count = geometry_simplify(24, vertices, 36, indices, 12, 1.0f, result);
+    expect_should_be(36, result_count);
+
+    for(u32 i = 0; i < 36; ++i)
+    {
+        expect_should_be(indices[i], result[i]);
+    }
+
+    expect_should_be(array_usage, memory_system_tag_usage(MEMORY_TAG_ARRAY));
+    return true;
+}
+
+u8 geometry_generate_occluder_test()
+{
+    ptr array_usage = memory_system_tag_usage(MEMORY_TAG_ARRAY);
+
+    vertex_3d* vertices;
+    u32* indices;
+    u32 vertex_count, index_count;
+    geometry_test_grid(&vertices, &vertex_count, &indices, &index_count);
+
+    u32* result = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+
+    // Плоская сетка без ограничения: компланарные треугольники объединены, покрытие полное.
+    u32 result_count = geometry_generate_occluder(vertex_count, vertices, index_count, indices, index_count, result);
+    kdebug("Flat grid occluder has %u of %u indices.", result_count, index_count);
+    expect_to_be_true(result_count > 0 && result_count < index_count && result_count % 3 == 0);
+
+    f32 area = 0.0f;
+    for(u32 i = 0; i < result_count; i += 3)
+    {
+        vec3 p0 = vertices[result[i + 0]].position;
+        vec3 p1 = vertices[result[i + 1]].position;
+        vec3 p2 = vertices[result[i + 2]].position;
+        vec3 normal = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+        expect_to_be_true(normal.z > 0.0f);
+        area += normal.z * 0.5f;
+    }
+
+    f32 expected_area = (f32)(GEOMETRY_TEST_GRID_SIZE * GEOMETRY_TEST_GRID_SIZE);
+    expect_to_be_true(kabs(area - expected_area) < 0.001f);
+
+    // С ограничением остаются наибольшие треугольники.
+    u32 limited_count = geometry_generate_occluder(vertex_count, vertices, index_count, indices, 3 * 4 + 2, result);
+    expect_should_be(3 * 4, limited_count);
+
+    // Искривленная поверхность не упрощается: окклюдер состоит только из исходных треугольников.
+    for(u32 i = 0; i < vertex_count; ++i)
+    {
+        vec3* p = &vertices[i].position;
+        f32 dx = p->x - GEOMETRY_TEST_GRID_SIZE * 0.5f;
+        f32 dy = p->y - GEOMETRY_TEST_GRID_SIZE * 0.5f;
+        p->z = (dx * dx + dy * dy) * 0.1f;
+    }
+
+    result_count = geometry_generate_occluder(vertex_count, vertices, index_count, indices, 3 * 16, result);
+    expect_should_be(3 * 16, result_count);
+
+    for(u32 i = 0; i < result_count; i += 3)
+    {
+        bool found = false;
+        for(u32 j = 0; j < index_count && !found; j += 3)
+        {
+            found = result[i] == indices[j] && result[i + 1] == indices[j + 1] && result[i + 2] == indices[j + 2];
+        }
+        expect_to_be_true(found);
+    }
+
+    // Пустой бюджет.
+    expect_should_be(0, geometry_generate_occluder(vertex_count, vertices, index_count, indices, 2, result));
+
+    kfree(result, MEMORY_TAG_ARRAY);
+    kfree(vertices, MEMORY_TAG_ARRAY);
+    kfree(indices, MEMORY_TAG_ARRAY);
+
+    expect_should_be(array_usage, memory_system_tag_usage(MEMORY_TAG_ARRAY));
+    return true;
+}
+
+u8 geometry_select_lod_test()
+{
+    // Без уровней детализации всегда 0.
+    expect_should_be(0, geometry_select_lod(0, 0, 0.01f));
+    expect_should_be(0, geometry_select_lod(1, 0, 0.01f));
+
+    // Пороги: < 0.5 уровень 1, < 0.25 уровень 2, < 0.125 уровень 3.
+    expect_should_be(0, geometry_select_lod(4, 0, 1.0f));
+    expect_should_be(1, geometry_select_lod(4, 0, 0.4f));
+    expect_should_be(2, geometry_select_lod(4, 0, 0.2f));
+    expect_should_be(3, geometry_select_lod(4, 0, 0.01f));
+    expect_should_be(2, geometry_select_lod(3, 0, 0.01f));
+
+    // Гистерезис: у порога 0.5 уровень не меняется в обе стороны.
+    expect_should_be(0, geometry_select_lod(4, 0, 0.48f));
+    expect_should_be(1, geometry_select_lod(4, 1, 0.48f));
+    expect_should_be(1, geometry_select_lod(4, 1, 0.52f));
+    expect_should_be(0, geometry_select_lod(4, 1, 0.6f));
+
+    // Устаревшее состояние за пределами уровней сбрасывается.
+    expect_should_be(0, geometry_select_lod(2, 7, 1.0f));
+    return true;
+}
+
+void geometry_utils_register_tests()
+{
+    test_managet_register_test(geometry_simplify_test1, "Mesh simplification should reduce flat grids without flips and keep curved ones within error.");
+    test_managet_register_test(geometry_simplify_test2, "Mesh simplification should keep attribute seams intact.");
+    test_managet_register_test(geometry_generate_occluder_test, "Mesh occluder should be a bounded subset of the surface.");
+    test_managet_register_test(geometry_select_lod_test, "LOD selection should follow screen size thresholds with hysteresis.");
+}
@@ -0,0 +1,207 @@
+#include "math/kmath_simd_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <math/kmath.h>
+#include <math/kmath_simd.h>
+#include <platform/time.h>
+
+#define KMATH_TEST_ITERATIONS 1000
+#define KMATH_BENCH_COUNT 1024
+#define KMATH_BENCH_REPEATS 500
+#define KMATH_TEST_TOLERANCE 0.0005f
+
+// Детерминированный генератор для повторяемых тестов.
+static f32 kmath_test_random(u32* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return ((f32)(*state >> 8) / (f32)(1u << 24)) * 4.0f - 2.0f;
+}
+
+static mat4 kmath_test_matrix(u32* state)
+{
+    // Случайная трансформация с масштабом и перемещением (гарантированно обратима).
+    vec3 axis = vec3_normalized(vec3_create(kmath_test_random(state), kmath_test_random(state), 1.0f));
+    quat rotation = quat_from_axis_angle(axis, kmath_test_random(state), true);
+    vec3 translation = vec3_create(kmath_test_random(state), kmath_test_random(state), kmath_test_random(state));
+    vec3 scale = vec3_create(1.5f + kmath_test_random(state) * 0.5f, 1.0f, 0.75f);
+    mat4 m = mat4_from_translation_rotation_scale(translation, rotation, scale);
+
+    // Возмущение всех элементов, чтобы проверить общий случай.
+    for(u32 i = 0; i < 16; ++i)
+    {
+        m.data[i] += kmath_test_random(state) * 0.1f;
+    }
+    return m;
+}
+
+static bool kmath_test_matrix_equal(mat4 expected, mat4a actual)
+{
+    for(u32 i = 0; i < 16; ++i)
+    {
+        f32 scale = kabs(expected.data[i]) > 1.0f ? kabs(expected.data[i]) : 1.0f;
+        if(kabs(expected.data[i] - actual.data[i]) > KMATH_TEST_TOLERANCE * scale)
+        {
+            kerror("Element %u: expected %f, got %f.", i, expected.data[i], actual.data[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+u8 kmath_simd_test1()
+{
+    mat4a aligned[2];
+    expect_should_be(0, ((u64)&aligned[1]) % 16);
+    expect_should_be(64, sizeof(mat4a));
+    expect_should_be(16, sizeof(vec4a));
+
+    u32 state = 12345;
+    for(u32 i = 0; i < KMATH_TEST_ITERATIONS; ++i)
+    {
+        mat4 a = kmath_test_matrix(&state);
+        mat4 b = kmath_test_matrix(&state);
+        mat4a aa = mat4a_from_mat4(a);
+        mat4a ba = mat4a_from_mat4(b);
+
+        expect_to_be_true(kmath_test_matrix_equal(mat4_mul(a, b), mat4a_mul(aa, ba)));
+        expect_to_be_true(kmath_test_matrix_equal(mat4_inverse(a), mat4a_inverse(aa)));
+        expect_to_be_true(kmath_test_matrix_equal(mat4_transposed(a), mat4a_transposed(aa)));
+    }
+
+    // Произведение на обратную дает единичную матрицу.
+    mat4a m = mat4a_from_mat4(kmath_test_matrix(&state));
+    expect_to_be_true(kmath_test_matrix_equal(mat4_identity(), mat4a_mul(m, mat4a_inverse(m))));
+    expect_to_be_true(kmath_test_matrix_equal(mat4_identity(), mat4a_identity()));
+
+    return true;
+}
+
+u8 kmath_simd_test2()
+{
+    u32 state = 777;
+    for(u32 i = 0; i < KMATH_TEST_ITERATIONS; ++i)
+    {
+        mat4 m = kmath_test_matrix(&state);
+        mat4a ma = mat4a_from_mat4(m);
+        vec4 v = vec4_create(kmath_test_random(&state), kmath_test_random(&state), kmath_test_random(&state), 1.0f);
+        vec4 u = vec4_create(kmath_test_random(&state), kmath_test_random(&state), kmath_test_random(&state), 0.5f);
+        vec4a va = vec4a_from_vec4(v);
+        vec4a ua = vec4a_from_vec4(u);
+
+        expect_to_be_true(vec4_compare(mat4_mul_vec4(m, v), vec4a_to_vec4(mat4a_mul_vec4a(ma, va)), KMATH_TEST_TOLERANCE));
+        expect_to_be_true(vec4_compare(vec4_mul_mat4(v, m), vec4a_to_vec4(vec4a_mul_mat4a(va, ma)), KMATH_TEST_TOLERANCE));
+
+        expect_to_be_true(vec4_compare(vec4_add(v, u), vec4a_to_vec4(vec4a_add(va, ua)), KMATH_TEST_TOLERANCE));
+        expect_to_be_true(vec4_compare(vec4_sub(v, u), vec4a_to_vec4(vec4a_sub(va, ua)), KMATH_TEST_TOLERANCE));
+        expect_to_be_true(vec4_compare(vec4_mul(v, u), vec4a_to_vec4(vec4a_mul(va, ua)), KMATH_TEST_TOLERANCE));
+        expect_to_be_true(vec4_compare(vec4_mul_scalar(v, 3.0f), vec4a_to_vec4(vec4a_mul_scalar(va, 3.0f)), KMATH_TEST_TOLERANCE));
+        expect_to_be_true(vec4_compare(vec4_mul_add(v, u, v), vec4a_to_vec4(vec4a_mul_add(va, ua, va)), KMATH_TEST_TOLERANCE));
+        expect_to_be_true(vec4_compare(vec4_normalized(v), vec4a_to_vec4(vec4a_normalized(va)), KMATH_TEST_TOLERANCE));
+
+        f32 dot = vec4_dot(v.x, v.y, v.z, v.w, u.x, u.y, u.z, u.w);
+        expect_to_be_true(kabs(dot - vec4a_dot(va, ua)) < KMATH_TEST_TOLERANCE);
+        expect_to_be_true(kabs(vec4_length(v) - vec4a_length(va)) < KMATH_TEST_TOLERANCE);
+
+        quat q0 = quat_normalize((quat){{ v.x, v.y, v.z, v.w }});
+        quat q1 = quat_normalize((quat){{ u.x, u.y, u.z, u.w }});
+        quata r = quata_mul(vec4a_from_vec4(q0), vec4a_from_vec4(q1));
+        expect_to_be_true(vec4_compare(quat_mul(q0, q1), vec4a_to_vec4(r), KMATH_TEST_TOLERANCE));
+    }
+
+    return true;
+}
+
+u8 kmath_simd_test3()
+{
+    // Микробенчмарк: пакетная обработка массивов скалярными функциями kmath.h и SIMD вариантами.
+    // NOTE: Результат только выводится в журнал, время зависит от машины и уровня оптимизации.
+    static mat4 m[KMATH_BENCH_COUNT];
+    static mat4a ma[KMATH_BENCH_COUNT];
+    static mat4 out[KMATH_BENCH_COUNT];
+    static mat4a outa[KMATH_BENCH_COUNT];
+    static vec4 v[KMATH_BENCH_COUNT];
+    static vec4a va[KMATH_BENCH_COUNT];
+    static vec4 outv[KMATH_BENCH_COUNT];
+    static vec4a outva[KMATH_BENCH_COUNT];
+
+    u32 state = 4242;
+    for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+    {
+        m[i] = kmath_test_matrix(&state);
+        ma[i] = mat4a_from_mat4(m[i]);
+        v[i] = vec4_create(kmath_test_random(&state), kmath_test_random(&state), kmath_test_random(&state), 1.0f);
+        va[i] = vec4a_from_vec4(v[i]);
+    }
+
+    // Пары времени (скалярный, SIMD) для умножения, обращения и преобразования вектора.
+    f64 times[6] = {0};
+    f32 sink = 0.0f;
+    const u32 mask = KMATH_BENCH_COUNT - 1;
+
+    for(u32 r = 0; r < KMATH_BENCH_REPEATS; ++r)
+    {
+        f64 start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+        {
+            out[i] = mat4_mul(m[i], m[(i + 1) & mask]);
+        }
+        times[0] += platform_time_absolute() - start;
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+        {
+            outa[i] = mat4a_mul(ma[i], ma[(i + 1) & mask]);
+        }
+        times[1] += platform_time_absolute() - start;
+        sink += out[r & mask].data[0] - outa[r & mask].data[0];
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+        {
+            out[i] = mat4_inverse(m[i]);
+        }
+        times[2] += platform_time_absolute() - start;
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+        {
+            outa[i] = mat4a_inverse(ma[i]);
+        }
+        times[3] += platform_time_absolute() - start;
+        sink += out[r & mask].data[0] - outa[r & mask].data[0];
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+        {
+            outv[i] = mat4_mul_vec4(m[i], v[i]);
+        }
+        times[4] += platform_time_absolute() - start;
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_BENCH_COUNT; ++i)
+        {
+            outva[i] = mat4a_mul_vec4a(ma[i], va[i]);
+        }
+        times[5] += platform_time_absolute() - start;
+        sink += outv[r & mask].x - outva[r & mask].x;
+    }
+
+    f64 to_ns = 1e9 / ((f64)KMATH_BENCH_COUNT * KMATH_BENCH_REPEATS);
+    kinfor("kmath benchmark (%s), ns per call, scalar / simd:", KMATH_SIMD_BACKEND);
+    kinfor("  mat4_mul      %6.2f / %6.2f", times[0] * to_ns, times[1] * to_ns);
+    kinfor("  mat4_inverse  %6.2f / %6.2f", times[2] * to_ns, times[3] * to_ns);
+    kinfor("  mat4_mul_vec4 %6.2f / %6.2f", times[4] * to_ns, times[5] * to_ns);
+
+    // Результаты обоих вариантов совпадают (с точностью до округления).
+    expect_to_be_true(kabs(sink) < 1.0f);
+    return true;
+}
+
+void kmath_simd_register_tests()
+{
+    test_managet_register_test(kmath_simd_test1, "SIMD mat4 kernels should match the scalar kmath results.");
+    test_managet_register_test(kmath_simd_test2, "SIMD vec4 and quat kernels should match the scalar kmath results.");
+    test_managet_register_test(kmath_simd_test3, "SIMD kmath microbenchmark.");
+}
@@ -0,0 +1,290 @@
+#include "math/kmath_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <math/kmath.h>
+#include <platform/math.h>
+#include <platform/time.h>
+
+#define KMATH_FAST_TEST_STEPS 100000
+#define KMATH_FAST_BENCH_COUNT 1024
+#define KMATH_FAST_BENCH_REPEATS 500
+#define KMATH_FRUSTUM_TEST_COUNT 1003
+
+// Детерминированный генератор для повторяемых тестов.
+static f32 kmath_fast_test_random(u32* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return ((f32)(*state >> 8) / (f32)(1u << 24)) * 2.0f - 1.0f;
+}
+
+u8 kmath_fast_test1()
+{
+    // Погрешность синуса и косинуса на [-2pi, 2pi] относительно функций платформы.
+    f32 max_sin_error = 0.0f;
+    f32 max_cos_error = 0.0f;
+    for(u32 i = 0; i <= KMATH_FAST_TEST_STEPS; ++i)
+    {
+        f32 x = -K_2PI + K_4PI * (f32)i / KMATH_FAST_TEST_STEPS;
+        f32 s, c;
+        kfast_sincos(x, &s, &c);
+        max_sin_error = KMAX(max_sin_error, kabs(s - platform_math_sin(x)));
+        max_cos_error = KMAX(max_cos_error, kabs(c - platform_math_cos(x)));
+        expect_to_be_true(kfast_sin(x) == s);
+        expect_to_be_true(kfast_cos(x) == c);
+    }
+    kdebug("kfast_sincos max error: sin %e, cos %e.", max_sin_error, max_cos_error);
+    expect_to_be_true(max_sin_error < 5e-7f);
+    expect_to_be_true(max_cos_error < 5e-7f);
+
+    // Относительная погрешность обратного корня на диапазоне [1e-6, 1e6].
+    f32 max_rsqrt_error = 0.0f;
+    for(f32 x = 1e-6f; x < 1e6f; x *= 1.001f)
+    {
+        f32 expected = 1.0f / platform_math_sqrt(x);
+        max_rsqrt_error = KMAX(max_rsqrt_error, kabs(kfast_rsqrt(x) - expected) / expected);
+
+        // Встраиваемые версии совпадают с функциями платформы.
+        expect_to_be_true(ksqrt(x) == platform_math_sqrt(x));
+        expect_to_be_true(kabs(-x) == platform_math_abs(-x));
+    }
+    kdebug("kfast_rsqrt max relative error: %e.", max_rsqrt_error);
+    expect_to_be_true(max_rsqrt_error < 1e-6f);
+
+    // Приведение очень больших углов остается в диапазоне (без приведения за пределы i32).
+    expect_to_be_true(kabs(kwrap_angle(1e7f)) <= K_PI);
+    expect_to_be_true(kwrap_angle(1e20f) == 0.0f);
+    expect_to_be_true(kwrap_angle(-3e38f) == 0.0f);
+    f32 wrapped_inf = kwrap_angle(__builtin_inff());
+    expect_to_be_true(wrapped_inf != wrapped_inf);
+
+    return true;
+}
+
+u8 kmath_fast_test2()
+{
+    vec3 vectors[103];
+    vec3 expected[103];
+    vec3 fast[103];
+    f32 angles[103];
+    f32 sines[103];
+    f32 cosines[103];
+    quat quaternions[103];
+
+    u32 state = 99;
+    for(u32 i = 0; i < 103; ++i)
+    {
+        vectors[i] = vec3_create(kmath_fast_test_random(&state) * 50.0f, kmath_fast_test_random(&state), kmath_fast_test_random(&state) + 2.0f);
+        expected[i] = vec3_normalized(vectors[i]);
+        fast[i] = vectors[i];
+        angles[i] = kmath_fast_test_random(&state) * 10.0f;
+    }
+
+    // Точная версия совпадает с 'vec3_normalize' побитово, быстрая - в пределах погрешности.
+    kmath_normalize_vec3_array(vectors, 103);
+    kmath_fast_normalize_vec3_array(fast, 103);
+    for(u32 i = 0; i < 103; ++i)
+    {
+        expect_to_be_true(vec3_compare(expected[i], vectors[i], 0.0f));
+        expect_to_be_true(vec3_compare(expected[i], fast[i], 2e-6f));
+    }
+
+    kmath_fast_sincos_array(angles, sines, cosines, 103);
+    kmath_quat_from_axis_angle_array(expected, angles, quaternions, 103);
+    for(u32 i = 0; i < 103; ++i)
+    {
+        f32 s, c;
+        kfast_sincos(angles[i], &s, &c);
+        expect_to_be_true(sines[i] == s);
+        expect_to_be_true(cosines[i] == c);
+
+        quat q = quat_from_axis_angle(expected[i], angles[i], false);
+        expect_to_be_true(vec4_compare(q, quaternions[i], 1e-6f));
+    }
+
+    // Массив синусов без косинусов.
+    kmath_fast_sincos_array(angles, sines, null, 103);
+    expect_to_be_true(sines[5] == kfast_sin(angles[5]));
+
+    return true;
+}
+
+u8 kmath_fast_test3()
+{
+    // Микробенчмарк: функции платформы против встраиваемых и пакетных версий.
+    // NOTE: Результат только выводится в журнал, время зависит от машины и уровня оптимизации.
+    static f32 angles[KMATH_FAST_BENCH_COUNT];
+    static f32 sines[KMATH_FAST_BENCH_COUNT];
+    static f32 cosines[KMATH_FAST_BENCH_COUNT];
+    static vec3 source[KMATH_FAST_BENCH_COUNT];
+    static vec3 vectors[KMATH_FAST_BENCH_COUNT];
+
+    u32 state = 4242;
+    for(u32 i = 0; i < KMATH_FAST_BENCH_COUNT; ++i)
+    {
+        angles[i] = kmath_fast_test_random(&state) * K_2PI;
+        source[i] = vec3_create(kmath_fast_test_random(&state), kmath_fast_test_random(&state), 1.0f);
+    }
+
+    f64 times[6] = {0};
+    f32 sink = 0.0f;
+
+    for(u32 r = 0; r < KMATH_FAST_BENCH_REPEATS; ++r)
+    {
+        f64 start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_FAST_BENCH_COUNT; ++i)
+        {
+            sines[i] = platform_math_sin(angles[i]);
+            cosines[i] = platform_math_cos(angles[i]);
+        }
+        times[0] += platform_time_absolute() - start;
+        sink += sines[r] + cosines[r];
+
+        start = platform_time_absolute();
+        kmath_fast_sincos_array(angles, sines, cosines, KMATH_FAST_BENCH_COUNT);
+        times[1] += platform_time_absolute() - start;
+        sink -= sines[r] + cosines[r];
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_FAST_BENCH_COUNT; ++i)
+        {
+            vec3 v = source[i];
+            f32 length = platform_math_sqrt(vec3_length_squared(v));
+            vectors[i] = vec3_create(v.x / length, v.y / length, v.z / length);
+        }
+        times[2] += platform_time_absolute() - start;
+        sink += vectors[r].x;
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_FAST_BENCH_COUNT; ++i)
+        {
+            vectors[i] = vec3_normalized(source[i]);
+        }
+        times[3] += platform_time_absolute() - start;
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_FAST_BENCH_COUNT; ++i)
+        {
+            vectors[i] = source[i];
+        }
+        kmath_normalize_vec3_array(vectors, KMATH_FAST_BENCH_COUNT);
+        times[4] += platform_time_absolute() - start;
+
+        start = platform_time_absolute();
+        for(u32 i = 0; i < KMATH_FAST_BENCH_COUNT; ++i)
+        {
+            vectors[i] = source[i];
+        }
+        kmath_fast_normalize_vec3_array(vectors, KMATH_FAST_BENCH_COUNT);
+        times[5] += platform_time_absolute() - start;
+        sink -= vectors[r].x;
+    }
+
+    f64 to_ns = 1e9 / ((f64)KMATH_FAST_BENCH_COUNT * KMATH_FAST_BENCH_REPEATS);
+    kinfor("kmath fast benchmark, ns per element:");
+    kinfor("  sin+cos   platform %6.2f / kfast_sincos array %6.2f", times[0] * to_ns, times[1] * to_ns);
+    kinfor("  normalize platform sqrt %6.2f / inline %6.2f / array %6.2f / fast array %6.2f",
+        times[2] * to_ns, times[3] * to_ns, times[4] * to_ns, times[5] * to_ns);
+
+    // Результаты вариантов совпадают (с точностью до погрешности).
+    expect_to_be_true(kabs(sink) < 1.0f);
+    return true;
+}
+
+// Матрица вида/проекции камеры как в 'camera_view_get' и 'render_view_world'.
+static frustum kmath_frustum_test_create(vec3 position, f32 yaw)
+{
+    mat4 camera_world = mat4_mul(mat4_euler_y(yaw), mat4_translation(position));
+    mat4 view = mat4_inverse(camera_world);
+    mat4 projection = mat4_perspective(deg_to_rad(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    return frustum_from_view_projection(mat4_mul(view, projection));
+}
+
+u8 kmath_frustum_test1()
+{
+    // Камера в начале координат смотрит вдоль -Z.
+    frustum f = kmath_frustum_test_create(vec3_zero(), 0.0f);
+    vec3 unit = vec3_one();
+
+    vec3 front = vec3_create(0.0f, 0.0f, -10.0f);
+    vec3 behind = vec3_create(0.0f, 0.0f, 10.0f);
+    vec3 left = vec3_create(-100.0f, 0.0f, -10.0f);
+    vec3 above = vec3_create(0.0f, 100.0f, -10.0f);
+    vec3 beyond_far = vec3_create(0.0f, 0.0f, -150.0f);
+    expect_to_be_true(frustum_intersects_aabb(&f, &front, &unit));
+    expect_to_be_false(frustum_intersects_aabb(&f, &behind, &unit));
+    expect_to_be_false(frustum_intersects_aabb(&f, &left, &unit));
+    expect_to_be_false(frustum_intersects_aabb(&f, &above, &unit));
+    expect_to_be_false(frustum_intersects_aabb(&f, &beyond_far, &unit));
+
+    // Центр вне пирамиды, но прямоугольник пересекает левую плоскость.
+    vec3 straddle = vec3_create(-10.0f, 0.0f, -10.0f);
+    vec3 wide = vec3_create(3.0f, 1.0f, 1.0f);
+    expect_to_be_true(frustum_intersects_aabb(&f, &straddle, &wide));
+    expect_to_be_false(frustum_intersects_aabb(&f, &straddle, &unit));
+
+    // Нормали направлены внутрь: точка перед камерой с положительной дистанцией до всех плоскостей.
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        expect_to_be_true(plane_signed_distance(&f.sides[i], &front) > 0.0f);
+    }
+    expect_to_be_true(frustum_intersects_sphere(&f, &front, 0.5f));
+    expect_to_be_false(frustum_intersects_sphere(&f, &behind, 0.5f));
+
+    // Повернутый на 45 градусов единичный куб: половинные размеры по X и Z равны sqrt(2).
+    extents_3d cube = { vec3_create(-1.0f, -1.0f, -1.0f), vec3_create(1.0f, 1.0f, 1.0f) };
+    mat4 model = mat4_mul(mat4_euler_y(deg_to_rad(45.0f)), mat4_translation(vec3_create(3.0f, 0.0f, -5.0f)));
+    vec3 center, extents;
+    aabb_transform(&cube, model, &center, &extents);
+    expect_to_be_true(kabs(center.x - 3.0f) < 0.0001f && kabs(center.z + 5.0f) < 0.0001f);
+    expect_to_be_true(kabs(extents.x - K_SQRT_TWO) < 0.0001f);
+    expect_to_be_true(kabs(extents.y - 1.0f) < 0.0001f);
+    expect_to_be_true(kabs(extents.z - K_SQRT_TWO) < 0.0001f);
+    return true;
+}
+
+u8 kmath_frustum_test2()
+{
+    // Пакетная проверка совпадает с поштучной (количество не кратно четырем).
+    frustum f = kmath_frustum_test_create(vec3_create(5.0f, 2.0f, 3.0f), deg_to_rad(30.0f));
+    vec3 centers[KMATH_FRUSTUM_TEST_COUNT];
+    vec3 extents[KMATH_FRUSTUM_TEST_COUNT];
+    u8 visible[KMATH_FRUSTUM_TEST_COUNT];
+
+    u32 state = 31337;
+    for(u32 i = 0; i < KMATH_FRUSTUM_TEST_COUNT; ++i)
+    {
+        centers[i] = vec3_create(
+            kmath_fast_test_random(&state) * 120.0f, kmath_fast_test_random(&state) * 120.0f, kmath_fast_test_random(&state) * 120.0f
+        );
+        extents[i] = vec3_create(
+            kabs(kmath_fast_test_random(&state)) * 5.0f, kabs(kmath_fast_test_random(&state)) * 5.0f, kabs(kmath_fast_test_random(&state)) * 5.0f
+        );
+    }
+
+    u32 visible_count = frustum_intersects_aabb_array(&f, centers, extents, KMATH_FRUSTUM_TEST_COUNT, visible);
+
+    u32 expected_count = 0;
+    for(u32 i = 0; i < KMATH_FRUSTUM_TEST_COUNT; ++i)
+    {
+        bool expected = frustum_intersects_aabb(&f, &centers[i], &extents[i]);
+        expect_should_be(expected, visible[i]);
+        expected_count += expected;
+    }
+    expect_should_be(expected_count, visible_count);
+
+    // Часть прямоугольников видима, часть отсечена.
+    kdebug("Frustum batch: visible %u of %u.", visible_count, KMATH_FRUSTUM_TEST_COUNT);
+    expect_to_be_true(visible_count > 0 && visible_count < KMATH_FRUSTUM_TEST_COUNT);
+    return true;
+}
+
+void kmath_register_tests()
+{
+    test_managet_register_test(kmath_fast_test1, "Fast kmath approximations should stay within documented error bounds.");
+    test_managet_register_test(kmath_fast_test2, "Batched kmath array functions should match scalar versions.");
+    test_managet_register_test(kmath_fast_test3, "Fast kmath functions benchmark.");
+    test_managet_register_test(kmath_frustum_test1, "Frustum planes and AABB tests should classify known boxes.");
+    test_managet_register_test(kmath_frustum_test2, "Batched frustum AABB test should match the scalar version.");
+}
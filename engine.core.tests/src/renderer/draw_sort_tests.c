@@ -0,0 +1,98 @@
+#include "renderer/draw_sort_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <memory/memory.h>
+#include <renderer/draw_sort.h>
+
+#define DRAW_SORT_TEST_COUNT 5000
+
+// Детерминированный генератор для повторяемых тестов.
+static u64 draw_sort_test_random(u64* state)
+{
+    *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+    return *state;
+}
+
+u8 draw_sort_test1()
+{
+    u64* keys = kallocate_tc(u64, DRAW_SORT_TEST_COUNT, MEMORY_TAG_ARRAY);
+    u64* original = kallocate_tc(u64, DRAW_SORT_TEST_COUNT, MEMORY_TAG_ARRAY);
+    u32* values = kallocate_tc(u32, DRAW_SORT_TEST_COUNT, MEMORY_TAG_ARRAY);
+    u64* temp_keys = kallocate_tc(u64, DRAW_SORT_TEST_COUNT, MEMORY_TAG_ARRAY);
+    u32* temp_values = kallocate_tc(u32, DRAW_SORT_TEST_COUNT, MEMORY_TAG_ARRAY);
+
+    // Много повторов в старших разрядах и случайные младшие, часть разрядов одинакова у всех ключей.
+    u64 state = 12345;
+    for(u32 i = 0; i < DRAW_SORT_TEST_COUNT; ++i)
+    {
+        u64 r = draw_sort_test_random(&state);
+        keys[i] = ((r >> 60) << 56) | (r & 0xffffff);
+        original[i] = keys[i];
+        values[i] = i;
+    }
+
+    draw_sort_radix(DRAW_SORT_TEST_COUNT, keys, values, temp_keys, temp_values);
+
+    for(u32 i = 0; i < DRAW_SORT_TEST_COUNT; ++i)
+    {
+        // Значения переставлены вместе с ключами.
+        expect_to_be_true(original[values[i]] == keys[i]);
+
+        if(i > 0)
+        {
+            expect_to_be_true(keys[i - 1] <= keys[i]);
+            // Устойчивость: равные ключи сохраняют исходный порядок.
+            if(keys[i - 1] == keys[i])
+            {
+                expect_to_be_true(values[i - 1] < values[i]);
+            }
+        }
+    }
+
+    kfree(keys, MEMORY_TAG_ARRAY);
+    kfree(original, MEMORY_TAG_ARRAY);
+    kfree(values, MEMORY_TAG_ARRAY);
+    kfree(temp_keys, MEMORY_TAG_ARRAY);
+    kfree(temp_values, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+u8 draw_sort_test2()
+{
+    // Непрозрачные: группировка по шейдеру и материалу, внутри - от ближних к дальним.
+    u64 near_a = draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 7, 3, 1.0f);
+    u64 far_a = draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 7, 3, 100.0f);
+    u64 near_b = draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 8, 3, 0.5f);
+    u64 other_shader = draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 1, 9, 3, 50.0f);
+    expect_to_be_true(near_a < far_a);
+    expect_to_be_true(far_a < near_b);
+    expect_to_be_true(other_shader < near_a);
+
+    // Непрозрачные: одинаковые геометрии материала идут подряд независимо от глубины.
+    u64 far_geometry_a = draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 7, 4, 90.0f);
+    u64 near_geometry_b = draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 7, 5, 2.0f);
+    expect_to_be_true(far_a < far_geometry_a);
+    expect_to_be_true(far_geometry_a < near_geometry_b);
+    expect_to_be_true(near_geometry_b < near_b);
+
+    // Прозрачные: после непрозрачных, от дальних к ближним независимо от материала и геометрии.
+    u64 far_t = draw_sort_key_create(1, DRAW_SORT_LAYER_TRANSPARENT, 2, 9, 1, 100.0f);
+    u64 near_t = draw_sort_key_create(1, DRAW_SORT_LAYER_TRANSPARENT, 1, 1, 9, 1.0f);
+    expect_to_be_true(far_a < far_t);
+    expect_to_be_true(near_b < far_t);
+    expect_to_be_true(far_t < near_t);
+
+    // Вид старше слоя, отрицательная глубина считается нулем.
+    expect_to_be_true(near_t < draw_sort_key_create(2, DRAW_SORT_LAYER_OPAQUE, 0, 0, 0, 0.0f));
+    expect_to_be_true(
+        draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 7, 3, -5.0f) == draw_sort_key_create(1, DRAW_SORT_LAYER_OPAQUE, 2, 7, 3, 0.0f)
+    );
+    return true;
+}
+
+void draw_sort_register_tests()
+{
+    test_managet_register_test(draw_sort_test1, "Draw sort radix sort is ordered and stable.");
+    test_managet_register_test(draw_sort_test2, "Draw sort keys order by view, layer, state, geometry and depth.");
+}
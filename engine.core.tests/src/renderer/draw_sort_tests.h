@@ -0,0 +1,3 @@
+#pragma once
+
+void draw_sort_register_tests();
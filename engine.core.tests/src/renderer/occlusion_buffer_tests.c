@@ -0,0 +1,192 @@
+#include "renderer/occlusion_buffer_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <memory/memory.h>
+#include <math/kmath.h>
+#include <renderer/occlusion_buffer.h>
+#include <systems/job_system.h>
+
+#define OCCLUSION_TEST_WIDTH 256
+#define OCCLUSION_TEST_HEIGHT 128
+#define OCCLUSION_TEST_TRIANGLES 4096
+#define OCCLUSION_TEST_THREAD_COUNT 4
+
+// Детерминированный генератор для повторяемых тестов.
+static f32 occlusion_test_random(u32* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return ((f32)(*state >> 8) / (f32)(1u << 24)) * 2.0f - 1.0f;
+}
+
+static occlusion_buffer* occlusion_test_create(void** out_memory)
+{
+    occlusion_buffer_config config = { OCCLUSION_TEST_WIDTH, OCCLUSION_TEST_HEIGHT, OCCLUSION_TEST_TRIANGLES };
+    u64 memory_requirement = 0;
+    occlusion_buffer_create(&memory_requirement, null, &config, null);
+    *out_memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+
+    occlusion_buffer* buffer = null;
+    occlusion_buffer_create(&memory_requirement, *out_memory, &config, &buffer);
+    return buffer;
+}
+
+// Камера в начале координат смотрит вдоль -Z.
+static mat4 occlusion_test_view_projection()
+{
+    return mat4_perspective(deg_to_rad(60.0f), 1.0f, 0.1f, 1000.0f);
+}
+
+u8 occlusion_buffer_test1()
+{
+    void* memory = null;
+    occlusion_buffer* buffer = occlusion_test_create(&memory);
+    expect_to_be_true(buffer != null);
+
+    // Стена x [-2, 2], y [-2, 2], z [-11, -10].
+    occluder wall = {};
+    wall.extents.min = vec3_create(-2.0f, -2.0f, -11.0f);
+    wall.extents.max = vec3_create(2.0f, 2.0f, -10.0f);
+    wall.model = mat4_identity();
+
+    occlusion_buffer_begin(buffer, occlusion_test_view_projection(), 0.1f);
+    expect_to_be_true(occlusion_buffer_add_occluder(buffer, &wall));
+    occlusion_buffer_rasterize(buffer);
+
+    // Ближняя грань стены в центре экрана на расстоянии 10.
+    f32 center_depth = occlusion_buffer_get_depth(buffer, OCCLUSION_TEST_WIDTH / 2, OCCLUSION_TEST_HEIGHT / 2);
+    expect_to_be_true(kabs(center_depth - 0.1f) < 0.0001f);
+    expect_float_to_be(0.0f, occlusion_buffer_get_depth(buffer, 0, 0));
+
+    vec3 unit = vec3_one();
+    vec3 behind = vec3_create(0.0f, 0.0f, -30.0f);
+    vec3 beside = vec3_create(8.0f, 0.0f, -30.0f);
+    vec3 partial = vec3_create(6.5f, 0.0f, -30.0f);
+    vec3 small = vec3_create(0.5f, 0.5f, 0.5f);
+    vec3 in_front = vec3_create(0.0f, 0.0f, -5.0f);
+    vec3 at_camera = vec3_create(0.0f, 0.0f, 0.0f);
+    expect_to_be_false(occlusion_buffer_test_aabb(buffer, &behind, &unit));
+    expect_to_be_true(occlusion_buffer_test_aabb(buffer, &beside, &unit));
+    expect_to_be_true(occlusion_buffer_test_aabb(buffer, &partial, &unit));
+    expect_to_be_true(occlusion_buffer_test_aabb(buffer, &in_front, &small));
+    expect_to_be_true(occlusion_buffer_test_aabb(buffer, &at_camera, &unit));
+
+    // Окклюдер не перекрывает свой же ограничивающий прямоугольник.
+    vec3 wall_center = vec3_create(0.0f, 0.0f, -10.5f);
+    vec3 wall_extents = vec3_create(2.0f, 2.0f, 0.5f);
+    expect_to_be_true(occlusion_buffer_test_aabb(buffer, &wall_center, &wall_extents));
+
+    // Пакетная проверка учитывает только отмеченные видимыми.
+    vec3 centers[4] = { behind, beside, behind, wall_center };
+    vec3 extents[4] = { unit, unit, unit, wall_extents };
+    u8 visible[4] = { 1, 1, 0, 1 };
+    expect_should_be(1, occlusion_buffer_test_aabb_array(buffer, centers, extents, 4, visible));
+    expect_should_be(0, visible[0]);
+    expect_should_be(1, visible[1]);
+    expect_should_be(0, visible[2]);
+    expect_should_be(1, visible[3]);
+
+    // Новый кадр без окклюдеров ничего не перекрывает.
+    occlusion_buffer_begin(buffer, occlusion_test_view_projection(), 0.1f);
+    occlusion_buffer_rasterize(buffer);
+    expect_to_be_true(occlusion_buffer_test_aabb(buffer, &behind, &unit));
+
+    occlusion_buffer_destroy(buffer);
+    kfree(memory, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+static void occlusion_test_fill(occlusion_buffer* buffer, vec3* vertices, u32* indices, u32 triangle_count)
+{
+    occluder o = {};
+    o.vertices = vertices;
+    o.vertex_count = triangle_count * 3;
+    o.indices = indices;
+    o.index_count = triangle_count * 3;
+    o.model = mat4_identity();
+
+    occlusion_buffer_begin(buffer, occlusion_test_view_projection(), 0.1f);
+    occlusion_buffer_add_occluder(buffer, &o);
+    occlusion_buffer_rasterize(buffer);
+}
+
+u8 occlusion_buffer_test2()
+{
+    // Параллельная растеризация полосами совпадает с однопоточной.
+    const u32 triangle_count = 2000;
+    vec3* vertices = kallocate_tc(vec3, triangle_count * 3, MEMORY_TAG_ARRAY);
+    u32* indices = kallocate_tc(u32, triangle_count * 3, MEMORY_TAG_ARRAY);
+
+    u32 state = 9001;
+    for(u32 i = 0; i < triangle_count; ++i)
+    {
+        vec3 base = vec3_create(occlusion_test_random(&state) * 40.0f, occlusion_test_random(&state) * 40.0f, -20.0f - kabs(occlusion_test_random(&state)) * 60.0f);
+        for(u32 j = 0; j < 3; ++j)
+        {
+            vec3 offset = vec3_create(occlusion_test_random(&state) * 4.0f, occlusion_test_random(&state) * 4.0f, occlusion_test_random(&state) * 2.0f);
+            vertices[i * 3 + j] = vec3_add(base, offset);
+            indices[i * 3 + j] = i * 3 + j;
+        }
+    }
+
+    void* memory_single = null;
+    void* memory_parallel = null;
+    occlusion_buffer* single = occlusion_test_create(&memory_single);
+    occlusion_buffer* parallel = occlusion_test_create(&memory_parallel);
+
+    occlusion_test_fill(single, vertices, indices, triangle_count);
+
+    u32 type_masks[OCCLUSION_TEST_THREAD_COUNT];
+    for(u32 i = 0; i < OCCLUSION_TEST_THREAD_COUNT; ++i)
+    {
+        type_masks[i] = JOB_TYPE_GENERAL;
+    }
+
+    job_system_config job_config = { OCCLUSION_TEST_THREAD_COUNT, type_masks };
+    u64 job_memory_requirement = 0;
+    job_system_initialize(&job_memory_requirement, null, &job_config);
+    void* job_memory = kallocate(job_memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(job_system_initialize(&job_memory_requirement, job_memory, &job_config));
+
+    occlusion_test_fill(parallel, vertices, indices, triangle_count);
+
+    job_system_shutdown();
+    kfree(job_memory, MEMORY_TAG_ARRAY);
+
+    u32 covered = 0;
+    for(u32 y = 0; y < OCCLUSION_TEST_HEIGHT; ++y)
+    {
+        for(u32 x = 0; x < OCCLUSION_TEST_WIDTH; ++x)
+        {
+            f32 expected = occlusion_buffer_get_depth(single, x, y);
+            expect_to_be_true(expected == occlusion_buffer_get_depth(parallel, x, y));
+            covered += expected > 0.0f;
+        }
+    }
+
+    // Часть экрана покрыта окклюдерами.
+    expect_to_be_true(covered > 0 && covered < OCCLUSION_TEST_WIDTH * OCCLUSION_TEST_HEIGHT);
+
+    // Глубина покрытых пикселей в пределах глубины треугольников.
+    for(u32 y = 0; y < OCCLUSION_TEST_HEIGHT; ++y)
+    {
+        for(u32 x = 0; x < OCCLUSION_TEST_WIDTH; ++x)
+        {
+            f32 depth = occlusion_buffer_get_depth(single, x, y);
+            expect_to_be_true(depth == 0.0f || (depth > 1.0f / 83.0f && depth < 1.0f / 17.0f));
+        }
+    }
+
+    kfree(memory_parallel, MEMORY_TAG_ARRAY);
+    kfree(memory_single, MEMORY_TAG_ARRAY);
+    kfree(indices, MEMORY_TAG_ARRAY);
+    kfree(vertices, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void occlusion_buffer_register_tests()
+{
+    test_managet_register_test(occlusion_buffer_test1, "Occlusion buffer should cull boxes hidden behind occluders.");
+    test_managet_register_test(occlusion_buffer_test2, "Occlusion buffer parallel rasterization should match single threaded.");
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void occlusion_buffer_register_tests();
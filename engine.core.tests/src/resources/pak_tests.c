@@ -0,0 +1,80 @@
+#include "resources/pak_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <resources/pak.h>
+#include <platform/file.h>
+#include <memory/memory.h>
+
+// Создает файл с заданным содержимым (при нулевом размере - пустой файл).
+static bool pak_test_file_create(const char* path, u64 size, const void* data)
+{
+    file* f = null;
+    if(!platform_file_open(path, FILE_MODE_WRITE | FILE_MODE_BINARY, &f))
+    {
+        return false;
+    }
+
+    bool result = !size || platform_file_write(f, size, data);
+    platform_file_close(f);
+    return result;
+}
+
+u8 pak_test1()
+{
+    const char* paths[] = { "pak_tests_empty.txt", "pak_tests_data.bin" };
+    const char* names[] = { "empty.txt", "data.bin" };
+    const char* pak_path = "pak_tests.kpak";
+    const char data[] = "0123456789";
+
+    expect_to_be_true(pak_test_file_create(paths[0], 0, null));
+    expect_to_be_true(pak_test_file_create(paths[1], sizeof(data), data));
+
+    // Пустой файл отображается как пустое отображение.
+    file_mapping mapping;
+    expect_to_be_true(platform_file_map(paths[0], &mapping));
+    expect_pointer_should_be(null, mapping.data);
+    expect_should_be(0, mapping.size);
+    platform_file_unmap(&mapping);
+
+    ptr array_usage = memory_system_tag_usage(MEMORY_TAG_ARRAY);
+    bool written = pak_write(pak_path, 2, names, paths);
+    expect_should_be(array_usage, memory_system_tag_usage(MEMORY_TAG_ARRAY));
+
+    pak archive;
+    bool opened = written && pak_open(pak_path, &archive);
+
+    const void* empty_data = null;
+    u64 empty_size = 1;
+    const void* found_data = null;
+    u64 found_size = 0;
+    bool found_empty = opened && pak_find(&archive, names[0], &empty_data, &empty_size);
+    bool found = opened && pak_find(&archive, names[1], &found_data, &found_size);
+    bool equal = found && found_size == sizeof(data);
+    for(u64 i = 0; equal && i < found_size; ++i)
+    {
+        equal = ((const char*)found_data)[i] == data[i];
+    }
+
+    if(opened)
+    {
+        pak_close(&archive);
+    }
+
+    platform_file_delete(paths[0]);
+    platform_file_delete(paths[1]);
+    platform_file_delete(pak_path);
+
+    expect_to_be_true(written);
+    expect_to_be_true(opened);
+    expect_to_be_true(found_empty);
+    expect_should_be(0, empty_size);
+    expect_to_be_true(found);
+    expect_to_be_true(equal);
+    return true;
+}
+
+void pak_register_tests()
+{
+    test_managet_register_test(pak_test1, "Resource archive should pack and find empty files.");
+}
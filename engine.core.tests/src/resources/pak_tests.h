@@ -0,0 +1,3 @@
+#pragma once
+
+void pak_register_tests();
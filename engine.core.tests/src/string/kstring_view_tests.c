@@ -0,0 +1,168 @@
+#include "string/kstring_view_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <kstring.h>
+#include <kstring_view.h>
+#include <platform/string.h>
+
+u8 string_view_test1()
+{
+    // Буфер без завершающего '\0', как у отображенного в память файла.
+    const char text[] = "# comment\r\n  name = Builtin.Material \n\nstages=vert, frag,,geom";
+    string_tokenizer tokenizer;
+    string_tokenizer_create(text, sizeof(text) - 1, &tokenizer);
+
+    kstring_view line;
+    expect_to_be_true(string_tokenizer_next_line(&tokenizer, &line));
+    expect_to_be_true(string_view_equal(line, "# comment"));
+
+    expect_to_be_true(string_tokenizer_next_line(&tokenizer, &line));
+    line = string_view_trim(line);
+    i64 equal_index = string_view_index_of(line, '=');
+    expect_should_be(5, equal_index);
+    expect_to_be_true(string_view_equali(string_view_trim(string_view_sub(line, 0, equal_index)), "NAME"));
+    expect_to_be_true(string_view_equal(string_view_trim(string_view_sub(line, equal_index + 1, -1)), "Builtin.Material"));
+    expect_to_be_false(string_view_equal(string_view_sub(line, 0, 4), "nam"));
+
+    expect_to_be_true(string_tokenizer_next_line(&tokenizer, &line));
+    expect_should_be(0, line.length);
+
+    expect_to_be_true(string_tokenizer_next_line(&tokenizer, &line));
+    expect_should_be(4, tokenizer.line_number);
+    expect_to_be_true(string_view_starts_withi(line, "STAGES="));
+
+    // Разделение как 'string_split' с пустыми частями, но без выделения памяти.
+    const char* expected[] = { "vert", "frag", "", "geom" };
+    kstring_view rest = string_view_sub(line, 7, -1);
+    kstring_view token;
+    u32 count = 0;
+    while(string_view_split_next(&rest, ',', &token))
+    {
+        expect_to_be_true(count < 4);
+        expect_to_be_true(string_view_equal(string_view_trim(token), expected[count]));
+        count++;
+    }
+    expect_should_be(4, count);
+    expect_to_be_false(string_tokenizer_next_line(&tokenizer, &line));
+
+    char buffer[5];
+    expect_should_be(4, string_view_copy(buffer, sizeof(buffer), string_view_create("Builtin")));
+    expect_to_be_true(string_equal(buffer, "Buil"));
+
+    char* copy = string_view_duplicate(string_view_sub(string_view_create("Builtin"), 3, 2));
+    expect_to_be_true(string_equal(copy, "lt"));
+    string_free(copy);
+
+    return true;
+}
+
+u8 string_view_test2()
+{
+    // Результат должен совпадать с библиотечным разбором бит в бит.
+    u64 seed = 0x9e3779b97f4a7c15ULL;
+    char text[64];
+
+    for(u32 i = 0; i < 20000; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        u32 digits = (u32)(seed >> 33) % 100000000;
+        u32 fraction = (u32)(seed >> 13) % 1000000;
+        i32 exponent = (i32)((seed >> 7) % 61) - 30;
+
+        switch(i % 3)
+        {
+            case 0: string_format(text, sizeof(text), "%u.%06u", digits, fraction); break;
+            case 1: string_format(text, sizeof(text), "-%u.%ue%d", digits % 1000, fraction, exponent); break;
+            default: string_format(text, sizeof(text), "%u%06u%u", digits, fraction, digits); break;
+        }
+
+        f32 expected32 = 0;
+        f64 expected64 = 0;
+        platform_string_sscanf(text, "%f", &expected32);
+        platform_string_sscanf(text, "%lf", &expected64);
+
+        kstring_view view = string_view_create(text);
+        f32 value32 = 0;
+        expect_to_be_true(string_view_parse_f32(&view, &value32));
+        expect_should_be(0, view.length);
+        expect_to_be_true(expected32 == value32);
+
+        view = string_view_create(text);
+        f64 value64 = 0;
+        expect_to_be_true(string_view_parse_f64(&view, &value64));
+        expect_to_be_true(expected64 == value64);
+    }
+
+    f32 value = 0;
+    expect_to_be_true(string_view_to_f32(string_view_create(" -468.9 "), &value));
+    expect_float_to_be(-468.9f, value);
+    expect_to_be_false(string_view_to_f32(string_view_create("a-468.9"), &value));
+    expect_to_be_false(string_view_to_f32(string_view_create("6.5x"), &value));
+    expect_to_be_false(string_view_to_f32(string_view_create("1e"), &value));
+
+    vec3 v;
+    expect_to_be_true(string_view_to_vec3(string_view_create("0.5 -2 3e1"), &v));
+    expect_float_to_be(0.5f, v.x);
+    expect_float_to_be(-2.0f, v.y);
+    expect_float_to_be(30.0f, v.z);
+
+    vec4 color;
+    expect_to_be_true(string_view_to_vec4(string_view_create("1.0 0.25"), &color));
+    expect_float_to_be(0.25f, color.y);
+    expect_float_to_be(0.0f, color.w);
+
+    return true;
+}
+
+u8 string_view_test3()
+{
+    i32 value = 0;
+    expect_to_be_true(string_view_to_i32(string_view_create(" -2147483648 "), &value));
+    expect_should_be(I32_MIN, value);
+    expect_to_be_false(string_view_to_i32(string_view_create("2147483648"), &value));
+    expect_to_be_false(string_view_to_i32(string_view_create("--1"), &value));
+
+    u64 big = 0;
+    kstring_view view = string_view_create("18446744073709551615");
+    expect_to_be_true(string_view_parse_u64(&view, &big));
+    expect_to_be_true(big == U64_MAX);
+    view = string_view_create("18446744073709551616");
+    expect_to_be_false(string_view_parse_u64(&view, &big));
+
+    // Разбор индексов грани obj вида pos/tex/norm.
+    kstring_view face = string_view_create("f 1/2/3 4//6 7");
+    kstring_view token;
+    i64 indices[9] = {0};
+    u32 vertex = 0;
+
+    expect_to_be_true(string_view_next_token(&face, &token));
+    expect_to_be_true(string_view_equal(token, "f"));
+    while(string_view_next_token(&face, &token))
+    {
+        for(u32 j = 0; j < 3 && token.length > 0; ++j)
+        {
+            string_view_parse_i64(&token, &indices[vertex * 3 + j]);
+            if(token.length > 0 && token.data[0] == '/')
+            {
+                token = string_view_sub(token, 1, -1);
+            }
+        }
+        vertex++;
+    }
+
+    expect_should_be(3, vertex);
+    expect_should_be(2, indices[1]);
+    expect_should_be(0, indices[4]);
+    expect_should_be(6, indices[5]);
+    expect_should_be(7, indices[6]);
+
+    return true;
+}
+
+void string_view_register_tests()
+{
+    test_managet_register_test(string_view_test1, "String views should tokenize a buffer without allocations.");
+    test_managet_register_test(string_view_test2, "Fast float parsing should match the standard library.");
+    test_managet_register_test(string_view_test3, "Integer parsing should detect overflow and parse obj faces.");
+}
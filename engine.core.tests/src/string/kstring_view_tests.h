@@ -0,0 +1,3 @@
+#pragma once
+
+void string_view_register_tests();
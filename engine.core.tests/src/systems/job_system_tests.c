@@ -0,0 +1,86 @@
+#include "systems/job_system_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <memory/memory.h>
+#include <systems/job_system.h>
+
+#define JOB_TEST_THREAD_COUNT 4
+#define JOB_TEST_OUTER_COUNT 12
+#define JOB_TEST_INNER_COUNT 4096
+#define JOB_TEST_INNER_BATCH 64
+
+typedef struct job_test_context {
+    u64 sums[JOB_TEST_OUTER_COUNT];
+    u32 calls[JOB_TEST_OUTER_COUNT];
+} job_test_context;
+
+typedef struct job_test_inner_context {
+    job_test_context* outer;
+    u32 index;
+} job_test_inner_context;
+
+static void job_test_inner(void* context, u32 begin, u32 end)
+{
+    job_test_inner_context* ctx = context;
+
+    u64 sum = 0;
+    for(u32 i = begin; i < end; ++i)
+    {
+        sum += i;
+    }
+
+    __atomic_add_fetch(&ctx->outer->sums[ctx->index], sum, __ATOMIC_RELAXED);
+}
+
+static void job_test_outer(void* context, u32 begin, u32 end)
+{
+    job_test_context* ctx = context;
+
+    for(u32 i = begin; i < end; ++i)
+    {
+        // Вложенный цикл внутри части внешнего.
+        job_test_inner_context inner = { ctx, i };
+        job_system_parallel_for(JOB_TEST_INNER_COUNT + i, JOB_TEST_INNER_BATCH, job_test_inner, &inner);
+        ctx->calls[i]++;
+    }
+}
+
+u8 job_system_test1()
+{
+    u32 type_masks[JOB_TEST_THREAD_COUNT];
+    for(u32 i = 0; i < JOB_TEST_THREAD_COUNT; ++i)
+    {
+        type_masks[i] = JOB_TYPE_GENERAL;
+    }
+
+    job_system_config job_config = { JOB_TEST_THREAD_COUNT, type_masks };
+    u64 job_memory_requirement = 0;
+    job_system_initialize(&job_memory_requirement, null, &job_config);
+    void* job_memory = kallocate(job_memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(job_system_initialize(&job_memory_requirement, job_memory, &job_config));
+
+    for(u32 frame = 0; frame < 16; ++frame)
+    {
+        job_test_context context = {};
+        job_system_parallel_for(JOB_TEST_OUTER_COUNT, 1, job_test_outer, &context);
+
+        // Каждая часть внешнего и внутреннего цикла обработана ровно один раз.
+        for(u32 i = 0; i < JOB_TEST_OUTER_COUNT; ++i)
+        {
+            u64 count = JOB_TEST_INNER_COUNT + i;
+            expect_should_be(1, context.calls[i]);
+            expect_should_be(count * (count - 1) / 2, context.sums[i]);
+        }
+    }
+
+    job_system_shutdown();
+    kfree(job_memory, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void job_system_register_tests()
+{
+    test_managet_register_test(job_system_test1, "Nested parallel loops should process every batch exactly once.");
+}
@@ -0,0 +1,260 @@
+#include "systems/transform_system_tests.h"
+#include "test_manager.h"
+#include "expect.h"
+
+#include <logger.h>
+#include <memory/memory.h>
+#include <math/kmath.h>
+#include <math/transform.h>
+#include <systems/transform_system.h>
+#include <systems/job_system.h>
+
+#define TRANSFORM_TEST_COUNT 64
+#define TRANSFORM_TEST_LARGE_COUNT 6000
+#define TRANSFORM_TEST_THREAD_COUNT 4
+#define TRANSFORM_TEST_TOLERANCE 0.0005f
+
+// Детерминированный генератор для повторяемых тестов.
+static f32 transform_test_random(u32* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return ((f32)(*state >> 8) / (f32)(1u << 24)) * 2.0f - 1.0f;
+}
+
+static void transform_test_random_trs(u32* state, vec3* position, quat* rotation, vec3* scale)
+{
+    vec3 axis = vec3_normalized(vec3_create(transform_test_random(state), transform_test_random(state), 1.0f));
+    *rotation = quat_from_axis_angle(axis, transform_test_random(state) * 3.0f, true);
+    *position = vec3_create(transform_test_random(state) * 10.0f, transform_test_random(state) * 10.0f, transform_test_random(state) * 10.0f);
+    *scale = vec3_create(1.0f + transform_test_random(state) * 0.25f, 1.0f, 1.0f - transform_test_random(state) * 0.25f);
+}
+
+static bool transform_test_matrix_equal(mat4 expected, mat4 actual)
+{
+    for(u32 i = 0; i < 16; ++i)
+    {
+        f32 scale = kabs(expected.data[i]) > 1.0f ? kabs(expected.data[i]) : 1.0f;
+        if(kabs(expected.data[i] - actual.data[i]) > TRANSFORM_TEST_TOLERANCE * scale)
+        {
+            kerror("Element %u: expected %f, got %f.", i, expected.data[i], actual.data[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void* transform_test_start(u32 max_count)
+{
+    transform_system_config config = { max_count };
+    u64 memory_requirement = 0;
+    transform_system_initialize(&memory_requirement, null, &config);
+    void* memory = kallocate(memory_requirement, MEMORY_TAG_ARRAY);
+    transform_system_initialize(&memory_requirement, memory, &config);
+    return memory;
+}
+
+static void transform_test_stop(void* memory)
+{
+    transform_system_shutdown();
+    kfree(memory, MEMORY_TAG_ARRAY);
+}
+
+// Строит случайную иерархию в системе и такую же из 'transform' для сравнения.
+static void transform_test_build(u32 count, u32 seed, u32* ids, transform* reference)
+{
+    u32 state = seed;
+    for(u32 i = 0; i < count; ++i)
+    {
+        vec3 position, scale;
+        quat rotation;
+        transform_test_random_trs(&state, &position, &rotation, &scale);
+
+        // Каждый четвертый - корневой, остальные привязаны к одному из предыдущих.
+        u32 parent = (i % 4 == 0) ? INVALID_ID : (u32)((transform_test_random(&state) * 0.5f + 0.5f) * i) % i;
+
+        ids[i] = transform_system_acquire(position, rotation, scale, parent == INVALID_ID ? INVALID_ID : ids[parent]);
+        reference[i] = transform_from_position_rotation_scale(position, rotation, scale);
+        reference[i].parent = parent == INVALID_ID ? null : &reference[parent];
+    }
+}
+
+static bool transform_test_compare(u32 count, u32* ids, transform* reference)
+{
+    for(u32 i = 0; i < count; ++i)
+    {
+        if(!transform_test_matrix_equal(transform_get_world(&reference[i]), transform_system_get_world(ids[i])))
+        {
+            kerror("Transform %u world matrix mismatch.", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+u8 transform_system_test1()
+{
+    void* memory = transform_test_start(TRANSFORM_TEST_COUNT);
+    u32 ids[TRANSFORM_TEST_COUNT];
+    transform reference[TRANSFORM_TEST_COUNT];
+
+    transform_test_build(TRANSFORM_TEST_COUNT, 777, ids, reference);
+    transform_system_update_all();
+    expect_to_be_true(transform_test_compare(TRANSFORM_TEST_COUNT, ids, reference));
+
+    // Изменение корня пересчитывает всех потомков.
+    quat rotation = quat_from_axis_angle(vec3_up(), 0.3f, false);
+    transform_system_rotate(ids[0], rotation);
+    transform_rotate(&reference[0], rotation);
+    transform_system_translate(ids[5], vec3_create(1.0f, 2.0f, 3.0f));
+    transform_translate(&reference[5], vec3_create(1.0f, 2.0f, 3.0f));
+    transform_system_update_all();
+    expect_to_be_true(transform_test_compare(TRANSFORM_TEST_COUNT, ids, reference));
+
+    expect_to_be_true(transform_system_world_changed(ids[0]));
+
+    // Повторное обновление без изменений не меняет результат.
+    transform_system_update_all();
+    expect_to_be_true(transform_test_compare(TRANSFORM_TEST_COUNT, ids, reference));
+    expect_to_be_false(transform_system_world_changed(ids[0]));
+
+    transform_test_stop(memory);
+    return true;
+}
+
+u8 transform_system_test2()
+{
+    void* memory = transform_test_start(TRANSFORM_TEST_COUNT);
+    vec3 one = vec3_one();
+    quat identity = quat_identity();
+
+    u32 a = transform_system_acquire(vec3_create(1.0f, 0.0f, 0.0f), identity, one, INVALID_ID);
+    u32 b = transform_system_acquire(vec3_create(0.0f, 2.0f, 0.0f), identity, one, a);
+    u32 c = transform_system_acquire(vec3_create(0.0f, 0.0f, 3.0f), identity, one, b);
+    u32 d = transform_system_acquire(vec3_create(4.0f, 0.0f, 0.0f), identity, one, INVALID_ID);
+    expect_should_be(a, transform_system_get_parent(b));
+    expect_should_be(INVALID_ID, transform_system_get_parent(d));
+
+    // Цикл в иерархии запрещен.
+    expect_to_be_false(transform_system_set_parent(a, c));
+    expect_to_be_false(transform_system_set_parent(a, a));
+
+    // Корень становится потомком узла, добавленного позже (требуется перестроение порядка).
+    expect_to_be_true(transform_system_set_parent(a, d));
+    transform_system_update_all();
+    mat4 world = transform_system_get_world(c);
+    expect_float_to_be(5.0f, world.data[12]);
+    expect_float_to_be(2.0f, world.data[13]);
+    expect_float_to_be(3.0f, world.data[14]);
+
+    // Потомки удаленного преобразования становятся корневыми.
+    transform_system_release(a);
+    expect_should_be(INVALID_ID, transform_system_get_parent(b));
+    expect_should_be(b, transform_system_get_parent(c));
+    transform_system_update_all();
+    world = transform_system_get_world(c);
+    expect_float_to_be(0.0f, world.data[12]);
+    expect_float_to_be(2.0f, world.data[13]);
+    expect_float_to_be(3.0f, world.data[14]);
+
+    // Освободившийся идентификатор используется повторно.
+    u32 e = transform_system_acquire(vec3_zero(), identity, one, c);
+    expect_should_be(a, e);
+    transform_system_update_all();
+    world = transform_system_get_world(e);
+    expect_float_to_be(2.0f, world.data[13]);
+
+    transform_test_stop(memory);
+    return true;
+}
+
+u8 transform_system_test4()
+{
+    // Число корней больше 255: после перестроения уровней их границы не должны сохранять старые байты.
+    const u32 root_count = 300;
+    ptr array_usage = memory_system_tag_usage(MEMORY_TAG_ARRAY);
+    void* memory = transform_test_start(root_count + 1);
+    vec3 one = vec3_one();
+    quat identity = quat_identity();
+
+    u32 roots[300];
+    for(u32 i = 0; i < root_count; ++i)
+    {
+        roots[i] = transform_system_acquire(vec3_create((f32)i, 0.0f, 0.0f), identity, one, INVALID_ID);
+    }
+    u32 child = transform_system_acquire(vec3_create(0.0f, 1.0f, 0.0f), identity, one, roots[7]);
+    transform_system_update_all();
+    expect_float_to_be(7.0f, transform_system_get_world(child).data[12]);
+
+    // Удаление единственного потомка сокращает иерархию до одного уровня.
+    transform_system_release(child);
+    transform_system_update_all();
+
+    // Перепривязка создает второй уровень и снова убирает его.
+    expect_to_be_true(transform_system_set_parent(roots[1], roots[2]));
+    transform_system_update_all();
+    expect_float_to_be(3.0f, transform_system_get_world(roots[1]).data[12]);
+    expect_to_be_true(transform_system_set_parent(roots[1], INVALID_ID));
+    transform_system_update_all();
+
+    for(u32 i = 0; i < root_count; ++i)
+    {
+        expect_float_to_be((f32)i, transform_system_get_world(roots[i]).data[12]);
+    }
+
+    // Обновление не выходит за пределы памяти системы.
+    transform_test_stop(memory);
+    expect_should_be(array_usage, memory_system_tag_usage(MEMORY_TAG_ARRAY));
+    return true;
+}
+
+u8 transform_system_test3()
+{
+    // Система заданий для параллельного обновления уровней иерархии.
+    u32 type_masks[TRANSFORM_TEST_THREAD_COUNT];
+    for(u32 i = 0; i < TRANSFORM_TEST_THREAD_COUNT; ++i)
+    {
+        type_masks[i] = JOB_TYPE_GENERAL;
+    }
+
+    job_system_config job_config = { TRANSFORM_TEST_THREAD_COUNT, type_masks };
+    u64 job_memory_requirement = 0;
+    job_system_initialize(&job_memory_requirement, null, &job_config);
+    void* job_memory = kallocate(job_memory_requirement, MEMORY_TAG_ARRAY);
+    expect_to_be_true(job_system_initialize(&job_memory_requirement, job_memory, &job_config));
+
+    void* memory = transform_test_start(TRANSFORM_TEST_LARGE_COUNT);
+    u32* ids = kallocate_tc(u32, TRANSFORM_TEST_LARGE_COUNT, MEMORY_TAG_ARRAY);
+    transform* reference = kallocate_tc(transform, TRANSFORM_TEST_LARGE_COUNT, MEMORY_TAG_ARRAY);
+
+    transform_test_build(TRANSFORM_TEST_LARGE_COUNT, 4242, ids, reference);
+    transform_system_update_all();
+    expect_to_be_true(transform_test_compare(TRANSFORM_TEST_LARGE_COUNT, ids, reference));
+
+    for(u32 frame = 0; frame < 8; ++frame)
+    {
+        quat rotation = quat_from_axis_angle(vec3_up(), 0.1f, false);
+        for(u32 i = frame; i < TRANSFORM_TEST_LARGE_COUNT; i += 97)
+        {
+            transform_system_rotate(ids[i], rotation);
+            transform_rotate(&reference[i], rotation);
+        }
+        transform_system_update_all();
+    }
+    expect_to_be_true(transform_test_compare(TRANSFORM_TEST_LARGE_COUNT, ids, reference));
+
+    kfree(reference, MEMORY_TAG_ARRAY);
+    kfree(ids, MEMORY_TAG_ARRAY);
+    transform_test_stop(memory);
+
+    job_system_shutdown();
+    kfree(job_memory, MEMORY_TAG_ARRAY);
+    return true;
+}
+
+void transform_system_register_tests()
+{
+    test_managet_register_test(transform_system_test1, "Transform system world matrices should match recursive transforms.");
+    test_managet_register_test(transform_system_test2, "Transform system should keep hierarchy order on reparent and release.");
+    test_managet_register_test(transform_system_test4, "Transform system should rebuild hierarchy levels after release and reparent.");
+    test_managet_register_test(transform_system_test3, "Transform system should update large hierarchies in parallel.");
+}
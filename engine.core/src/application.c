@@ -9,6 +9,7 @@
 #include "platform/window.h"
 #include "platform/time.h"
 #include "platform/thread.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "memory/allocators/linear_allocator.h"
 #include "renderer/renderer_frontend.h"
@@ -20,11 +21,14 @@
 #include "systems/camera_system.h"
 #include "systems/render_view_system.h"
 #include "systems/job_system.h"
+#include "systems/transform_system.h"
+#include "containers/bvh.h"
+#include "containers/darray.h"
+#include "renderer/occlusion_buffer.h"
 
 // TODO: Временный тестовый код: начало.
 #include "kstring.h"
 #include "math/kmath.h"
-#include "math/transform.h"
 #include "resources/mesh.h"
 // TODO: Временный тестовый код: конец.
 
@@ -37,6 +41,21 @@ typedef struct application_state {
 
     linear_allocator* systems_allocator;
 
+    u64 logger_memory_requirement;
+    void* logger_state;
+
+    u64 profiler_memory_requirement;
+    void* profiler_state;
+    f64 profiler_report_time;
+
+    // Идет воспроизведение записи ввода (приложение завершается после него).
+    bool input_replay;
+
+    // Замер способов отрисовки: номер кадра замера, время отрисовки и вызовы отрисовки (прямой, косвенный).
+    u32 draw_benchmark_frame;
+    f64 draw_benchmark_time[2];
+    u64 draw_benchmark_calls[2];
+
     u64 event_system_memory_requirement;
     void* event_system_state;
 
@@ -73,6 +92,9 @@ typedef struct application_state {
     u64 camera_system_memory_requirement;
     void* camera_system_state;
 
+    u64 transform_system_memory_requirement;
+    void* transform_system_state;
+
     // TODO: Временный тестовый код: начало.
     skybox sb;
     texture_map* sb_maps[1];
@@ -83,6 +105,14 @@ typedef struct application_state {
     bool models_loaded;
 
     mesh ui_meshes[10];
+
+    // Индекс сцены по ограничивающим прямоугольникам геометрий мировых сеток.
+    bvh* scene;
+    void* scene_memory;
+    u32* world_mesh_proxies[10];
+    // Окклюдеры геометрий мировых сеток (darray), окклюдеры одной сетки идут подряд с индекса world_mesh_occluders[i].
+    occluder* occluders;
+    u32 world_mesh_occluders[10];
     // TODO: Временный тестовый код: конец.
 
 } application_state;
@@ -98,6 +128,87 @@ void application_on_resize(i32 width, i32 height);
 void application_on_close();
 
 // TODO: Временный тестовый код: начало.
+static extents_3d application_geometry_world_extents(const geometry* g, mat4 model)
+{
+    vec3 center, half;
+    aabb_transform(&g->extents, model, &center, &half);
+
+    extents_3d result = { vec3_sub(center, half), vec3_add(center, half) };
+    return result;
+}
+
+// Добавляет загруженные сетки в индекс сцены и обновляет прямоугольники перемещенных.
+static void application_scene_update()
+{
+    bool inserted = false;
+
+    for(u32 i = 0; i < 10; ++i)
+    {
+        mesh* m = &app_state->world_meshes[i];
+        if(m->generation == INVALID_ID_U8 || !m->geometry_count)
+        {
+            continue;
+        }
+
+        u32* proxies = app_state->world_mesh_proxies[i];
+        if(proxies && !transform_system_world_changed(m->transform_id))
+        {
+            continue;
+        }
+
+        mat4 model = transform_system_get_world(m->transform_id);
+
+        if(!proxies)
+        {
+            proxies = kallocate_tc(u32, m->geometry_count, MEMORY_TAG_ARRAY);
+            app_state->world_mesh_proxies[i] = proxies;
+
+            app_state->world_mesh_occluders[i] = darray_length(app_state->occluders);
+
+            for(u32 j = 0; j < m->geometry_count; ++j)
+            {
+                const geometry* g = m->geometries[j];
+                extents_3d extents = application_geometry_world_extents(g, model);
+                proxies[j] = bvh_insert(app_state->scene, &extents, m, j);
+
+                // Окклюдер построен при импорте сетки (смотри geometry_generate_occluder).
+                if(g->occluder_vertices)
+                {
+                    occluder o = {};
+                    o.vertices = g->occluder_vertices;
+                    o.vertex_count = g->occluder_vertex_count;
+                    o.indices = g->occluder_indices;
+                    o.index_count = g->occluder_index_count;
+                    o.extents = g->extents;
+                    o.model = model;
+                    darray_push(app_state->occluders, o);
+                }
+            }
+            inserted = true;
+            continue;
+        }
+
+        u32 occluder_index = app_state->world_mesh_occluders[i];
+        for(u32 j = 0; j < m->geometry_count; ++j)
+        {
+            if(m->geometries[j]->occluder_vertices)
+            {
+                app_state->occluders[occluder_index++].model = model;
+            }
+
+            if(proxies[j] == INVALID_ID) continue;
+            extents_3d extents = application_geometry_world_extents(m->geometries[j], model);
+            bvh_move(app_state->scene, proxies[j], &extents);
+        }
+    }
+
+    // Статическая геометрия загружается редко: после загрузки дерево перестраивается по SAH.
+    if(inserted)
+    {
+        bvh_rebuild(app_state->scene);
+    }
+}
+
 bool event_on_debug_event(event_code code, void* sender, void* listener_inst, event_context* context)
 {
     if(code == EVENT_CODE_DEBUG_0)
@@ -192,6 +303,41 @@ bool application_create(game* game_inst)
     u64 systems_allocator_total_size = 64 MiB;
     app_state->systems_allocator = linear_allocator_create(systems_allocator_total_size); // TODO: Реарганизовать!
 
+    // Асинхронный вывод сообщений (до остальных систем, чтобы их сообщения не задерживали инициализацию).
+    logger_config logger_cfg;
+    logger_cfg.max_thread_count = 16;
+    logger_cfg.thread_buffer_size = 1 << 16;
+    logger_cfg.flush_interval_ms = 2;
+    logger_cfg.file_path = "engine.log";
+    // NOTE: Двоичный журнал (читается утилитой logdecoder) включается явно, т.к. в этом режиме в консоль
+    //       выводятся только ошибки и предупреждения.
+    logger_cfg.binary_file_path = null;
+    logger_cfg.binary_ring_size = 4 MiB;
+    logger_initialize(&app_state->logger_memory_requirement, null, &logger_cfg);
+    app_state->logger_state = linear_allocator_allocate(app_state->systems_allocator, app_state->logger_memory_requirement);
+    if(!logger_initialize(&app_state->logger_memory_requirement, app_state->logger_state, &logger_cfg))
+    {
+        kerror("Failed to initialize logger. Aborted!");
+        return false;
+    }
+    kinfor("Logger started.");
+
+#if KPROFILER_ENABLED
+    // Профилировщик (до остальных систем, чтобы их замеры попадали в отчет).
+    profiler_config profiler_cfg;
+    profiler_cfg.max_thread_count = 16;
+    profiler_cfg.max_event_count = 16384;
+    profiler_cfg.max_node_count = 1024;
+    profiler_initialize(&app_state->profiler_memory_requirement, null, &profiler_cfg);
+    app_state->profiler_state = linear_allocator_allocate(app_state->systems_allocator, app_state->profiler_memory_requirement);
+    if(!profiler_initialize(&app_state->profiler_memory_requirement, app_state->profiler_state, &profiler_cfg))
+    {
+        kerror("Failed to initialize profiler. Aborted!");
+        return false;
+    }
+    kinfor("Profiler started.");
+#endif
+
     // Система событий (должно быть инициализировано до создания окна приложения).
     event_system_initialize(&app_state->event_system_memory_requirement, null);
     app_state->event_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->event_system_memory_requirement);
@@ -210,6 +356,7 @@ bool application_create(game* game_inst)
     window_sys_config.title = game_inst->window_title;
     window_sys_config.width = game_inst->window_width;
     window_sys_config.height = game_inst->window_height;
+    window_sys_config.use_event_thread = game_inst->window_event_thread;
     platform_window_create(&app_state->platform_window_memory_requirement, null, null);
     app_state->platform_window_state = linear_allocator_allocate(app_state->systems_allocator, app_state->platform_window_memory_requirement);
     if(!platform_window_create(&app_state->platform_window_memory_requirement, app_state->platform_window_state, &window_sys_config))
@@ -231,7 +378,9 @@ bool application_create(game* game_inst)
     // Система загрузки ресурсов (должна загружаться до визуализатора, и других ресурсных систем).
     resource_system_config resource_sys_config;
     resource_sys_config.asset_base_path = "../assets";
+    resource_sys_config.asset_pak_path = "assets.pak"; // NOTE: Необязателен, создается целью 'make pack'.
     resource_sys_config.max_loader_count = 32;
+    resource_sys_config.watch_asset_changes = true;
     resource_system_initialize(&app_state->resource_system_memory_requirement, null, &resource_sys_config);
     app_state->resource_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->resource_system_memory_requirement);
     if(!resource_system_initialize(&app_state->resource_system_memory_requirement, app_state->resource_system_state, &resource_sys_config))
@@ -265,6 +414,9 @@ bool application_create(game* game_inst)
     }
     kinfor("Renderer system started.");
 
+    // NOTE: Если косвенная отрисовка не поддерживается, используются прямые вызовы отрисовки.
+    renderer_indirect_draw_set(game_inst->renderer_indirect_draw);
+
     bool renderer_multithreaded = renderer_is_multithreaded();
 
     // NOTE: Минус один, т.к. главный поток уже запущен и используется.
@@ -364,6 +516,17 @@ bool application_create(game* game_inst)
     }
     kinfor("Camera system started.");
 
+    transform_system_config transform_sys_config;
+    transform_sys_config.max_transform_count = 4096;
+    transform_system_initialize(&app_state->transform_system_memory_requirement, null, &transform_sys_config);
+    app_state->transform_system_state = linear_allocator_allocate(app_state->systems_allocator, app_state->transform_system_memory_requirement);
+    if(!transform_system_initialize(&app_state->transform_system_memory_requirement, app_state->transform_system_state, &transform_sys_config))
+    {
+        kerror("Failed to initialize transform system. Aborted!");
+        return false;
+    }
+    kinfor("Transform system started.");
+
     render_view_system_config render_view_sys_config;
     render_view_sys_config.max_view_count = 251;
     render_view_system_initialize(&app_state->render_view_system_memory_requirement, null, &render_view_sys_config);
@@ -468,22 +631,22 @@ bool application_create(game* game_inst)
     cube_mesh->geometries = kallocate_tc(geometry*, cube_mesh->geometry_count, MEMORY_TAG_ARRAY);
     geometry_config g_config = geometry_system_generate_cube_config(10.0f, 10.0f, 10.0f, 1.0f, 1.0f, "test_cube", "test_material");
     cube_mesh->geometries[0] = geometry_system_acquire_from_config(&g_config, true);
-    cube_mesh->transform = transform_create();
+    cube_mesh->transform_id = transform_system_acquire(vec3_zero(), quat_identity(), vec3_one(), INVALID_ID);
     geometry_system_config_dispose(&g_config);
     mesh_count++;
 
     // Машина.
     app_state->car_mesh = &app_state->world_meshes[mesh_count];
-    app_state->car_mesh->transform = transform_from_position((vec3){{20.0f, 0.0f, 0.0f}});
+    app_state->car_mesh->transform_id = transform_system_acquire((vec3){{20.0f, 0.0f, 0.0f}}, quat_identity(), vec3_one(), INVALID_ID);
     mesh_count++;
 
     // Спонза.
     app_state->sponza_mesh = &app_state->world_meshes[mesh_count];
-    app_state->sponza_mesh->transform = transform_from_position((vec3){{0.0f, 0.0f, 0.0f}});
+    app_state->sponza_mesh->transform_id = transform_system_acquire(vec3_zero(), quat_identity(), vec3_one(), INVALID_ID);
     mesh_count++;
 
     // UI.
-    geometry_config ui_config;
+    geometry_config ui_config = {};
     ui_config.vertex_size = sizeof(vertex_2d);
     ui_config.vertex_count = 4;
     ui_config.index_size = sizeof(u32);
@@ -524,7 +687,21 @@ bool application_create(game* game_inst)
     ui_mesh->geometry_count = 1;
     ui_mesh->geometries = kallocate_tc(geometry*, ui_mesh->geometry_count, MEMORY_TAG_ARRAY);
     ui_mesh->geometries[0] = geometry_system_acquire_from_config(&ui_config, true);
-    ui_mesh->transform = transform_create();
+    ui_mesh->transform_id = transform_system_acquire(vec3_zero(), quat_identity(), vec3_one(), INVALID_ID);
+
+    // Индекс сцены.
+    bvh_config scene_config;
+    scene_config.max_proxy_count = 8192;
+    scene_config.margin = 0.5f;
+    u64 scene_memory_requirement = 0;
+    bvh_create(&scene_memory_requirement, null, &scene_config, null);
+    app_state->scene_memory = kallocate(scene_memory_requirement, MEMORY_TAG_APPLICATION);
+    if(!bvh_create(&scene_memory_requirement, app_state->scene_memory, &scene_config, &app_state->scene))
+    {
+        kerror("Failed to create scene bvh. Aborted!");
+        return false;
+    }
+    app_state->occluders = darray_create(occluder);
 
     event_register(EVENT_CODE_DEBUG_0, null, event_on_debug_event);
     event_register(EVENT_CODE_DEBUG_1, null, event_on_debug_event);
@@ -548,6 +725,42 @@ bool application_create(game* game_inst)
     return true;
 }
 
+// Накапливает замер способов отрисовки: первые кадры рисуются прямыми вызовами, следующие косвенными.
+static void application_draw_benchmark_update(f64 draw_time)
+{
+    u32 frames = app_state->game_inst->draw_benchmark_frames;
+    if(!frames || app_state->draw_benchmark_frame >= frames * 2)
+    {
+        return;
+    }
+
+    u32 path = app_state->draw_benchmark_frame / frames;
+    app_state->draw_benchmark_time[path] += draw_time;
+    app_state->draw_benchmark_calls[path] += renderer_draw_call_count();
+    app_state->draw_benchmark_frame++;
+
+    if(app_state->draw_benchmark_frame == frames)
+    {
+        if(!renderer_indirect_draw_set(true))
+        {
+            kwarng("Draw benchmark stopped: indirect draw is not supported.");
+            app_state->draw_benchmark_frame = frames * 2;
+            renderer_indirect_draw_set(false);
+        }
+        return;
+    }
+
+    if(app_state->draw_benchmark_frame == frames * 2)
+    {
+        kinfor(
+            "Draw benchmark (%u frames per path): direct %.3f ms and %llu draw calls per frame, indirect %.3f ms and %llu draw calls per frame.",
+            frames, app_state->draw_benchmark_time[0] * 1000.0 / frames, (unsigned long long)(app_state->draw_benchmark_calls[0] / frames),
+            app_state->draw_benchmark_time[1] * 1000.0 / frames, (unsigned long long)(app_state->draw_benchmark_calls[1] / frames)
+        );
+        renderer_indirect_draw_set(app_state->game_inst->renderer_indirect_draw);
+    }
+}
+
 bool application_run()
 {
     if(!app_state)
@@ -566,29 +779,61 @@ bool application_run()
     // u16 frame_count      = 0;
     f64 frame_limit_time = 1.0f / 120; // TODO: сделать настраиваемым!
 
+    // Воспроизведение или запись ввода для повторяемых замеров производительности.
+    if(app_state->game_inst->input_replay_path)
+    {
+        app_state->input_replay = input_replay_start(app_state->game_inst->input_replay_path);
+    }
+    else if(app_state->game_inst->input_record_path)
+    {
+        input_record_start(app_state->game_inst->input_record_path);
+    }
+
+    // Замер начинается с прямой отрисовки.
+    if(app_state->game_inst->draw_benchmark_frames)
+    {
+        renderer_indirect_draw_set(false);
+    }
+
     // TODO: Временный тестовый код: начало.
     render_view_packet views[3];
     // TODO: Временный тестовый код: конец.
 
     while(app_state->is_running)
     {
+        // NOTE: В режиме потока событий здесь передаются обработчикам накопленные потоком события.
         if(!platform_window_dispatch(app_state->platform_window_state))
         {
             app_state->is_running = false;
         }
 
+        // Обработка отложенных событий (в том числе отправленных из других потоков).
+        event_system_dispatch();
+
         if(!app_state->is_suspended)
         {
             // Обновляем таймер и получаем дельту!
             clock_update(&app_state->clock);
             f64 current_time = app_state->clock.elapsed;
-            f64 delta = current_time - app_state->last_time;
+            // NOTE: При воспроизведении ввода используется записанная длительность кадра.
+            f64 delta = input_system_frame_delta(current_time - app_state->last_time);
             f64 frame_start_time = platform_time_absolute();
+            KPROFILE_BEGIN("application_run");
 
             // Update the job system.
             job_system_update();
 
-            if(!app_state->game_inst->update(app_state->game_inst, (f32)delta))
+            // Подмена текстур, данные которых загружены на GPU.
+            texture_system_update();
+
+            // Обновление индекса файлов ресурсов при изменениях в каталоге ресурсов.
+            resource_system_update();
+
+            KPROFILE_BEGIN("game_update");
+            bool game_updated = app_state->game_inst->update(app_state->game_inst, (f32)delta);
+            KPROFILE_END();
+
+            if(!game_updated)
             {
                 kerror("Game update failed, shutting down!");
                 app_state->is_running = false;
@@ -596,7 +841,11 @@ bool application_run()
             }
 
             // Пользовательский рендер.
-            if(!app_state->game_inst->render(app_state->game_inst, (f32)delta))
+            KPROFILE_BEGIN("game_render");
+            bool game_rendered = app_state->game_inst->render(app_state->game_inst, (f32)delta);
+            KPROFILE_END();
+
+            if(!game_rendered)
             {
                 kerror("Game render failed, shutting down!");
                 app_state->is_running = false;
@@ -605,7 +854,11 @@ bool application_run()
 
             // TODO: Временный тестовый код: начало.
             quat rotation = quat_from_axis_angle(vec3_up(), 0.5f * delta, false);
-            transform_rotate(&app_state->world_meshes[0].transform, rotation);
+            transform_system_rotate(app_state->world_meshes[0].transform_id, rotation);
+
+            // Мировые матрицы вычисляются один раз за кадр, представления используют готовые.
+            transform_system_update_all();
+            application_scene_update();
 
             // TODO: Реарганизовать.
             render_packet packet = {};
@@ -617,11 +870,6 @@ bool application_run()
             // Skybox.
             skybox_packet_data skybox_data = {};
             skybox_data.sb = &app_state->sb;
-            if(!render_view_system_build_packet(render_view_system_get("skybox"), &skybox_data, &packet.views[0]))
-            {
-                kerror("Failed to build packet for view 'skybox'.");
-                return false;
-            }
 
             // World.
             mesh_packet_data world_mesh_data = {};
@@ -640,12 +888,11 @@ bool application_run()
 
             world_mesh_data.mesh_count = mesh_count;
             world_mesh_data.meshes = meshes;
+            world_mesh_data.scene = app_state->scene;
 
-            if(!render_view_system_build_packet(render_view_system_get("world_opaque"), &world_mesh_data, &packet.views[1]))
-            {
-                kerror("Failed to build packet for view 'world_opaque'.");
-                return false;
-            }
+            // Окклюдеры всех сеток сцены, матрицы обновлены вместе с индексом сцены.
+            world_mesh_data.occluder_count = darray_length(app_state->occluders);
+            world_mesh_data.occluders = app_state->occluders;
 
             // UI.
             mesh_packet_data ui_mesh_data = {};
@@ -666,19 +913,30 @@ bool application_run()
             ui_mesh_data.mesh_count = ui_mesh_count;
             ui_mesh_data.meshes = ui_meshes;
 
-            if(!render_view_system_build_packet(render_view_system_get("ui"), &ui_mesh_data, &packet.views[2]))
+            // Пакеты представлений строятся параллельно, основной поток ждет только их завершения.
+            // NOTE: Ленивая матрица вида общей камеры вычисляется заранее, представления только читают ее.
+            camera_view_get(camera_system_get_default());
+
+            render_view* packet_views[3] = {
+                render_view_system_get("skybox"), render_view_system_get("world_opaque"), render_view_system_get("ui")
+            };
+            void* packet_data[3] = { &skybox_data, &world_mesh_data, &ui_mesh_data };
+
+            if(!render_view_system_build_packets(packet.view_count, packet_views, packet_data, packet.views))
             {
-                kerror("Failed to build packet for view 'ui'.");
+                kerror("Failed to build view packets.");
                 return false;
             }
             // TODO: Временный тестовый код: конец.
 
+            f64 draw_start_time = platform_time_absolute();
             if(!renderer_draw_frame(&packet))
             {
                 kerror("Renderer failed draw frame, shutting down!");
                 app_state->is_running = false;
                 break;
             }
+            application_draw_benchmark_update(platform_time_absolute() - draw_start_time);
 
             // TODO: Временный тестовый код: начало.
             // Очистка данных пакетов.
@@ -703,6 +961,7 @@ bool application_run()
                 bool frame_limit_on = true;
                 if(remaining_ms > 0 && frame_limit_on)
                 {
+                    KPROFILE_SCOPE("frame_limiter");
                     platform_thread_sleep(remaining_ms - 1);
                 }
 
@@ -713,6 +972,23 @@ bool application_run()
             // NOTE: Устройства ввода последнее что должно обновляться в кадре!
             input_system_update(delta);
 
+            if(app_state->input_replay && !input_is_replaying())
+            {
+                app_state->is_running = false;
+            }
+
+            KPROFILE_END();
+
+#if KPROFILER_ENABLED
+            // Сбор замеров кадра и периодический вывод отчета.
+            profiler_frame_end();
+            if(current_time - app_state->profiler_report_time >= 10.0)
+            {
+                profiler_report_log();
+                app_state->profiler_report_time = current_time;
+            }
+#endif
+
             app_state->last_time = current_time;
         }
     }
@@ -726,10 +1002,22 @@ bool application_run()
         if(app_state->world_meshes[i].generation != INVALID_ID_U8)
         {
             kdebug("World mesh[%u]: get geometries is %u", i, app_state->world_meshes[i].geometry_count);
+            if(app_state->world_mesh_proxies[i])
+            {
+                kfree(app_state->world_mesh_proxies[i], MEMORY_TAG_ARRAY);
+                app_state->world_mesh_proxies[i] = null;
+            }
             kfree(app_state->world_meshes[i].geometries, MEMORY_TAG_ARRAY);
         }
     }
 
+    bvh_destroy(app_state->scene);
+    kfree(app_state->scene_memory, MEMORY_TAG_APPLICATION);
+    app_state->scene = null;
+
+    darray_destroy(app_state->occluders);
+    app_state->occluders = null;
+
     for(u32 i = 0; i < 10; ++i)
     {
         if(app_state->ui_meshes[i].generation != INVALID_ID_U8)
@@ -752,6 +1040,9 @@ bool application_run()
     render_view_system_shutdown();
     kinfor("Render view system stopped.");
 
+    transform_system_shutdown();
+    kinfor("Transform system stopped.");
+
     camera_system_shutdown();
     kinfor("Camera system stopped.");
 
@@ -782,6 +1073,14 @@ bool application_run()
     event_system_shutdown();
     kinfor("Event system stopped.");
 
+#if KPROFILER_ENABLED
+    profiler_shutdown();
+    kinfor("Profiler stopped.");
+#endif
+
+    kinfor("Logger stopped.");
+    logger_shutdown();
+
     linear_allocator_free_all(app_state->systems_allocator);
     linear_allocator_destroy(app_state->systems_allocator);
     app_state->systems_allocator = null;
@@ -834,7 +1133,7 @@ void application_on_resize(i32 width, i32 height)
 
     // Создание события на обновление размеров.
     event_context context = { .i32[0] = width, .i32[1] = height };
-    event_send(EVENT_CODE_APPLICATION_RESIZE, null, &context);
+    event_post(EVENT_CODE_APPLICATION_RESIZE, null, &context);
 }
 
 void application_on_close()
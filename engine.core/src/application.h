@@ -10,6 +10,16 @@ typedef struct game {
     i32   window_width;
     // @brief Высота окна.
     i32   window_height;
+    // @brief Принимать события окна в отдельном потоке (ниже задержка ввода, цикл кадра не ждет композитор).
+    bool  window_event_thread;
+    // @brief Путь к файлу для записи ввода за все время работы, null без записи.
+    const char* input_record_path;
+    // @brief Путь к файлу записи ввода для воспроизведения (приложение завершается после него), null без воспроизведения.
+    const char* input_replay_path;
+    // @brief Рисовать пакеты геометрий мира командами косвенной отрисовки (multi-draw indirect).
+    bool  renderer_indirect_draw;
+    // @brief Количество кадров замера каждого способа отрисовки (прямого и косвенного), 0 без замера.
+    u32   draw_benchmark_frames;
     // @brief Указатель на функцию инициализации игры.
     bool (*initialize)(struct game* inst);
     // @brief Указатель на функцию обновления состояния игры.
@@ -0,0 +1,827 @@
+// Собственные подключения.
+#include "containers/bvh.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "math/kmath.h"
+
+#define BVH_NODE_FREE          -1
+#define BVH_QUERY_STACK_SIZE   256
+#define BVH_QUERY_INSIDE_FLAG  0x80000000u
+#define BVH_SAH_BIN_COUNT      16
+// NOTE: Глубже этого уровня построение делит объекты пополам, что ограничивает высоту дерева.
+#define BVH_SAH_MAX_DEPTH      48
+
+typedef struct bvh_node {
+    // Ограничивающий прямоугольник (для листьев - расширенный на margin).
+    extents_3d box;
+    // Пользовательские данные (только для листьев).
+    void* user_data;
+    u32 user_index;
+    // Родительский узел, или следующий свободный узел для свободных узлов.
+    u32 parent;
+    // Дочерние узлы, INVALID_ID для листьев.
+    u32 child1;
+    u32 child2;
+    // Высота поддерева: 0 для листьев, BVH_NODE_FREE для свободных узлов.
+    i32 height;
+} bvh_node;
+
+struct bvh {
+    // Максимальное количество объектов.
+    u32 max_proxy_count;
+    // Количество узлов.
+    u32 node_capacity;
+    // Текущее количество объектов.
+    u32 proxy_count;
+    // Корневой узел.
+    u32 root;
+    // Первый свободный узел.
+    u32 free_list;
+    // Запас расширения прямоугольников листьев.
+    f32 margin;
+    // Массив узлов.
+    bvh_node* nodes;
+};
+
+static bool bvh_valid(bvh* tree, const char* func_name)
+{
+    if(!tree || !tree->nodes)
+    {
+        if(func_name) kerror("Function '%s' requires a valid pointer to bvh.", func_name);
+        return false;
+    }
+    return true;
+}
+
+static bool bvh_proxy_valid(bvh* tree, u32 proxy_id, const char* func_name)
+{
+    if(!bvh_valid(tree, func_name)) return false;
+
+    if(proxy_id >= tree->node_capacity || tree->nodes[proxy_id].height != 0)
+    {
+        if(func_name) kerror("Function '%s': Invalid proxy id %u.", func_name, proxy_id);
+        return false;
+    }
+    return true;
+}
+
+KINLINE bool bvh_node_is_leaf(const bvh_node* node)
+{
+    return node->child1 == INVALID_ID;
+}
+
+KINLINE extents_3d bvh_box_union(extents_3d a, extents_3d b)
+{
+    extents_3d result;
+    result.min = vec3_min(a.min, b.min);
+    result.max = vec3_max(a.max, b.max);
+    return result;
+}
+
+// Площадь поверхности прямоугольника (для эвристики SAH).
+KINLINE f32 bvh_box_area(extents_3d box)
+{
+    vec3 d = vec3_sub(box.max, box.min);
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+KINLINE bool bvh_box_contains(extents_3d outer, extents_3d inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+        && outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+static u32 bvh_allocate_node(bvh* tree)
+{
+    u32 index = tree->free_list;
+    if(index == INVALID_ID)
+    {
+        return INVALID_ID;
+    }
+
+    bvh_node* node = &tree->nodes[index];
+    tree->free_list = node->parent;
+    node->parent = INVALID_ID;
+    node->child1 = INVALID_ID;
+    node->child2 = INVALID_ID;
+    node->height = 0;
+    node->user_data = null;
+    node->user_index = INVALID_ID;
+    return index;
+}
+
+static void bvh_free_node(bvh* tree, u32 index)
+{
+    bvh_node* node = &tree->nodes[index];
+    node->parent = tree->free_list;
+    node->height = BVH_NODE_FREE;
+    tree->free_list = index;
+}
+
+static void bvh_update_node(bvh* tree, u32 index)
+{
+    bvh_node* node = &tree->nodes[index];
+    bvh_node* child1 = &tree->nodes[node->child1];
+    bvh_node* child2 = &tree->nodes[node->child2];
+    node->box = bvh_box_union(child1->box, child2->box);
+    node->height = 1 + KMAX(child1->height, child2->height);
+}
+
+static void bvh_replace_child(bvh* tree, u32 parent, u32 old_child, u32 new_child)
+{
+    if(parent == INVALID_ID)
+    {
+        tree->root = new_child;
+        return;
+    }
+
+    bvh_node* node = &tree->nodes[parent];
+    if(node->child1 == old_child)
+    {
+        node->child1 = new_child;
+    }
+    else
+    {
+        node->child2 = new_child;
+    }
+}
+
+// Поворот поддерева, если высоты дочерних узлов отличаются больше чем на 1. Возвращает новый корень поддерева.
+static u32 bvh_balance(bvh* tree, u32 index_a)
+{
+    bvh_node* a = &tree->nodes[index_a];
+    if(bvh_node_is_leaf(a) || a->height < 2)
+    {
+        return index_a;
+    }
+
+    u32 index_b = a->child1;
+    u32 index_c = a->child2;
+    bvh_node* b = &tree->nodes[index_b];
+    bvh_node* c = &tree->nodes[index_c];
+    i32 balance = c->height - b->height;
+
+    // Поднятие узла C.
+    if(balance > 1)
+    {
+        u32 index_f = c->child1;
+        u32 index_g = c->child2;
+        bvh_node* f = &tree->nodes[index_f];
+        bvh_node* g = &tree->nodes[index_g];
+
+        c->child1 = index_a;
+        c->parent = a->parent;
+        a->parent = index_c;
+        bvh_replace_child(tree, c->parent, index_a, index_c);
+
+        if(f->height > g->height)
+        {
+            c->child2 = index_f;
+            a->child2 = index_g;
+            g->parent = index_a;
+        }
+        else
+        {
+            c->child2 = index_g;
+            a->child2 = index_f;
+            f->parent = index_a;
+        }
+
+        bvh_update_node(tree, index_a);
+        bvh_update_node(tree, index_c);
+        return index_c;
+    }
+
+    // Поднятие узла B.
+    if(balance < -1)
+    {
+        u32 index_d = b->child1;
+        u32 index_e = b->child2;
+        bvh_node* d = &tree->nodes[index_d];
+        bvh_node* e = &tree->nodes[index_e];
+
+        b->child1 = index_a;
+        b->parent = a->parent;
+        a->parent = index_b;
+        bvh_replace_child(tree, b->parent, index_a, index_b);
+
+        if(d->height > e->height)
+        {
+            b->child2 = index_d;
+            a->child1 = index_e;
+            e->parent = index_a;
+        }
+        else
+        {
+            b->child2 = index_e;
+            a->child1 = index_d;
+            d->parent = index_a;
+        }
+
+        bvh_update_node(tree, index_a);
+        bvh_update_node(tree, index_b);
+        return index_b;
+    }
+
+    return index_a;
+}
+
+// Обновляет прямоугольники и высоты от узла до корня с балансировкой.
+static void bvh_refit_to_root(bvh* tree, u32 index)
+{
+    while(index != INVALID_ID)
+    {
+        index = bvh_balance(tree, index);
+        bvh_update_node(tree, index);
+        index = tree->nodes[index].parent;
+    }
+}
+
+static void bvh_insert_leaf(bvh* tree, u32 leaf)
+{
+    if(tree->root == INVALID_ID)
+    {
+        tree->root = leaf;
+        tree->nodes[leaf].parent = INVALID_ID;
+        return;
+    }
+
+    // Поиск лучшего соседа: спуск по дереву с минимальной стоимостью площади поверхности.
+    extents_3d leaf_box = tree->nodes[leaf].box;
+    u32 index = tree->root;
+
+    while(!bvh_node_is_leaf(&tree->nodes[index]))
+    {
+        bvh_node* node = &tree->nodes[index];
+        f32 area = bvh_box_area(node->box);
+        f32 combined_area = bvh_box_area(bvh_box_union(node->box, leaf_box));
+
+        // Стоимость создания нового родителя для этого узла и листа.
+        f32 cost = 2.0f * combined_area;
+        // Минимальная стоимость увеличения прямоугольников предков при спуске ниже.
+        f32 inheritance_cost = 2.0f * (combined_area - area);
+
+        f32 child_costs[2];
+        u32 children[2] = { node->child1, node->child2 };
+        for(u32 i = 0; i < 2; ++i)
+        {
+            bvh_node* child = &tree->nodes[children[i]];
+            f32 child_area = bvh_box_area(bvh_box_union(leaf_box, child->box));
+            if(!bvh_node_is_leaf(child))
+            {
+                child_area -= bvh_box_area(child->box);
+            }
+            child_costs[i] = child_area + inheritance_cost;
+        }
+
+        if(cost < child_costs[0] && cost < child_costs[1])
+        {
+            break;
+        }
+
+        index = child_costs[0] < child_costs[1] ? children[0] : children[1];
+    }
+
+    // Создание нового родителя для соседа и листа.
+    u32 sibling = index;
+    u32 old_parent = tree->nodes[sibling].parent;
+    u32 new_parent = bvh_allocate_node(tree);
+
+    bvh_node* parent = &tree->nodes[new_parent];
+    parent->parent = old_parent;
+    parent->box = bvh_box_union(leaf_box, tree->nodes[sibling].box);
+    parent->height = tree->nodes[sibling].height + 1;
+    parent->child1 = sibling;
+    parent->child2 = leaf;
+
+    bvh_replace_child(tree, old_parent, sibling, new_parent);
+    tree->nodes[sibling].parent = new_parent;
+    tree->nodes[leaf].parent = new_parent;
+
+    bvh_refit_to_root(tree, new_parent);
+}
+
+static void bvh_remove_leaf(bvh* tree, u32 leaf)
+{
+    if(leaf == tree->root)
+    {
+        tree->root = INVALID_ID;
+        return;
+    }
+
+    u32 parent = tree->nodes[leaf].parent;
+    u32 grand_parent = tree->nodes[parent].parent;
+    u32 sibling = tree->nodes[parent].child1 == leaf ? tree->nodes[parent].child2 : tree->nodes[parent].child1;
+
+    // Сосед занимает место родителя.
+    bvh_replace_child(tree, grand_parent, parent, sibling);
+    tree->nodes[sibling].parent = grand_parent;
+    bvh_free_node(tree, parent);
+
+    bvh_refit_to_root(tree, grand_parent);
+}
+
+bool bvh_create(u64* memory_requirement, void* memory, bvh_config* config, bvh** out_bvh)
+{
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_proxy_count)
+    {
+        kerror("Function '%s' requires max proxy count.", __FUNCTION__);
+        return false;
+    }
+
+    // NOTE: Для n листьев требуется n - 1 внутренних узлов.
+    u32 node_capacity = config->max_proxy_count * 2;
+    *memory_requirement = sizeof(bvh) + sizeof(bvh_node) * node_capacity;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    if(!out_bvh)
+    {
+        kerror("Function '%s' requires a valid pointer to save pointer of bvh.", __FUNCTION__);
+        return false;
+    }
+
+    kzero(memory, *memory_requirement);
+    bvh* tree = memory;
+
+    tree->max_proxy_count = config->max_proxy_count;
+    tree->node_capacity = node_capacity;
+    tree->margin = KMAX(config->margin, 0.0f);
+    tree->root = INVALID_ID;
+    tree->nodes = (void*)((u8*)memory + sizeof(bvh));
+
+    // Связывание всех узлов в список свободных.
+    for(u32 i = 0; i < node_capacity; ++i)
+    {
+        tree->nodes[i].parent = i + 1 < node_capacity ? i + 1 : INVALID_ID;
+        tree->nodes[i].height = BVH_NODE_FREE;
+    }
+    tree->free_list = 0;
+
+    *out_bvh = tree;
+    return true;
+}
+
+void bvh_destroy(bvh* tree)
+{
+    if(!bvh_valid(tree, __FUNCTION__)) return;
+
+    kzero(tree, sizeof(bvh) + sizeof(bvh_node) * tree->node_capacity);
+}
+
+u32 bvh_insert(bvh* tree, const extents_3d* extents, void* user_data, u32 user_index)
+{
+    if(!bvh_valid(tree, __FUNCTION__)) return INVALID_ID;
+
+    if(!extents)
+    {
+        kerror("Function '%s' requires a valid pointer to extents.", __FUNCTION__);
+        return INVALID_ID;
+    }
+
+    if(tree->proxy_count >= tree->max_proxy_count)
+    {
+        kerror("Function '%s': Max proxy count %u reached.", __FUNCTION__, tree->max_proxy_count);
+        return INVALID_ID;
+    }
+
+    u32 proxy_id = bvh_allocate_node(tree);
+    bvh_node* node = &tree->nodes[proxy_id];
+    vec3 margin = vec3_create(tree->margin, tree->margin, tree->margin);
+    node->box.min = vec3_sub(extents->min, margin);
+    node->box.max = vec3_add(extents->max, margin);
+    node->user_data = user_data;
+    node->user_index = user_index;
+
+    bvh_insert_leaf(tree, proxy_id);
+    tree->proxy_count++;
+    return proxy_id;
+}
+
+void bvh_remove(bvh* tree, u32 proxy_id)
+{
+    if(!bvh_proxy_valid(tree, proxy_id, __FUNCTION__)) return;
+
+    bvh_remove_leaf(tree, proxy_id);
+    bvh_free_node(tree, proxy_id);
+    tree->proxy_count--;
+}
+
+bool bvh_move(bvh* tree, u32 proxy_id, const extents_3d* extents)
+{
+    if(!bvh_proxy_valid(tree, proxy_id, __FUNCTION__)) return false;
+
+    if(!extents)
+    {
+        kerror("Function '%s' requires a valid pointer to extents.", __FUNCTION__);
+        return false;
+    }
+
+    bvh_node* node = &tree->nodes[proxy_id];
+    if(bvh_box_contains(node->box, *extents))
+    {
+        return false;
+    }
+
+    bvh_remove_leaf(tree, proxy_id);
+
+    vec3 margin = vec3_create(tree->margin, tree->margin, tree->margin);
+    node->box.min = vec3_sub(extents->min, margin);
+    node->box.max = vec3_add(extents->max, margin);
+
+    bvh_insert_leaf(tree, proxy_id);
+    return true;
+}
+
+// Строит поддерево для листьев [0, count) сверху вниз по бинированной эвристике SAH.
+static u32 bvh_build_range(bvh* tree, u32* leaves, u32 count, u32 depth)
+{
+    if(count == 1)
+    {
+        return leaves[0];
+    }
+
+    // Границы центров прямоугольников и ось с наибольшим разбросом.
+    vec3 centroid_min = vec3_create(K_FLOAT_MAX, K_FLOAT_MAX, K_FLOAT_MAX);
+    vec3 centroid_max = vec3_create(-K_FLOAT_MAX, -K_FLOAT_MAX, -K_FLOAT_MAX);
+    for(u32 i = 0; i < count; ++i)
+    {
+        extents_3d* box = &tree->nodes[leaves[i]].box;
+        vec3 centroid = vec3_mul_scalar(vec3_add(box->min, box->max), 0.5f);
+        centroid_min = vec3_min(centroid_min, centroid);
+        centroid_max = vec3_max(centroid_max, centroid);
+    }
+
+    vec3 spread = vec3_sub(centroid_max, centroid_min);
+    u32 axis = 0;
+    if(spread.y > spread.elements[axis]) axis = 1;
+    if(spread.z > spread.elements[axis]) axis = 2;
+
+    u32 split = count / 2;
+
+    if(spread.elements[axis] > K_FLOAT_EPSILON && depth < BVH_SAH_MAX_DEPTH)
+    {
+        u32 bin_counts[BVH_SAH_BIN_COUNT] = {0};
+        extents_3d bin_boxes[BVH_SAH_BIN_COUNT];
+        for(u32 b = 0; b < BVH_SAH_BIN_COUNT; ++b)
+        {
+            bin_boxes[b].min = vec3_create(K_FLOAT_MAX, K_FLOAT_MAX, K_FLOAT_MAX);
+            bin_boxes[b].max = vec3_create(-K_FLOAT_MAX, -K_FLOAT_MAX, -K_FLOAT_MAX);
+        }
+
+        f32 bin_scale = BVH_SAH_BIN_COUNT / spread.elements[axis];
+        f32 axis_min = centroid_min.elements[axis];
+
+        #define BVH_BIN_INDEX(box) KMIN((u32)((((box)->min.elements[axis] + (box)->max.elements[axis]) * 0.5f - axis_min) * bin_scale), BVH_SAH_BIN_COUNT - 1)
+
+        for(u32 i = 0; i < count; ++i)
+        {
+            extents_3d* box = &tree->nodes[leaves[i]].box;
+            u32 b = BVH_BIN_INDEX(box);
+            bin_counts[b]++;
+            bin_boxes[b] = bvh_box_union(bin_boxes[b], *box);
+        }
+
+        // Площади и количества слева от каждой границы.
+        f32 left_areas[BVH_SAH_BIN_COUNT - 1];
+        u32 left_counts[BVH_SAH_BIN_COUNT - 1];
+        extents_3d accumulated = bin_boxes[0];
+        u32 accumulated_count = 0;
+        for(u32 b = 0; b < BVH_SAH_BIN_COUNT - 1; ++b)
+        {
+            accumulated = bvh_box_union(accumulated, bin_boxes[b]);
+            accumulated_count += bin_counts[b];
+            left_areas[b] = accumulated_count ? bvh_box_area(accumulated) : 0.0f;
+            left_counts[b] = accumulated_count;
+        }
+
+        // Проход справа налево с выбором границы минимальной стоимости.
+        f32 best_cost = K_FLOAT_MAX;
+        u32 best_bin = 0;
+        accumulated = bin_boxes[BVH_SAH_BIN_COUNT - 1];
+        accumulated_count = 0;
+        for(u32 b = BVH_SAH_BIN_COUNT - 1; b > 0; --b)
+        {
+            accumulated = bvh_box_union(accumulated, bin_boxes[b]);
+            accumulated_count += bin_counts[b];
+            if(!accumulated_count || !left_counts[b - 1])
+            {
+                continue;
+            }
+
+            f32 cost = left_counts[b - 1] * left_areas[b - 1] + accumulated_count * bvh_box_area(accumulated);
+            if(cost < best_cost)
+            {
+                best_cost = cost;
+                best_bin = b;
+            }
+        }
+
+        // Разделение листьев на месте: бины меньше best_bin - слева.
+        if(best_bin > 0)
+        {
+            u32 left = 0;
+            for(u32 i = 0; i < count; ++i)
+            {
+                if(BVH_BIN_INDEX(&tree->nodes[leaves[i]].box) < best_bin)
+                {
+                    u32 temp = leaves[left];
+                    leaves[left] = leaves[i];
+                    leaves[i] = temp;
+                    left++;
+                }
+            }
+
+            if(left > 0 && left < count)
+            {
+                split = left;
+            }
+        }
+
+        #undef BVH_BIN_INDEX
+    }
+
+    u32 index = bvh_allocate_node(tree);
+    u32 child1 = bvh_build_range(tree, leaves, split, depth + 1);
+    u32 child2 = bvh_build_range(tree, leaves + split, count - split, depth + 1);
+
+    bvh_node* node = &tree->nodes[index];
+    node->child1 = child1;
+    node->child2 = child2;
+    tree->nodes[child1].parent = index;
+    tree->nodes[child2].parent = index;
+    bvh_update_node(tree, index);
+    return index;
+}
+
+void bvh_rebuild(bvh* tree)
+{
+    if(!bvh_valid(tree, __FUNCTION__) || tree->proxy_count < 2) return;
+
+    // Сбор листьев и освобождение внутренних узлов.
+    u32* leaves = kallocate_tc(u32, tree->proxy_count, MEMORY_TAG_ARRAY);
+    u32 leaf_count = 0;
+
+    for(u32 i = 0; i < tree->node_capacity; ++i)
+    {
+        bvh_node* node = &tree->nodes[i];
+        if(node->height == 0)
+        {
+            leaves[leaf_count++] = i;
+        }
+        else if(node->height > 0)
+        {
+            bvh_free_node(tree, i);
+        }
+    }
+
+    tree->root = bvh_build_range(tree, leaves, leaf_count, 0);
+    tree->nodes[tree->root].parent = INVALID_ID;
+
+    kfree(leaves, MEMORY_TAG_ARRAY);
+}
+
+void* bvh_get_user_data(bvh* tree, u32 proxy_id)
+{
+    if(!bvh_proxy_valid(tree, proxy_id, __FUNCTION__)) return null;
+    return tree->nodes[proxy_id].user_data;
+}
+
+bool bvh_get_extents(bvh* tree, u32 proxy_id, extents_3d* out_extents)
+{
+    if(!bvh_proxy_valid(tree, proxy_id, __FUNCTION__) || !out_extents) return false;
+    *out_extents = tree->nodes[proxy_id].box;
+    return true;
+}
+
+u32 bvh_get_proxy_count(bvh* tree)
+{
+    if(!bvh_valid(tree, __FUNCTION__)) return 0;
+    return tree->proxy_count;
+}
+
+u32 bvh_get_height(bvh* tree)
+{
+    if(!bvh_valid(tree, __FUNCTION__) || tree->root == INVALID_ID) return 0;
+    return tree->nodes[tree->root].height;
+}
+
+// Помещает узел в стек запроса, false если стек переполнен.
+KINLINE bool bvh_stack_push(u32* stack, u32* stack_size, u32 value)
+{
+    if(*stack_size >= BVH_QUERY_STACK_SIZE)
+    {
+        kerror("BVH query stack overflow, tree is too deep.");
+        return false;
+    }
+    stack[(*stack_size)++] = value;
+    return true;
+}
+
+u32 bvh_query_frustum(bvh* tree, const frustum* f, PFN_bvh_query_callback callback, void* context)
+{
+    if(!bvh_valid(tree, __FUNCTION__) || !f || !callback || tree->root == INVALID_ID) return 0;
+
+    u32 stack[BVH_QUERY_STACK_SIZE];
+    u32 stack_size = 0;
+    u32 found_count = 0;
+    stack[stack_size++] = tree->root;
+
+    while(stack_size > 0)
+    {
+        u32 entry = stack[--stack_size];
+        u32 index = entry & ~BVH_QUERY_INSIDE_FLAG;
+        bool inside = (entry & BVH_QUERY_INSIDE_FLAG) != 0;
+        bvh_node* node = &tree->nodes[index];
+
+        if(!inside)
+        {
+            vec3 center = vec3_mul_scalar(vec3_add(node->box.min, node->box.max), 0.5f);
+            vec3 extents = vec3_mul_scalar(vec3_sub(node->box.max, node->box.min), 0.5f);
+            bool outside = false;
+            inside = true;
+
+            for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+            {
+                const plane_3d* p = &f->sides[i];
+                f32 distance = plane_signed_distance(p, &center);
+                f32 r = extents.x * kabs(p->normal.x) + extents.y * kabs(p->normal.y) + extents.z * kabs(p->normal.z);
+                if(distance + r < 0.0f)
+                {
+                    outside = true;
+                    break;
+                }
+                if(distance - r < 0.0f)
+                {
+                    inside = false;
+                }
+            }
+
+            if(outside)
+            {
+                continue;
+            }
+        }
+
+        if(bvh_node_is_leaf(node))
+        {
+            found_count++;
+            if(!callback(context, index, node->user_data, node->user_index))
+            {
+                break;
+            }
+            continue;
+        }
+
+        // Поддерево целиком внутри пирамиды: потомки передаются без проверок.
+        u32 flag = inside ? BVH_QUERY_INSIDE_FLAG : 0;
+        if(!bvh_stack_push(stack, &stack_size, node->child1 | flag) || !bvh_stack_push(stack, &stack_size, node->child2 | flag))
+        {
+            break;
+        }
+    }
+
+    return found_count;
+}
+
+u32 bvh_query_sphere(bvh* tree, vec3 center, f32 radius, PFN_bvh_query_callback callback, void* context)
+{
+    if(!bvh_valid(tree, __FUNCTION__) || !callback || tree->root == INVALID_ID) return 0;
+
+    u32 stack[BVH_QUERY_STACK_SIZE];
+    u32 stack_size = 0;
+    u32 found_count = 0;
+    f32 radius_sq = radius * radius;
+    stack[stack_size++] = tree->root;
+
+    while(stack_size > 0)
+    {
+        u32 index = stack[--stack_size];
+        bvh_node* node = &tree->nodes[index];
+
+        // Квадрат расстояния от центра сферы до ближайшей точки прямоугольника.
+        f32 distance_sq = 0.0f;
+        for(u32 i = 0; i < 3; ++i)
+        {
+            f32 v = center.elements[i];
+            if(v < node->box.min.elements[i])
+            {
+                f32 d = node->box.min.elements[i] - v;
+                distance_sq += d * d;
+            }
+            else if(v > node->box.max.elements[i])
+            {
+                f32 d = v - node->box.max.elements[i];
+                distance_sq += d * d;
+            }
+        }
+
+        if(distance_sq > radius_sq)
+        {
+            continue;
+        }
+
+        if(bvh_node_is_leaf(node))
+        {
+            found_count++;
+            if(!callback(context, index, node->user_data, node->user_index))
+            {
+                break;
+            }
+            continue;
+        }
+
+        if(!bvh_stack_push(stack, &stack_size, node->child1) || !bvh_stack_push(stack, &stack_size, node->child2))
+        {
+            break;
+        }
+    }
+
+    return found_count;
+}
+
+// Пересечение отрезка луча [0, max_distance] с прямоугольником (метод плит).
+static bool bvh_ray_intersects_box(const extents_3d* box, vec3 origin, vec3 direction, vec3 inv_direction, f32 max_distance)
+{
+    f32 t_min = 0.0f;
+    f32 t_max = max_distance;
+
+    for(u32 i = 0; i < 3; ++i)
+    {
+        // Луч параллелен плитам: пересечение только если начало между ними.
+        if(kabs(direction.elements[i]) < K_FLOAT_EPSILON)
+        {
+            if(origin.elements[i] < box->min.elements[i] || origin.elements[i] > box->max.elements[i])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        f32 t1 = (box->min.elements[i] - origin.elements[i]) * inv_direction.elements[i];
+        f32 t2 = (box->max.elements[i] - origin.elements[i]) * inv_direction.elements[i];
+        t_min = KMAX(t_min, KMIN(t1, t2));
+        t_max = KMIN(t_max, KMAX(t1, t2));
+        if(t_min > t_max)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+u32 bvh_query_ray(bvh* tree, vec3 origin, vec3 direction, f32 max_distance, PFN_bvh_query_callback callback, void* context)
+{
+    if(!bvh_valid(tree, __FUNCTION__) || !callback || tree->root == INVALID_ID) return 0;
+
+    vec3 inv_direction;
+    for(u32 i = 0; i < 3; ++i)
+    {
+        inv_direction.elements[i] = kabs(direction.elements[i]) < K_FLOAT_EPSILON ? 0.0f : 1.0f / direction.elements[i];
+    }
+
+    u32 stack[BVH_QUERY_STACK_SIZE];
+    u32 stack_size = 0;
+    u32 found_count = 0;
+    stack[stack_size++] = tree->root;
+
+    while(stack_size > 0)
+    {
+        u32 index = stack[--stack_size];
+        bvh_node* node = &tree->nodes[index];
+
+        if(!bvh_ray_intersects_box(&node->box, origin, direction, inv_direction, max_distance))
+        {
+            continue;
+        }
+
+        if(bvh_node_is_leaf(node))
+        {
+            found_count++;
+            if(!callback(context, index, node->user_data, node->user_index))
+            {
+                break;
+            }
+            continue;
+        }
+
+        if(!bvh_stack_push(stack, &stack_size, node->child1) || !bvh_stack_push(stack, &stack_size, node->child2))
+        {
+            break;
+        }
+    }
+
+    return found_count;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+
+// @brief Контекст иерархии ограничивающих объемов (дерево выровненных по осям прямоугольников).
+typedef struct bvh bvh;
+
+// @brief Конфигурация иерархии ограничивающих объемов.
+typedef struct bvh_config {
+    // @brief Максимальное количество объектов (листьев) в дереве.
+    u32 max_proxy_count;
+    // @brief Запас, на который расширяются прямоугольники листьев, чтобы небольшие перемещения не меняли дерево.
+    f32 margin;
+} bvh_config;
+
+/*
+    @brief Функция обратного вызова для найденных запросом объектов.
+    @param context Контекст, переданный в запрос.
+    @param proxy_id Идентификатор объекта.
+    @param user_data Пользовательские данные объекта.
+    @param user_index Пользовательский индекс объекта.
+    @return True чтобы продолжить запрос, false чтобы прервать.
+*/
+typedef bool (*PFN_bvh_query_callback)(void* context, u32 proxy_id, void* user_data, u32 user_index);
+
+/*
+    @brief Создает иерархию ограничивающих объемов фиксированного размера.
+    NOTE: Вызывается дважды: первый раз для получения требований к памяти, второй для создания.
+    @param memory_requirement Указатель на переменную для получения требований к памяти.
+    @param memory Указатель на выделенную память, для получения требований к памяти передать null.
+    @param config Конфигурация иерархии.
+    @param out_bvh Указатель для сохранения указателя на иерархию.
+    @return True операция завершилась успешно, false операция завершилась неудачей.
+*/
+KAPI bool bvh_create(u64* memory_requirement, void* memory, bvh_config* config, bvh** out_bvh);
+
+/*
+    @brief Уничтожает иерархию ограничивающих объемов.
+    @param tree Указатель на иерархию.
+*/
+KAPI void bvh_destroy(bvh* tree);
+
+/*
+    @brief Добавляет объект в иерархию (инкрементально, с выбором места по площади поверхности и балансировкой).
+    @param tree Указатель на иерархию.
+    @param extents Ограничивающий прямоугольник объекта в мировом пространстве.
+    @param user_data Пользовательские данные объекта.
+    @param user_index Пользовательский индекс объекта (например, номер геометрии в сетке).
+    @return Идентификатор объекта, INVALID_ID если не удалось.
+*/
+KAPI u32 bvh_insert(bvh* tree, const extents_3d* extents, void* user_data, u32 user_index);
+
+/*
+    @brief Удаляет объект из иерархии.
+    @param tree Указатель на иерархию.
+    @param proxy_id Идентификатор объекта.
+*/
+KAPI void bvh_remove(bvh* tree, u32 proxy_id);
+
+/*
+    @brief Обновляет ограничивающий прямоугольник объекта.
+    NOTE: Дерево меняется только если новый прямоугольник выходит за расширенный прямоугольник листа.
+    @param tree Указатель на иерархию.
+    @param proxy_id Идентификатор объекта.
+    @param extents Новый ограничивающий прямоугольник объекта в мировом пространстве.
+    @return True если объект был перемещен в дереве, false если дерево не изменилось.
+*/
+KAPI bool bvh_move(bvh* tree, u32 proxy_id, const extents_3d* extents);
+
+/*
+    @brief Полностью перестраивает дерево по эвристике площади поверхности (SAH).
+    NOTE: Предназначена для статической геометрии, например после загрузки сцены. Идентификаторы объектов
+          сохраняются.
+    @param tree Указатель на иерархию.
+*/
+KAPI void bvh_rebuild(bvh* tree);
+
+/*
+    @brief Получает пользовательские данные объекта.
+    @param tree Указатель на иерархию.
+    @param proxy_id Идентификатор объекта.
+    @return Пользовательские данные, null если идентификатор недействителен.
+*/
+KAPI void* bvh_get_user_data(bvh* tree, u32 proxy_id);
+
+/*
+    @brief Получает расширенный ограничивающий прямоугольник объекта.
+    @param tree Указатель на иерархию.
+    @param proxy_id Идентификатор объекта.
+    @param out_extents Указатель для сохранения прямоугольника.
+    @return True в случае успеха, false если идентификатор недействителен.
+*/
+KAPI bool bvh_get_extents(bvh* tree, u32 proxy_id, extents_3d* out_extents);
+
+/*
+    @brief Получает количество объектов в иерархии.
+    @param tree Указатель на иерархию.
+    @return Количество объектов.
+*/
+KAPI u32 bvh_get_proxy_count(bvh* tree);
+
+/*
+    @brief Получает высоту дерева (0 для пустого дерева или одного объекта).
+    @param tree Указатель на иерархию.
+    @return Высота дерева.
+*/
+KAPI u32 bvh_get_height(bvh* tree);
+
+/*
+    @brief Находит объекты, пересекающие усеченную пирамиду.
+    NOTE: Проверка консервативная (по расширенным прямоугольникам). Поддеревья целиком внутри пирамиды
+          передаются без дальнейших проверок.
+    @param tree Указатель на иерархию.
+    @param f Указатель на усеченную пирамиду.
+    @param callback Функция обратного вызова для найденных объектов.
+    @param context Контекст для функции обратного вызова.
+    @return Количество найденных объектов.
+*/
+KAPI u32 bvh_query_frustum(bvh* tree, const frustum* f, PFN_bvh_query_callback callback, void* context);
+
+/*
+    @brief Находит объекты, пересекающие сферу.
+    @param tree Указатель на иерархию.
+    @param center Центр сферы.
+    @param radius Радиус сферы.
+    @param callback Функция обратного вызова для найденных объектов.
+    @param context Контекст для функции обратного вызова.
+    @return Количество найденных объектов.
+*/
+KAPI u32 bvh_query_sphere(bvh* tree, vec3 center, f32 radius, PFN_bvh_query_callback callback, void* context);
+
+/*
+    @brief Находит объекты, пересекающие луч.
+    @param tree Указатель на иерархию.
+    @param origin Начало луча.
+    @param direction Направление луча (не обязательно нормализованное).
+    @param max_distance Длина луча в единицах направления.
+    @param callback Функция обратного вызова для найденных объектов.
+    @param context Контекст для функции обратного вызова.
+    @return Количество найденных объектов.
+*/
+KAPI u32 bvh_query_ray(bvh* tree, vec3 origin, vec3 direction, f32 max_distance, PFN_bvh_query_callback callback, void* context);
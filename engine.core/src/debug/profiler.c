@@ -0,0 +1,370 @@
+// Собственные подключения.
+#include "debug/profiler.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "kstring.h"
+#include "memory/memory.h"
+#include "platform/time.h"
+#include "platform/thread.h"
+
+// Максимальная глубина вложенности областей замера.
+#define PROFILER_MAX_DEPTH 32
+
+// Событие кольцевого буфера потока (name = null для конца области).
+typedef struct profiler_event {
+    const char* name;
+    u64 ticks;
+} profiler_event;
+
+typedef struct profiler_thread {
+    // Идентификатор потока.
+    u64 thread_id;
+    // Кольцевой буфер событий (пишет только поток-владелец).
+    profiler_event* events;
+    // Количество записанных событий (атомарно, пишет поток-владелец).
+    u64 write_index;
+    // Количество обработанных событий (только для основного потока).
+    u64 read_index;
+    // Первый корневой узел иерархии потока.
+    u32 first_root;
+    // Стек открытых областей при разборе событий.
+    u32 depth;
+    u32 overflow_depth;
+    u32 stack_nodes[PROFILER_MAX_DEPTH];
+    u64 stack_ticks[PROFILER_MAX_DEPTH];
+} profiler_thread;
+
+typedef struct profiler_state {
+    profiler_config config;
+    profiler_thread* threads;
+    // Количество зарегистрированных потоков (атомарно).
+    u32 thread_count;
+    profiler_node* nodes;
+    u32 node_count;
+    bool node_overflow_reported;
+    u64 frame_count;
+    u64 ticks_frequency;
+} profiler_state;
+
+static profiler_state* state_ptr = null;
+
+// NOTE: Поколение профилировщика, чтобы кэш потока не ссылался на память предыдущего запуска.
+static u32 state_generation = 0;
+static _Thread_local profiler_thread* local_thread = null;
+static _Thread_local u32 local_generation = 0;
+
+static profiler_thread* profiler_thread_get();
+static u32 profiler_node_get(profiler_thread* thread, u32 thread_index, u32 parent, const char* name);
+static void profiler_node_log(const profiler_node* node, f64 ms_per_tick);
+
+bool profiler_initialize(u64* memory_requirement, void* memory, profiler_config* config)
+{
+    if(state_ptr)
+    {
+        kwarng("Function '%s' was called more than once! Return false!", __FUNCTION__);
+        return false;
+    }
+
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config. Return false!", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_thread_count || !config->max_node_count || !config->max_event_count
+    || (config->max_event_count & (config->max_event_count - 1)))
+    {
+        kerror(
+            "Function '%s': config.max_thread_count and max_node_count must be greater then zero, "
+            "max_event_count must be power of two. Return false!", __FUNCTION__
+        );
+        return false;
+    }
+
+    u64 state_requirement = sizeof(profiler_state);
+    u64 threads_requirement = sizeof(profiler_thread) * config->max_thread_count;
+    u64 events_requirement = sizeof(profiler_event) * config->max_event_count * config->max_thread_count;
+    u64 nodes_requirement = sizeof(profiler_node) * config->max_node_count;
+    *memory_requirement = state_requirement + threads_requirement + events_requirement + nodes_requirement;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    kzero_tc(memory, profiler_state, 1);
+    state_ptr = memory;
+    state_ptr->config = *config;
+    state_ptr->ticks_frequency = platform_time_ticks_frequency();
+
+    state_ptr->threads = (void*)((u8*)state_ptr + state_requirement);
+    kzero_tc(state_ptr->threads, profiler_thread, config->max_thread_count);
+
+    profiler_event* events = (void*)((u8*)state_ptr->threads + threads_requirement);
+    for(u32 i = 0; i < config->max_thread_count; ++i)
+    {
+        state_ptr->threads[i].events = &events[i * config->max_event_count];
+        state_ptr->threads[i].first_root = INVALID_ID;
+    }
+
+    state_ptr->nodes = (void*)((u8*)events + events_requirement);
+    state_generation++;
+
+    kinfor("Profiler ticks frequency: %llu Hz.", state_ptr->ticks_frequency);
+    return true;
+}
+
+void profiler_shutdown()
+{
+    if(!state_ptr)
+    {
+        kerror("Function '%s' requires the profiler to be initialized.", __FUNCTION__);
+        return;
+    }
+
+    state_ptr = null;
+}
+
+const char* profiler_scope_begin(const char* name)
+{
+    profiler_thread* thread = profiler_thread_get();
+    if(thread)
+    {
+        u64 index = thread->write_index & (state_ptr->config.max_event_count - 1);
+        thread->events[index].name = name;
+        thread->events[index].ticks = platform_time_ticks();
+        __atomic_store_n(&thread->write_index, thread->write_index + 1, __ATOMIC_RELEASE);
+    }
+
+    return name;
+}
+
+void profiler_scope_end()
+{
+    profiler_thread* thread = profiler_thread_get();
+    if(thread)
+    {
+        u64 index = thread->write_index & (state_ptr->config.max_event_count - 1);
+        thread->events[index].ticks = platform_time_ticks();
+        thread->events[index].name = null;
+        __atomic_store_n(&thread->write_index, thread->write_index + 1, __ATOMIC_RELEASE);
+    }
+}
+
+void profiler_frame_end()
+{
+    if(!state_ptr)
+    {
+        return;
+    }
+
+    for(u32 i = 0; i < state_ptr->node_count; ++i)
+    {
+        state_ptr->nodes[i].frame_calls = 0;
+        state_ptr->nodes[i].frame_ticks = 0;
+    }
+
+    u32 thread_count = __atomic_load_n(&state_ptr->thread_count, __ATOMIC_ACQUIRE);
+    if(thread_count > state_ptr->config.max_thread_count)
+    {
+        thread_count = state_ptr->config.max_thread_count;
+    }
+
+    u64 event_count = state_ptr->config.max_event_count;
+
+    for(u32 t = 0; t < thread_count; ++t)
+    {
+        profiler_thread* thread = &state_ptr->threads[t];
+        u64 write_index = __atomic_load_n(&thread->write_index, __ATOMIC_ACQUIRE);
+
+        // Поток записал больше событий, чем вмещает буфер: часть событий потеряна, стек разбора сбрасывается.
+        if(write_index - thread->read_index > event_count)
+        {
+            kwarng("Function '%s': Profiler events of thread %llu were lost.", __FUNCTION__, thread->thread_id);
+            thread->read_index = write_index - event_count;
+            thread->depth = 0;
+            thread->overflow_depth = 0;
+        }
+
+        for(; thread->read_index < write_index; ++thread->read_index)
+        {
+            const profiler_event* event = &thread->events[thread->read_index & (event_count - 1)];
+
+            if(event->name)
+            {
+                if(thread->depth >= PROFILER_MAX_DEPTH)
+                {
+                    thread->overflow_depth++;
+                    continue;
+                }
+
+                u32 parent = thread->depth ? thread->stack_nodes[thread->depth - 1] : INVALID_ID;
+                thread->stack_nodes[thread->depth] = profiler_node_get(thread, t, parent, event->name);
+                thread->stack_ticks[thread->depth] = event->ticks;
+                thread->depth++;
+            }
+            else if(thread->overflow_depth)
+            {
+                thread->overflow_depth--;
+            }
+            else if(thread->depth)
+            {
+                thread->depth--;
+                u32 node_index = thread->stack_nodes[thread->depth];
+
+                if(node_index != INVALID_ID)
+                {
+                    profiler_node* node = &state_ptr->nodes[node_index];
+                    node->frame_calls++;
+                    node->frame_ticks += event->ticks - thread->stack_ticks[thread->depth];
+                }
+            }
+        }
+    }
+
+    for(u32 i = 0; i < state_ptr->node_count; ++i)
+    {
+        profiler_node* node = &state_ptr->nodes[i];
+        node->total_ticks += node->frame_ticks;
+
+        if(node->frame_ticks > node->max_frame_ticks)
+        {
+            node->max_frame_ticks = node->frame_ticks;
+        }
+    }
+
+    state_ptr->frame_count++;
+}
+
+bool profiler_get_report(profiler_report* out_report)
+{
+    if(!state_ptr || !out_report)
+    {
+        return false;
+    }
+
+    out_report->frame_count = state_ptr->frame_count;
+    out_report->ticks_frequency = state_ptr->ticks_frequency;
+    out_report->node_count = state_ptr->node_count;
+    out_report->nodes = state_ptr->nodes;
+    return true;
+}
+
+void profiler_report_log()
+{
+    if(!state_ptr)
+    {
+        return;
+    }
+
+    f64 ms_per_tick = 1000.0 / (f64)state_ptr->ticks_frequency;
+    u32 thread_count = __atomic_load_n(&state_ptr->thread_count, __ATOMIC_ACQUIRE);
+    if(thread_count > state_ptr->config.max_thread_count)
+    {
+        thread_count = state_ptr->config.max_thread_count;
+    }
+
+    kdebug("Profiler report (frame %llu):", state_ptr->frame_count);
+
+    for(u32 t = 0; t < thread_count; ++t)
+    {
+        const profiler_thread* thread = &state_ptr->threads[t];
+        if(thread->first_root == INVALID_ID)
+        {
+            continue;
+        }
+
+        kdebug("  Thread %llu:", thread->thread_id);
+
+        for(u32 i = thread->first_root; i != INVALID_ID; i = state_ptr->nodes[i].next_sibling)
+        {
+            profiler_node_log(&state_ptr->nodes[i], ms_per_tick);
+        }
+    }
+}
+
+static profiler_thread* profiler_thread_get()
+{
+    if(!state_ptr)
+    {
+        return null;
+    }
+
+    if(local_generation == state_generation)
+    {
+        return local_thread;
+    }
+
+    // Регистрация потока при первом замере.
+    local_generation = state_generation;
+    local_thread = null;
+
+    u32 index = __atomic_fetch_add(&state_ptr->thread_count, 1, __ATOMIC_ACQ_REL);
+    if(index >= state_ptr->config.max_thread_count)
+    {
+        kwarng("Function '%s': Profiler thread limit reached, thread is not profiled.", __FUNCTION__);
+        return null;
+    }
+
+    local_thread = &state_ptr->threads[index];
+    local_thread->thread_id = platform_thread_get_id();
+    return local_thread;
+}
+
+static u32 profiler_node_get(profiler_thread* thread, u32 thread_index, u32 parent, const char* name)
+{
+    u32* first = parent != INVALID_ID ? &state_ptr->nodes[parent].first_child : &thread->first_root;
+    u32* last = first;
+
+    for(u32 i = *first; i != INVALID_ID; i = state_ptr->nodes[i].next_sibling)
+    {
+        const profiler_node* node = &state_ptr->nodes[i];
+        if(node->name == name || string_equal(node->name, name))
+        {
+            return i;
+        }
+
+        last = &state_ptr->nodes[i].next_sibling;
+    }
+
+    if(state_ptr->node_count >= state_ptr->config.max_node_count)
+    {
+        if(!state_ptr->node_overflow_reported)
+        {
+            kwarng("Function '%s': Profiler node limit reached, new scopes are not profiled.", __FUNCTION__);
+            state_ptr->node_overflow_reported = true;
+        }
+        return INVALID_ID;
+    }
+
+    u32 index = state_ptr->node_count++;
+    profiler_node* node = &state_ptr->nodes[index];
+    kzero_tc(node, profiler_node, 1);
+    node->name = name;
+    node->thread_index = thread_index;
+    node->depth = parent != INVALID_ID ? state_ptr->nodes[parent].depth + 1 : 0;
+    node->parent = parent;
+    node->first_child = INVALID_ID;
+    node->next_sibling = INVALID_ID;
+
+    *last = index;
+    return index;
+}
+
+static void profiler_node_log(const profiler_node* node, f64 ms_per_tick)
+{
+    f64 frame_ms = node->frame_ticks * ms_per_tick;
+    f64 average_ms = state_ptr->frame_count ? node->total_ticks * ms_per_tick / state_ptr->frame_count : 0.0;
+    f64 max_ms = node->max_frame_ticks * ms_per_tick;
+
+    kdebug(
+        "  %*s%s: %.3f ms, calls %u (avg %.3f ms, max %.3f ms)", (i32)(node->depth + 1) * 2, "", node->name,
+        frame_ms, node->frame_calls, average_ms, max_ms
+    );
+
+    for(u32 i = node->first_child; i != INVALID_ID; i = state_ptr->nodes[i].next_sibling)
+    {
+        profiler_node_log(&state_ptr->nodes[i], ms_per_tick);
+    }
+}
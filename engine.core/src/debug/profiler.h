@@ -0,0 +1,128 @@
+#pragma once
+
+#include <defines.h>
+
+// Включено при отладке.
+#if KDEBUG_FLAG
+    #define KPROFILER_ENABLED 1
+#else
+    #define KPROFILER_ENABLED 0
+#endif
+
+// @brief Конфигурация профилировщика.
+typedef struct profiler_config {
+    // @brief Максимальное количество потоков, которые могут записывать замеры.
+    u32 max_thread_count;
+    // @brief Размер кольцевого буфера событий одного потока (степень двойки).
+    u32 max_event_count;
+    // @brief Максимальное количество узлов иерархии замеров (уникальных путей вложенности).
+    u32 max_node_count;
+} profiler_config;
+
+// @brief Узел иерархии замеров (агрегированные данные одной области по одному пути вложенности).
+typedef struct profiler_node {
+    // @brief Имя области замера.
+    const char* name;
+    // @brief Индекс потока, в котором выполнялась область.
+    u32 thread_index;
+    // @brief Глубина вложенности (0 для корневых областей потока).
+    u32 depth;
+    // @brief Индекс родительского узла, INVALID_ID для корневых.
+    u32 parent;
+    // @brief Индекс первого дочернего узла, INVALID_ID если нет.
+    u32 first_child;
+    // @brief Индекс следующего узла того же уровня, INVALID_ID если нет.
+    u32 next_sibling;
+    // @brief Количество вызовов за последний кадр.
+    u32 frame_calls;
+    // @brief Суммарное время за последний кадр в тиках.
+    u64 frame_ticks;
+    // @brief Суммарное время за все кадры в тиках.
+    u64 total_ticks;
+    // @brief Максимальное время за кадр в тиках.
+    u64 max_frame_ticks;
+} profiler_node;
+
+// @brief Отчет профилировщика за последний кадр.
+typedef struct profiler_report {
+    // @brief Количество обработанных кадров.
+    u64 frame_count;
+    // @brief Частота тиков (количество тиков в секунду).
+    u64 ticks_frequency;
+    // @brief Количество узлов иерархии.
+    u32 node_count;
+    // @brief Указатель на узлы иерархии (дочерние узлы всегда следуют после родительских).
+    const profiler_node* nodes;
+} profiler_report;
+
+/*
+    @brief Запускает профилировщик.
+    @param memory_requirement Указатель на переменную для получения требований к памяти.
+    @param memory Указатель на выделенную память, для получения требований к памяти передать null.
+    @param config Указатель на конфигурацию профилировщика.
+    @return True профилировщик запущен успешно, false в случае ошибок.
+*/
+KAPI bool profiler_initialize(u64* memory_requirement, void* memory, profiler_config* config);
+
+/*
+    @brief Останавливает профилировщик.
+*/
+KAPI void profiler_shutdown();
+
+/*
+    @brief Отмечает начало области замера в текущем потоке (запись в кольцевой буфер потока).
+    NOTE: Имя должно оставаться действительным все время работы профилировщика (строковый литерал).
+    @param name Указатель на строку имени области.
+    @return Указатель на строку имени области.
+*/
+KAPI const char* profiler_scope_begin(const char* name);
+
+/*
+    @brief Отмечает конец последней начатой области замера в текущем потоке.
+*/
+KAPI void profiler_scope_end();
+
+/*
+    @brief Собирает события всех потоков за прошедший кадр в иерархию замеров.
+    NOTE: Вызывается один раз за кадр из основного потока.
+*/
+KAPI void profiler_frame_end();
+
+/*
+    @brief Получает отчет профилировщика за последний кадр.
+    @param out_report Указатель на память для сохранения отчета.
+    @return True отчет получен, false профилировщик не запущен.
+*/
+KAPI bool profiler_get_report(profiler_report* out_report);
+
+/*
+    @brief Выводит иерархический отчет профилировщика за последний кадр в журнал.
+*/
+KAPI void profiler_report_log();
+
+// Функция завершения области для KPROFILE_SCOPE (вызывается при выходе из блока).
+KINLINE void profiler_scope_cleanup(const char** name)
+{
+    profiler_scope_end();
+}
+
+#define KPROFILE_CONCAT_INTERNAL(a, b) a##b
+#define KPROFILE_CONCAT(a, b) KPROFILE_CONCAT_INTERNAL(a, b)
+
+#if KPROFILER_ENABLED
+    // @brief Замеряет время выполнения от текущего места до конца блока.
+    #define KPROFILE_SCOPE(name)                                                                  \
+        const char* KPROFILE_CONCAT(profile_scope_, __LINE__) __attribute__((cleanup(profiler_scope_cleanup))) \
+            = profiler_scope_begin(name)
+    // @brief Замеряет время выполнения функции (от текущего места до выхода из функции).
+    #define KPROFILE_FUNCTION() KPROFILE_SCOPE(__FUNCTION__)
+    // @brief Начинает область замера, которая должна быть завершена KPROFILE_END.
+    #define KPROFILE_BEGIN(name) profiler_scope_begin(name)
+    // @brief Завершает область замера, начатую KPROFILE_BEGIN.
+    #define KPROFILE_END() profiler_scope_end()
+#else
+    #define KPROFILE_SCOPE(name)
+    #define KPROFILE_FUNCTION()
+    #define KPROFILE_BEGIN(name)
+    #define KPROFILE_END()
+#endif
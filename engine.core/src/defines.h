@@ -172,6 +172,13 @@ STATIC_ASSERT(sizeof(ptr) == sizeof(void*), "Size of ptr must be equal to addres
     #define NOINLINE __attribute__((noinline))
 #endif
 
+// Определение квалификатора выравнивания типов KALIGN.
+#if KCOMPILER_MICROSOFT_FLAG
+    #define KALIGN(n) __declspec(align(n))
+#elif KCOMPILER_CLANG_FLAG
+    #define KALIGN(n) __attribute__((aligned(n)))
+#endif
+
 /*
     @brief Макрос для копирования 8 байт(64 бита) из источника в память назначения.
     @param dest Источник байт которые нужно скопировать.
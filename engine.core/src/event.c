@@ -3,21 +3,49 @@
 
 // Внутренние подключения.
 #include "logger.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "containers/darray.h"
 
+// Размер очереди отложенных событий (степень двойки).
+#define EVENT_QUEUE_CAPACITY 4096
+
 typedef struct registered_listener {
     void* instance;
     PFN_event_handler handler;
 } registered_listener;
 
 typedef struct event {
-    // Использует динамический массив.
-    registered_listener* listeners;
+    // Индекс первого слушателя события в общем массиве слушателей.
+    u32 first_listener;
+    // Количество слушателей события.
+    u32 listener_count;
+    // Номер обработки очереди, в которой событие уже было передано (для объединения).
+    u32 coalesce_stamp;
+    // Объединять отложенные события с этим кодом (передается только последнее за кадр).
+    bool coalesce;
 } event;
 
+// Отложенное событие.
+typedef struct queued_event {
+    // Порядковый номер ячейки очереди (готовность к записи или чтению).
+    u64 sequence;
+    event_code code;
+    void* sender;
+    event_context context;
+} queued_event;
+
 typedef struct event_system_state {
     event events[EVENT_CODES_MAX];
+    // NOTE: Слушатели всех событий хранятся в одном массиве, сгруппированными по коду события по порядку.
+    registered_listener* listeners;
+    // Очередь отложенных событий (много записывающих потоков, один читающий).
+    queued_event queue[EVENT_QUEUE_CAPACITY];
+    u64 queue_write;
+    u64 queue_read;
+    // Извлеченные из очереди события на обработку.
+    queued_event batch[EVENT_QUEUE_CAPACITY];
+    u32 dispatch_stamp;
 } event_system_state;
 
 static event_system_state* state_ptr = null;
@@ -26,6 +54,8 @@ static const char* message_not_initialized =
 static const char* message_code_out_of_bounds = "Function '%s': Event code is out of bounds.";
 static const char* message_handler_not_present = "Function '%s' requires a handler function pointer.";
 
+static bool event_dispatch(event_code code, void* sender, event_context* context);
+
 void event_system_initialize(u64* memory_requirement, void* memory)
 {
     if(state_ptr)
@@ -43,6 +73,16 @@ void event_system_initialize(u64* memory_requirement, void* memory)
 
     kzero(memory, *memory_requirement);
     state_ptr = memory;
+    state_ptr->listeners = darray_create(registered_listener);
+
+    for(u64 i = 0; i < EVENT_QUEUE_CAPACITY; ++i)
+    {
+        state_ptr->queue[i].sequence = i;
+    }
+
+    // События высокой частоты, для которых важно только последнее значение за кадр.
+    state_ptr->events[EVENT_CODE_MOUSE_MOVED].coalesce = true;
+    state_ptr->events[EVENT_CODE_APPLICATION_RESIZE].coalesce = true;
 }
 
 void event_system_shutdown()
@@ -53,16 +93,8 @@ void event_system_shutdown()
         return;
     }
 
-    // Уничтожаем все созданые массивы!
-    for(i32 i = 0; i < EVENT_CODES_MAX; ++i)
-    {
-        if(state_ptr->events[i].listeners != null)
-        {
-            darray_destroy(state_ptr->events[i].listeners);
-            state_ptr->events[i].listeners = null;
-        }
-    }
-
+    darray_destroy(state_ptr->listeners);
+    state_ptr->listeners = null;
     state_ptr = null;
 }
 
@@ -86,17 +118,12 @@ bool event_register(event_code code, void* listener, PFN_event_handler handler)
         return false;
     }
 
-    if(state_ptr->events[code].listeners == null)
-    {
-        state_ptr->events[code].listeners = darray_create(registered_listener);
-    }
+    event* e = &state_ptr->events[code];
+    registered_listener* listeners = &state_ptr->listeners[e->first_listener];
 
-    u64 registered_count = darray_length(state_ptr->events[code].listeners);
-
-    for(u64 i = 0; i < registered_count; ++i)
+    for(u32 i = 0; i < e->listener_count; ++i)
     {
-        if(state_ptr->events[code].listeners[i].instance == listener
-        && state_ptr->events[code].listeners[i].handler == handler)
+        if(listeners[i].instance == listener && listeners[i].handler == handler)
         {
             kwarng(
                 "Function '%s': Event registered with code (%s), listener or/and function handler.",
@@ -107,7 +134,24 @@ bool event_register(event_code code, void* listener, PFN_event_handler handler)
     }
 
     registered_listener r = { .instance = listener, .handler = handler };
-    darray_push(state_ptr->events[code].listeners, r);
+    u32 index = e->first_listener + e->listener_count;
+
+    if(index < darray_length(state_ptr->listeners))
+    {
+        darray_insert_at(state_ptr->listeners, index, r);
+    }
+    else
+    {
+        darray_push(state_ptr->listeners, r);
+    }
+    e->listener_count++;
+
+    // Слушатели следующих кодов событий сдвинулись.
+    for(u32 i = code + 1; i < EVENT_CODES_MAX; ++i)
+    {
+        state_ptr->events[i].first_listener++;
+    }
+
     return true;
 }
 
@@ -131,21 +175,29 @@ bool event_unregister(event_code code, void* listener, PFN_event_handler handler
         return false;
     }
 
-    if(state_ptr->events[code].listeners == null)
+    event* e = &state_ptr->events[code];
+
+    if(!e->listener_count)
     {
         kwarng("Function '%s': Event code (%s) has no listeners.", __FUNCTION__, event_code_str(code));
         return false;
     }
 
-    u64 registered_count = darray_length(state_ptr->events[code].listeners);
-
-    for(u64 i = 0; i < registered_count; ++i)
+    for(u32 i = 0; i < e->listener_count; ++i)
     {
-        registered_listener r = state_ptr->events[code].listeners[i];
+        registered_listener r = state_ptr->listeners[e->first_listener + i];
 
         if(r.instance == listener && r.handler == handler)
         {
-            darray_pop_at(state_ptr->events[code].listeners, i, null);
+            darray_pop_at(state_ptr->listeners, e->first_listener + i, null);
+            e->listener_count--;
+
+            // Слушатели следующих кодов событий сдвинулись.
+            for(u32 j = code + 1; j < EVENT_CODES_MAX; ++j)
+            {
+                state_ptr->events[j].first_listener--;
+            }
+
             return true;
         }
     }
@@ -171,25 +223,163 @@ bool event_send(event_code code, void* sender, event_context* context)
         return false;
     }
 
-    if(state_ptr->events[code].listeners == null)
+    return event_dispatch(code, sender, context);
+}
+
+bool event_post(event_code code, void* sender, event_context* context)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return false;
+    }
+
+    if(code >= EVENT_CODES_MAX)
     {
-        // NOTE: Включить при отладке!
-        // ktrace("Function '%s': Event code (%s) has no listeners.", __FUNCTION__, event_code_str(code));
+        kerror(message_code_out_of_bounds, __FUNCTION__);
         return false;
     }
 
-    u64 registered_count = darray_length(state_ptr->events[code].listeners);
+    // Захват ячейки очереди: ячейка свободна, когда ее номер совпадает с позицией записи.
+    u64 position = __atomic_load_n(&state_ptr->queue_write, __ATOMIC_RELAXED);
+    queued_event* slot = null;
+
+    while(true)
+    {
+        slot = &state_ptr->queue[position & (EVENT_QUEUE_CAPACITY - 1)];
+        u64 sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        i64 difference = (i64)sequence - (i64)position;
+
+        if(difference == 0)
+        {
+            if(__atomic_compare_exchange_n(
+                &state_ptr->queue_write, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+            ))
+            {
+                break;
+            }
+        }
+        else if(difference < 0)
+        {
+            kwarng("Function '%s': Event queue is full, event (%s) is dropped.", __FUNCTION__, event_code_str(code));
+            return false;
+        }
+        else
+        {
+            position = __atomic_load_n(&state_ptr->queue_write, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->code = code;
+    slot->sender = sender;
+    if(context)
+    {
+        slot->context = *context;
+    }
+    else
+    {
+        kzero_tc(&slot->context, event_context, 1);
+    }
+
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void event_system_dispatch()
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return;
+    }
+
+    KPROFILE_FUNCTION();
+
+    // Извлечение опубликованных событий (события, отправленные обработчиками, попадут в следующий кадр).
+    u32 batch_count = 0;
+    while(batch_count < EVENT_QUEUE_CAPACITY)
+    {
+        queued_event* slot = &state_ptr->queue[state_ptr->queue_read & (EVENT_QUEUE_CAPACITY - 1)];
+        if(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != state_ptr->queue_read + 1)
+        {
+            break;
+        }
+
+        state_ptr->batch[batch_count++] = *slot;
+        __atomic_store_n(&slot->sequence, state_ptr->queue_read + EVENT_QUEUE_CAPACITY, __ATOMIC_RELEASE);
+        state_ptr->queue_read++;
+    }
+
+    if(!batch_count)
+    {
+        return;
+    }
+
+    // Объединение: от каждого объединяемого кода остается последнее событие на его месте в очереди.
+    state_ptr->dispatch_stamp++;
+    for(u32 i = batch_count; i > 0; --i)
+    {
+        queued_event* queued = &state_ptr->batch[i - 1];
+        event* e = &state_ptr->events[queued->code];
+
+        if(!e->coalesce)
+        {
+            continue;
+        }
+
+        if(e->coalesce_stamp == state_ptr->dispatch_stamp)
+        {
+            queued->code = EVENT_CODE_NULL;
+        }
+        else
+        {
+            e->coalesce_stamp = state_ptr->dispatch_stamp;
+        }
+    }
+
+    for(u32 i = 0; i < batch_count; ++i)
+    {
+        queued_event* queued = &state_ptr->batch[i];
+        if(queued->code != EVENT_CODE_NULL)
+        {
+            event_dispatch(queued->code, queued->sender, &queued->context);
+        }
+    }
+}
+
+void event_set_coalescing(event_code code, bool coalesce)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return;
+    }
+
+    if(code >= EVENT_CODES_MAX)
+    {
+        kerror(message_code_out_of_bounds, __FUNCTION__);
+        return;
+    }
+
+    state_ptr->events[code].coalesce = coalesce;
+}
+
+static bool event_dispatch(event_code code, void* sender, event_context* context)
+{
+    const event* e = &state_ptr->events[code];
 
-    for(u64 i = 0; i < registered_count; ++i)
+    // NOTE: Слушатель может снять регистрацию или зарегистрировать новых во время обработки,
+    //       поэтому границы и указатель на массив читаются заново на каждом шаге.
+    for(u32 i = 0; i < e->listener_count; ++i)
     {
-        registered_listener r = state_ptr->events[code].listeners[i];
+        registered_listener r = state_ptr->listeners[e->first_listener + i];
 
         if(r.handler(code, sender, r.instance, context))
         {
             // Сообщение было обработано, другие слушатели пропускаются.
             // ktrace(
             //     "Function '%s' has processed an event. Other listeners are skipped (Current %llu, Total %llu).",
-            //     __FUNCTION__, i, registered_count
+            //     __FUNCTION__, i, e->listener_count
             // );
             return true;
         }
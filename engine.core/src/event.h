@@ -25,8 +25,15 @@ void event_system_initialize(u64* memory_requirement, void* memory);
 */
 void event_system_shutdown();
 
+/*
+    @brief Передает обработчикам накопленные с прошлого вызова отложенные события (см. event_post).
+    NOTE: Вызывается один раз за кадр из основного потока.
+*/
+void event_system_dispatch();
+
 /*
     @brief Регистрирует функцию-обработчик на заданное событие.
+    NOTE: Регистрация и снятие регистрации только из основного потока.
     @param code Код события.
     @param listener Указатель на слушателя события, может быть null.
     @param handler Функция обработчик события.
@@ -44,7 +51,8 @@ KAPI bool event_register(event_code code, void* listener, PFN_event_handler hand
 KAPI bool event_unregister(event_code code, void* listener, PFN_event_handler handler);
 
 /*
-    @brief Создает событие с заданным кодом события и его контекстом.
+    @brief Создает событие с заданным кодом события и его контекстом, обработчики вызываются сразу.
+    NOTE: Только из основного потока, для других потоков используется event_post.
     @param code Код события.
     @param sender Указатель на отправителя события, может быть null.
     @param context Указатель на контекст события, может быть null.
@@ -52,6 +60,25 @@ KAPI bool event_unregister(event_code code, void* listener, PFN_event_handler ha
 */
 KAPI bool event_send(event_code code, void* sender, event_context* context);
 
+/*
+    @brief Ставит событие в очередь отложенных событий, обработчики вызываются в основном потоке при следующем
+           вызове event_system_dispatch. Можно вызывать из любого потока.
+    @param code Код события.
+    @param sender Указатель на отправителя события, может быть null.
+    @param context Указатель на контекст события (копируется), может быть null.
+    @return True событие поставлено в очередь, false очередь заполнена.
+*/
+KAPI bool event_post(event_code code, void* sender, event_context* context);
+
+/*
+    @brief Включает объединение отложенных событий с заданным кодом: из событий, накопленных за кадр,
+           обработчикам передается только последнее. По умолчанию включено для движения мыши и изменения
+           размера окна.
+    @param code Код события.
+    @param coalesce True объединять события, false передавать все.
+*/
+KAPI void event_set_coalescing(event_code code, bool coalesce);
+
 /*
     @brief По коду события возвращает символьную строку.
     @param code Код события.
@@ -5,6 +5,16 @@
 #include "logger.h"
 #include "event.h"
 #include "memory/memory.h"
+#include "containers/darray.h"
+#include "platform/file.h"
+#include "platform/time.h"
+#include "kstring.h"
+
+// Сигнатура файла записи ввода ('KINP').
+#define INPUT_RECORD_MAGIC 0x504e494b
+
+// Версия формата файла записи ввода.
+#define INPUT_RECORD_VERSION 1
 
 typedef struct keyboard_state {
     bool keys[KEYS_MAX + 1];
@@ -17,17 +27,75 @@ typedef struct mouse_state {
     bool buttons[BTNS_MAX];
 } mouse_state;
 
+// Тип записанного события ввода.
+typedef enum input_record_type {
+    INPUT_RECORD_TYPE_KEY,
+    INPUT_RECORD_TYPE_BUTTON,
+    INPUT_RECORD_TYPE_MOVE,
+    INPUT_RECORD_TYPE_WHEEL
+} input_record_type;
+
+/*
+    Заголовок файла записи ввода. За ним следуют длительности кадров (f32, в секундах) и события ввода.
+*/
+typedef struct input_record_header {
+    u32 magic;
+    u32 version;
+    u32 frame_count;
+    u32 event_count;
+} input_record_header;
+
+// Записанное событие ввода (16 байт).
+typedef struct input_record {
+    // Номер кадра от начала записи, в котором событие было получено.
+    u32 frame;
+    // Время от начала записи в секундах.
+    f32 time;
+    // Тип события (input_record_type).
+    u8 type;
+    // Состояние клавиши или кнопки.
+    u8 pressed;
+    // Код клавиши или кнопки.
+    u16 code;
+    // Координаты мыши или значение колесика (x).
+    i16 x;
+    i16 y;
+} input_record;
+
 typedef struct input_system_state {
     keyboard_state keyboard_current;
     keyboard_state keyboard_previous;
     mouse_state mouse_current;
     mouse_state mouse_previous;
+    // Номер кадра от начала записи или воспроизведения.
+    u32 frame;
+    // Запись ввода (динамические массивы, null если запись не ведется).
+    bool recording;
+    char* record_path;
+    f64 record_start_time;
+    f32* record_deltas;
+    input_record* record_events;
+    // Воспроизведение ввода из отображенного в память файла.
+    bool replaying;
+    file_mapping replay_mapping;
+    const f32* replay_deltas;
+    const input_record* replay_events;
+    u32 replay_frame_count;
+    u32 replay_event_count;
+    u32 replay_event_index;
 } input_system_state;
 
 static input_system_state* state_ptr = null;
 static const char* message_not_initialized =
     "Function '%s' requires the input system to be initialized. Call 'input_system_initialize' first.";
 
+static void input_apply_keyboard_key(key key, bool pressed);
+static void input_apply_mouse_button(button button, bool pressed);
+static void input_apply_mouse_move(i32 x, i32 y);
+static void input_apply_mouse_wheel(i32 z_delta);
+static void input_record_push(input_record_type type, u16 code, bool pressed, i32 x, i32 y);
+static void input_replay_apply_frame();
+
 void input_system_initialize(u64* memory_requirement, void* memory)
 {
     if(state_ptr)
@@ -55,6 +123,16 @@ void input_system_shutdown()
         return;
     }
 
+    if(state_ptr->recording)
+    {
+        input_record_stop();
+    }
+
+    if(state_ptr->replaying)
+    {
+        input_replay_stop();
+    }
+
     state_ptr = null;
 }
 
@@ -68,9 +146,188 @@ void input_system_update(f64 delta_time)
 
     kcopy_tc(&state_ptr->keyboard_previous, &state_ptr->keyboard_current, keyboard_state, 1);
     kcopy_tc(&state_ptr->mouse_previous, &state_ptr->mouse_current, mouse_state, 1);
+
+    if(state_ptr->recording || state_ptr->replaying)
+    {
+        state_ptr->frame++;
+    }
+
+    if(state_ptr->replaying)
+    {
+        if(state_ptr->frame >= state_ptr->replay_frame_count)
+        {
+            kinfor("Input replay finished (%u frames).", state_ptr->replay_frame_count);
+            input_replay_stop();
+        }
+        else
+        {
+            // События следующего кадра применяются сразу, как и события окна до обновления кадра.
+            input_replay_apply_frame();
+        }
+    }
 }
 
-void input_update_keyboard_key(key key, bool pressed)
+f64 input_system_frame_delta(f64 delta_time)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return delta_time;
+    }
+
+    if(state_ptr->replaying)
+    {
+        return state_ptr->replay_deltas[state_ptr->frame];
+    }
+
+    if(state_ptr->recording)
+    {
+        // NOTE: Длительность записывается один раз на кадр, пропущенные кадры (запись начата во время кадра)
+        //       заполняются текущей длительностью.
+        while(darray_length(state_ptr->record_deltas) <= state_ptr->frame)
+        {
+            f32 delta = (f32)delta_time;
+            darray_push(state_ptr->record_deltas, delta);
+        }
+    }
+
+    return delta_time;
+}
+
+bool input_record_start(const char* path)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return false;
+    }
+
+    if(!path || state_ptr->recording || state_ptr->replaying)
+    {
+        kerror("Function '%s' requires a valid path and no active recording or replay.", __FUNCTION__);
+        return false;
+    }
+
+    state_ptr->recording = true;
+    state_ptr->record_path = string_duplicate(path);
+    state_ptr->record_start_time = platform_time_absolute();
+    state_ptr->record_deltas = darray_reserve(f32, 4096);
+    state_ptr->record_events = darray_reserve(input_record, 4096);
+    state_ptr->frame = 0;
+
+    kinfor("Input recording to '%s' started.", path);
+    return true;
+}
+
+bool input_record_stop()
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return false;
+    }
+
+    if(!state_ptr->recording)
+    {
+        kwarng("Function '%s': Input recording is not active.", __FUNCTION__);
+        return false;
+    }
+
+    input_record_header header;
+    header.magic = INPUT_RECORD_MAGIC;
+    header.version = INPUT_RECORD_VERSION;
+    header.frame_count = darray_length(state_ptr->record_deltas);
+    header.event_count = darray_length(state_ptr->record_events);
+
+    // События после последнего полного кадра не воспроизводятся.
+    while(header.event_count && state_ptr->record_events[header.event_count - 1].frame >= header.frame_count)
+    {
+        header.event_count--;
+    }
+
+    file* f = null;
+    bool result = platform_file_open(state_ptr->record_path, FILE_MODE_WRITE | FILE_MODE_BINARY, &f);
+    if(result)
+    {
+        result = platform_file_write(f, sizeof(input_record_header), &header)
+              && platform_file_write(f, sizeof(f32) * header.frame_count, state_ptr->record_deltas)
+              && platform_file_write(f, sizeof(input_record) * header.event_count, state_ptr->record_events);
+        platform_file_close(f);
+    }
+
+    if(result)
+    {
+        kinfor(
+            "Input recording saved to '%s' (%u frames, %u events).", state_ptr->record_path, header.frame_count,
+            header.event_count
+        );
+    }
+    else
+    {
+        kerror("Function '%s': Failed to write input recording '%s'.", __FUNCTION__, state_ptr->record_path);
+    }
+
+    string_free(state_ptr->record_path);
+    darray_destroy(state_ptr->record_deltas);
+    darray_destroy(state_ptr->record_events);
+    state_ptr->record_path = null;
+    state_ptr->record_deltas = null;
+    state_ptr->record_events = null;
+    state_ptr->recording = false;
+    return result;
+}
+
+bool input_replay_start(const char* path)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return false;
+    }
+
+    if(!path || state_ptr->recording || state_ptr->replaying)
+    {
+        kerror("Function '%s' requires a valid path and no active recording or replay.", __FUNCTION__);
+        return false;
+    }
+
+    file_mapping mapping;
+    if(!platform_file_map(path, &mapping))
+    {
+        kerror("Function '%s': Unable to open input recording '%s'.", __FUNCTION__, path);
+        return false;
+    }
+
+    const input_record_header* header = mapping.data;
+    if(mapping.size < sizeof(input_record_header) || header->magic != INPUT_RECORD_MAGIC
+    || header->version != INPUT_RECORD_VERSION || !header->frame_count
+    || mapping.size < sizeof(input_record_header) + sizeof(f32) * header->frame_count
+                    + sizeof(input_record) * header->event_count)
+    {
+        kerror("Function '%s': File '%s' is not a valid input recording.", __FUNCTION__, path);
+        platform_file_unmap(&mapping);
+        return false;
+    }
+
+    state_ptr->replaying = true;
+    state_ptr->replay_mapping = mapping;
+    state_ptr->replay_deltas = (const f32*)((const u8*)mapping.data + sizeof(input_record_header));
+    state_ptr->replay_events = (const input_record*)(state_ptr->replay_deltas + header->frame_count);
+    state_ptr->replay_frame_count = header->frame_count;
+    state_ptr->replay_event_count = header->event_count;
+    state_ptr->replay_event_index = 0;
+    state_ptr->frame = 0;
+
+    // Воспроизведение начинается с ненажатых клавиш и кнопок.
+    kzero_tc(&state_ptr->keyboard_current, keyboard_state, 1);
+    kzero_tc(&state_ptr->mouse_current.buttons, bool, BTNS_MAX);
+    input_replay_apply_frame();
+
+    kinfor("Input replay from '%s' started (%u frames, %u events).", path, header->frame_count, header->event_count);
+    return true;
+}
+
+void input_replay_stop()
 {
     if(!state_ptr)
     {
@@ -78,19 +335,47 @@ void input_update_keyboard_key(key key, bool pressed)
         return;
     }
 
-    if(key >= KEYS_MAX || key == KEY_UNKNOWN)
+    if(!state_ptr->replaying)
     {
-        kwarng("Input system: unknown keyboard key code: %X.", key);
         return;
     }
 
-    if(state_ptr->keyboard_current.keys[key] != pressed)
+    platform_file_unmap(&state_ptr->replay_mapping);
+    state_ptr->replay_deltas = null;
+    state_ptr->replay_events = null;
+    state_ptr->replaying = false;
+}
+
+bool input_is_replaying()
+{
+    return state_ptr && state_ptr->replaying;
+}
+
+bool input_is_recording()
+{
+    return state_ptr && state_ptr->recording;
+}
+
+void input_update_keyboard_key(key key, bool pressed)
+{
+    if(!state_ptr)
     {
-        state_ptr->keyboard_current.keys[key] = pressed;
+        kerror(message_not_initialized, __FUNCTION__);
+        return;
+    }
 
-        event_context context = { .u32[0] = key };
-        event_send(pressed ? EVENT_CODE_KEYBOARD_KEY_PRESSED : EVENT_CODE_KEYBOARD_KEY_RELEASED, null, &context);
+    // NOTE: При воспроизведении ввод пользователя игнорируется.
+    if(state_ptr->replaying)
+    {
+        return;
     }
+
+    if(state_ptr->recording)
+    {
+        input_record_push(INPUT_RECORD_TYPE_KEY, key, pressed, 0, 0);
+    }
+
+    input_apply_keyboard_key(key, pressed);
 }
 
 void input_update_mouse_button(button button, bool pressed)
@@ -101,19 +386,17 @@ void input_update_mouse_button(button button, bool pressed)
         return;
     }
 
-    if(button >= BTNS_MAX || button == BTN_UNKNOWN)
+    if(state_ptr->replaying)
     {
-        kwarng("Input system: unknown mouse button %X code.", button);
         return;
     }
 
-    if(state_ptr->mouse_current.buttons[button] != pressed)
+    if(state_ptr->recording)
     {
-        state_ptr->mouse_current.buttons[button] = pressed;
-
-        event_context context = { .u32[0] = button };
-        event_send(pressed ? EVENT_CODE_MOUSE_BUTTON_PRESSED : EVENT_CODE_MOUSE_BUTTON_RELEASED, null, &context);
+        input_record_push(INPUT_RECORD_TYPE_BUTTON, button, pressed, 0, 0);
     }
+
+    input_apply_mouse_button(button, pressed);
 }
 
 void input_update_mouse_move(i32 x, i32 y)
@@ -124,17 +407,17 @@ void input_update_mouse_move(i32 x, i32 y)
         return;
     }
 
-    if(state_ptr->mouse_current.x != x || state_ptr->mouse_current.y != y)
+    if(state_ptr->replaying)
     {
-        // NOTE: Включить при отладке!
-        // kdebug("Current mouse position %X : %X", x, y);
-
-        state_ptr->mouse_current.x = x;
-        state_ptr->mouse_current.y = y;
+        return;
+    }
 
-        event_context context = { .i32[0] = x, .i32[1] = y };
-        event_send(EVENT_CODE_MOUSE_MOVED, null, &context);
+    if(state_ptr->recording)
+    {
+        input_record_push(INPUT_RECORD_TYPE_MOVE, 0, false, x, y);
     }
+
+    input_apply_mouse_move(x, y);
 }
 
 void input_update_mouse_wheel(i32 z_delta)
@@ -145,6 +428,116 @@ void input_update_mouse_wheel(i32 z_delta)
         return;
     }
 
+    if(state_ptr->replaying)
+    {
+        return;
+    }
+
+    if(state_ptr->recording)
+    {
+        input_record_push(INPUT_RECORD_TYPE_WHEEL, 0, false, z_delta, 0);
+    }
+
+    input_apply_mouse_wheel(z_delta);
+}
+
+static void input_record_push(input_record_type type, u16 code, bool pressed, i32 x, i32 y)
+{
+    input_record record;
+    record.frame = state_ptr->frame;
+    record.time = (f32)(platform_time_absolute() - state_ptr->record_start_time);
+    record.type = type;
+    record.pressed = pressed;
+    record.code = code;
+    record.x = (i16)KCLAMP(x, -32768, 32767);
+    record.y = (i16)KCLAMP(y, -32768, 32767);
+    darray_push(state_ptr->record_events, record);
+}
+
+static void input_replay_apply_frame()
+{
+    while(state_ptr->replay_event_index < state_ptr->replay_event_count)
+    {
+        const input_record* record = &state_ptr->replay_events[state_ptr->replay_event_index];
+        if(record->frame > state_ptr->frame)
+        {
+            break;
+        }
+
+        switch(record->type)
+        {
+            case INPUT_RECORD_TYPE_KEY:
+                input_apply_keyboard_key(record->code, record->pressed);
+                break;
+            case INPUT_RECORD_TYPE_BUTTON:
+                input_apply_mouse_button(record->code, record->pressed);
+                break;
+            case INPUT_RECORD_TYPE_MOVE:
+                input_apply_mouse_move(record->x, record->y);
+                break;
+            case INPUT_RECORD_TYPE_WHEEL:
+                input_apply_mouse_wheel(record->x);
+                break;
+            default:
+                kwarng("Function '%s': Unknown input record type %u.", __FUNCTION__, record->type);
+                break;
+        }
+
+        state_ptr->replay_event_index++;
+    }
+}
+
+static void input_apply_keyboard_key(key key, bool pressed)
+{
+    if(key >= KEYS_MAX || key == KEY_UNKNOWN)
+    {
+        kwarng("Input system: unknown keyboard key code: %X.", key);
+        return;
+    }
+
+    if(state_ptr->keyboard_current.keys[key] != pressed)
+    {
+        state_ptr->keyboard_current.keys[key] = pressed;
+
+        event_context context = { .u32[0] = key };
+        event_send(pressed ? EVENT_CODE_KEYBOARD_KEY_PRESSED : EVENT_CODE_KEYBOARD_KEY_RELEASED, null, &context);
+    }
+}
+
+static void input_apply_mouse_button(button button, bool pressed)
+{
+    if(button >= BTNS_MAX || button == BTN_UNKNOWN)
+    {
+        kwarng("Input system: unknown mouse button %X code.", button);
+        return;
+    }
+
+    if(state_ptr->mouse_current.buttons[button] != pressed)
+    {
+        state_ptr->mouse_current.buttons[button] = pressed;
+
+        event_context context = { .u32[0] = button };
+        event_send(pressed ? EVENT_CODE_MOUSE_BUTTON_PRESSED : EVENT_CODE_MOUSE_BUTTON_RELEASED, null, &context);
+    }
+}
+
+static void input_apply_mouse_move(i32 x, i32 y)
+{
+    if(state_ptr->mouse_current.x != x || state_ptr->mouse_current.y != y)
+    {
+        // NOTE: Включить при отладке!
+        // kdebug("Current mouse position %X : %X", x, y);
+
+        state_ptr->mouse_current.x = x;
+        state_ptr->mouse_current.y = y;
+
+        event_context context = { .i32[0] = x, .i32[1] = y };
+        event_post(EVENT_CODE_MOUSE_MOVED, null, &context);
+    }
+}
+
+static void input_apply_mouse_wheel(i32 z_delta)
+{
     if(state_ptr->mouse_current.z_delta != z_delta)
     {
         state_ptr->mouse_current.z_delta = z_delta;
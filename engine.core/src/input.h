@@ -22,6 +22,54 @@ void input_system_shutdown();
 */
 void input_system_update(f64 delta_time);
 
+/*
+    @brief Возвращает длительность текущего кадра: при воспроизведении записанную, иначе переданную
+           (при записи ввода она сохраняется).
+    NOTE: Вызывается один раз за кадр до обновления игры, для повторяемого хода игры при воспроизведении.
+    @param delta_time Измеренное время кадра.
+    @return Время кадра, которое нужно использовать для обновления.
+*/
+f64 input_system_frame_delta(f64 delta_time);
+
+/*
+    @brief Начинает запись событий ввода (клавиатура, кнопки, движение и колесико мыши) с номерами кадров
+           и временем, файл записывается при остановке записи или системы ввода.
+    @param path Указатель на строку пути к файлу записи.
+    @return True запись начата, false уже идет запись или воспроизведение.
+*/
+KAPI bool input_record_start(const char* path);
+
+/*
+    @brief Останавливает запись событий ввода и сохраняет ее в файл.
+    @return True запись сохранена, false запись не велась или не удалось записать файл.
+*/
+KAPI bool input_record_stop();
+
+/*
+    @brief Начинает воспроизведение записанных событий ввода с длительностями кадров,
+           ввод пользователя на время воспроизведения игнорируется.
+    @param path Указатель на строку пути к файлу записи.
+    @return True воспроизведение начато, false файл не найден, поврежден или уже идет запись или воспроизведение.
+*/
+KAPI bool input_replay_start(const char* path);
+
+/*
+    @brief Останавливает воспроизведение записанных событий ввода.
+*/
+KAPI void input_replay_stop();
+
+/*
+    @brief Проверяет, идет ли воспроизведение записанных событий ввода (завершается после последнего кадра записи).
+    @return True идет воспроизведение, false нет.
+*/
+KAPI bool input_is_replaying();
+
+/*
+    @brief Проверяет, идет ли запись событий ввода.
+    @return True идет запись, false нет.
+*/
+KAPI bool input_is_recording();
+
 /*
     @brief Обновляет текущее состояние клавиши клавиатуры.
     NOTE: Используется в функции обработки прерывания ввода.
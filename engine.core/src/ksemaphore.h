@@ -0,0 +1,33 @@
+#pragma once
+
+#include <defines.h>
+#include <platform/semaphore.h>
+
+/*
+    @brief Создает семафор.
+    @param initial_count Начальное значение счетчика семафора.
+    @param out_semaphore Указатель на память для сохранения созданного семафора.
+    @return True семафор успешно создан, false если не удалось.
+*/
+#define ksemaphore_create(initial_count, out_semaphore) platform_semaphore_create(initial_count, out_semaphore)
+
+/*
+    @brief Уничтожает предоставленный семафор.
+    @param semaphore Указатель на семафор который будет уничтожен.
+*/
+#define ksemaphore_destroy(semaphore) platform_semaphore_destroy(semaphore)
+
+/*
+    @brief Увеличивает счетчик семафора, пробуждая один ожидающий поток.
+    @param semaphore Указатель на семафор который необходимо просигнализировать.
+    @return True сигнал успешно отправлен, false если не удалось.
+*/
+#define ksemaphore_signal(semaphore) platform_semaphore_signal(semaphore)
+
+/*
+    @brief Ожидает сигнала семафора не дольше заданного времени и уменьшает его счетчик.
+    @param semaphore Указатель на семафор сигнала которого необходимо дождаться.
+    @param timeout_ms Максимальное время ожидания в миллисекундах.
+    @return True сигнал получен, false если истекло время ожидания или произошла ошибка.
+*/
+#define ksemaphore_wait(semaphore, timeout_ms) platform_semaphore_wait(semaphore, timeout_ms)
@@ -0,0 +1,582 @@
+// Cобственные подключения.
+#include "kstring_view.h"
+
+// Внутренние подключения.
+#include "memory/memory.h"
+#include "platform/string.h"
+
+// Максимальное количество значащих цифр, которое гарантированно помещается в u64.
+#define SIGNIFICANT_DIGITS_MAX 19
+// Максимальная мантисса, точно представимая в f64 (2^53).
+#define EXACT_MANTISSA_MAX (1ULL << 53)
+// Максимальная точно представимая в f64 степень десяти.
+#define EXACT_POW10_MAX 22
+// Максимальная длина числа для разбора стандартной библиотекой.
+#define FALLBACK_LENGTH_MAX 128
+
+// Степени десяти, которые точно представимы в f64.
+static const f64 exact_pow10[EXACT_POW10_MAX + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// @brief Результат предварительного разбора десятичного числа.
+typedef struct decimal_number {
+    // @brief Начало числа (после пробельных символов).
+    const char* start;
+    // @brief Количество символов числа.
+    u64 length;
+    // @brief Значащие цифры числа (не более SIGNIFICANT_DIGITS_MAX).
+    u64 mantissa;
+    // @brief Десятичный порядок мантиссы.
+    i64 exponent;
+    // @brief Знак числа.
+    bool negative;
+    // @brief Часть значащих цифр отброшена (быстрый путь невозможен).
+    bool truncated;
+} decimal_number;
+
+KINLINE bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+KINLINE bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+KINLINE char to_lower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+// @brief Пропускает начальные пробельные символы.
+static void view_skip_space(kstring_view* view)
+{
+    while(view->length > 0 && is_space(*view->data))
+    {
+        view->data++;
+        view->length--;
+    }
+}
+
+// @brief Разбирает синтаксис десятичного числа [+-]цифры[.цифры][(e|E)[+-]цифры] без преобразования.
+static bool decimal_number_scan(const kstring_view* view, decimal_number* out_number)
+{
+    const char* p = view->data;
+    const char* end = view->data + view->length;
+
+    out_number->start = p;
+    out_number->mantissa = 0;
+    out_number->exponent = 0;
+    out_number->negative = false;
+    out_number->truncated = false;
+
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        out_number->negative = *p == '-';
+        p++;
+    }
+
+    u32 significant = 0;
+    u32 digit_count = 0;
+
+    // Целая часть.
+    for(; p < end && is_digit(*p); ++p, ++digit_count)
+    {
+        u32 digit = (u32)(*p - '0');
+        if(significant < SIGNIFICANT_DIGITS_MAX)
+        {
+            out_number->mantissa = out_number->mantissa * 10 + digit;
+            significant += out_number->mantissa != 0;
+        }
+        else
+        {
+            out_number->truncated |= digit != 0;
+            out_number->exponent++;
+        }
+    }
+
+    // Дробная часть.
+    if(p < end && *p == '.')
+    {
+        p++;
+        for(; p < end && is_digit(*p); ++p, ++digit_count)
+        {
+            u32 digit = (u32)(*p - '0');
+            if(significant < SIGNIFICANT_DIGITS_MAX)
+            {
+                out_number->mantissa = out_number->mantissa * 10 + digit;
+                out_number->exponent--;
+                significant += out_number->mantissa != 0;
+            }
+            else
+            {
+                out_number->truncated |= digit != 0;
+            }
+        }
+    }
+
+    if(digit_count == 0)
+    {
+        return false;
+    }
+
+    // Порядок (учитывается только если за 'e' следуют цифры).
+    if(p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* e = p + 1;
+        bool exponent_negative = false;
+
+        if(e < end && (*e == '-' || *e == '+'))
+        {
+            exponent_negative = *e == '-';
+            e++;
+        }
+
+        if(e < end && is_digit(*e))
+        {
+            i64 exponent = 0;
+            for(; e < end && is_digit(*e); ++e)
+            {
+                // NOTE: Ограничение от переполнения, такие порядки все равно дают 0 или бесконечность.
+                if(exponent < 100000)
+                {
+                    exponent = exponent * 10 + (*e - '0');
+                }
+            }
+
+            out_number->exponent += exponent_negative ? -exponent : exponent;
+            p = e;
+        }
+    }
+
+    out_number->length = (u64)(p - out_number->start);
+    return true;
+}
+
+// @brief Точный быстрый путь: мантисса и степень десяти представимы в f64, результат округляется один раз.
+static bool decimal_number_fast_f64(const decimal_number* number, f64* out_value)
+{
+    if(number->truncated || number->mantissa > EXACT_MANTISSA_MAX)
+    {
+        return false;
+    }
+
+    if(number->exponent < -EXACT_POW10_MAX || number->exponent > EXACT_POW10_MAX)
+    {
+        // Ноль с любым порядком остается нулем.
+        if(number->mantissa != 0)
+        {
+            return false;
+        }
+    }
+
+    f64 value = (f64)number->mantissa;
+    if(value != 0.0)
+    {
+        if(number->exponent < 0)
+        {
+            value /= exact_pow10[-number->exponent];
+        }
+        else
+        {
+            value *= exact_pow10[number->exponent];
+        }
+    }
+
+    *out_value = number->negative ? -value : value;
+    return true;
+}
+
+// @brief Медленный путь через стандартную библиотеку для чисел вне быстрого пути.
+static bool decimal_number_fallback(const decimal_number* number, const char* format, void* out_value)
+{
+    char buffer[FALLBACK_LENGTH_MAX];
+    if(number->length >= FALLBACK_LENGTH_MAX)
+    {
+        return false;
+    }
+
+    kcopy(buffer, number->start, number->length);
+    buffer[number->length] = '\0';
+    return platform_string_sscanf(buffer, format, out_value) == 1;
+}
+
+kstring_view string_view_create(const char* str)
+{
+    kstring_view view = { str, str ? platform_string_length(str) : 0 };
+    return view;
+}
+
+kstring_view string_view_trim(kstring_view view)
+{
+    view_skip_space(&view);
+
+    while(view.length > 0 && is_space(view.data[view.length - 1]))
+    {
+        view.length--;
+    }
+
+    return view;
+}
+
+kstring_view string_view_sub(kstring_view view, u64 start, i64 length)
+{
+    if(start >= view.length)
+    {
+        return string_view_from(view.data + view.length, 0);
+    }
+
+    u64 available = view.length - start;
+    u64 count = (length < 0 || (u64)length > available) ? available : (u64)length;
+    return string_view_from(view.data + start, count);
+}
+
+i64 string_view_index_of(kstring_view view, char c)
+{
+    for(u64 i = 0; i < view.length; ++i)
+    {
+        if(view.data[i] == c)
+        {
+            return (i64)i;
+        }
+    }
+
+    return -1;
+}
+
+bool string_view_equal(kstring_view view, const char* str)
+{
+    if(!str) return false;
+
+    u64 i = 0;
+    for(; i < view.length; ++i)
+    {
+        if(str[i] == '\0' || str[i] != view.data[i])
+        {
+            return false;
+        }
+    }
+
+    return str[i] == '\0';
+}
+
+bool string_view_equali(kstring_view view, const char* str)
+{
+    if(!str) return false;
+
+    u64 i = 0;
+    for(; i < view.length; ++i)
+    {
+        if(str[i] == '\0' || to_lower(str[i]) != to_lower(view.data[i]))
+        {
+            return false;
+        }
+    }
+
+    return str[i] == '\0';
+}
+
+bool string_view_starts_withi(kstring_view view, const char* prefix)
+{
+    if(!prefix) return false;
+
+    u64 i = 0;
+    for(; prefix[i] != '\0'; ++i)
+    {
+        if(i >= view.length || to_lower(prefix[i]) != to_lower(view.data[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+u64 string_view_copy(char* dest, u64 dest_size, kstring_view view)
+{
+    if(!dest || dest_size == 0) return 0;
+
+    u64 count = view.length < dest_size - 1 ? view.length : dest_size - 1;
+    if(count > 0)
+    {
+        kcopy(dest, view.data, count);
+    }
+
+    dest[count] = '\0';
+    return count;
+}
+
+char* string_view_duplicate(kstring_view view)
+{
+    // NOTE: Выделяется так же как в 'string_duplicate', чтобы освобождать через 'string_free'.
+    char* newstr = kallocate_tc(char, view.length + 1, MEMORY_TAG_STRING);
+    string_view_copy(newstr, view.length + 1, view);
+    return newstr;
+}
+
+bool string_view_split_next(kstring_view* remaining, char delim, kstring_view* out_token)
+{
+    // NOTE: Конец представления отмечается указателем data == null (пустой хвост после разделителя тоже часть).
+    if(!remaining->data)
+    {
+        return false;
+    }
+
+    i64 index = string_view_index_of(*remaining, delim);
+    if(index < 0)
+    {
+        *out_token = *remaining;
+        remaining->data = null;
+        remaining->length = 0;
+        return true;
+    }
+
+    *out_token = string_view_from(remaining->data, (u64)index);
+    remaining->data += index + 1;
+    remaining->length -= index + 1;
+    return true;
+}
+
+bool string_view_next_token(kstring_view* remaining, kstring_view* out_token)
+{
+    view_skip_space(remaining);
+    if(remaining->length == 0)
+    {
+        return false;
+    }
+
+    u64 length = 0;
+    while(length < remaining->length && !is_space(remaining->data[length]))
+    {
+        length++;
+    }
+
+    *out_token = string_view_from(remaining->data, length);
+    remaining->data += length;
+    remaining->length -= length;
+    return true;
+}
+
+bool string_view_parse_f64(kstring_view* remaining, f64* out_value)
+{
+    kstring_view view = *remaining;
+    view_skip_space(&view);
+
+    decimal_number number;
+    if(!decimal_number_scan(&view, &number))
+    {
+        return false;
+    }
+
+    if(!decimal_number_fast_f64(&number, out_value) && !decimal_number_fallback(&number, "%lf", out_value))
+    {
+        return false;
+    }
+
+    remaining->data = view.data + number.length;
+    remaining->length = view.length - number.length;
+    return true;
+}
+
+bool string_view_parse_f32(kstring_view* remaining, f32* out_value)
+{
+    kstring_view view = *remaining;
+    view_skip_space(&view);
+
+    decimal_number number;
+    if(!decimal_number_scan(&view, &number))
+    {
+        return false;
+    }
+
+    // NOTE: Быстрый путь f64 ограничен диапазоном [1e-22, 2^53 * 1e22], где все значения нормальны для f32.
+    //       Двойное округление f64 -> f32 ошибается только если f64 результат попал точно в середину
+    //       между соседними f32 (младшие 29 бит мантиссы равны 1 << 28), такие значения разбираются медленно.
+    f64 value;
+    bool fast = decimal_number_fast_f64(&number, &value);
+    if(fast)
+    {
+        union { f64 f; u64 u; } bits = { value };
+        fast = (bits.u & ((1ULL << 29) - 1)) != (1ULL << 28);
+    }
+
+    if(fast)
+    {
+        *out_value = (f32)value;
+    }
+    else if(!decimal_number_fallback(&number, "%f", out_value))
+    {
+        return false;
+    }
+
+    remaining->data = view.data + number.length;
+    remaining->length = view.length - number.length;
+    return true;
+}
+
+bool string_view_parse_u64(kstring_view* remaining, u64* out_value)
+{
+    kstring_view view = *remaining;
+    view_skip_space(&view);
+
+    u64 i = 0;
+    if(i < view.length && view.data[i] == '+')
+    {
+        i++;
+    }
+
+    u64 start = i;
+    u64 value = 0;
+    for(; i < view.length && is_digit(view.data[i]); ++i)
+    {
+        u64 digit = (u64)(view.data[i] - '0');
+        if(value > (U64_MAX - digit) / 10)
+        {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+
+    if(i == start)
+    {
+        return false;
+    }
+
+    *out_value = value;
+    remaining->data = view.data + i;
+    remaining->length = view.length - i;
+    return true;
+}
+
+bool string_view_parse_i64(kstring_view* remaining, i64* out_value)
+{
+    kstring_view view = *remaining;
+    view_skip_space(&view);
+
+    bool negative = false;
+    if(view.length > 0 && (view.data[0] == '-' || view.data[0] == '+'))
+    {
+        negative = view.data[0] == '-';
+        view.data++;
+        view.length--;
+    }
+
+    // NOTE: Знак уже обработан, повторный знак не допускается.
+    if(view.length == 0 || !is_digit(view.data[0]))
+    {
+        return false;
+    }
+
+    u64 magnitude = 0;
+    if(!string_view_parse_u64(&view, &magnitude))
+    {
+        return false;
+    }
+
+    u64 limit = negative ? (u64)I64_MAX + 1 : (u64)I64_MAX;
+    if(magnitude > limit)
+    {
+        return false;
+    }
+
+    *out_value = negative ? (i64)(0 - magnitude) : (i64)magnitude;
+    *remaining = view;
+    return true;
+}
+
+bool string_view_to_f32(kstring_view view, f32* out_value)
+{
+    kstring_view rest = string_view_trim(view);
+    f32 value = 0;
+
+    if(!string_view_parse_f32(&rest, &value) || rest.length != 0)
+    {
+        return false;
+    }
+
+    *out_value = value;
+    return true;
+}
+
+bool string_view_to_i32(kstring_view view, i32* out_value)
+{
+    kstring_view rest = string_view_trim(view);
+    i64 value = 0;
+
+    if(!string_view_parse_i64(&rest, &value) || rest.length != 0 || value < I32_MIN || value > I32_MAX)
+    {
+        return false;
+    }
+
+    *out_value = (i32)value;
+    return true;
+}
+
+// @brief Читает до count компонент, разделенных пробельными символами, возвращает количество прочитанных.
+static u32 view_parse_f32_array(kstring_view view, u32 count, f32* out_values)
+{
+    kzero_tc(out_values, f32, count);
+
+    u32 parsed = 0;
+    while(parsed < count && string_view_parse_f32(&view, &out_values[parsed]))
+    {
+        parsed++;
+    }
+
+    return parsed;
+}
+
+bool string_view_to_vec4(kstring_view view, vec4* out_vector)
+{
+    return view_parse_f32_array(view, 4, out_vector->elements) > 0;
+}
+
+bool string_view_to_vec3(kstring_view view, vec3* out_vector)
+{
+    return view_parse_f32_array(view, 3, out_vector->elements) > 0;
+}
+
+bool string_view_to_vec2(kstring_view view, vec2* out_vector)
+{
+    return view_parse_f32_array(view, 2, out_vector->elements) > 0;
+}
+
+void string_tokenizer_create(const void* data, u64 size, string_tokenizer* out_tokenizer)
+{
+    out_tokenizer->data = data;
+    out_tokenizer->size = data ? size : 0;
+    out_tokenizer->offset = 0;
+    out_tokenizer->line_number = 0;
+}
+
+bool string_tokenizer_next_line(string_tokenizer* tokenizer, kstring_view* out_line)
+{
+    if(tokenizer->offset >= tokenizer->size)
+    {
+        return false;
+    }
+
+    const char* start = tokenizer->data + tokenizer->offset;
+    u64 available = tokenizer->size - tokenizer->offset;
+    u64 length = 0;
+
+    while(length < available && start[length] != '\n')
+    {
+        length++;
+    }
+
+    // Переход за '\n' (если строка не последняя).
+    tokenizer->offset += length < available ? length + 1 : length;
+    tokenizer->line_number++;
+
+    if(length > 0 && start[length - 1] == '\r')
+    {
+        length--;
+    }
+
+    *out_line = string_view_from(start, length);
+    return true;
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+
+// @brief Представление части строки без владения памятью (строка не обязана завершаться '\0').
+typedef struct kstring_view {
+    // @brief Указатель на первый символ.
+    const char* data;
+    // @brief Количество символов.
+    u64 length;
+} kstring_view;
+
+// @brief Построчный разбор текстового буфера без выделения памяти.
+typedef struct string_tokenizer {
+    // @brief Указатель на начало буфера.
+    const char* data;
+    // @brief Размер буфера в байтах.
+    u64 size;
+    // @brief Текущая позиция разбора.
+    u64 offset;
+    // @brief Номер последней полученной строки (начиная с 1).
+    u32 line_number;
+} string_tokenizer;
+
+/*
+    @brief Создает представление из строки, завершающейся '\0'.
+    @param str Указатель на строку (может быть null).
+    @return Представление строки.
+*/
+KAPI kstring_view string_view_create(const char* str);
+
+/*
+    @brief Создает представление из указателя и количества символов.
+    @param data Указатель на первый символ.
+    @param length Количество символов.
+    @return Представление строки.
+*/
+KINLINE kstring_view string_view_from(const char* data, u64 length)
+{
+    kstring_view view = { data, length };
+    return view;
+}
+
+/*
+    @brief Убирает начальные и конечные пробельные символы (исходные данные не изменяются).
+    @param view Исходное представление.
+    @return Представление без пробельных символов по краям.
+*/
+KAPI kstring_view string_view_trim(kstring_view view);
+
+/*
+    @brief Получает часть представления.
+    @param view Исходное представление.
+    @param start Индекс первого символа.
+    @param length Количество символов, -1 до конца представления.
+    @return Часть представления (обрезается по границе исходного).
+*/
+KAPI kstring_view string_view_sub(kstring_view view, u64 start, i64 length);
+
+/*
+    @brief Указывает позицию первого совпадения искомого символа.
+    @param view Представление для поиска.
+    @param c Искомый символ.
+    @return Позиция символа, -1 если символ не найден.
+*/
+KAPI i64 string_view_index_of(kstring_view view, char c);
+
+/*
+    @brief Посимвольно сравнивает представление со строкой с учетом регистра символов.
+    @param view Представление для сравнения.
+    @param str Указатель на строку, завершающуюся '\0'.
+    @return True если строки одинаковые, false разные.
+*/
+KAPI bool string_view_equal(kstring_view view, const char* str);
+
+/*
+    @brief Посимвольно сравнивает представление со строкой без учета регистра символов.
+    @param view Представление для сравнения.
+    @param str Указатель на строку, завершающуюся '\0'.
+    @return True если строки одинаковые, false разные.
+*/
+KAPI bool string_view_equali(kstring_view view, const char* str);
+
+/*
+    @brief Проверяет начинается ли представление с указанной строки (без учета регистра символов).
+    @param view Представление для проверки.
+    @param prefix Указатель на строку начала, завершающуюся '\0'.
+    @return True если представление начинается с указанной строки, false если нет.
+*/
+KAPI bool string_view_starts_withi(kstring_view view, const char* prefix);
+
+/*
+    @brief Копирует представление в буфер и завершает его символом '\0'.
+    NOTE: Если представление не помещается, оно будет обрезано.
+    @param dest Указатель на буфер куда скопировать.
+    @param dest_size Размер буфера включая завершающий символ.
+    @param view Представление для копирования.
+    @return Количество скопированных символов (без учета '\0').
+*/
+KAPI u64 string_view_copy(char* dest, u64 dest_size, kstring_view view);
+
+/*
+    @brief Создает копию представления в виде строки, завершающейся '\0'.
+    @note  После использования удалить с помощью функуии 'string_free'.
+    @param view Представление для копирования.
+    @return Указатель на копию строки.
+*/
+KAPI char* string_view_duplicate(kstring_view view);
+
+/*
+    @brief Получает очередную часть до разделителя и сдвигает оставшееся представление.
+    NOTE: Пустые части возвращаются (как 'string_split' с include_empty), обрезка не выполняется.
+    @param remaining Указатель на оставшееся представление, после вызова указывает за разделитель.
+    @param delim Символ разделителя.
+    @param out_token Указатель на представление куда записать полученную часть.
+    @return True если часть получена, false если представление закончилось.
+*/
+KAPI bool string_view_split_next(kstring_view* remaining, char delim, kstring_view* out_token);
+
+/*
+    @brief Получает очередное слово, разделенное пробельными символами, и сдвигает оставшееся представление.
+    @param remaining Указатель на оставшееся представление, после вызова указывает за слово.
+    @param out_token Указатель на представление куда записать полученное слово.
+    @return True если слово получено, false если остались только пробельные символы.
+*/
+KAPI bool string_view_next_token(kstring_view* remaining, kstring_view* out_token);
+
+/*
+    @brief Разбирает 64-bit число с плавающей точкой в начале представления и сдвигает его за число.
+    NOTE: Начальные пробельные символы пропускаются. Используется точный быстрый путь (Clinger),
+          остальные случаи разбираются стандартной библиотекой.
+    @param remaining Указатель на оставшееся представление.
+    @param out_value Указатель на число куда записать результат.
+    @return True если число разобрано, false если в начале представления нет числа.
+*/
+KAPI bool string_view_parse_f64(kstring_view* remaining, f64* out_value);
+
+/*
+    @brief Разбирает 32-bit число с плавающей точкой в начале представления и сдвигает его за число.
+    NOTE: Начальные пробельные символы пропускаются.
+    @param remaining Указатель на оставшееся представление.
+    @param out_value Указатель на число куда записать результат.
+    @return True если число разобрано, false если в начале представления нет числа.
+*/
+KAPI bool string_view_parse_f32(kstring_view* remaining, f32* out_value);
+
+/*
+    @brief Разбирает 64-bit целочисленное число со знаком в начале представления и сдвигает его за число.
+    NOTE: Начальные пробельные символы пропускаются.
+    @param remaining Указатель на оставшееся представление.
+    @param out_value Указатель на число куда записать результат.
+    @return True если число разобрано, false если в начале представления нет числа или оно переполнено.
+*/
+KAPI bool string_view_parse_i64(kstring_view* remaining, i64* out_value);
+
+/*
+    @brief Разбирает 64-bit целочисленное число без знака в начале представления и сдвигает его за число.
+    NOTE: Начальные пробельные символы пропускаются.
+    @param remaining Указатель на оставшееся представление.
+    @param out_value Указатель на число куда записать результат.
+    @return True если число разобрано, false если в начале представления нет числа или оно переполнено.
+*/
+KAPI bool string_view_parse_u64(kstring_view* remaining, u64* out_value);
+
+/*
+    @brief Попытка преобразовать представление полностью в 32-bit число с плавающей точкой.
+    @param view Представление (пробельные символы по краям допускаются).
+    @param out_value Указатель на число куда записать результат.
+    @return True если преобразование прошло успешно, false если не удалось.
+*/
+KAPI bool string_view_to_f32(kstring_view view, f32* out_value);
+
+/*
+    @brief Попытка преобразовать представление полностью в 32-bit целочисленное число со знаком.
+    @param view Представление (пробельные символы по краям допускаются).
+    @param out_value Указатель на число куда записать результат.
+    @return True если преобразование прошло успешно, false если не удалось.
+*/
+KAPI bool string_view_to_i32(kstring_view view, i32* out_value);
+
+/*
+    @brief Попытка преобразовать представление (т.е. "1.0 2.0 3.0 4.0") в вектор.
+    NOTE: Как и 'string_to_vec4', недостающие компоненты равны нулю.
+    @param view Представление. Разделитель - пробельные символы.
+    @param out_vector Указатель на вектор, куда записывать.
+    @return True если прочитана хотя бы одна компонента, false если не удалось.
+*/
+KAPI bool string_view_to_vec4(kstring_view view, vec4* out_vector);
+
+/*
+    @brief Попытка преобразовать представление (т.е. "1.0 2.0 3.0") в вектор.
+    NOTE: Как и 'string_to_vec3', недостающие компоненты равны нулю.
+    @param view Представление. Разделитель - пробельные символы.
+    @param out_vector Указатель на вектор, куда записывать.
+    @return True если прочитана хотя бы одна компонента, false если не удалось.
+*/
+KAPI bool string_view_to_vec3(kstring_view view, vec3* out_vector);
+
+/*
+    @brief Попытка преобразовать представление (т.е. "1.0 2.0") в вектор.
+    NOTE: Как и 'string_to_vec2', недостающие компоненты равны нулю.
+    @param view Представление. Разделитель - пробельные символы.
+    @param out_vector Указатель на вектор, куда записывать.
+    @return True если прочитана хотя бы одна компонента, false если не удалось.
+*/
+KAPI bool string_view_to_vec2(kstring_view view, vec2* out_vector);
+
+/*
+    @brief Инициализирует построчный разбор текстового буфера (например, отображенного в память файла).
+    @param data Указатель на буфер.
+    @param size Размер буфера в байтах.
+    @param out_tokenizer Указатель на структуру разбора.
+*/
+KAPI void string_tokenizer_create(const void* data, u64 size, string_tokenizer* out_tokenizer);
+
+/*
+    @brief Получает очередную строку буфера без символов конца строки ('\n', "\r\n").
+    @param tokenizer Указатель на структуру разбора.
+    @param out_line Указатель на представление куда записать строку.
+    @return True если строка получена, false если буфер закончился.
+*/
+KAPI bool string_tokenizer_next_line(string_tokenizer* tokenizer, kstring_view* out_line);
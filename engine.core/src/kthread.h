@@ -31,6 +31,12 @@
 */
 #define kthread_cancel(thread) platform_thread_cancel(thread)
 
+/*
+    @brief Ожидает завершения работы потока и освобождает его ресурсы.
+    @param thread Поток завершения которого необходимо дождаться.
+*/
+#define kthread_join(thread) platform_thread_join(thread)
+
 /*
     @brief Проверяет активность потока в данный момент.
     @param thread Поток который необходимо проверить.
@@ -44,6 +50,11 @@
 */
 #define kthread_sleep(thread, time_ms) platform_thread_sleep(time_ms)
 
+/*
+    @brief Уступает оставшееся время кванта текущего потока другим готовым потокам.
+*/
+#define kthread_yield() platform_thread_yield()
+
 /*
     @brief Получает идентификатор потока.
 */
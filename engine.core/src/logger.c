@@ -4,10 +4,17 @@
 // Внутренние подключения.
 #include "platform/console.h"
 #include "platform/string.h"
+#include "platform/memory.h"
+#include "platform/thread.h"
+#include "platform/semaphore.h"
+#include "platform/file.h"
 #include "debug/assert.h"
+#include "kstring.h"
 
 // Внешние подключения.
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 
 // Функиця обработки сообщения по умолчанию, message игнорируется, но функция использует buffer напрямую.
 void log_output_default_hook(log_level level, const char* message);
@@ -18,38 +25,400 @@ void log_output_default_hook(log_level level, const char* message);
 // Отступ в буфере данных в байтах.
 #define LOG_BUFFER_OFFSET 8
 
+// Выравнивание записей в буфере потока в байтах.
+#define LOG_RECORD_ALIGNMENT 8
+
+// Уровень записи-заполнителя до конца кольцевого буфера.
+#define LOG_RECORD_PADDING 0xff
+
+// Время ожидания продвижения вывода сообщений в миллисекундах (logger_flush, logger_shutdown, заполненный буфер).
+#define LOG_FLUSH_TIMEOUT_MS 1000
+
+// Сигнатура двоичного журнала ('KLOG').
+#define LOG_BINARY_MAGIC 0x474f4c4b
+
+// Версия формата двоичного журнала.
+#define LOG_BINARY_VERSION 1
+
+// Размер раздела строк формата двоичного журнала в байтах.
+#define LOG_BINARY_STRINGS_SIZE (1 MiB)
+
+// Размер таблицы поиска строк формата (степень двойки, больше количества строк формата).
+#define LOG_BINARY_FORMAT_TABLE_SIZE 8192
+
 /*
-    Буфер сообщений.
-    TODO: Заменить на многопоточный вариант.
+    Буфер сообщений потока (синхронный вывод и форматирование в потоке вывода).
+    NOTE: У каждого потока свой буфер, поэтому одновременные вызовы из разных потоков не портят сообщения.
+          Выровнен, т.к. используется и для сборки записей сообщений.
 */
-static char buffer[LOG_BUFFER_SIZE];
+static _Thread_local char buffer[LOG_BUFFER_SIZE] __attribute__((aligned(LOG_RECORD_ALIGNMENT)));
 
 // Указатель на функцию в которую будет передаваться сообщение.
 static PFN_console_write log_output_hook = log_output_default_hook;
 
-void log_output(log_level level, const char* message, ...)
+// Типы аргументов строки формата.
+typedef enum log_arg_type {
+    // Аргумента нет ('%%' или нераспознанная спецификация).
+    LOG_ARG_NONE,
+    LOG_ARG_INT,
+    LOG_ARG_UINT,
+    LOG_ARG_CHAR,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_STRING,
+    LOG_ARG_POINTER,
+    // Аргумент '%n' пропускается.
+    LOG_ARG_SKIP
+} log_arg_type;
+
+// Спецификация преобразования строки формата.
+typedef struct log_spec {
+    // Длина спецификации от '%' включительно.
+    u32 length;
+    // Длина части спецификации до модификатора длины (флаги, ширина, точность).
+    u32 prefix_length;
+    // Количество '*' в ширине и точности (каждая забирает аргумент int).
+    u32 star_count;
+    // Модификатор длины: 0, 'H' (hh), 'h', 'l', 'q' (ll), 'L', 'z', 'j', 't'.
+    char modifier;
+    // Символ преобразования.
+    char conversion;
+    log_arg_type type;
+} log_spec;
+
+/*
+    Заголовок записи сообщения. За ним следуют копия строки формата (только если format равен null) и аргументы,
+    каждые выровнены по LOG_RECORD_ALIGNMENT.
+*/
+typedef struct log_record {
+    // Полный размер записи в байтах (выровнен).
+    u32 size;
+    // Уровень сообщения или LOG_RECORD_PADDING.
+    u16 level;
+    // Длина копии строки формата без завершающего нуля (0 если строка формата не копируется).
+    u16 format_length;
+    // Глобальный порядковый номер сообщения (для упорядочивания сообщений разных потоков).
+    u64 sequence;
+    // Строка формата со статическим временем жизни (идентификатор места вызова), null если строка скопирована в запись.
+    const char* format;
+} log_record;
+
+/*
+    Заголовок двоичного журнала. За ним следуют раздел строк формата и кольцевой буфер записей.
+    Строка формата хранится как u32 длина, символы и завершающий ноль (выровнено по LOG_RECORD_ALIGNMENT),
+    ее идентификатор - смещение в разделе строк.
+*/
+typedef struct log_binary_header {
+    u32 magic;
+    u32 version;
+    // Смещение и размер раздела строк формата от начала файла.
+    u64 strings_offset;
+    u64 strings_size;
+    // Занято байт в разделе строк.
+    u64 strings_used;
+    // Смещение и размер кольцевого буфера записей от начала файла (степень двойки).
+    u64 ring_offset;
+    u64 ring_size;
+    // Начало самой старой записи и конец последней записи в байтах (монотонно растут).
+    u64 ring_head;
+    u64 ring_tail;
+} log_binary_header;
+
+// Запись двоичного журнала. За ней следуют аргументы в том же виде, что и в записи сообщения.
+typedef struct log_binary_record {
+    // Полный размер записи в байтах (выровнен).
+    u32 size;
+    // Уровень сообщения или LOG_RECORD_PADDING.
+    u16 level;
+    u16 reserved;
+    // Идентификатор строки формата, INVALID_ID если раздел строк заполнен.
+    u32 format_id;
+    // Размер аргументов в байтах.
+    u32 args_size;
+    // Глобальный порядковый номер сообщения.
+    u64 sequence;
+} log_binary_record;
+
+typedef struct log_thread {
+    // Кольцевой буфер записей (пишет только поток-владелец, читает только поток вывода).
+    u8* data;
+    // Записано байт (атомарно, поток-владелец).
+    u64 write_index;
+    // Прочитано байт (атомарно, поток вывода).
+    u64 read_index;
+    // Буфер занят потоком (атомарно).
+    bool owned;
+} log_thread;
+
+typedef struct logger_state {
+    logger_config config;
+    log_thread* threads;
+    // Количество когда-либо занятых буферов (буферы дальше не использовались и не просматриваются).
+    u32 thread_count;
+    u64 sequence;
+    // Порядковый номер следующего выводимого сообщения (только поток вывода).
+    u64 output_sequence;
+    // Поток вывода.
+    thread flusher;
+    // Семафор пробуждения потока вывода (при остановке и ожидании вывода).
+    semaphore flusher_wake;
+    // Семафор оповещения ожидающих потоков о выводе сообщений (сигналится по разу на каждый ожидающий поток).
+    semaphore flusher_progress;
+    // Количество потоков, ожидающих оповещения о выводе сообщений.
+    u32 progress_waiters;
+    bool running;
+    // Файл журнала (null если не используется).
+    file* log_file;
+    // Пакет отформатированных сообщений для вывода в консоль и файл.
+    char* batch;
+    u64 batch_length;
+    log_level batch_level;
+    // Отображение двоичного журнала (null если не используется).
+    file_mapping binary_mapping;
+    log_binary_header* binary;
+    // Таблица поиска идентификаторов строк формата по хешу строки (INVALID_ID - свободно).
+    u32* format_table;
+} logger_state;
+
+static logger_state* state_ptr = null;
+
+// NOTE: Поколение логгера, чтобы кэш потока не ссылался на память предыдущего запуска.
+static u32 state_generation = 0;
+static _Thread_local log_thread* local_thread = null;
+static _Thread_local u32 local_generation = 0;
+// NOTE: Поток вывода не использует буфер, чтобы не ожидать освобождения места самим собой.
+static _Thread_local bool local_flusher = false;
+
+static void log_output_va(log_level level, const char* message, bool static_format, va_list args);
+static void log_output_sync(log_level level, const char* message, va_list args);
+static bool log_record_push(log_thread* thread, log_level level, const char* message, bool static_format, va_list args);
+static log_thread* log_thread_get();
+static bool log_thread_wait(log_thread* thread, u64 required);
+static u32 log_flusher_run(void* params);
+static bool log_flusher_process(logger_state* state, bool strict);
+static bool log_threads_drained(logger_state* state);
+static bool log_thread_has_space(logger_state* state, log_thread* thread, u64 required);
+static bool log_progress_wait(logger_state* state, log_thread* thread, u64 required);
+static u64 log_args_format(const char* format, const u8* data, u64 args_size, char* dest, u64 dest_size);
+
+bool logger_initialize(u64* memory_requirement, void* memory, logger_config* config)
 {
-    // Проверяет наличие указателя на функцию вывода.
-    if(log_output_hook)
+    if(state_ptr)
     {
-        // Получение указателя на аргументы строки формата.
-        __builtin_va_list args;
-        va_start(args, message);
+        kwarng("Function '%s' was called more than once! Return false!", __FUNCTION__);
+        return false;
+    }
 
-        // Запись отформатированной строки в буфер.
-        i32 length = platform_string_format_va(&buffer[LOG_BUFFER_OFFSET], LOG_BUFFER_SIZE - LOG_BUFFER_OFFSET, message, args);
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config. Return false!", __FUNCTION__);
+        return false;
+    }
 
-        // Завершение работы с аргументами.
-        va_end(args);
+    if(!config->max_thread_count || config->thread_buffer_size < LOG_BUFFER_SIZE + 1
+    || (config->thread_buffer_size & (config->thread_buffer_size - 1)))
+    {
+        kerror(
+            "Function '%s': config.max_thread_count must be greater then zero, "
+            "thread_buffer_size must be power of two greater then %u. Return false!", __FUNCTION__, LOG_BUFFER_SIZE
+        );
+        return false;
+    }
 
-        // Запись строки \n\0, но пишется как "\n" в которой символ \0 вставляется компилятором автоматически.
-        KCOPY2BYTES(&buffer[LOG_BUFFER_OFFSET + length], "\n");
+    if(config->binary_file_path && (config->binary_ring_size < 2 * (LOG_BUFFER_SIZE + 1)
+    || (config->binary_ring_size & (config->binary_ring_size - 1))))
+    {
+        kerror(
+            "Function '%s': config.binary_ring_size must be power of two not less then %u. Return false!",
+            __FUNCTION__, 2 * (LOG_BUFFER_SIZE + 1)
+        );
+        return false;
+    }
+
+    u64 state_requirement = sizeof(logger_state);
+    u64 threads_requirement = sizeof(log_thread) * config->max_thread_count;
+    u64 buffers_requirement = (u64)config->thread_buffer_size * config->max_thread_count;
+    u64 batch_requirement = get_aligned(LOG_BUFFER_SIZE, LOG_RECORD_ALIGNMENT);
+    u64 format_table_requirement = config->binary_file_path ? sizeof(u32) * LOG_BINARY_FORMAT_TABLE_SIZE : 0;
+    *memory_requirement = state_requirement + threads_requirement + buffers_requirement + batch_requirement
+                        + format_table_requirement;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    platform_memory_zero(memory, state_requirement + threads_requirement);
+    logger_state* state = memory;
+    state->config = *config;
+    state->threads = (void*)((u8*)state + state_requirement);
+
+    u8* buffers = (u8*)state->threads + threads_requirement;
+    for(u32 i = 0; i < config->max_thread_count; ++i)
+    {
+        state->threads[i].data = &buffers[(u64)i * config->thread_buffer_size];
+    }
+
+    state->batch = (char*)(buffers + buffers_requirement);
+
+    if(config->binary_file_path)
+    {
+        u64 file_size = sizeof(log_binary_header) + LOG_BINARY_STRINGS_SIZE + config->binary_ring_size;
+
+        if(platform_file_map_writable(config->binary_file_path, file_size, &state->binary_mapping))
+        {
+            state->binary = (log_binary_header*)state->binary_mapping.data;
+            state->binary->magic = LOG_BINARY_MAGIC;
+            state->binary->version = LOG_BINARY_VERSION;
+            state->binary->strings_offset = sizeof(log_binary_header);
+            state->binary->strings_size = LOG_BINARY_STRINGS_SIZE;
+            state->binary->ring_offset = sizeof(log_binary_header) + LOG_BINARY_STRINGS_SIZE;
+            state->binary->ring_size = config->binary_ring_size;
+
+            state->format_table = (u32*)(state->batch + batch_requirement);
+            platform_memory_set(state->format_table, format_table_requirement, 0xff);
+        }
+        else
+        {
+            kwarng("Function '%s': Unable to create binary log '%s', using text output.", __FUNCTION__, config->binary_file_path);
+        }
+    }
+
+    if(config->file_path && !platform_file_open(config->file_path, FILE_MODE_WRITE, &state->log_file))
+    {
+        kwarng("Function '%s': Unable to open log file '%s', logging to console only.", __FUNCTION__, config->file_path);
+        state->log_file = null;
+    }
+
+    if(!platform_semaphore_create(0, &state->flusher_wake) || !platform_semaphore_create(0, &state->flusher_progress))
+    {
+        kerror("Function '%s': Failed to create log flusher semaphore. Return false!", __FUNCTION__);
+        if(state->flusher_wake.internal_data)
+        {
+            platform_semaphore_destroy(&state->flusher_wake);
+        }
+        if(state->log_file)
+        {
+            platform_file_close(state->log_file);
+        }
+        if(state->binary)
+        {
+            platform_file_unmap(&state->binary_mapping);
+        }
+        return false;
+    }
+
+    state->running = true;
+    if(!platform_thread_create(log_flusher_run, state, false, &state->flusher))
+    {
+        kerror("Function '%s': Failed to create log flusher thread. Return false!", __FUNCTION__);
+        platform_semaphore_destroy(&state->flusher_wake);
+        platform_semaphore_destroy(&state->flusher_progress);
+        if(state->log_file)
+        {
+            platform_file_close(state->log_file);
+        }
+        if(state->binary)
+        {
+            platform_file_unmap(&state->binary_mapping);
+        }
+        return false;
+    }
+
+    state_generation++;
+    __atomic_store_n(&state_ptr, state, __ATOMIC_RELEASE);
+    return true;
+}
+
+void logger_shutdown()
+{
+    logger_state* state = __atomic_exchange_n(&state_ptr, null, __ATOMIC_ACQ_REL);
+    if(!state)
+    {
+        return;
+    }
+
+    // Поток вывода пробуждается и выводит все накопленные сообщения перед завершением.
+    __atomic_store_n(&state->running, false, __ATOMIC_RELEASE);
+    platform_semaphore_signal(&state->flusher_wake);
+    platform_thread_join(&state->flusher);
+    platform_semaphore_destroy(&state->flusher_wake);
+    platform_semaphore_destroy(&state->flusher_progress);
+
+    if(state->log_file)
+    {
+        platform_file_close(state->log_file);
+        state->log_file = null;
+    }
+
+    if(state->binary)
+    {
+        platform_file_unmap(&state->binary_mapping);
+        state->binary = null;
+    }
+}
+
+void logger_flush()
+{
+    logger_state* state = __atomic_load_n(&state_ptr, __ATOMIC_ACQUIRE);
+    if(!state || local_flusher)
+    {
+        return;
+    }
+
+    log_progress_wait(state, null, 0);
+}
+
+void logger_thread_release()
+{
+    logger_state* state = __atomic_load_n(&state_ptr, __ATOMIC_ACQUIRE);
+    if(state && local_thread && local_generation == state_generation)
+    {
+        // Запись сообщений в буфер завершена, поток вывода продолжает читать его до освобождения.
+        __atomic_store_n(&local_thread->owned, false, __ATOMIC_RELEASE);
+    }
+
+    local_thread = null;
+    local_generation = 0;
+}
+
+void log_output(log_level level, const char* message, ...)
+{
+    __builtin_va_list args;
+    va_start(args, message);
+    log_output_va(level, message, false, args);
+    va_end(args);
+}
+
+void log_output_static(log_level level, const char* message, ...)
+{
+    __builtin_va_list args;
+    va_start(args, message);
+    log_output_va(level, message, true, args);
+    va_end(args);
+}
+
+static void log_output_va(log_level level, const char* message, bool static_format, va_list args)
+{
+    // Фатальные сообщения выводятся синхронно после всех накопленных, т.к. следом идет остановка программы.
+    if(level == LOG_LEVEL_FATAL)
+    {
+        logger_flush();
+        log_output_sync(level, message, args);
+    }
+    else if(log_output_hook)
+    {
+        log_thread* thread = log_thread_get();
 
-        // Отправка вывода буфера в заданную функцию.
-        log_output_hook(level, &buffer[LOG_BUFFER_OFFSET]);
+        // NOTE: Копия аргументов, т.к. при неудачной записи в буфер сообщение выводится синхронно.
+        __builtin_va_list args_copy;
+        va_copy(args_copy, args);
 
-        // Очистка буфера.
-        buffer[0] = '\0';
+        if(!thread || !log_record_push(thread, level, message, static_format, args_copy))
+        {
+            log_output_sync(level, message, args);
+        }
+
+        va_end(args_copy);
     }
 
     // Вызывает остановку программы, в случае фатальной ошибки. Используется для отладки программы.
@@ -59,6 +428,28 @@ void log_output(log_level level, const char* message, ...)
     }
 }
 
+static void log_output_sync(log_level level, const char* message, va_list args)
+{
+    // Проверяет наличие указателя на функцию вывода.
+    if(!log_output_hook)
+    {
+        return;
+    }
+
+    // Запись отформатированной строки в буфер.
+    i32 length = platform_string_format_va(&buffer[LOG_BUFFER_OFFSET], LOG_BUFFER_SIZE - LOG_BUFFER_OFFSET - 1, message, args);
+    length = KCLAMP(length, 0, LOG_BUFFER_SIZE - LOG_BUFFER_OFFSET - 2);
+
+    // Запись строки \n\0, но пишется как "\n" в которой символ \0 вставляется компилятором автоматически.
+    KCOPY2BYTES(&buffer[LOG_BUFFER_OFFSET + length], "\n");
+
+    // Отправка вывода буфера в заданную функцию.
+    log_output_hook(level, &buffer[LOG_BUFFER_OFFSET]);
+
+    // Очистка буфера.
+    buffer[0] = '\0';
+}
+
 void log_output_default_hook(log_level level, const char* message)
 {
     // Текстовые метки сообщений в соответствии с уровнем.
@@ -100,3 +491,880 @@ void report_assertion_failure(const char* expression, const char* message, const
 {
     log_output(LOG_LEVEL_FATAL, "Assertion failure: %s, message: '%s' in %s:%d", expression, message, file, line);
 }
+
+// Разбирает спецификацию преобразования, format указывает на символ '%'.
+static void log_spec_parse(const char* format, log_spec* out_spec)
+{
+    const char* c = format + 1;
+    out_spec->star_count = 0;
+    out_spec->modifier = 0;
+    out_spec->type = LOG_ARG_NONE;
+
+    // Флаги.
+    while(*c == '-' || *c == '+' || *c == ' ' || *c == '#' || *c == '0' || *c == '\'')
+    {
+        c++;
+    }
+
+    // Ширина.
+    if(*c == '*')
+    {
+        out_spec->star_count++;
+        c++;
+    }
+    while(*c >= '0' && *c <= '9') c++;
+
+    // Точность.
+    if(*c == '.')
+    {
+        c++;
+        if(*c == '*')
+        {
+            out_spec->star_count++;
+            c++;
+        }
+        while(*c >= '0' && *c <= '9') c++;
+    }
+
+    out_spec->prefix_length = c - format;
+
+    // Модификатор длины.
+    switch(*c)
+    {
+        case 'h':
+            c++;
+            out_spec->modifier = 'h';
+            if(*c == 'h')
+            {
+                c++;
+                out_spec->modifier = 'H';
+            }
+            break;
+        case 'l':
+            c++;
+            out_spec->modifier = 'l';
+            if(*c == 'l')
+            {
+                c++;
+                out_spec->modifier = 'q';
+            }
+            break;
+        case 'L': case 'z': case 'j': case 't':
+            out_spec->modifier = *c++;
+            break;
+        default:
+            break;
+    }
+
+    out_spec->conversion = *c;
+
+    switch(*c)
+    {
+        case 'd': case 'i':
+            out_spec->type = LOG_ARG_INT;
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            out_spec->type = LOG_ARG_UINT;
+            break;
+        case 'c':
+            out_spec->type = LOG_ARG_CHAR;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            out_spec->type = LOG_ARG_DOUBLE;
+            break;
+        case 's':
+            out_spec->type = LOG_ARG_STRING;
+            break;
+        case 'p':
+            out_spec->type = LOG_ARG_POINTER;
+            break;
+        case 'n':
+            out_spec->type = LOG_ARG_SKIP;
+            break;
+        default:
+            // '%%' или неизвестная спецификация выводятся как есть.
+            out_spec->star_count = 0;
+            break;
+    }
+
+    if(*c)
+    {
+        c++;
+    }
+
+    out_spec->length = c - format;
+}
+
+// Записывает аргумент в запись, возвращает новое смещение или 0, если не хватает места.
+static u64 log_record_write_value(u8* record, u64 offset, u64 capacity, const void* value)
+{
+    if(offset + sizeof(u64) > capacity)
+    {
+        return 0;
+    }
+
+    platform_memory_copy(record + offset, value, sizeof(u64));
+    return offset + sizeof(u64);
+}
+
+// Возвращает строку формата записи сообщения.
+static const char* log_record_format(const log_record* record)
+{
+    return record->format ? record->format : (const char*)record + sizeof(log_record);
+}
+
+// Возвращает смещение аргументов от начала записи сообщения.
+static u64 log_record_args_offset(const log_record* record)
+{
+    return record->format ? sizeof(log_record) : get_aligned(sizeof(log_record) + record->format_length + 1, LOG_RECORD_ALIGNMENT);
+}
+
+static bool log_record_push(log_thread* thread, log_level level, const char* message, bool static_format, va_list args)
+{
+    // NOTE: Запись собирается в буфере потока (без форматирования), затем копируется в кольцевой буфер.
+    u8* record = (u8*)buffer;
+    u64 capacity = LOG_BUFFER_SIZE;
+
+    log_record* header = (log_record*)record;
+    header->level = level;
+
+    // Строка формата со статическим временем жизни не копируется, в запись попадает только ее адрес.
+    if(static_format)
+    {
+        header->format = message;
+        header->format_length = 0;
+    }
+    else
+    {
+        u64 format_length = platform_string_length(message);
+        if(format_length > 0xfffe || sizeof(log_record) + format_length + 1 > capacity / 2)
+        {
+            return false;
+        }
+
+        header->format = null;
+        header->format_length = format_length;
+        platform_memory_copy(record + sizeof(log_record), message, format_length + 1);
+    }
+
+    u64 offset = log_record_args_offset(header);
+
+    // Копирование аргументов в порядке спецификаций строки формата.
+    for(const char* c = message; *c; ++c)
+    {
+        if(*c != '%')
+        {
+            continue;
+        }
+
+        log_spec spec;
+        log_spec_parse(c, &spec);
+        c += spec.length - 1;
+
+        for(u32 i = 0; i < spec.star_count; ++i)
+        {
+            i64 star = va_arg(args, i32);
+            if(!(offset = log_record_write_value(record, offset, capacity, &star))) return false;
+        }
+
+        switch(spec.type)
+        {
+            case LOG_ARG_INT: {
+                i64 value;
+                switch(spec.modifier)
+                {
+                    case 'H': value = (signed char)va_arg(args, i32); break;
+                    case 'h': value = (short)va_arg(args, i32);       break;
+                    case 'l': value = va_arg(args, long);             break;
+                    case 'q': value = va_arg(args, long long);        break;
+                    case 'z': value = va_arg(args, ptrdiff_t);        break;
+                    case 'j': value = va_arg(args, intmax_t);         break;
+                    case 't': value = va_arg(args, ptrdiff_t);        break;
+                    default:  value = va_arg(args, i32);              break;
+                }
+                if(!(offset = log_record_write_value(record, offset, capacity, &value))) return false;
+            } break;
+            case LOG_ARG_UINT: {
+                u64 value;
+                switch(spec.modifier)
+                {
+                    case 'H': value = (unsigned char)va_arg(args, u32);  break;
+                    case 'h': value = (unsigned short)va_arg(args, u32); break;
+                    case 'l': value = va_arg(args, unsigned long);       break;
+                    case 'q': value = va_arg(args, unsigned long long);  break;
+                    case 'z': value = va_arg(args, size_t);              break;
+                    case 'j': value = va_arg(args, uintmax_t);           break;
+                    case 't': value = va_arg(args, size_t);              break;
+                    default:  value = va_arg(args, u32);                 break;
+                }
+                if(!(offset = log_record_write_value(record, offset, capacity, &value))) return false;
+            } break;
+            case LOG_ARG_CHAR: {
+                i64 value = va_arg(args, i32);
+                if(!(offset = log_record_write_value(record, offset, capacity, &value))) return false;
+            } break;
+            case LOG_ARG_DOUBLE: {
+                f64 value = spec.modifier == 'L' ? (f64)va_arg(args, long double) : va_arg(args, f64);
+                if(!(offset = log_record_write_value(record, offset, capacity, &value))) return false;
+            } break;
+            case LOG_ARG_POINTER:
+            case LOG_ARG_SKIP: {
+                void* value = va_arg(args, void*);
+                if(!(offset = log_record_write_value(record, offset, capacity, &value))) return false;
+            } break;
+            case LOG_ARG_STRING: {
+                // Строка копируется целиком: к моменту вывода исходная память может быть освобождена.
+                const char* str = va_arg(args, const char*);
+                if(!str) str = "(null)";
+                u64 length = platform_string_length(str);
+
+                // Длинные строки усекаются, чтобы запись поместилась в буфер.
+                u64 available = capacity - offset;
+                if(available < sizeof(u64) + 1)
+                {
+                    return false;
+                }
+                if(length > available - sizeof(u64) - 1)
+                {
+                    length = available - sizeof(u64) - 1;
+                }
+
+                u64 stored_length = length;
+                platform_memory_copy(record + offset, &stored_length, sizeof(u64));
+                platform_memory_copy(record + offset + sizeof(u64), str, length);
+                record[offset + sizeof(u64) + length] = '\0';
+                offset = get_aligned(offset + sizeof(u64) + length + 1, LOG_RECORD_ALIGNMENT);
+                if(offset > capacity) return false;
+            } break;
+            case LOG_ARG_NONE:
+                break;
+        }
+    }
+
+    header->size = offset;
+
+    logger_state* state = __atomic_load_n(&state_ptr, __ATOMIC_ACQUIRE);
+    if(!state)
+    {
+        return false;
+    }
+
+    u64 size = state->config.thread_buffer_size;
+    u64 write_index = thread->write_index;
+    u64 tail = size - (write_index & (size - 1));
+
+    // Запись не помещается до конца буфера: остаток заполняется записью-заполнителем.
+    if(header->size > tail)
+    {
+        if(!log_thread_wait(thread, tail))
+        {
+            return false;
+        }
+
+        log_record* padding = (log_record*)&thread->data[write_index & (size - 1)];
+        padding->size = tail;
+        padding->level = LOG_RECORD_PADDING;
+        write_index += tail;
+        __atomic_store_n(&thread->write_index, write_index, __ATOMIC_RELEASE);
+    }
+
+    if(!log_thread_wait(thread, header->size))
+    {
+        return false;
+    }
+
+    header->sequence = __atomic_fetch_add(&state->sequence, 1, __ATOMIC_RELAXED);
+    platform_memory_copy(&thread->data[write_index & (size - 1)], record, header->size);
+    __atomic_store_n(&thread->write_index, write_index + header->size, __ATOMIC_RELEASE);
+
+    // Поток вывода уже завершает работу и ожидает пропущенные номера.
+    if(!__atomic_load_n(&state->running, __ATOMIC_ACQUIRE))
+    {
+        platform_semaphore_signal(&state->flusher_wake);
+    }
+
+    buffer[0] = '\0';
+    return true;
+}
+
+// Ожидает освобождения места в кольцевом буфере потока (освобождает поток вывода).
+static bool log_thread_wait(log_thread* thread, u64 required)
+{
+    logger_state* state = __atomic_load_n(&state_ptr, __ATOMIC_ACQUIRE);
+    if(!state)
+    {
+        return false;
+    }
+
+    return log_thread_has_space(state, thread, required) || log_progress_wait(state, thread, required);
+}
+
+static bool log_thread_has_space(logger_state* state, log_thread* thread, u64 required)
+{
+    u64 used = thread->write_index - __atomic_load_n(&thread->read_index, __ATOMIC_ACQUIRE);
+    return state->config.thread_buffer_size - used >= required;
+}
+
+/*
+    Ожидает освобождения места в буфере потока (или вывода всех сообщений, если thread равен null).
+    NOTE: Поток вывода оповещает ожидающих после каждого прохода с выводом сообщений, поэтому ожидание
+          прерывается, только если вывод не продвинулся за LOG_FLUSH_TIMEOUT_MS.
+          Ожидающий регистрируется до проверки условия, поэтому оповещение не теряется.
+*/
+static bool log_progress_wait(logger_state* state, log_thread* thread, u64 required)
+{
+    __atomic_fetch_add(&state->progress_waiters, 1, __ATOMIC_ACQ_REL);
+
+    bool result = true;
+    while(thread ? !log_thread_has_space(state, thread, required) : !log_threads_drained(state))
+    {
+        platform_semaphore_signal(&state->flusher_wake);
+        if(!platform_semaphore_wait(&state->flusher_progress, LOG_FLUSH_TIMEOUT_MS))
+        {
+            result = false;
+            break;
+        }
+    }
+
+    __atomic_fetch_sub(&state->progress_waiters, 1, __ATOMIC_ACQ_REL);
+    return result;
+}
+
+static log_thread* log_thread_get()
+{
+    logger_state* state = __atomic_load_n(&state_ptr, __ATOMIC_ACQUIRE);
+    if(!state || local_flusher)
+    {
+        return null;
+    }
+
+    if(local_generation == state_generation)
+    {
+        return local_thread;
+    }
+
+    // Регистрация потока при первом сообщении: занимается первый свободный буфер.
+    local_generation = state_generation;
+    local_thread = null;
+
+    for(u32 i = 0; i < state->config.max_thread_count; ++i)
+    {
+        bool expected = false;
+        if(!__atomic_compare_exchange_n(&state->threads[i].owned, &expected, true, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            continue;
+        }
+
+        u32 count = __atomic_load_n(&state->thread_count, __ATOMIC_ACQUIRE);
+        while(count <= i && !__atomic_compare_exchange_n(&state->thread_count, &count, i + 1, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+        local_thread = &state->threads[i];
+        break;
+    }
+
+    return local_thread;
+}
+
+// Форматирует сообщение по строке формата и скопированным аргументам в буфер назначения, возвращает длину.
+static u64 log_args_format(const char* format, const u8* data, u64 args_size, char* dest, u64 dest_size)
+{
+    u64 offset = 0;
+    u64 length = 0;
+
+    #define LOG_DEST_REMAINING() (length < dest_size ? dest_size - length : 0)
+    #define LOG_FORMAT_VALUE(value)                                                                                   \
+        (star_count == 0 ? platform_string_format(&dest[length], LOG_DEST_REMAINING(), spec_format, value)            \
+        : star_count == 1 ? platform_string_format(&dest[length], LOG_DEST_REMAINING(), spec_format, stars[0], value) \
+        : platform_string_format(&dest[length], LOG_DEST_REMAINING(), spec_format, stars[0], stars[1], value))
+
+    for(const char* c = format; *c && length + 1 < dest_size; ++c)
+    {
+        if(*c != '%')
+        {
+            dest[length++] = *c;
+            continue;
+        }
+
+        log_spec spec;
+        log_spec_parse(c, &spec);
+
+        if(spec.type == LOG_ARG_NONE)
+        {
+            // '%%' выводится как '%', неизвестная спецификация - как есть.
+            if(spec.conversion == '%')
+            {
+                dest[length++] = '%';
+            }
+            else
+            {
+                for(u32 i = 0; i < spec.length && length + 1 < dest_size; ++i)
+                {
+                    dest[length++] = c[i];
+                }
+            }
+
+            c += spec.length - 1;
+            continue;
+        }
+
+        // NOTE: Аргументов меньше, чем спецификаций (поврежденная запись двоичного журнала).
+        if(offset + sizeof(u64) * (spec.star_count + 1) > args_size)
+        {
+            break;
+        }
+
+        i32 stars[2] = {0};
+        u32 star_count = spec.star_count;
+        for(u32 i = 0; i < star_count; ++i)
+        {
+            i64 star;
+            platform_memory_copy(&star, data + offset, sizeof(i64));
+            stars[i] = (i32)star;
+            offset += sizeof(u64);
+        }
+
+        // Спецификация для одного аргумента: целые выводятся как 64-битные, остальные без модификатора длины.
+        char spec_format[64];
+        u32 prefix_length = KMIN(spec.prefix_length, sizeof(spec_format) - 4);
+        platform_memory_copy(spec_format, c, prefix_length);
+        u32 spec_length = prefix_length;
+
+        if(spec.type == LOG_ARG_INT || spec.type == LOG_ARG_UINT)
+        {
+            spec_format[spec_length++] = 'l';
+            spec_format[spec_length++] = 'l';
+        }
+
+        spec_format[spec_length++] = spec.conversion;
+        spec_format[spec_length] = '\0';
+
+        i32 written = 0;
+        switch(spec.type)
+        {
+            case LOG_ARG_INT: {
+                long long value;
+                platform_memory_copy(&value, data + offset, sizeof(u64));
+                offset += sizeof(u64);
+                written = LOG_FORMAT_VALUE(value);
+            } break;
+            case LOG_ARG_UINT: {
+                unsigned long long value;
+                platform_memory_copy(&value, data + offset, sizeof(u64));
+                offset += sizeof(u64);
+                written = LOG_FORMAT_VALUE(value);
+            } break;
+            case LOG_ARG_CHAR: {
+                i64 value;
+                platform_memory_copy(&value, data + offset, sizeof(u64));
+                offset += sizeof(u64);
+                written = LOG_FORMAT_VALUE((i32)value);
+            } break;
+            case LOG_ARG_DOUBLE: {
+                f64 value;
+                platform_memory_copy(&value, data + offset, sizeof(u64));
+                offset += sizeof(u64);
+                written = LOG_FORMAT_VALUE(value);
+            } break;
+            case LOG_ARG_POINTER: {
+                void* value;
+                platform_memory_copy(&value, data + offset, sizeof(u64));
+                offset += sizeof(u64);
+                written = LOG_FORMAT_VALUE(value);
+            } break;
+            case LOG_ARG_SKIP:
+                offset += sizeof(u64);
+                break;
+            case LOG_ARG_STRING: {
+                u64 str_length;
+                platform_memory_copy(&str_length, data + offset, sizeof(u64));
+                if(str_length >= args_size - offset - sizeof(u64))
+                {
+                    break;
+                }
+                const char* value = (const char*)(data + offset + sizeof(u64));
+                offset = get_aligned(offset + sizeof(u64) + str_length + 1, LOG_RECORD_ALIGNMENT);
+                written = LOG_FORMAT_VALUE(value);
+            } break;
+            case LOG_ARG_NONE:
+                break;
+        }
+
+        if(written > 0)
+        {
+            length += written;
+        }
+
+        c += spec.length - 1;
+    }
+
+    #undef LOG_FORMAT_VALUE
+    #undef LOG_DEST_REMAINING
+
+    if(length >= dest_size)
+    {
+        length = dest_size - 1;
+    }
+
+    dest[length] = '\0';
+    return length;
+}
+
+// Выводит накопленный пакет сообщений одного уровня в консоль и файл.
+static void log_batch_flush(logger_state* state)
+{
+    if(!state->batch_length)
+    {
+        return;
+    }
+
+    const console_color colors[LOG_LEVELS_MAX] = {
+        CONSOLE_COLOR_BG_RED, CONSOLE_COLOR_FG_RED, CONSOLE_COLOR_FG_YELLOW,
+        CONSOLE_COLOR_FG_GREEN, CONSOLE_COLOR_FG_BLUE, CONSOLE_COLOR_FG_WHITE
+    };
+
+    state->batch[state->batch_length] = '\0';
+
+    if(state->batch_level == LOG_LEVEL_ERROR || state->batch_level == LOG_LEVEL_FATAL)
+    {
+        platform_console_write_error(colors[state->batch_level], state->batch);
+    }
+    else
+    {
+        platform_console_write(colors[state->batch_level], state->batch);
+    }
+
+    if(state->log_file)
+    {
+        platform_file_write(state->log_file, state->batch_length, state->batch);
+    }
+
+    state->batch_length = 0;
+}
+
+// Возвращает идентификатор строки формата двоичного журнала, добавляя строку в раздел строк при первой встрече.
+static u32 log_binary_format_id(logger_state* state, const char* format, u32 format_length)
+{
+    log_binary_header* header = state->binary;
+    u8* strings = (u8*)header + header->strings_offset;
+
+    // NOTE: Строки сравниваются по содержимому, т.к. строка формата может быть не литералом.
+    u32 hash = 2166136261u;
+    for(u32 i = 0; i < format_length; ++i)
+    {
+        hash = (hash ^ (u8)format[i]) * 16777619u;
+    }
+
+    u32 mask = LOG_BINARY_FORMAT_TABLE_SIZE - 1;
+    for(u32 probe = 0, i = hash & mask; probe < LOG_BINARY_FORMAT_TABLE_SIZE; ++probe, i = (i + 1) & mask)
+    {
+        u32 id = state->format_table[i];
+
+        if(id == INVALID_ID)
+        {
+            u64 entry_size = get_aligned(sizeof(u32) + format_length + 1, LOG_RECORD_ALIGNMENT);
+            if(header->strings_used + entry_size > header->strings_size)
+            {
+                return INVALID_ID;
+            }
+
+            id = header->strings_used;
+            platform_memory_copy(strings + id, &format_length, sizeof(u32));
+            platform_memory_copy(strings + id + sizeof(u32), format, format_length + 1);
+            header->strings_used += entry_size;
+            state->format_table[i] = id;
+            return id;
+        }
+
+        u32 length;
+        platform_memory_copy(&length, strings + id, sizeof(u32));
+        if(length == format_length && string_equal((const char*)(strings + id + sizeof(u32)), format))
+        {
+            return id;
+        }
+    }
+
+    return INVALID_ID;
+}
+
+// Записывает сообщение в кольцевой буфер двоичного журнала (самые старые записи перезаписываются).
+static void log_binary_write(logger_state* state, const log_record* record)
+{
+    log_binary_header* header = state->binary;
+    u8* ring = (u8*)header + header->ring_offset;
+    u64 ring_size = header->ring_size;
+
+    const u8* data = (const u8*)record;
+    const char* format = log_record_format(record);
+    u64 args_offset = log_record_args_offset(record);
+    u32 args_size = record->size - args_offset;
+    u32 size = sizeof(log_binary_record) + args_size;
+
+    u64 tail = header->ring_tail;
+    u64 tail_free = ring_size - (tail & (ring_size - 1));
+    u64 required = size > tail_free ? tail_free + size : size;
+
+    while(tail + required - header->ring_head > ring_size)
+    {
+        const log_binary_record* oldest = (const log_binary_record*)&ring[header->ring_head & (ring_size - 1)];
+        header->ring_head += oldest->size;
+    }
+
+    // Запись не помещается до конца буфера: остаток заполняется записью-заполнителем.
+    if(size > tail_free)
+    {
+        log_binary_record* padding = (log_binary_record*)&ring[tail & (ring_size - 1)];
+        padding->size = tail_free;
+        padding->level = LOG_RECORD_PADDING;
+        tail += tail_free;
+    }
+
+    log_binary_record* out = (log_binary_record*)&ring[tail & (ring_size - 1)];
+    out->size = size;
+    out->level = record->level;
+    out->reserved = 0;
+    out->format_id = log_binary_format_id(
+        state, format, record->format ? platform_string_length(format) : record->format_length
+    );
+    out->args_size = args_size;
+    out->sequence = record->sequence;
+    platform_memory_copy((u8*)out + sizeof(log_binary_record), data + args_offset, args_size);
+
+    header->ring_tail = tail + size;
+}
+
+// Выводит одно сообщение: в пакет для стандартного вывода или в пользовательскую функцию.
+static void log_flusher_output(logger_state* state, const log_record* record)
+{
+    log_level level = record->level;
+    PFN_console_write hook = log_output_hook;
+
+    // В двоичном режиме в консоль и текстовый файл дополнительно выводятся только ошибки и предупреждения.
+    if(state->binary)
+    {
+        log_binary_write(state, record);
+
+        if(level > LOG_LEVEL_WARNG)
+        {
+            return;
+        }
+    }
+
+    if(!hook)
+    {
+        return;
+    }
+
+    // Форматирование в буфер потока вывода, с местом под метку уровня.
+    const u8* data = (const u8*)record;
+    u64 args_offset = log_record_args_offset(record);
+    u64 length = log_args_format(
+        log_record_format(record), data + args_offset, record->size - args_offset,
+        &buffer[LOG_BUFFER_OFFSET], LOG_BUFFER_SIZE - LOG_BUFFER_OFFSET - 1
+    );
+    KCOPY2BYTES(&buffer[LOG_BUFFER_OFFSET + length], "\n");
+    length++;
+
+    if(hook != log_output_default_hook)
+    {
+        hook(level, &buffer[LOG_BUFFER_OFFSET]);
+        return;
+    }
+
+    const char* levels[LOG_LEVELS_MAX] = {
+        "[FATAL] ", "[ERROR] ", "[WARNG] ", "[INFOR] ", "[DEBUG] ", "[TRACE] "
+    };
+    KCOPY8BYTES(buffer, levels[level]);
+    length += LOG_BUFFER_OFFSET;
+
+    // Пакет выводится при смене уровня (цвета) или переполнении.
+    if(state->batch_length && (state->batch_level != level || state->batch_length + length >= LOG_BUFFER_SIZE))
+    {
+        log_batch_flush(state);
+    }
+
+    platform_memory_copy(&state->batch[state->batch_length], buffer, length);
+    state->batch_length += length;
+    state->batch_level = level;
+}
+
+/*
+    Выводит все накопленные сообщения всех потоков в порядке их поступления.
+    NOTE: Порядковый номер берется до публикации записи, поэтому запись с меньшим номером может появиться позже.
+          В строгом режиме вывод останавливается на пропуске номера до публикации недостающей записи.
+*/
+static bool log_flusher_process(logger_state* state, bool strict)
+{
+    u32 thread_count = KMIN(__atomic_load_n(&state->thread_count, __ATOMIC_ACQUIRE), state->config.max_thread_count);
+    u64 size = state->config.thread_buffer_size;
+    bool processed = false;
+
+    while(true)
+    {
+        log_thread* next_thread = null;
+        const log_record* next_record = null;
+
+        for(u32 i = 0; i < thread_count; ++i)
+        {
+            log_thread* thread = &state->threads[i];
+            u64 write_index = __atomic_load_n(&thread->write_index, __ATOMIC_ACQUIRE);
+
+            while(thread->read_index < write_index)
+            {
+                const log_record* record = (const log_record*)&thread->data[thread->read_index & (size - 1)];
+
+                if(record->level == LOG_RECORD_PADDING)
+                {
+                    __atomic_store_n(&thread->read_index, thread->read_index + record->size, __ATOMIC_RELEASE);
+                    continue;
+                }
+
+                if(!next_record || record->sequence < next_record->sequence)
+                {
+                    next_record = record;
+                    next_thread = thread;
+                }
+                break;
+            }
+        }
+
+        if(!next_record || (strict && next_record->sequence != state->output_sequence))
+        {
+            break;
+        }
+
+        state->output_sequence = next_record->sequence + 1;
+        log_flusher_output(state, next_record);
+        __atomic_store_n(&next_thread->read_index, next_thread->read_index + next_record->size, __ATOMIC_RELEASE);
+        processed = true;
+    }
+
+    log_batch_flush(state);
+
+    if(processed)
+    {
+        u32 waiters = __atomic_load_n(&state->progress_waiters, __ATOMIC_ACQUIRE);
+        for(u32 i = 0; i < waiters; ++i)
+        {
+            platform_semaphore_signal(&state->flusher_progress);
+        }
+    }
+
+    return processed;
+}
+
+static bool log_threads_drained(logger_state* state)
+{
+    u32 thread_count = KMIN(__atomic_load_n(&state->thread_count, __ATOMIC_ACQUIRE), state->config.max_thread_count);
+
+    for(u32 i = 0; i < thread_count; ++i)
+    {
+        log_thread* thread = &state->threads[i];
+        if(__atomic_load_n(&thread->read_index, __ATOMIC_ACQUIRE) != __atomic_load_n(&thread->write_index, __ATOMIC_ACQUIRE))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static u32 log_flusher_run(void* params)
+{
+    logger_state* state = params;
+    local_flusher = true;
+
+    while(__atomic_load_n(&state->running, __ATOMIC_ACQUIRE))
+    {
+        if(!log_flusher_process(state, true))
+        {
+            platform_semaphore_wait(&state->flusher_wake, state->config.flush_interval_ms);
+        }
+    }
+
+    // Вывод оставшихся сообщений перед завершением: пропуск номера ожидается ограниченное время
+    // (после остановки каждая опубликованная запись пробуждает поток вывода).
+    while(!log_threads_drained(state))
+    {
+        if(!log_flusher_process(state, true) && !platform_semaphore_wait(&state->flusher_wake, LOG_FLUSH_TIMEOUT_MS))
+        {
+            break;
+        }
+    }
+
+    log_flusher_process(state, false);
+    return 0;
+}
+
+bool logger_binary_decode(const char* path, PFN_console_write output)
+{
+    file_mapping mapping;
+    if(!platform_file_map(path, &mapping))
+    {
+        kerror("Function '%s': Unable to open binary log '%s'.", __FUNCTION__, path);
+        return false;
+    }
+
+    const log_binary_header* header = mapping.data;
+    if(mapping.size < sizeof(log_binary_header) || header->magic != LOG_BINARY_MAGIC
+    || header->version != LOG_BINARY_VERSION || header->strings_used > header->strings_size
+    || header->strings_offset + header->strings_size > mapping.size
+    || header->ring_offset + header->ring_size > mapping.size || !header->ring_size
+    || (header->ring_size & (header->ring_size - 1)) || header->ring_tail - header->ring_head > header->ring_size)
+    {
+        kerror("Function '%s': File '%s' is not a valid binary log.", __FUNCTION__, path);
+        platform_file_unmap(&mapping);
+        return false;
+    }
+
+    const u8* strings = (const u8*)header + header->strings_offset;
+    const u8* ring = (const u8*)header + header->ring_offset;
+    u64 ring_size = header->ring_size;
+    PFN_console_write hook = output ? output : log_output_default_hook;
+    bool result = true;
+
+    for(u64 index = header->ring_head; index < header->ring_tail;)
+    {
+        const log_binary_record* record = (const log_binary_record*)&ring[index & (ring_size - 1)];
+        u64 tail_free = ring_size - (index & (ring_size - 1));
+
+        if(record->size < sizeof(u64) || record->size > tail_free || record->size % LOG_RECORD_ALIGNMENT)
+        {
+            kerror("Function '%s': Binary log '%s' is corrupted at offset %llu.", __FUNCTION__, path, index);
+            result = false;
+            break;
+        }
+
+        index += record->size;
+
+        if(record->level == LOG_RECORD_PADDING)
+        {
+            continue;
+        }
+
+        if(record->size < sizeof(log_binary_record) || record->level >= LOG_LEVELS_MAX
+        || record->args_size > record->size - sizeof(log_binary_record))
+        {
+            kerror("Function '%s': Binary log '%s' is corrupted at offset %llu.", __FUNCTION__, path, index);
+            result = false;
+            break;
+        }
+
+        const char* format = "<format string lost>";
+        if(record->format_id != INVALID_ID && record->format_id + sizeof(u32) < header->strings_used)
+        {
+            format = (const char*)(strings + record->format_id + sizeof(u32));
+        }
+
+        u64 length = log_args_format(
+            format, (const u8*)record + sizeof(log_binary_record), record->args_size,
+            &buffer[LOG_BUFFER_OFFSET], LOG_BUFFER_SIZE - LOG_BUFFER_OFFSET - 1
+        );
+        KCOPY2BYTES(&buffer[LOG_BUFFER_OFFSET + length], "\n");
+
+        hook(record->level, &buffer[LOG_BUFFER_OFFSET]);
+    }
+
+    buffer[0] = '\0';
+    platform_file_unmap(&mapping);
+    return result;
+}
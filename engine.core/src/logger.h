@@ -36,8 +36,68 @@ typedef enum log_level {
 // @brief Указатель на функцию обработки сообщения.
 typedef void (*PFN_console_write)(log_level level, const char* message);
 
+// @brief Конфигурация асинхронного вывода сообщений.
+typedef struct logger_config {
+    /*
+        @brief Максимальное количество одновременно работающих потоков с собственными буферами сообщений.
+               Буфер освобождается при завершении потока (см. 'logger_thread_release'), при нехватке
+               буферов сообщения потока выводятся синхронно.
+    */
+    u32 max_thread_count;
+    // @brief Размер кольцевого буфера сообщений одного потока в байтах (степень двойки).
+    u32 thread_buffer_size;
+    // @brief Интервал ожидания потока вывода при отсутствии сообщений в миллисекундах.
+    u32 flush_interval_ms;
+    // @brief Путь к файлу журнала, null если вывод только в консоль.
+    const char* file_path;
+    /*
+        @brief Путь к файлу двоичного журнала, null если не используется. Сообщения записываются в файл,
+               отображенный в память, без форматирования (идентификатор строки формата и аргументы),
+               в консоль и текстовый журнал выводятся только ошибки и предупреждения.
+    */
+    const char* binary_file_path;
+    // @brief Размер кольцевого буфера двоичного журнала в байтах (степень двойки, не меньше 128 KiB).
+    u64 binary_ring_size;
+} logger_config;
+
+/*
+    @brief Запускает асинхронный вывод сообщений: сообщения копируются в буфер потока вместе с аргументами,
+           а форматирование и вывод в консоль и файл выполняет отдельный поток.
+    NOTE: До запуска и после остановки сообщения выводятся синхронно.
+    @param memory_requirement Указатель на переменную для получения требований к памяти.
+    @param memory Указатель на выделенную память, для получения требований к памяти передать null.
+    @param config Указатель на конфигурацию.
+    @return True запущено успешно, false в случае ошибок.
+*/
+KAPI bool logger_initialize(u64* memory_requirement, void* memory, logger_config* config);
+
+/*
+    @brief Останавливает асинхронный вывод сообщений, предварительно выведя все накопленные сообщения.
+*/
+KAPI void logger_shutdown();
+
+/*
+    @brief Ожидает вывода всех накопленных к моменту вызова сообщений.
+*/
+KAPI void logger_flush();
+
+/*
+    @brief Освобождает буфер сообщений текущего потока для других потоков (накопленные сообщения будут выведены).
+    NOTE: Вызывается автоматически при завершении потока, созданного 'platform_thread_create'.
+*/
+KAPI void logger_thread_release();
+
+/*
+    @brief Читает двоичный журнал и передает сообщения в заданную функцию от самого старого к последнему.
+    @param path Указатель на строку пути к файлу двоичного журнала.
+    @param output Указатель на функцию обработки сообщения, null для вывода в консоль.
+    @return True журнал прочитан полностью, false файл не найден или поврежден.
+*/
+KAPI bool logger_binary_decode(const char* path, PFN_console_write output);
+
 /*
     @brief Задает указатель на пользовательскую функцию обработки сообщения. По умолчанию выводит в консоль.
+    NOTE: При асинхронном выводе функция вызывается из потока вывода.
     @param hook Указатель на функцию обработки сообщения. Для отбрасывания сообщений установить в 'null'.
 */
 KAPI void log_output_set_custom_hook(PFN_console_write hook);
@@ -55,12 +115,33 @@ KAPI void log_output_set_default_hook();
 */
 KAPI void log_output(log_level level, const char* message, ...);
 
+/*
+    @brief Функция отправки сообщения, строка формата которого имеет статическое время жизни (строковый литерал).
+    NOTE: Строка формата не копируется в запись сообщения, вместо нее передается адрес, служащий идентификатором
+          места вызова. Используется через klog и макросы уровней.
+    @param level Уровень логирования.
+    @param message Строка форматирования со статическим временем жизни.
+    @param ... Аргументы строки форматирования.
+*/
+KAPI void log_output_static(log_level level, const char* message, ...);
+
+/*
+    @brief Отправляет сообщение с заданным уровнем в логи, для строковых литералов без копирования строки формата.
+    NOTE: __builtin_constant_p истинно только для указателей на строковые литералы, строки из буферов копируются.
+    @param level Уровень логирования.
+    @param message Сообщение или строка форматирования.
+    @param ... Аргументы строки форматирования.
+*/
+#define klog(level, message, ...)                                                                        \
+    (__builtin_constant_p(message) ? log_output_static(level, message, ##__VA_ARGS__)                    \
+                                   : log_output(level, message, ##__VA_ARGS__))
+
 /*
     @brief Отправляет сообщение с фатальным уровнем в логи и останавливает нормальную работу приложения.
     @param message Сообщение или строка форматирования.
     @param ... Аргументы строки форматирования.
 */
-#define kfatal(message, ...) log_output(LOG_LEVEL_FATAL, message, ##__VA_ARGS__)
+#define kfatal(message, ...) klog(LOG_LEVEL_FATAL, message, ##__VA_ARGS__)
 
 #ifndef kerror
     /*
@@ -68,7 +149,7 @@ KAPI void log_output(log_level level, const char* message, ...);
         @param message Сообщение или строка форматирования.
         @param ... Аргументы строки форматирования.
     */
-    #define kerror(message, ...) log_output(LOG_LEVEL_ERROR, message, ##__VA_ARGS__)
+    #define kerror(message, ...) klog(LOG_LEVEL_ERROR, message, ##__VA_ARGS__)
 #endif
 
 #if LOG_WARNG_ENABLED == 1
@@ -77,7 +158,7 @@ KAPI void log_output(log_level level, const char* message, ...);
         @param message Сообщение или строка форматирования.
         @param ... Аргументы строки форматирования.
     */
-    #define kwarng(message, ...) log_output(LOG_LEVEL_WARNG, message, ##__VA_ARGS__)
+    #define kwarng(message, ...) klog(LOG_LEVEL_WARNG, message, ##__VA_ARGS__)
 #else
     /*
         @brief Отправляет сообщение с не критическим уровнем в логи.
@@ -93,7 +174,7 @@ KAPI void log_output(log_level level, const char* message, ...);
         @param message Сообщение или строка форматирования.
         @param ... Аргументы строки форматирования.
     */
-    #define kinfor(message, ...) log_output(LOG_LEVEL_INFOR, message, ##__VA_ARGS__)
+    #define kinfor(message, ...) klog(LOG_LEVEL_INFOR, message, ##__VA_ARGS__)
 #else
     /*
         @brief Отправляет сообщение с информационным уровнем в логи.
@@ -109,7 +190,7 @@ KAPI void log_output(log_level level, const char* message, ...);
         @param message Сообщение или строка форматирования.
         @param ... Аргументы строки форматирования.
     */
-    #define kdebug(message, ...) log_output(LOG_LEVEL_DEBUG, message, ##__VA_ARGS__)
+    #define kdebug(message, ...) klog(LOG_LEVEL_DEBUG, message, ##__VA_ARGS__)
 #else
     /*
         @brief Отправляет сообщение с отладочным уровнем в логи.
@@ -125,7 +206,7 @@ KAPI void log_output(log_level level, const char* message, ...);
         @param message Сообщение или строка форматирования.
         @param ... Аргументы строки форматирования.
     */
-    #define ktrace(message, ...) log_output(LOG_LEVEL_TRACE, message, ##__VA_ARGS__)
+    #define ktrace(message, ...) klog(LOG_LEVEL_TRACE, message, ##__VA_ARGS__)
 #else
     /*
         @brief Отправляет сообщение с пошаговым уровнем в логи.
@@ -3,6 +3,7 @@
 
 // Внутренние подключения.
 #include "math/kmath.h"
+#include "memory/memory.h"
 
 void geometry_generate_normals(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices)
 {
@@ -67,3 +68,568 @@ void geometry_generate_tangent(u32 vertex_count, vertex_3d* vertices, u32 index_
         vertices[i2].tangent = t3;
     }
 }
+
+// @brief Квадрика ошибки: взвешенная сумма квадратов расстояний до плоскостей (симметричная матрица 4x4).
+typedef struct geometry_quadric {
+    f32 a00, a11, a22;
+    f32 a10, a20, a21;
+    f32 b0, b1, b2;
+    f32 c;
+    // @brief Суммарный вес (площадь) плоскостей.
+    f32 w;
+} geometry_quadric;
+
+// @brief Кандидат на стягивание ребра 'from' -> 'to'.
+typedef struct geometry_collapse {
+    f32 error;
+    u32 from;
+    u32 to;
+} geometry_collapse;
+
+static void geometry_quadric_from_plane(geometry_quadric* q, vec3 n, f32 d, f32 w)
+{
+    q->a00 = n.x * n.x * w;
+    q->a11 = n.y * n.y * w;
+    q->a22 = n.z * n.z * w;
+    q->a10 = n.y * n.x * w;
+    q->a20 = n.z * n.x * w;
+    q->a21 = n.z * n.y * w;
+    q->b0 = n.x * d * w;
+    q->b1 = n.y * d * w;
+    q->b2 = n.z * d * w;
+    q->c = d * d * w;
+    q->w = w;
+}
+
+static void geometry_quadric_add(geometry_quadric* dest, const geometry_quadric* q)
+{
+    dest->a00 += q->a00;
+    dest->a11 += q->a11;
+    dest->a22 += q->a22;
+    dest->a10 += q->a10;
+    dest->a20 += q->a20;
+    dest->a21 += q->a21;
+    dest->b0 += q->b0;
+    dest->b1 += q->b1;
+    dest->b2 += q->b2;
+    dest->c += q->c;
+    dest->w += q->w;
+}
+
+// @brief Возвращает средний квадрат расстояния от точки до плоскостей квадрики.
+static f32 geometry_quadric_error(const geometry_quadric* q, vec3 p)
+{
+    f32 rx = q->a00 * p.x + q->a10 * p.y + q->a20 * p.z + q->b0;
+    f32 ry = q->a10 * p.x + q->a11 * p.y + q->a21 * p.z + q->b1;
+    f32 rz = q->a20 * p.x + q->a21 * p.y + q->a22 * p.z + q->b2;
+    f32 r = rx * p.x + ry * p.y + rz * p.z + q->b0 * p.x + q->b1 * p.y + q->b2 * p.z + q->c;
+    return q->w > 0.0f ? kabs(r) / q->w : 0.0f;
+}
+
+static u32 geometry_hash_u32(u32 h)
+{
+    // Финализатор MurmurHash3.
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+static u32 geometry_table_capacity(u32 count)
+{
+    u32 capacity = 16;
+    while(capacity < count * 2)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// @brief Сортирует кандидатов по возрастанию ошибки (поразрядно: неотрицательные f32 упорядочены как u32).
+static void geometry_collapse_sort(geometry_collapse* collapses, geometry_collapse* scratch, u32 count)
+{
+    for(u32 shift = 0; shift < 32; shift += 8)
+    {
+        u32 offsets[256] = {0};
+        for(u32 i = 0; i < count; ++i)
+        {
+            u32 key = *(u32*)&collapses[i].error;
+            offsets[(key >> shift) & 0xff]++;
+        }
+
+        u32 sum = 0;
+        for(u32 i = 0; i < 256; ++i)
+        {
+            u32 c = offsets[i];
+            offsets[i] = sum;
+            sum += c;
+        }
+
+        for(u32 i = 0; i < count; ++i)
+        {
+            u32 key = *(u32*)&collapses[i].error;
+            scratch[offsets[(key >> shift) & 0xff]++] = collapses[i];
+        }
+
+        geometry_collapse* temp = collapses;
+        collapses = scratch;
+        scratch = temp;
+    }
+    // NOTE: Четное число проходов, результат снова в исходном массиве.
+}
+
+// @brief Проверяет, не перевернется или не выродится ли треугольник при перемещении вершины 'from' в позицию 'to'.
+static bool geometry_collapse_flips(
+    const vec3* positions, const u32* remap, const u32* adjacency_offsets, const u32* adjacency, const u32* indices,
+    u32 from, u32 to
+)
+{
+    vec3 target = positions[to];
+
+    for(u32 i = adjacency_offsets[from]; i < adjacency_offsets[from + 1]; ++i)
+    {
+        const u32* tri = &indices[adjacency[i] * 3];
+
+        // Треугольники, содержащие ребро, вырождаются и удаляются.
+        if(remap[tri[0]] == remap[to] || remap[tri[1]] == remap[to] || remap[tri[2]] == remap[to])
+        {
+            continue;
+        }
+
+        vec3 p0 = positions[tri[0]];
+        vec3 p1 = positions[tri[1]];
+        vec3 p2 = positions[tri[2]];
+        vec3 n0 = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+
+        if(tri[0] == from) p0 = target;
+        if(tri[1] == from) p1 = target;
+        if(tri[2] == from) p2 = target;
+        vec3 n1 = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+
+        // NOTE: Отклоняются и повороты нормали больше ~75 градусов, и почти вырожденные треугольники:
+        //       из-за округления у вырожденного треугольника нормаль может иметь любое направление.
+        f32 length0 = vec3_length(n0);
+        f32 length1 = vec3_length(n1);
+        if(vec3_dot(n0, n1) < 0.25f * length0 * length1 || length1 < length0 * 0.001f)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+u32 geometry_simplify(
+    u32 vertex_count, const vertex_3d* vertices, u32 index_count, const u32* indices, u32 target_index_count,
+    f32 target_error, u32* out_indices
+)
+{
+    kcopy_tc(out_indices, indices, u32, index_count);
+
+    if(index_count <= target_index_count || !vertex_count)
+    {
+        return index_count;
+    }
+
+    // Нормализация позиций, чтобы ошибка не зависела от масштаба сетки.
+    vec3 min = vertices[0].position;
+    vec3 max = vertices[0].position;
+    for(u32 i = 1; i < vertex_count; ++i)
+    {
+        min = vec3_min(min, vertices[i].position);
+        max = vec3_max(max, vertices[i].position);
+    }
+
+    f32 diagonal = vec3_distance(min, max);
+    f32 scale = diagonal > 0.0f ? 1.0f / diagonal : 1.0f;
+
+    u32 position_capacity = geometry_table_capacity(vertex_count);
+    u32 edge_capacity = geometry_table_capacity(index_count);
+
+    vec3* positions = kallocate_tc(vec3, vertex_count, MEMORY_TAG_ARRAY);
+    u32* remap = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    u8* locked = kallocate_tc(u8, vertex_count, MEMORY_TAG_ARRAY);
+    u8* touched = kallocate_tc(u8, vertex_count, MEMORY_TAG_ARRAY);
+    u32* collapse_target = kallocate_tc(u32, vertex_count, MEMORY_TAG_ARRAY);
+    u32* adjacency_offsets = kallocate_tc(u32, (vertex_count + 1), MEMORY_TAG_ARRAY);
+    u32* adjacency = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    geometry_quadric* quadrics = kallocate_tc(geometry_quadric, vertex_count, MEMORY_TAG_ARRAY);
+    geometry_collapse* collapses = kallocate_tc(geometry_collapse, index_count * 2, MEMORY_TAG_ARRAY);
+    geometry_collapse* collapses_scratch = kallocate_tc(geometry_collapse, index_count * 2, MEMORY_TAG_ARRAY);
+    u32* position_table = kallocate_tc(u32, position_capacity, MEMORY_TAG_ARRAY);
+    u64* edge_keys = kallocate_tc(u64, edge_capacity, MEMORY_TAG_ARRAY);
+    u32* edge_counts = kallocate_tc(u32, edge_capacity, MEMORY_TAG_ARRAY);
+
+    kzero_tc(locked, u8, vertex_count);
+    kzero_tc(quadrics, geometry_quadric, vertex_count);
+    kzero_tc(edge_counts, u32, edge_capacity);
+    kset_tc(position_table, u32, position_capacity, 0xff);
+    kset_tc(edge_keys, u64, edge_capacity, 0xff);
+
+    // Объединение вершин с одинаковыми позициями (швы атрибутов) и блокировка швов.
+    for(u32 i = 0; i < vertex_count; ++i)
+    {
+        positions[i] = vec3_mul_scalar(vec3_sub(vertices[i].position, min), scale);
+
+        const u32* key = (const u32*)&vertices[i].position;
+        u32 slot = geometry_hash_u32(key[0] ^ geometry_hash_u32(key[1] ^ geometry_hash_u32(key[2])));
+
+        for(;; ++slot)
+        {
+            slot &= position_capacity - 1;
+            u32 other = position_table[slot];
+
+            if(other == INVALID_ID)
+            {
+                position_table[slot] = i;
+                remap[i] = i;
+                break;
+            }
+
+            const u32* other_key = (const u32*)&vertices[other].position;
+            if(other_key[0] == key[0] && other_key[1] == key[1] && other_key[2] == key[2])
+            {
+                remap[i] = other;
+                locked[other] = true;
+                break;
+            }
+        }
+    }
+
+    // Квадрики плоскостей треугольников и подсчет треугольников на каждом ребре.
+    for(u32 i = 0; i < index_count; i += 3)
+    {
+        u32 v[3] = { remap[indices[i + 0]], remap[indices[i + 1]], remap[indices[i + 2]] };
+
+        vec3 p0 = positions[v[0]];
+        vec3 normal = vec3_cross(vec3_sub(positions[v[1]], p0), vec3_sub(positions[v[2]], p0));
+        f32 length = vec3_length(normal);
+
+        if(length > 0.0f)
+        {
+            normal = vec3_mul_scalar(normal, 1.0f / length);
+            geometry_quadric q;
+            geometry_quadric_from_plane(&q, normal, -vec3_dot(normal, p0), length * 0.5f);
+            geometry_quadric_add(&quadrics[v[0]], &q);
+            geometry_quadric_add(&quadrics[v[1]], &q);
+            geometry_quadric_add(&quadrics[v[2]], &q);
+        }
+
+        for(u32 e = 0; e < 3; ++e)
+        {
+            u32 a = v[e];
+            u32 b = v[(e + 1) % 3];
+            if(a == b) continue;
+
+            u64 key = a < b ? ((u64)a << 32) | b : ((u64)b << 32) | a;
+            u32 slot = geometry_hash_u32((u32)key ^ geometry_hash_u32((u32)(key >> 32)));
+
+            for(;; ++slot)
+            {
+                slot &= edge_capacity - 1;
+                if(edge_keys[slot] == key || edge_keys[slot] == INVALID_ID_U64)
+                {
+                    edge_keys[slot] = key;
+                    edge_counts[slot]++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Блокировка вершин на границах и неманифолдных ребрах.
+    for(u32 slot = 0; slot < edge_capacity; ++slot)
+    {
+        if(edge_keys[slot] != INVALID_ID_U64 && edge_counts[slot] != 2)
+        {
+            locked[(u32)(edge_keys[slot] >> 32)] = true;
+            locked[(u32)edge_keys[slot]] = true;
+        }
+    }
+
+    f32 error_limit = target_error * target_error;
+    u32 result_count = index_count;
+
+    while(result_count > target_index_count)
+    {
+        // Списки треугольников каждой вершины.
+        kzero_tc(adjacency_offsets, u32, (vertex_count + 1));
+        for(u32 i = 0; i < result_count; ++i)
+        {
+            adjacency_offsets[out_indices[i] + 1]++;
+        }
+
+        for(u32 i = 0; i < vertex_count; ++i)
+        {
+            adjacency_offsets[i + 1] += adjacency_offsets[i];
+        }
+
+        for(u32 i = 0; i < result_count; ++i)
+        {
+            adjacency[adjacency_offsets[out_indices[i]]++] = i / 3;
+        }
+
+        for(u32 i = vertex_count; i > 0; --i)
+        {
+            adjacency_offsets[i] = adjacency_offsets[i - 1];
+        }
+        adjacency_offsets[0] = 0;
+
+        // Кандидаты: каждое ребро в обоих направлениях, заблокированные вершины не перемещаются.
+        u32 collapse_count = 0;
+        for(u32 i = 0; i < result_count; i += 3)
+        {
+            for(u32 e = 0; e < 3; ++e)
+            {
+                u32 a = out_indices[i + e];
+                u32 b = out_indices[i + (e + 1) % 3];
+
+                for(u32 d = 0; d < 2; ++d)
+                {
+                    u32 from = d ? b : a;
+                    u32 to = d ? a : b;
+
+                    if(locked[remap[from]] || remap[from] == remap[to])
+                    {
+                        continue;
+                    }
+
+                    geometry_quadric q = quadrics[remap[from]];
+                    geometry_quadric_add(&q, &quadrics[remap[to]]);
+
+                    geometry_collapse* c = &collapses[collapse_count++];
+                    c->error = geometry_quadric_error(&q, positions[to]);
+                    c->from = from;
+                    c->to = to;
+                }
+            }
+        }
+
+        geometry_collapse_sort(collapses, collapses_scratch, collapse_count);
+
+        // NOTE: Каждое стягивание удаляет примерно два треугольника, за проход стягиваются только
+        //       независимые ребра (окрестности не пересекаются).
+        u32 budget = (result_count - target_index_count) / 6 + 1;
+        u32 performed = 0;
+
+        kzero_tc(touched, u8, vertex_count);
+        for(u32 i = 0; i < vertex_count; ++i)
+        {
+            collapse_target[i] = i;
+        }
+
+        for(u32 i = 0; i < collapse_count && performed < budget; ++i)
+        {
+            geometry_collapse* c = &collapses[i];
+
+            if(c->error > error_limit)
+            {
+                break;
+            }
+
+            if(touched[c->from] || touched[c->to]
+            || geometry_collapse_flips(positions, remap, adjacency_offsets, adjacency, out_indices, c->from, c->to))
+            {
+                continue;
+            }
+
+            collapse_target[c->from] = c->to;
+            geometry_quadric_add(&quadrics[remap[c->to]], &quadrics[remap[c->from]]);
+
+            for(u32 j = adjacency_offsets[c->from]; j < adjacency_offsets[c->from + 1]; ++j)
+            {
+                const u32* tri = &out_indices[adjacency[j] * 3];
+                touched[tri[0]] = true;
+                touched[tri[1]] = true;
+                touched[tri[2]] = true;
+            }
+
+            performed++;
+        }
+
+        if(!performed)
+        {
+            break;
+        }
+
+        // Перезапись индексов с удалением вырожденных треугольников.
+        u32 write = 0;
+        for(u32 i = 0; i < result_count; i += 3)
+        {
+            u32 a = collapse_target[out_indices[i + 0]];
+            u32 b = collapse_target[out_indices[i + 1]];
+            u32 c = collapse_target[out_indices[i + 2]];
+
+            if(remap[a] == remap[b] || remap[b] == remap[c] || remap[a] == remap[c])
+            {
+                continue;
+            }
+
+            out_indices[write + 0] = a;
+            out_indices[write + 1] = b;
+            out_indices[write + 2] = c;
+            write += 3;
+        }
+
+        result_count = write;
+    }
+
+    kfree(positions, MEMORY_TAG_ARRAY);
+    kfree(remap, MEMORY_TAG_ARRAY);
+    kfree(locked, MEMORY_TAG_ARRAY);
+    kfree(touched, MEMORY_TAG_ARRAY);
+    kfree(collapse_target, MEMORY_TAG_ARRAY);
+    kfree(adjacency_offsets, MEMORY_TAG_ARRAY);
+    kfree(adjacency, MEMORY_TAG_ARRAY);
+    kfree(quadrics, MEMORY_TAG_ARRAY);
+    kfree(collapses, MEMORY_TAG_ARRAY);
+    kfree(collapses_scratch, MEMORY_TAG_ARRAY);
+    kfree(position_table, MEMORY_TAG_ARRAY);
+    kfree(edge_keys, MEMORY_TAG_ARRAY);
+    kfree(edge_counts, MEMORY_TAG_ARRAY);
+
+    return result_count;
+}
+
+// Допустимое отклонение поверхности окклюдера (относительно диагонали сетки), учитывает только погрешность вычислений.
+#define GEOMETRY_OCCLUDER_ERROR 1e-5f
+
+static f32 geometry_triangle_area(const vertex_3d* vertices, const u32* tri)
+{
+    vec3 p0 = vertices[tri[0]].position;
+    vec3 edge1 = vec3_sub(vertices[tri[1]].position, p0);
+    vec3 edge2 = vec3_sub(vertices[tri[2]].position, p0);
+    return vec3_length(vec3_cross(edge1, edge2)) * 0.5f;
+}
+
+// Восстанавливает свойство кучи (наименьшая площадь в корне) начиная с позиции 'i'.
+static void geometry_heap_sift_down(u32* heap, const f32* areas, u32 count, u32 i)
+{
+    for(;;)
+    {
+        u32 smallest = i;
+        u32 left = i * 2 + 1;
+        u32 right = left + 1;
+
+        if(left < count && areas[heap[left]] < areas[heap[smallest]])
+        {
+            smallest = left;
+        }
+
+        if(right < count && areas[heap[right]] < areas[heap[smallest]])
+        {
+            smallest = right;
+        }
+
+        if(smallest == i)
+        {
+            break;
+        }
+
+        u32 temp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = temp;
+        i = smallest;
+    }
+}
+
+u32 geometry_generate_occluder(
+    u32 vertex_count, const vertex_3d* vertices, u32 index_count, const u32* indices, u32 max_index_count,
+    u32* out_indices
+)
+{
+    u32 max_triangle_count = max_index_count / 3;
+    if(!vertex_count || !index_count || !max_triangle_count)
+    {
+        return 0;
+    }
+
+    u32* simplified = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    u32 simplified_count = geometry_simplify(
+        vertex_count, vertices, index_count, indices, 0, GEOMETRY_OCCLUDER_ERROR, simplified
+    );
+
+    u32 triangle_count = simplified_count / 3;
+    if(!triangle_count)
+    {
+        kfree(simplified, MEMORY_TAG_ARRAY);
+        return 0;
+    }
+
+    // Площади треугольников, вырожденные не участвуют.
+    f32* areas = kallocate_tc(f32, triangle_count, MEMORY_TAG_ARRAY);
+    u32* heap = kallocate_tc(u32, max_triangle_count, MEMORY_TAG_ARRAY);
+    u32 heap_count = 0;
+
+    // NOTE: Куча из max_triangle_count наибольших треугольников, в корне наименьший из них.
+    for(u32 i = 0; i < triangle_count; ++i)
+    {
+        areas[i] = geometry_triangle_area(vertices, &simplified[i * 3]);
+        if(areas[i] <= 0.0f)
+        {
+            continue;
+        }
+
+        if(heap_count < max_triangle_count)
+        {
+            // Подъем нового элемента.
+            u32 j = heap_count++;
+            heap[j] = i;
+
+            while(j > 0 && areas[heap[(j - 1) / 2]] > areas[heap[j]])
+            {
+                u32 parent = (j - 1) / 2;
+                u32 temp = heap[parent];
+                heap[parent] = heap[j];
+                heap[j] = temp;
+                j = parent;
+            }
+        }
+        else if(areas[i] > areas[heap[0]])
+        {
+            heap[0] = i;
+            geometry_heap_sift_down(heap, areas, heap_count, 0);
+        }
+    }
+
+    for(u32 i = 0; i < heap_count; ++i)
+    {
+        kcopy_tc(&out_indices[i * 3], &simplified[heap[i] * 3], u32, 3);
+    }
+
+    kfree(simplified, MEMORY_TAG_ARRAY);
+    kfree(areas, MEMORY_TAG_ARRAY);
+    kfree(heap, MEMORY_TAG_ARRAY);
+
+    return heap_count * 3;
+}
+
+// Размер на экране, ниже которого используется первый упрощенный уровень.
+#define GEOMETRY_LOD_SCREEN_SIZE 0.5f
+// Относительный запас порогов при смене уровня.
+#define GEOMETRY_LOD_HYSTERESIS 0.1f
+
+u8 geometry_select_lod(u8 lod_count, u8 current_lod, f32 screen_size)
+{
+    if(lod_count < 2)
+    {
+        return 0;
+    }
+
+    u8 lod = current_lod < lod_count ? current_lod : 0;
+
+    // Порог уровня 'lod + 1' равен GEOMETRY_LOD_SCREEN_SIZE / 2^lod.
+    while(lod + 1 < lod_count && screen_size < (GEOMETRY_LOD_SCREEN_SIZE / (f32)(1u << lod)) * (1.0f - GEOMETRY_LOD_HYSTERESIS))
+    {
+        lod++;
+    }
+
+    while(lod > 0 && screen_size > (GEOMETRY_LOD_SCREEN_SIZE / (f32)(1u << (lod - 1))) * (1.0f + GEOMETRY_LOD_HYSTERESIS))
+    {
+        lod--;
+    }
+
+    return lod;
+}
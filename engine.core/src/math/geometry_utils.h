@@ -20,3 +20,52 @@ void geometry_generate_normals(u32 vertex_count, vertex_3d* vertices, u32 index_
     @param indices Массив индексов.
 */
 void geometry_generate_tangent(u32 vertex_count, vertex_3d* vertices, u32 index_count, u32* indices);
+
+/*
+    @brief Упрощает сетку стягиванием ребер с оценкой ошибки по квадрикам (Garland-Heckbert).
+    NOTE: Новые вершины не создаются, результат ссылается на исходный массив вершин, поэтому уровни
+          детализации можно хранить диапазонами одного буфера индексов. Вершины на границах сетки и на швах
+          атрибутов (одна позиция с разными нормалями или текстурными координатами) не перемещаются.
+    @param vertex_count Количество вершин.
+    @param vertices Массив вершин.
+    @param index_count Количество индексов (кратно 3).
+    @param indices Массив индексов.
+    @param target_index_count Желаемое количество индексов результата.
+    @param target_error Допустимое отклонение поверхности относительно диагонали ограничивающего прямоугольника сетки.
+    @param out_indices Массив для записи индексов результата (не меньше index_count).
+    @return Количество индексов результата.
+*/
+KAPI u32 geometry_simplify(
+    u32 vertex_count, const vertex_3d* vertices, u32 index_count, const u32* indices, u32 target_index_count,
+    f32 target_error, u32* out_indices
+);
+
+/*
+    @brief Строит консервативный окклюдер сетки: подмножество треугольников поверхности не больше заданного размера.
+    NOTE: Сетка упрощается только стягиваниями без отклонения поверхности (объединение компланарных треугольников),
+          затем остаются треугольники наибольшей площади. Результат никогда не выходит за исходную поверхность,
+          поэтому в отличие от ограничивающего прямоугольника или упрощенного уровня детализации не скрывает
+          видимые объекты (в том числе для невыпуклых сеток).
+    @param vertex_count Количество вершин.
+    @param vertices Массив вершин.
+    @param index_count Количество индексов (кратно 3).
+    @param indices Массив индексов.
+    @param max_index_count Наибольшее количество индексов результата.
+    @param out_indices Массив для записи индексов результата (не меньше max_index_count).
+    @return Количество индексов результата.
+*/
+KAPI u32 geometry_generate_occluder(
+    u32 vertex_count, const vertex_3d* vertices, u32 index_count, const u32* indices, u32 max_index_count,
+    u32* out_indices
+);
+
+/*
+    @brief Выбирает уровень детализации по размеру геометрии на экране с гистерезисом.
+    NOTE: Уровень i (i > 0) используется, когда размер меньше 0.5 / 2^(i-1). Для смены уровня размер должен
+          выйти за порог с запасом 10%, поэтому геометрия на границе порога не переключается каждый кадр.
+    @param lod_count Количество уровней детализации.
+    @param current_lod Уровень, выбранный в предыдущем кадре.
+    @param screen_size Видимый диаметр геометрии относительно высоты экрана.
+    @return Уровень детализации.
+*/
+KAPI u8 geometry_select_lod(u8 lod_count, u8 current_lod, f32 screen_size);
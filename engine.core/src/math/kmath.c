@@ -3,6 +3,7 @@
 
 // Внутренние подключения.
 #include "platform/math.h"
+#include "math/kmath_simd.h"
 
 // f32 kattenuation_min_max(f32 min, f32 max, f32 x)
 // {
@@ -12,38 +13,269 @@
 // {
 // }
 
-// plane_3d plane_3d_create(vec3 p1, vec3 norm)
-// {
-// }
+plane_3d plane_3d_create(vec3 p1, vec3 norm)
+{
+    plane_3d p;
+    p.normal = vec3_normalized(norm);
+    p.distance = vec3_dot(p.normal, p1);
+    return p;
+}
 
-// frustum frustum_create(const vec3 *position, const vec3 *forward, const vec3 *right, const vec3 *up, f32 aspect, f32 fov, f32 near, f32 far)
-// {
-// }
+frustum frustum_create(const vec3 *position, const vec3 *forward, const vec3 *right, const vec3 *up, f32 aspect, f32 fov, f32 near, f32 far)
+{
+    frustum f;
+    f32 half_v = far * ktan(fov * 0.5f);
+    f32 half_h = half_v * aspect;
+    vec3 forward_far = vec3_mul_scalar(*forward, far);
+    vec3 right_half = vec3_mul_scalar(*right, half_h);
+    vec3 up_half = vec3_mul_scalar(*up, half_v);
 
-// frustum frustum_from_view_projection(mat4 view_projection)
-// {
-// }
+    // Нормали боковых плоскостей - векторные произведения ребер пирамиды, направлены внутрь.
+    f.sides[FRUSTUM_SIDE_TOP]    = plane_3d_create(*position, vec3_cross(*right, vec3_add(forward_far, up_half)));
+    f.sides[FRUSTUM_SIDE_BOTTOM] = plane_3d_create(*position, vec3_cross(vec3_sub(forward_far, up_half), *right));
+    f.sides[FRUSTUM_SIDE_RIGHT]  = plane_3d_create(*position, vec3_cross(vec3_add(forward_far, right_half), *up));
+    f.sides[FRUSTUM_SIDE_LEFT]   = plane_3d_create(*position, vec3_cross(*up, vec3_sub(forward_far, right_half)));
+    f.sides[FRUSTUM_SIDE_FAR]    = plane_3d_create(vec3_add(*position, forward_far), vec3_mul_scalar(*forward, -1.0f));
+    f.sides[FRUSTUM_SIDE_NEAR]   = plane_3d_create(vec3_add(*position, vec3_mul_scalar(*forward, near)), *forward);
+    return f;
+}
 
-// void frustum_corner_points_world_space(mat4 projection_view, vec4 *corners)
-// {
-// }
+// Создает плоскость из коэффициентов ax + by + cz + w >= 0.
+static plane_3d plane_3d_from_coefficients(f32 a, f32 b, f32 c, f32 w)
+{
+    plane_3d p;
+    f32 inv_length = 1.0f / ksqrt(a * a + b * b + c * c);
+    p.normal = vec3_create(a * inv_length, b * inv_length, c * inv_length);
+    p.distance = -w * inv_length;
+    return p;
+}
 
-// f32 plane_signed_distance(const plane_3d *p, const vec3 *position)
-// {
-// }
+frustum frustum_from_view_projection(mat4 view_projection)
+{
+    // NOTE: Векторы-строки: clip = v * M, плоскости строятся из столбцов матрицы.
+    const f32* m = view_projection.data;
+    frustum f;
 
-// bool plane_intersects_sphere(const plane_3d *p, const vec3 *center, f32 radius)
-// {
-// }
+    #define KMATH_FRUSTUM_PLANE(sign, col) plane_3d_from_coefficients(  \
+        m[3]  sign m[0 + col], m[7]  sign m[4 + col],                  \
+        m[11] sign m[8 + col], m[15] sign m[12 + col])
 
-// bool frustum_intersects_sphere(const frustum *f, const vec3 *center, f32 radius)
-// {
-// }
+    f.sides[FRUSTUM_SIDE_LEFT]   = KMATH_FRUSTUM_PLANE(+, 0);
+    f.sides[FRUSTUM_SIDE_RIGHT]  = KMATH_FRUSTUM_PLANE(-, 0);
+    f.sides[FRUSTUM_SIDE_BOTTOM] = KMATH_FRUSTUM_PLANE(+, 1);
+    f.sides[FRUSTUM_SIDE_TOP]    = KMATH_FRUSTUM_PLANE(-, 1);
+    f.sides[FRUSTUM_SIDE_NEAR]   = KMATH_FRUSTUM_PLANE(+, 2);
+    f.sides[FRUSTUM_SIDE_FAR]    = KMATH_FRUSTUM_PLANE(-, 2);
 
-// bool plane_intersects_aabb(const plane_3d *p, const vec3 *center, const vec3 *extents)
-// {
-// }
+    #undef KMATH_FRUSTUM_PLANE
+    return f;
+}
 
-// bool frustum_intersects_aabb(const frustum *f, const vec3 *center, const vec3 *extents)
-// {
-// }
+void frustum_corner_points_world_space(mat4 projection_view, vec4 *corners)
+{
+    mat4 inverse = mat4_inverse(projection_view);
+
+    u32 index = 0;
+    for(u32 x = 0; x < 2; ++x)
+    {
+        for(u32 y = 0; y < 2; ++y)
+        {
+            for(u32 z = 0; z < 2; ++z)
+            {
+                vec4 corner = vec4_create(2.0f * x - 1.0f, 2.0f * y - 1.0f, 2.0f * z - 1.0f, 1.0f);
+                vec4 point = vec4_mul_mat4(corner, inverse);
+                corners[index++] = vec4_div_scalar(point, point.w);
+            }
+        }
+    }
+}
+
+f32 plane_signed_distance(const plane_3d *p, const vec3 *position)
+{
+    return vec3_dot(p->normal, *position) - p->distance;
+}
+
+bool plane_intersects_sphere(const plane_3d *p, const vec3 *center, f32 radius)
+{
+    return plane_signed_distance(p, center) > -radius;
+}
+
+bool frustum_intersects_sphere(const frustum *f, const vec3 *center, f32 radius)
+{
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        if(!plane_intersects_sphere(&f->sides[i], center, radius))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool plane_intersects_aabb(const plane_3d *p, const vec3 *center, const vec3 *extents)
+{
+    // Проекция половинных размеров на нормаль плоскости.
+    f32 r = extents->x * kabs(p->normal.x) + extents->y * kabs(p->normal.y) + extents->z * kabs(p->normal.z);
+    return -r <= plane_signed_distance(p, center);
+}
+
+bool frustum_intersects_aabb(const frustum *f, const vec3 *center, const vec3 *extents)
+{
+    for(u32 i = 0; i < FRUSTUM_SIDES_MAX; ++i)
+    {
+        if(!plane_intersects_aabb(&f->sides[i], center, extents))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void aabb_transform(const extents_3d *extents, mat4 model, vec3 *out_center, vec3 *out_extents)
+{
+    vec3 center = vec3_mul_scalar(vec3_add(extents->min, extents->max), 0.5f);
+    vec3 half = vec3_mul_scalar(vec3_sub(extents->max, extents->min), 0.5f);
+    const f32* m = model.data;
+
+    *out_center = vec3_transform(center, 1.0f, model);
+    for(u32 j = 0; j < 3; ++j)
+    {
+        out_extents->elements[j] = half.x * kabs(m[0 + j]) + half.y * kabs(m[4 + j]) + half.z * kabs(m[8 + j]);
+    }
+}
+
+u32 frustum_intersects_aabb_array(const frustum *f, const vec3 *centers, const vec3 *extents, u32 count, u8 *out_visible)
+{
+    u32 visible_count = 0;
+    u32 i = 0;
+
+    // Четыре прямоугольника за раз: для каждой плоскости min(distance + r) по всем плоскостям.
+    for(; i + 4 <= count; i += 4)
+    {
+        const vec3* c = &centers[i];
+        const vec3* e = &extents[i];
+        ksimd_f32x4 cx = ksimd_set(c[0].x, c[1].x, c[2].x, c[3].x);
+        ksimd_f32x4 cy = ksimd_set(c[0].y, c[1].y, c[2].y, c[3].y);
+        ksimd_f32x4 cz = ksimd_set(c[0].z, c[1].z, c[2].z, c[3].z);
+        ksimd_f32x4 ex = ksimd_set(e[0].x, e[1].x, e[2].x, e[3].x);
+        ksimd_f32x4 ey = ksimd_set(e[0].y, e[1].y, e[2].y, e[3].y);
+        ksimd_f32x4 ez = ksimd_set(e[0].z, e[1].z, e[2].z, e[3].z);
+        ksimd_f32x4 min_margin = ksimd_set1(K_FLOAT_MAX);
+
+        for(u32 s = 0; s < FRUSTUM_SIDES_MAX; ++s)
+        {
+            const plane_3d* p = &f->sides[s];
+            ksimd_f32x4 distance = ksimd_sub(
+                ksimd_add(ksimd_add(ksimd_mul(cx, ksimd_set1(p->normal.x)), ksimd_mul(cy, ksimd_set1(p->normal.y))), ksimd_mul(cz, ksimd_set1(p->normal.z))),
+                ksimd_set1(p->distance)
+            );
+            ksimd_f32x4 r = ksimd_add(
+                ksimd_add(ksimd_mul(ex, ksimd_set1(kabs(p->normal.x))), ksimd_mul(ey, ksimd_set1(kabs(p->normal.y)))),
+                ksimd_mul(ez, ksimd_set1(kabs(p->normal.z)))
+            );
+            min_margin = ksimd_min(min_margin, ksimd_add(distance, r));
+        }
+
+        KALIGN(16) f32 margins[4];
+        ksimd_store(margins, min_margin);
+        for(u32 j = 0; j < 4; ++j)
+        {
+            out_visible[i + j] = margins[j] >= 0.0f;
+            visible_count += out_visible[i + j];
+        }
+    }
+
+    for(; i < count; ++i)
+    {
+        out_visible[i] = frustum_intersects_aabb(f, &centers[i], &extents[i]);
+        visible_count += out_visible[i];
+    }
+
+    return visible_count;
+}
+
+// Нормализует четыре вектора: длины (или обратные длины) вычисляются одним регистром.
+static void kmath_normalize_vec3_x4(vec3* v, bool fast)
+{
+    ksimd_f32x4 x = ksimd_set(v[0].x, v[1].x, v[2].x, v[3].x);
+    ksimd_f32x4 y = ksimd_set(v[0].y, v[1].y, v[2].y, v[3].y);
+    ksimd_f32x4 z = ksimd_set(v[0].z, v[1].z, v[2].z, v[3].z);
+    ksimd_f32x4 length_squared = ksimd_add(ksimd_add(ksimd_mul(x, x), ksimd_mul(y, y)), ksimd_mul(z, z));
+
+    if(fast)
+    {
+        ksimd_f32x4 inv_length = ksimd_fast_rsqrt(length_squared);
+        x = ksimd_mul(x, inv_length);
+        y = ksimd_mul(y, inv_length);
+        z = ksimd_mul(z, inv_length);
+    }
+    else
+    {
+        ksimd_f32x4 length = ksimd_sqrt(length_squared);
+        x = ksimd_div(x, length);
+        y = ksimd_div(y, length);
+        z = ksimd_div(z, length);
+    }
+
+    KALIGN(16) f32 out[3][4];
+    ksimd_store(out[0], x);
+    ksimd_store(out[1], y);
+    ksimd_store(out[2], z);
+
+    for(u32 i = 0; i < 4; ++i)
+    {
+        v[i].x = out[0][i];
+        v[i].y = out[1][i];
+        v[i].z = out[2][i];
+    }
+}
+
+void kmath_normalize_vec3_array(vec3* vectors, u32 count)
+{
+    u32 i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        kmath_normalize_vec3_x4(&vectors[i], false);
+    }
+
+    for(; i < count; ++i)
+    {
+        vec3_normalize(&vectors[i]);
+    }
+}
+
+void kmath_fast_normalize_vec3_array(vec3* vectors, u32 count)
+{
+    u32 i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        kmath_normalize_vec3_x4(&vectors[i], true);
+    }
+
+    for(; i < count; ++i)
+    {
+        vectors[i] = vec3_mul_scalar(vectors[i], kfast_rsqrt(vec3_length_squared(vectors[i])));
+    }
+}
+
+void kmath_fast_sincos_array(const f32* angles, f32* out_sin, f32* out_cos, u32 count)
+{
+    // NOTE: Тело цикла без ветвлений и вызовов, компилятор может его векторизовать.
+    for(u32 i = 0; i < count; ++i)
+    {
+        f32 s, c;
+        kfast_sincos(angles[i], &s, &c);
+        if(out_sin) out_sin[i] = s;
+        if(out_cos) out_cos[i] = c;
+    }
+}
+
+void kmath_quat_from_axis_angle_array(const vec3* axes, const f32* angles, quat* out_quaternions, u32 count)
+{
+    for(u32 i = 0; i < count; ++i)
+    {
+        f32 s, c;
+        kfast_sincos(0.5f * angles[i], &s, &c);
+        out_quaternions[i] = (quat){{ s * axes[i].x, s * axes[i].y, s * axes[i].z, c }};
+    }
+}
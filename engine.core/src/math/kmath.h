@@ -4,6 +4,15 @@
 #include <math/math_types.h>
 #include <platform/math.h>
 
+// Встроенные функции процессора для квадратного корня (вычисляются без вызова функций платформы).
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define KMATH_SQRT_SSE_FLAG 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define KMATH_SQRT_NEON_FLAG 1
+#endif
+
 // Приблизительное представление числа ПИ.
 #define K_PI 3.14159265358979323846f
 
@@ -112,18 +121,30 @@ KINLINE f32 kstep(f32 edge, f32 x)
 #define kacos(x) platform_math_acos(x)
 
 /*
-    @brief Вычисляет квадратный корень числа.
+    @brief Вычисляет квадратный корень числа (встраиваемая версия, результат совпадает с 'platform_math_sqrt').
     @param x Число.
     @return Результирующее значение.
 */
-#define ksqrt(x) platform_math_sqrt(x)
+KINLINE f32 ksqrt(f32 x)
+{
+#if KMATH_SQRT_SSE_FLAG
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(x)));
+#elif KMATH_SQRT_NEON_FLAG
+    return vget_lane_f32(vsqrt_f32(vdup_n_f32(x)), 0);
+#else
+    return platform_math_sqrt(x);
+#endif
+}
 
 /*
-    @brief Вычисляет абсолютное значение числа.
+    @brief Вычисляет абсолютное значение числа (встраиваемая версия).
     @param x Число.
     @return Результирующее значение.
 */
-#define kabs(x) platform_math_abs(x)
+KINLINE f32 kabs(f32 x)
+{
+    return __builtin_fabsf(x);
+}
 
 /*
     @brief Возвращает наибольшее целое значение, меньшее или равное числу.
@@ -154,6 +175,120 @@ KINLINE f32 kstep(f32 edge, f32 x)
 */
 #define kpow(x, p) platform_math_pow(x, p)
 
+/*
+    @brief Вычисляет обратный квадратный корень числа (1 / sqrt(x)).
+    @param x Число.
+    @return Результирующее значение.
+*/
+KINLINE f32 krsqrt(f32 x)
+{
+    return 1.0f / ksqrt(x);
+}
+
+/*
+    @brief Быстро вычисляет приближенный обратный квадратный корень числа (оценка процессора и шаги Ньютона).
+    NOTE: Оценка SSE имеет точность около 12 бит и уточняется одним шагом, оценка NEON - около 8 бит
+          и уточняется двумя шагами; без SIMD используется точная 'krsqrt'. Относительная погрешность
+          не превышает 1e-6 для нормализованных положительных чисел на всех платформах.
+    @param x Число (больше нуля).
+    @return Результирующее значение.
+*/
+KINLINE f32 kfast_rsqrt(f32 x)
+{
+#if KMATH_SQRT_SSE_FLAG
+    f32 y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+#elif KMATH_SQRT_NEON_FLAG
+    float32x2_t v = vdup_n_f32(x);
+    float32x2_t y = vrsqrte_f32(v);
+    y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+    y = vmul_f32(y, vrsqrts_f32(vmul_f32(v, y), y));
+    return vget_lane_f32(y, 0);
+#else
+    return krsqrt(x);
+#endif
+}
+
+/*
+    @brief Приводит угол к диапазону [-pi, pi].
+    NOTE: Погрешность приведения растет с модулем угла, примерно |x| * 6e-8; при |x| >= 2^23 * 2pi
+          фаза не определена и возвращается ноль, для NaN и бесконечностей - NaN.
+    @param x Угол в радианах.
+    @return Угол в радианах в диапазоне [-pi, pi].
+*/
+KINLINE f32 kwrap_angle(f32 x)
+{
+    f32 turns = x * K_ONE_OVER_TWO_PI;
+
+    // Начиная с 2^23 оборотов шаг f32 больше полного оборота и фаза не определена, а приведение
+    // к i32 дальше не определено вовсе. Сравнение через отрицание пропускает и NaN с бесконечностями:
+    // для них x * 0 дает NaN, для конечных углов - ноль.
+    if(!(kabs(turns) < 8388608.0f))
+    {
+        return x * 0.0f;
+    }
+
+    f32 k = (f32)(i32)(turns + (turns >= 0.0f ? 0.5f : -0.5f));
+    return x - k * K_2PI;
+}
+
+/*
+    @brief Вычисляет синус угла из диапазона [-pi/2, pi/2] многочленом (ряд Тейлора до x^11).
+    @param x Угол в радианах.
+    @return Синус угла.
+*/
+KINLINE f32 kfast_sin_half_pi(f32 x)
+{
+    f32 x2 = x * x;
+    f32 p = -2.5052108e-8f;
+    p = p * x2 + 2.7557319e-6f;
+    p = p * x2 - 1.9841270e-4f;
+    p = p * x2 + 8.3333333e-3f;
+    p = p * x2 - 1.6666667e-1f;
+    return x + x * x2 * p;
+}
+
+/*
+    @brief Быстро вычисляет синус и косинус угла без ветвлений и вызова функций платформы.
+    NOTE: Абсолютная погрешность не превышает 5e-7 для |x| <= 2pi, для больших углов добавляется
+          погрешность приведения (см. 'kwrap_angle').
+    @param x Угол в радианах.
+    @param out_sin Указатель на переменную для сохранения синуса.
+    @param out_cos Указатель на переменную для сохранения косинуса.
+*/
+KINLINE void kfast_sincos(f32 x, f32* out_sin, f32* out_cos)
+{
+    f32 r = kwrap_angle(x);
+    f32 a = kabs(r);
+
+    // sin(a) = sin(pi - a), cos(a) = sin(pi/2 - a), аргументы многочлена в [-pi/2, pi/2].
+    f32 s = kfast_sin_half_pi(a > K_HALF_PI ? K_PI - a : a);
+    *out_sin = r < 0.0f ? -s : s;
+    *out_cos = kfast_sin_half_pi(K_HALF_PI - a);
+}
+
+/*
+    @brief Быстро вычисляет синус угла (погрешность см. 'kfast_sincos').
+    @param x Угол в радианах.
+    @return Синус угла.
+*/
+KINLINE f32 kfast_sin(f32 x)
+{
+    f32 s, c;
+    kfast_sincos(x, &s, &c);
+    return s;
+}
+
+/*
+    @brief Быстро вычисляет косинус угла (погрешность см. 'kfast_sincos').
+    @param x Угол в радианах.
+    @return Косинус угла.
+*/
+KINLINE f32 kfast_cos(f32 x)
+{
+    return kfast_sin_half_pi(K_HALF_PI - kabs(kwrap_angle(x)));
+}
+
 /*
     @brief Указывает, является ли значение степенью числа 2.
     NOTE: 0 не считается степенью числа 2.
@@ -2030,6 +2165,14 @@ KAPI frustum frustum_create(
     f32 near, f32 far
 );
 
+/*
+    @brief Извлекает плоскости усеченной пирамиды из матрицы вида/проекции (метод Gribb/Hartmann).
+    NOTE: Матрица в порядке движка: mat4_mul(view, projection). Нормали плоскостей направлены внутрь.
+          Ближняя плоскость соответствует глубине -1 (как в 'mat4_perspective'), что консервативно
+          и для диапазона глубины [0, 1].
+    @param view_projection Объединенная матрица вида/проекции.
+    @return Усеченная пирамида с нормализованными плоскостями.
+*/
 KAPI frustum frustum_from_view_projection(mat4 view_projection);
 
 /*
@@ -2090,6 +2233,29 @@ KAPI bool plane_intersects_aabb(const plane_3d *p, const vec3 *center, const vec
 */
 KAPI bool frustum_intersects_aabb(const frustum *f, const vec3 *center, const vec3 *extents);
 
+/*
+    @brief Вычисляет выровненный по осям ограничивающий прямоугольник в мировом пространстве для локального
+           прямоугольника и матрицы модели (метод Arvo, результат охватывает повернутый прямоугольник).
+    @param extents Указатель на локальные минимальные и максимальные размеры.
+    @param model Матрица модели.
+    @param out_center Указатель для сохранения центра прямоугольника в мировом пространстве.
+    @param out_extents Указатель для сохранения половинных размеров прямоугольника в мировом пространстве.
+*/
+KAPI void aabb_transform(const extents_3d *extents, mat4 model, vec3 *out_center, vec3 *out_extents);
+
+/*
+    @brief Проверяет массив выровненных по осям прямоугольников на пересечение с усеченной пирамидой
+           (по четыре прямоугольника за раз с помощью SIMD).
+    NOTE: Результат для каждого прямоугольника совпадает с 'frustum_intersects_aabb'.
+    @param f Указатель на усеченную пирамиду.
+    @param centers Массив центров прямоугольников.
+    @param extents Массив половинных размеров прямоугольников.
+    @param count Количество прямоугольников.
+    @param out_visible Массив для сохранения результатов (1 - видим, 0 - отсечен).
+    @return Количество видимых прямоугольников.
+*/
+KAPI u32 frustum_intersects_aabb_array(const frustum *f, const vec3 *centers, const vec3 *extents, u32 count, u8 *out_visible);
+
 KINLINE bool rect_2d_contains_point(rect_2d rect, vec2 point)
 {
     return (point.x >= rect.x && point.x <= rect.x + rect.width)
@@ -2127,3 +2293,40 @@ KINLINE bool vertex_3d_equal(vertex_3d lvert, vertex_3d rvert)
            vec4_compare(lvert.color,    rvert.color,    K_FLOAT_EPSILON) &&
            vec3_compare(lvert.tangent,  rvert.tangent,  K_FLOAT_EPSILON);
 }
+
+//------------------------------------ Пакетная обработка -------------------------------------
+
+/*
+    @brief Нормализует массив векторов (по четыре вектора за раз с помощью SIMD).
+    NOTE: Результат совпадает с 'vec3_normalize' для каждого вектора.
+    @param vectors Массив векторов (изменяется).
+    @param count Количество векторов.
+*/
+KAPI void kmath_normalize_vec3_array(vec3* vectors, u32 count);
+
+/*
+    @brief Быстро нормализует массив векторов с помощью 'kfast_rsqrt' и 'ksimd_fast_rsqrt'.
+    NOTE: Относительная погрешность до 1e-6 на SSE и NEON (число шагов Ньютона подобрано под точность оценки).
+    @param vectors Массив векторов (изменяется).
+    @param count Количество векторов.
+*/
+KAPI void kmath_fast_normalize_vec3_array(vec3* vectors, u32 count);
+
+/*
+    @brief Быстро вычисляет синусы и косинусы массива углов (погрешность см. 'kfast_sincos').
+    @param angles Массив углов в радианах.
+    @param out_sin Массив для сохранения синусов (может быть null).
+    @param out_cos Массив для сохранения косинусов (может быть null).
+    @param count Количество углов.
+*/
+KAPI void kmath_fast_sincos_array(const f32* angles, f32* out_sin, f32* out_cos, u32 count);
+
+/*
+    @brief Создает массив кватернионов из осей и углов (как 'quat_from_axis_angle' без нормализации),
+           синусы и косинусы вычисляются с помощью 'kfast_sincos'.
+    @param axes Массив осей вращения (нормализованных).
+    @param angles Массив углов вращения в радианах.
+    @param out_quaternions Массив для сохранения кватернионов.
+    @param count Количество кватернионов.
+*/
+KAPI void kmath_quat_from_axis_angle_array(const vec3* axes, const f32* angles, quat* out_quaternions, u32 count);
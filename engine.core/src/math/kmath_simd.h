@@ -0,0 +1,675 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+#include <math/kmath.h>
+
+/*
+    Выбор набора инструкций во время компиляции:
+      - AVX (-mavx): как SSE, умножение матриц обрабатывает по две строки за инструкцию.
+      - SSE2: всегда доступен на x86_64.
+      - NEON: AArch64.
+      - Скалярная реализация: в остальных случаях или если задан KMATH_SIMD_SCALAR_FLAG.
+*/
+#if !defined(KMATH_SIMD_SCALAR_FLAG) && (defined(__SSE2__) || defined(_M_X64))
+    #include <emmintrin.h>
+    #if defined(__AVX__)
+        #include <immintrin.h>
+        #define KMATH_SIMD_AVX_FLAG 1
+        #define KMATH_SIMD_BACKEND "AVX"
+    #else
+        #define KMATH_SIMD_BACKEND "SSE2"
+    #endif
+    #define KMATH_SIMD_SSE_FLAG 1
+#elif !defined(KMATH_SIMD_SCALAR_FLAG) && defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define KMATH_SIMD_NEON_FLAG 1
+    #define KMATH_SIMD_BACKEND "NEON"
+#else
+    #undef  KMATH_SIMD_SCALAR_FLAG
+    #define KMATH_SIMD_SCALAR_FLAG 1
+    #define KMATH_SIMD_BACKEND "Scalar"
+#endif
+
+//------------------------------------ Регистр из 4х f32 --------------------------------------
+
+#if KMATH_SIMD_SSE_FLAG
+
+    typedef __m128 ksimd_f32x4;
+
+    #define ksimd_load(p)        _mm_load_ps(p)
+    #define ksimd_store(p, v)    _mm_store_ps(p, v)
+    #define ksimd_set1(s)        _mm_set1_ps(s)
+    #define ksimd_set(x, y, z, w) _mm_setr_ps(x, y, z, w)
+    #define ksimd_add(a, b)      _mm_add_ps(a, b)
+    #define ksimd_sub(a, b)      _mm_sub_ps(a, b)
+    #define ksimd_mul(a, b)      _mm_mul_ps(a, b)
+    #define ksimd_div(a, b)      _mm_div_ps(a, b)
+    #define ksimd_min(a, b)      _mm_min_ps(a, b)
+    #define ksimd_max(a, b)      _mm_max_ps(a, b)
+    // Результат: a[i] для элементов где cond[i] >= 0, иначе b[i].
+    #define ksimd_select_nonneg(cond, a, b) ksimd_sse_select(_mm_cmpge_ps(cond, _mm_setzero_ps()), a, b)
+    #define ksimd_sqrt(a)        _mm_sqrt_ps(a)
+    #define ksimd_rsqrt_estimate(a) _mm_rsqrt_ps(a)
+    #define ksimd_get_x(v)       _mm_cvtss_f32(v)
+    // Результат: [a[i0], a[i1], b[i2], b[i3]].
+    #define ksimd_shuffle(a, b, i0, i1, i2, i3) _mm_shuffle_ps(a, b, _MM_SHUFFLE(i3, i2, i1, i0))
+
+    KINLINE __m128 ksimd_sse_select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+#elif KMATH_SIMD_NEON_FLAG
+
+    typedef float32x4_t ksimd_f32x4;
+
+    #define ksimd_load(p)        vld1q_f32(p)
+    #define ksimd_store(p, v)    vst1q_f32(p, v)
+    #define ksimd_set1(s)        vdupq_n_f32(s)
+    #define ksimd_set(x, y, z, w) ((float32x4_t){ x, y, z, w })
+    #define ksimd_add(a, b)      vaddq_f32(a, b)
+    #define ksimd_sub(a, b)      vsubq_f32(a, b)
+    #define ksimd_mul(a, b)      vmulq_f32(a, b)
+    #define ksimd_div(a, b)      vdivq_f32(a, b)
+    #define ksimd_min(a, b)      vminq_f32(a, b)
+    #define ksimd_max(a, b)      vmaxq_f32(a, b)
+    // Результат: a[i] для элементов где cond[i] >= 0, иначе b[i].
+    #define ksimd_select_nonneg(cond, a, b) vbslq_f32(vcgeq_f32(cond, vdupq_n_f32(0.0f)), a, b)
+    #define ksimd_sqrt(a)        vsqrtq_f32(a)
+    #define ksimd_rsqrt_estimate(a) vrsqrteq_f32(a)
+    #define ksimd_get_x(v)       vgetq_lane_f32(v, 0)
+    // Результат: [a[i0], a[i1], b[i2], b[i3]].
+    #define ksimd_shuffle(a, b, i0, i1, i2, i3) __builtin_shufflevector(a, b, i0, i1, 4 + (i2), 4 + (i3))
+
+#else
+
+    typedef struct ksimd_f32x4 {
+        f32 v[4];
+    } ksimd_f32x4;
+
+    KINLINE ksimd_f32x4 ksimd_scalar_load(const f32* p)
+    {
+        return (ksimd_f32x4){{ p[0], p[1], p[2], p[3] }};
+    }
+
+    KINLINE void ksimd_scalar_store(f32* p, ksimd_f32x4 v)
+    {
+        p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2]; p[3] = v.v[3];
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_add(ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{ a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_sub(ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{ a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_mul(ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{ a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_div(ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{ a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_min(ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{ KMIN(a.v[0], b.v[0]), KMIN(a.v[1], b.v[1]), KMIN(a.v[2], b.v[2]), KMIN(a.v[3], b.v[3]) }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_max(ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{ KMAX(a.v[0], b.v[0]), KMAX(a.v[1], b.v[1]), KMAX(a.v[2], b.v[2]), KMAX(a.v[3], b.v[3]) }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_select_nonneg(ksimd_f32x4 cond, ksimd_f32x4 a, ksimd_f32x4 b)
+    {
+        return (ksimd_f32x4){{
+            cond.v[0] >= 0.0f ? a.v[0] : b.v[0], cond.v[1] >= 0.0f ? a.v[1] : b.v[1],
+            cond.v[2] >= 0.0f ? a.v[2] : b.v[2], cond.v[3] >= 0.0f ? a.v[3] : b.v[3]
+        }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_sqrt(ksimd_f32x4 a)
+    {
+        return (ksimd_f32x4){{ ksqrt(a.v[0]), ksqrt(a.v[1]), ksqrt(a.v[2]), ksqrt(a.v[3]) }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_rsqrt_estimate(ksimd_f32x4 a)
+    {
+        return (ksimd_f32x4){{ krsqrt(a.v[0]), krsqrt(a.v[1]), krsqrt(a.v[2]), krsqrt(a.v[3]) }};
+    }
+
+    KINLINE ksimd_f32x4 ksimd_scalar_shuffle(ksimd_f32x4 a, ksimd_f32x4 b, u32 i0, u32 i1, u32 i2, u32 i3)
+    {
+        return (ksimd_f32x4){{ a.v[i0], a.v[i1], b.v[i2], b.v[i3] }};
+    }
+
+    #define ksimd_load(p)        ksimd_scalar_load(p)
+    #define ksimd_store(p, v)    ksimd_scalar_store(p, v)
+    #define ksimd_set1(s)        ((ksimd_f32x4){{ s, s, s, s }})
+    #define ksimd_set(x, y, z, w) ((ksimd_f32x4){{ x, y, z, w }})
+    #define ksimd_add(a, b)      ksimd_scalar_add(a, b)
+    #define ksimd_sub(a, b)      ksimd_scalar_sub(a, b)
+    #define ksimd_mul(a, b)      ksimd_scalar_mul(a, b)
+    #define ksimd_div(a, b)      ksimd_scalar_div(a, b)
+    #define ksimd_min(a, b)      ksimd_scalar_min(a, b)
+    #define ksimd_max(a, b)      ksimd_scalar_max(a, b)
+    // Результат: a[i] для элементов где cond[i] >= 0, иначе b[i].
+    #define ksimd_select_nonneg(cond, a, b) ksimd_scalar_select_nonneg(cond, a, b)
+    #define ksimd_sqrt(a)        ksimd_scalar_sqrt(a)
+    #define ksimd_rsqrt_estimate(a) ksimd_scalar_rsqrt_estimate(a)
+    #define ksimd_get_x(r)       ((r).v[0])
+    // Результат: [a[i0], a[i1], b[i2], b[i3]].
+    #define ksimd_shuffle(a, b, i0, i1, i2, i3) ksimd_scalar_shuffle(a, b, i0, i1, i2, i3)
+
+#endif
+
+// Заполняет все элементы регистра элементом i.
+#define ksimd_splat(v, i) ksimd_shuffle(v, v, i, i, i, i)
+
+/*
+    @brief Быстро вычисляет приближенный обратный квадратный корень элементов (как 'kfast_rsqrt').
+    @param a Регистр (элементы больше нуля).
+    @return Регистр обратных квадратных корней.
+*/
+KINLINE ksimd_f32x4 ksimd_fast_rsqrt(ksimd_f32x4 a)
+{
+#if KMATH_SIMD_NEON_FLAG
+    // Оценка NEON имеет точность около 8 бит и уточняется двумя шагами 'vrsqrtsq_f32'.
+    float32x4_t y = vrsqrteq_f32(a);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(a, y), y));
+    return y;
+#else
+    // Оценка процессора уточняется одним шагом Ньютона: y * (1.5 - 0.5 * a * y * y).
+    ksimd_f32x4 y = ksimd_rsqrt_estimate(a);
+    ksimd_f32x4 ayy = ksimd_mul(ksimd_mul(a, y), y);
+    return ksimd_mul(y, ksimd_sub(ksimd_set1(1.5f), ksimd_mul(ksimd_set1(0.5f), ayy)));
+#endif
+}
+
+/*
+    @brief Вычисляет сумму элементов регистра.
+    @param v Регистр.
+    @return Регистр, все элементы которого равны сумме элементов v.
+*/
+KINLINE ksimd_f32x4 ksimd_sum(ksimd_f32x4 v)
+{
+    ksimd_f32x4 s = ksimd_add(v, ksimd_shuffle(v, v, 1, 0, 3, 2));
+    return ksimd_add(s, ksimd_shuffle(s, s, 2, 3, 0, 1));
+}
+
+/*
+    @brief Транспонирует матрицу из четырех регистров.
+    @param r Массив из четырех регистров (строк), заменяется столбцами.
+*/
+KINLINE void ksimd_transpose(ksimd_f32x4 r[4])
+{
+    ksimd_f32x4 t0 = ksimd_shuffle(r[0], r[1], 0, 1, 0, 1);
+    ksimd_f32x4 t1 = ksimd_shuffle(r[0], r[1], 2, 3, 2, 3);
+    ksimd_f32x4 t2 = ksimd_shuffle(r[2], r[3], 0, 1, 0, 1);
+    ksimd_f32x4 t3 = ksimd_shuffle(r[2], r[3], 2, 3, 2, 3);
+    r[0] = ksimd_shuffle(t0, t2, 0, 2, 0, 2);
+    r[1] = ksimd_shuffle(t0, t2, 1, 3, 1, 3);
+    r[2] = ksimd_shuffle(t1, t3, 0, 2, 0, 2);
+    r[3] = ksimd_shuffle(t1, t3, 1, 3, 1, 3);
+}
+
+//----------------------------------------- vec4a ---------------------------------------------
+
+/*
+    @brief Создает выровненный вектор.
+    @param x Первый элемент.
+    @param y Второй элемент.
+    @param z Третий элемент.
+    @param w Четвертый элемент.
+    @return Выровненный вектор.
+*/
+KINLINE vec4a vec4a_create(f32 x, f32 y, f32 z, f32 w)
+{
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_set(x, y, z, w));
+    return out_vector;
+}
+
+/*
+    @brief Создает выровненный вектор из vec4.
+    @param vector Вектор.
+    @return Выровненный вектор.
+*/
+KINLINE vec4a vec4a_from_vec4(vec4 vector)
+{
+    return vec4a_create(vector.x, vector.y, vector.z, vector.w);
+}
+
+/*
+    @brief Создает vec4 из выровненного вектора.
+    @param vector Выровненный вектор.
+    @return Вектор.
+*/
+KINLINE vec4 vec4a_to_vec4(vec4a vector)
+{
+    return (vec4){{ vector.x, vector.y, vector.z, vector.w }};
+}
+
+/*
+    @brief Складывает два вектора.
+    @param vector_0 Первый вектор.
+    @param vector_1 Второй вектор.
+    @return Результирующий вектор.
+*/
+KINLINE vec4a vec4a_add(vec4a vector_0, vec4a vector_1)
+{
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_add(ksimd_load(vector_0.elements), ksimd_load(vector_1.elements)));
+    return out_vector;
+}
+
+/*
+    @brief Вычитает второй вектор из первого.
+    @param vector_0 Первый вектор.
+    @param vector_1 Второй вектор.
+    @return Результирующий вектор.
+*/
+KINLINE vec4a vec4a_sub(vec4a vector_0, vec4a vector_1)
+{
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_sub(ksimd_load(vector_0.elements), ksimd_load(vector_1.elements)));
+    return out_vector;
+}
+
+/*
+    @brief Поэлементно умножает два вектора.
+    @param vector_0 Первый вектор.
+    @param vector_1 Второй вектор.
+    @return Результирующий вектор.
+*/
+KINLINE vec4a vec4a_mul(vec4a vector_0, vec4a vector_1)
+{
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_mul(ksimd_load(vector_0.elements), ksimd_load(vector_1.elements)));
+    return out_vector;
+}
+
+/*
+    @brief Умножает вектор на скаляр.
+    @param vector Вектор.
+    @param scalar Скаляр.
+    @return Результирующий вектор.
+*/
+KINLINE vec4a vec4a_mul_scalar(vec4a vector, f32 scalar)
+{
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_mul(ksimd_load(vector.elements), ksimd_set1(scalar)));
+    return out_vector;
+}
+
+/*
+    @brief Поэлементно умножает первый вектор на второй и прибавляет третий.
+    @param vector_0 Первый вектор.
+    @param vector_1 Второй вектор.
+    @param vector_2 Третий вектор.
+    @return Результирующий вектор.
+*/
+KINLINE vec4a vec4a_mul_add(vec4a vector_0, vec4a vector_1, vec4a vector_2)
+{
+    vec4a out_vector;
+    ksimd_f32x4 m = ksimd_mul(ksimd_load(vector_0.elements), ksimd_load(vector_1.elements));
+    ksimd_store(out_vector.elements, ksimd_add(m, ksimd_load(vector_2.elements)));
+    return out_vector;
+}
+
+/*
+    @brief Поэлементно делит первый вектор на второй.
+    @param vector_0 Первый вектор.
+    @param vector_1 Второй вектор.
+    @return Результирующий вектор.
+*/
+KINLINE vec4a vec4a_div(vec4a vector_0, vec4a vector_1)
+{
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_div(ksimd_load(vector_0.elements), ksimd_load(vector_1.elements)));
+    return out_vector;
+}
+
+/*
+    @brief Вычисляет скалярное произведение векторов.
+    @param vector_0 Первый вектор.
+    @param vector_1 Второй вектор.
+    @return Скалярное произведение.
+*/
+KINLINE f32 vec4a_dot(vec4a vector_0, vec4a vector_1)
+{
+    return ksimd_get_x(ksimd_sum(ksimd_mul(ksimd_load(vector_0.elements), ksimd_load(vector_1.elements))));
+}
+
+/*
+    @brief Вычисляет квадрат длины вектора.
+    @param vector Вектор.
+    @return Квадрат длины вектора.
+*/
+KINLINE f32 vec4a_length_squared(vec4a vector)
+{
+    return vec4a_dot(vector, vector);
+}
+
+/*
+    @brief Вычисляет длину вектора.
+    @param vector Вектор.
+    @return Длина вектора.
+*/
+KINLINE f32 vec4a_length(vec4a vector)
+{
+    return ksqrt(vec4a_dot(vector, vector));
+}
+
+/*
+    @brief Возвращает нормализованную копию вектора.
+    @param vector Вектор.
+    @return Нормализованный вектор.
+*/
+KINLINE vec4a vec4a_normalized(vec4a vector)
+{
+    return vec4a_mul_scalar(vector, 1.0f / vec4a_length(vector));
+}
+
+//----------------------------------------- mat4a ---------------------------------------------
+
+/*
+    @brief Создает выровненную единичную матрицу.
+    @return Единичная матрица.
+*/
+KINLINE mat4a mat4a_identity()
+{
+    mat4a out_matrix;
+    ksimd_store(out_matrix.rows[0].elements, ksimd_set(1.0f, 0.0f, 0.0f, 0.0f));
+    ksimd_store(out_matrix.rows[1].elements, ksimd_set(0.0f, 1.0f, 0.0f, 0.0f));
+    ksimd_store(out_matrix.rows[2].elements, ksimd_set(0.0f, 0.0f, 1.0f, 0.0f));
+    ksimd_store(out_matrix.rows[3].elements, ksimd_set(0.0f, 0.0f, 0.0f, 1.0f));
+    return out_matrix;
+}
+
+/*
+    @brief Создает выровненную матрицу из mat4.
+    @param matrix Матрица.
+    @return Выровненная матрица.
+*/
+KINLINE mat4a mat4a_from_mat4(mat4 matrix)
+{
+    mat4a out_matrix;
+    for(u32 i = 0; i < 16; ++i)
+    {
+        out_matrix.data[i] = matrix.data[i];
+    }
+    return out_matrix;
+}
+
+/*
+    @brief Создает mat4 из выровненной матрицы.
+    @param matrix Выровненная матрица.
+    @return Матрица.
+*/
+KINLINE mat4 mat4a_to_mat4(mat4a matrix)
+{
+    mat4 out_matrix;
+    for(u32 i = 0; i < 16; ++i)
+    {
+        out_matrix.data[i] = matrix.data[i];
+    }
+    return out_matrix;
+}
+
+/*
+    @brief Перемножает две матрицы 4x4 (как 'mat4_mul').
+    @param matrix_0 Первая матрица.
+    @param matrix_1 Вторая матрица.
+    @return Результирующая матрица.
+*/
+KINLINE mat4a mat4a_mul(mat4a matrix_0, mat4a matrix_1)
+{
+    mat4a out_matrix;
+
+#if KMATH_SIMD_AVX_FLAG
+    // Две строки первой матрицы за раз, строки второй матрицы продублированы в обеих половинах.
+    __m256 b0 = _mm256_broadcast_ps((const __m128*)matrix_1.rows[0].elements);
+    __m256 b1 = _mm256_broadcast_ps((const __m128*)matrix_1.rows[1].elements);
+    __m256 b2 = _mm256_broadcast_ps((const __m128*)matrix_1.rows[2].elements);
+    __m256 b3 = _mm256_broadcast_ps((const __m128*)matrix_1.rows[3].elements);
+
+    for(u32 i = 0; i < 16; i += 8)
+    {
+        __m256 a = _mm256_loadu_ps(&matrix_0.data[i]);
+        __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x00), b0);
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x55), b1));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xAA), b2));
+        r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xFF), b3));
+        _mm256_storeu_ps(&out_matrix.data[i], r);
+    }
+#else
+    ksimd_f32x4 b0 = ksimd_load(matrix_1.rows[0].elements);
+    ksimd_f32x4 b1 = ksimd_load(matrix_1.rows[1].elements);
+    ksimd_f32x4 b2 = ksimd_load(matrix_1.rows[2].elements);
+    ksimd_f32x4 b3 = ksimd_load(matrix_1.rows[3].elements);
+
+    for(u32 i = 0; i < 4; ++i)
+    {
+        // Строка результата - линейная комбинация строк второй матрицы.
+        ksimd_f32x4 a = ksimd_load(matrix_0.rows[i].elements);
+        ksimd_f32x4 r = ksimd_mul(ksimd_splat(a, 0), b0);
+        r = ksimd_add(r, ksimd_mul(ksimd_splat(a, 1), b1));
+        r = ksimd_add(r, ksimd_mul(ksimd_splat(a, 2), b2));
+        r = ksimd_add(r, ksimd_mul(ksimd_splat(a, 3), b3));
+        ksimd_store(out_matrix.rows[i].elements, r);
+    }
+#endif
+
+    return out_matrix;
+}
+
+/*
+    @brief Возвращает транспонированную копию матрицы.
+    @param matrix Матрица.
+    @return Транспонированная матрица.
+*/
+KINLINE mat4a mat4a_transposed(mat4a matrix)
+{
+    ksimd_f32x4 r[4];
+    for(u32 i = 0; i < 4; ++i)
+    {
+        r[i] = ksimd_load(matrix.rows[i].elements);
+    }
+
+    ksimd_transpose(r);
+
+    mat4a out_matrix;
+    for(u32 i = 0; i < 4; ++i)
+    {
+        ksimd_store(out_matrix.rows[i].elements, r[i]);
+    }
+    return out_matrix;
+}
+
+/*
+    @brief Создает обратную матрицу (как 'mat4_inverse').
+    NOTE: Метод алгебраических дополнений, строки матрицы обрабатываются как столбцы, что не меняет
+          результат, так как обратная транспонированной равна транспонированной обратной.
+    @param matrix Матрица.
+    @return Обратная матрица.
+*/
+KINLINE mat4a mat4a_inverse(mat4a matrix)
+{
+    ksimd_f32x4 in0 = ksimd_load(matrix.rows[0].elements);
+    ksimd_f32x4 in1 = ksimd_load(matrix.rows[1].elements);
+    ksimd_f32x4 in2 = ksimd_load(matrix.rows[2].elements);
+    ksimd_f32x4 in3 = ksimd_load(matrix.rows[3].elements);
+
+    // Миноры 2x2 нижних строк: fac = a0 * b0 - a1 * b1 для пар элементов (i, j).
+    #define KMATH_INVERSE_FACTOR(out, i, j)                                      \
+    {                                                                           \
+        ksimd_f32x4 swp0a = ksimd_shuffle(in3, in2, j, j, j, j);                \
+        ksimd_f32x4 swp0b = ksimd_shuffle(in3, in2, i, i, i, i);                \
+        ksimd_f32x4 swp00 = ksimd_shuffle(in2, in1, i, i, i, i);                \
+        ksimd_f32x4 swp01 = ksimd_shuffle(swp0a, swp0a, 0, 0, 0, 2);            \
+        ksimd_f32x4 swp02 = ksimd_shuffle(swp0b, swp0b, 0, 0, 0, 2);            \
+        ksimd_f32x4 swp03 = ksimd_shuffle(in2, in1, j, j, j, j);                \
+        out = ksimd_sub(ksimd_mul(swp00, swp01), ksimd_mul(swp02, swp03));      \
+    }
+
+    ksimd_f32x4 fac0, fac1, fac2, fac3, fac4, fac5;
+    KMATH_INVERSE_FACTOR(fac0, 2, 3);
+    KMATH_INVERSE_FACTOR(fac1, 1, 3);
+    KMATH_INVERSE_FACTOR(fac2, 1, 2);
+    KMATH_INVERSE_FACTOR(fac3, 0, 3);
+    KMATH_INVERSE_FACTOR(fac4, 0, 2);
+    KMATH_INVERSE_FACTOR(fac5, 0, 1);
+    #undef KMATH_INVERSE_FACTOR
+
+    ksimd_f32x4 sign_a = ksimd_set(-1.0f, 1.0f, -1.0f, 1.0f);
+    ksimd_f32x4 sign_b = ksimd_set(1.0f, -1.0f, 1.0f, -1.0f);
+
+    // vecN = [in1[N], in0[N], in0[N], in0[N]].
+    ksimd_f32x4 temp0 = ksimd_shuffle(in1, in0, 0, 0, 0, 0);
+    ksimd_f32x4 vec0 = ksimd_shuffle(temp0, temp0, 0, 2, 2, 2);
+    ksimd_f32x4 temp1 = ksimd_shuffle(in1, in0, 1, 1, 1, 1);
+    ksimd_f32x4 vec1 = ksimd_shuffle(temp1, temp1, 0, 2, 2, 2);
+    ksimd_f32x4 temp2 = ksimd_shuffle(in1, in0, 2, 2, 2, 2);
+    ksimd_f32x4 vec2 = ksimd_shuffle(temp2, temp2, 0, 2, 2, 2);
+    ksimd_f32x4 temp3 = ksimd_shuffle(in1, in0, 3, 3, 3, 3);
+    ksimd_f32x4 vec3 = ksimd_shuffle(temp3, temp3, 0, 2, 2, 2);
+
+    ksimd_f32x4 inv0 = ksimd_add(ksimd_sub(ksimd_mul(vec1, fac0), ksimd_mul(vec2, fac1)), ksimd_mul(vec3, fac2));
+    ksimd_f32x4 inv1 = ksimd_add(ksimd_sub(ksimd_mul(vec0, fac0), ksimd_mul(vec2, fac3)), ksimd_mul(vec3, fac4));
+    ksimd_f32x4 inv2 = ksimd_add(ksimd_sub(ksimd_mul(vec0, fac1), ksimd_mul(vec1, fac3)), ksimd_mul(vec3, fac5));
+    ksimd_f32x4 inv3 = ksimd_add(ksimd_sub(ksimd_mul(vec0, fac2), ksimd_mul(vec1, fac4)), ksimd_mul(vec2, fac5));
+    inv0 = ksimd_mul(sign_b, inv0);
+    inv1 = ksimd_mul(sign_a, inv1);
+    inv2 = ksimd_mul(sign_b, inv2);
+    inv3 = ksimd_mul(sign_a, inv3);
+
+    // Определитель: первая строка, умноженная на первые элементы алгебраических дополнений.
+    ksimd_f32x4 row0 = ksimd_shuffle(inv0, inv1, 0, 0, 0, 0);
+    ksimd_f32x4 row1 = ksimd_shuffle(inv2, inv3, 0, 0, 0, 0);
+    ksimd_f32x4 row2 = ksimd_shuffle(row0, row1, 0, 2, 0, 2);
+    ksimd_f32x4 det = ksimd_sum(ksimd_mul(in0, row2));
+    ksimd_f32x4 rcp = ksimd_div(ksimd_set1(1.0f), det);
+
+    mat4a out_matrix;
+    ksimd_store(out_matrix.rows[0].elements, ksimd_mul(inv0, rcp));
+    ksimd_store(out_matrix.rows[1].elements, ksimd_mul(inv1, rcp));
+    ksimd_store(out_matrix.rows[2].elements, ksimd_mul(inv2, rcp));
+    ksimd_store(out_matrix.rows[3].elements, ksimd_mul(inv3, rcp));
+    return out_matrix;
+}
+
+/*
+    @brief Выполняет m * v (как 'mat4_mul_vec4').
+    @param m Матрица.
+    @param v Вектор.
+    @return Преобразованный вектор.
+*/
+KINLINE vec4a mat4a_mul_vec4a(mat4a m, vec4a v)
+{
+    ksimd_f32x4 vv = ksimd_load(v.elements);
+    ksimd_f32x4 p[4];
+    for(u32 i = 0; i < 4; ++i)
+    {
+        p[i] = ksimd_mul(ksimd_load(m.rows[i].elements), vv);
+    }
+
+    // После транспонирования сумма регистров дает скалярные произведения строк на вектор.
+    ksimd_transpose(p);
+
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, ksimd_add(ksimd_add(p[0], p[1]), ksimd_add(p[2], p[3])));
+    return out_vector;
+}
+
+/*
+    @brief Выполняет v * m (как 'vec4_mul_mat4').
+    @param v Вектор.
+    @param m Матрица.
+    @return Преобразованный вектор.
+*/
+KINLINE vec4a vec4a_mul_mat4a(vec4a v, mat4a m)
+{
+    ksimd_f32x4 vv = ksimd_load(v.elements);
+    ksimd_f32x4 r = ksimd_mul(ksimd_splat(vv, 0), ksimd_load(m.rows[0].elements));
+    r = ksimd_add(r, ksimd_mul(ksimd_splat(vv, 1), ksimd_load(m.rows[1].elements)));
+    r = ksimd_add(r, ksimd_mul(ksimd_splat(vv, 2), ksimd_load(m.rows[2].elements)));
+    r = ksimd_add(r, ksimd_mul(ksimd_splat(vv, 3), ksimd_load(m.rows[3].elements)));
+
+    vec4a out_vector;
+    ksimd_store(out_vector.elements, r);
+    return out_vector;
+}
+
+/*
+    @brief Создает матрицу преобразования из позиции, поворота и масштаба
+           (как mat4_mul(mat4_scale(scale), mat4_mul(quat_to_mat4(rotation), mat4_translation(position)))).
+    @param position Позиция.
+    @param rotation Поворот (нормализуется).
+    @param scale Масштаб.
+    @return Матрица преобразования.
+*/
+KINLINE mat4a mat4a_from_position_rotation_scale(vec3 position, quat rotation, vec3 scale)
+{
+    quat n = quat_normalize(rotation);
+    f32 xx = n.x * n.x, yy = n.y * n.y, zz = n.z * n.z;
+    f32 xy = n.x * n.y, xz = n.x * n.z, yz = n.y * n.z;
+    f32 xw = n.x * n.w, yw = n.y * n.w, zw = n.z * n.w;
+
+    // Строки матрицы поворота масштабируются, строка переноса - позиция.
+    mat4a out_matrix;
+    ksimd_f32x4 r0 = ksimd_set(1.0f - 2.0f * (yy + zz), 2.0f * (xy - zw), 2.0f * (xz + yw), 0.0f);
+    ksimd_f32x4 r1 = ksimd_set(2.0f * (xy + zw), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - xw), 0.0f);
+    ksimd_f32x4 r2 = ksimd_set(2.0f * (xz - yw), 2.0f * (yz + xw), 1.0f - 2.0f * (xx + yy), 0.0f);
+    ksimd_store(out_matrix.rows[0].elements, ksimd_mul(r0, ksimd_set1(scale.x)));
+    ksimd_store(out_matrix.rows[1].elements, ksimd_mul(r1, ksimd_set1(scale.y)));
+    ksimd_store(out_matrix.rows[2].elements, ksimd_mul(r2, ksimd_set1(scale.z)));
+    ksimd_store(out_matrix.rows[3].elements, ksimd_set(position.x, position.y, position.z, 1.0f));
+    return out_matrix;
+}
+
+//----------------------------------------- quata ---------------------------------------------
+
+/*
+    @brief Умножает предоставленные кватернионы (как 'quat_mul').
+    @param q_0 Первый кватернион.
+    @param q_1 Второй кватернион.
+    @return Результирующий кватернион.
+*/
+KINLINE quata quata_mul(quata q_0, quata q_1)
+{
+    ksimd_f32x4 a = ksimd_load(q_0.elements);
+    ksimd_f32x4 b = ksimd_load(q_1.elements);
+
+    // w0 * q1 + x0 * [w1, -z1, y1, -x1] + y0 * [z1, w1, -x1, -y1] + z0 * [-y1, x1, w1, -z1].
+    ksimd_f32x4 r = ksimd_mul(ksimd_splat(a, 3), b);
+    ksimd_f32x4 bx = ksimd_mul(ksimd_shuffle(b, b, 3, 2, 1, 0), ksimd_set(1.0f, -1.0f, 1.0f, -1.0f));
+    ksimd_f32x4 by = ksimd_mul(ksimd_shuffle(b, b, 2, 3, 0, 1), ksimd_set(1.0f, 1.0f, -1.0f, -1.0f));
+    ksimd_f32x4 bz = ksimd_mul(ksimd_shuffle(b, b, 1, 0, 3, 2), ksimd_set(-1.0f, 1.0f, 1.0f, -1.0f));
+    r = ksimd_add(r, ksimd_mul(ksimd_splat(a, 0), bx));
+    r = ksimd_add(r, ksimd_mul(ksimd_splat(a, 1), by));
+    r = ksimd_add(r, ksimd_mul(ksimd_splat(a, 2), bz));
+
+    quata out_quaternion;
+    ksimd_store(out_quaternion.elements, r);
+    return out_quaternion;
+}
+
+/*
+    @brief Возвращает нормализованную копию кватерниона.
+    @param q Кватернион.
+    @return Нормализованный кватернион.
+*/
+KINLINE quata quata_normalize(quata q)
+{
+    return vec4a_normalized(q);
+}
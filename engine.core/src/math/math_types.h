@@ -92,6 +92,19 @@ typedef union uvec4_u {
     };
 } uvec4;
 
+// @brief Вектор из 4х элементов c плавающей точкой, выровненный по 16 байт (для SIMD, смотри math/kmath_simd.h).
+typedef union KALIGN(16) vec4a_u {
+    // @brief Массив из 4х элементов.
+    f32 elements[4];
+    struct {
+        // @brief Элементы вектора.
+        f32 x, y, z, w;
+    };
+} vec4a;
+
+// @brief Кватернион, выровненный по 16 байт (для SIMD).
+typedef vec4a quata;
+
 // @brief Матрица 3х3 из чисел c плавающей точкой.
 typedef union mat3_u {
     // @brief Элементы матрицы.
@@ -104,6 +117,14 @@ typedef union mat4_u {
     f32 data[16];
 } mat4;
 
+// @brief Матрица 4х4 из чисел с плавающей точкой, выровненная по 16 байт (для SIMD, смотри math/kmath_simd.h).
+typedef union KALIGN(16) mat4a_u {
+    // @brief Элементы матрицы (в том же порядке, что и у mat4).
+    f32 data[16];
+    // @brief Строки матрицы.
+    vec4a rows[4];
+} mat4a;
+
 // @brief Представляет размеры 2D-объекта из чисел с плавающей точкой.
 typedef struct extents_2d {
     // @brief Минимальные размеры объекта.
@@ -161,7 +182,7 @@ typedef enum frustum_side {
     FRUSTUM_SIDE_RIGHT  = 2,
     FRUSTUM_SIDE_LEFT   = 3,
     FRUSTUM_SIDE_FAR    = 4,
-    FRUSTUM_SIDE_2BEAR  = 5,
+    FRUSTUM_SIDE_NEAR   = 5,
     FRUSTUM_SIDES_MAX   = 6
 } frustum_side;
 
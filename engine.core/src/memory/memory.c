@@ -439,6 +439,16 @@ ptr memory_system_allocation_count()
     return state_ptr->stats.allocation_count;
 }
 
+ptr memory_system_tag_usage(memory_tag tag)
+{
+    if(is_memory_system_invalid(__FUNCTION__) || tag >= MEMORY_TAGS_MAX)
+    {
+        return 0;
+    }
+
+    return state_ptr->stats.tagged_allocated[tag];
+}
+
 const char* memory_get_unit_for(ptr bytes, f32* out_amount)
 {
     if(bytes >= 1 GiB)
@@ -65,6 +65,13 @@ KAPI const char* memory_system_usage_str();
 */
 KAPI ptr memory_system_allocation_count();
 
+/*
+    @brief Запрашивает объем памяти, выделенной в данный момент с указанным маркером.
+    @param tag Маркер памяти.
+    @return Количество байт памяти.
+*/
+KAPI ptr memory_system_tag_usage(memory_tag tag);
+
 /*
     @brief Запрашивает у системы память с заданными размером и выравниванием.
     @note  В процессе память не обнуляется!
@@ -140,7 +147,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param tag Маркер памяти.
     @return Указатель на запрашиваемый участок памяти.
 */
-#define kallocate_tc(type, count, tag) (type*)memory_allocate(sizeof(type) * count, 1, tag)
+#define kallocate_tc(type, count, tag) (type*)memory_allocate(sizeof(type) * (count), 1, tag)
 
 /*
     @brief Запрашивает память у системы c учетом выравнивания.
@@ -157,7 +164,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param tag Маркер памяти.
     @return Указатель на запрашиваемый участок памяти.
 */
-#define kallocate_aligned_tc(type, count, alignment, tag) (type*)memory_allocate(sizeof(type) * count, alignment, tag)
+#define kallocate_aligned_tc(type, count, alignment, tag) (type*)memory_allocate(sizeof(type) * (count), alignment, tag)
 
 /*
     @brief Запрашивает память у системы, но не выделяет ее.
@@ -174,7 +181,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param tag Маркер памяти.
     @return Указатель на запрашиваемый участок памяти.
 */
-#define kallocate_report_tc(type, count, tag) memory_allocate_report(sizeof(type) * count, tag)
+#define kallocate_report_tc(type, count, tag) memory_allocate_report(sizeof(type) * (count), tag)
 
 /*
     @brief Возвращает память системе.
@@ -197,7 +204,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param count Количество элементов.
     @param tag Маркер памяти.
 */
-#define kfree_report_tc(type, count, tag) memory_free_report(sizeof(type) * count, tag)
+#define kfree_report_tc(type, count, tag) memory_free_report(sizeof(type) * (count), tag)
 
 /*
     @brief Обнуляет байты указанного участа памяти.
@@ -212,7 +219,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param type Тип элемента.
     @param count Количество элементов.
 */
-#define kzero_tc(block, type, count) platform_memory_zero((void*)block, sizeof(type) * count)
+#define kzero_tc(block, type, count) platform_memory_zero((void*)block, sizeof(type) * (count))
 
 /*
     @brief Заполняет байты указаного участка памяти значением.
@@ -229,7 +236,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param count Количество элементов.
     @param value Значение, которым нужно наполнить память.
 */
-#define kset_tc(block, type, count, value) platform_memory_set((void*)block, sizeof(type) * count, value)
+#define kset_tc(block, type, count, value) platform_memory_set((void*)block, sizeof(type) * (count), value)
 
 /*
     @brief Копирует заданное количество байт из одного участка памяти в другой.
@@ -248,7 +255,7 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param type Тип элемента участка памяти.
     @param count Количество элементов заданного типа.
 */
-#define kcopy_tc(dest, src, type, count) platform_memory_copy((void*)dest, (void*)src, sizeof(type) * count)
+#define kcopy_tc(dest, src, type, count) platform_memory_copy((void*)dest, (void*)src, sizeof(type) * (count))
 
 /*
     @brief Копирует заданное количество байт из одного участка памяти в другой.
@@ -267,4 +274,4 @@ KAPI const char* memory_get_unit_for(ptr bytes, f32* out_amount);
     @param type Тип элемента участка памяти.
     @param count Количество элементов заданного типа.
 */
-#define kmove_tc(dest, src, type, count) platform_memory_move((void*)dest, (void*)src, sizeof(type) * count)
+#define kmove_tc(dest, src, type, count) platform_memory_move((void*)dest, (void*)src, sizeof(type) * (count))
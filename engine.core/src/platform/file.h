@@ -12,6 +12,32 @@ typedef enum file_mode {
     FILE_MODE_BINARY = 0x04
 } file_mode;
 
+// @brief Отображение файла в память.
+typedef struct file_mapping {
+    // @brief Указатель на начало отображенных данных файла.
+    const void* data;
+    // @brief Размер отображенных данных в байтах.
+    u64 size;
+} file_mapping;
+
+// @brief Тип записи каталога.
+typedef enum directory_entry_type {
+    DIRECTORY_ENTRY_TYPE_FILE,
+    DIRECTORY_ENTRY_TYPE_DIRECTORY
+} directory_entry_type;
+
+/*
+    @brief Функция обратного вызова для обработки записи каталога.
+    @param name Указатель на строку имени записи (без пути к каталогу).
+    @param type Тип записи каталога.
+    @param user_data Указатель на пользовательские данные.
+    @return True продолжить перечисление, false прервать.
+*/
+typedef bool (*PFN_directory_entry)(const char* name, directory_entry_type type, void* user_data);
+
+// @brief Контекст наблюдения за изменениями в каталогах.
+typedef struct file_watch file_watch;
+
 /*
     @brief Проверяет, существует ли файл по указанному пути.
     @param path Указатель на строку пути к файлу.
@@ -19,6 +45,13 @@ typedef enum file_mode {
 */
 KAPI bool platform_file_exists(const char* path);
 
+/*
+    @brief Удаляет файл по указанному пути.
+    @param path Указатель на строку пути к файлу.
+    @return True файл удален, false не удалось удалить.
+*/
+KAPI bool platform_file_delete(const char* path);
+
 /*
     @brief Открывает файл по указанному пути.
     @param path Указатель на строку пути к файлу.
@@ -89,6 +122,73 @@ KAPI bool platform_file_write(file* file, u64 data_size, const void* data);
 */
 KAPI bool platform_file_read_all_bytes(file* file, void* buffer, u64* out_size);
 
+/*
+    @brief Отображает файл по указанному пути в память только для чтения, без промежуточного копирования.
+    NOTE: Страницы загружаются системой по мере обращения к ним, с подсказкой о последовательном чтении.
+    @param path Указатель на строку пути к файлу.
+    @param out_mapping Указатель на память куда будет сохранено отображение файла.
+    NOTE: Пустому файлу соответствует отображение с data равным null и нулевым размером.
+    @return True файл отображен успешно, false не удалось отобразить.
+*/
+KAPI bool platform_file_map(const char* path, file_mapping* out_mapping);
+
+/*
+    @brief Освобождает отображение файла, полученное с помощью 'platform_file_map'.
+    NOTE: После вызова данные отображения становятся недействительными.
+    @param mapping Указатель на отображение файла.
+*/
+KAPI void platform_file_unmap(file_mapping* mapping);
+
+/*
+    @brief Создает (или перезаписывает) файл заданного размера и отображает его в память для чтения и записи.
+    NOTE: Изменения данных отображения попадают в файл без явной записи, в том числе при аварийном завершении
+          программы. Данные нового файла заполнены нулями. Освобождается с помощью 'platform_file_unmap'.
+    @param path Указатель на строку пути к файлу.
+    @param size Размер файла в байтах.
+    @param out_mapping Указатель на память куда будет сохранено отображение файла (данные доступны для записи).
+    @return True файл отображен успешно, false не удалось создать или отобразить файл.
+*/
+KAPI bool platform_file_map_writable(const char* path, u64 size, file_mapping* out_mapping);
+
+/*
+    @brief Перечисляет записи каталога (без вложенных каталогов и записей '.' и '..').
+    NOTE: Учитываются только обычные файлы и каталоги, прочие записи пропускаются.
+    @param path Указатель на строку пути к каталогу.
+    @param callback Функция, вызываемая для каждой записи каталога.
+    @param user_data Указатель на пользовательские данные, передаваемые в функцию обратного вызова.
+    @return True каталог перечислен полностью, false не удалось открыть каталог или перечисление прервано.
+*/
+KAPI bool platform_directory_list(const char* path, PFN_directory_entry callback, void* user_data);
+
+/*
+    @brief Создает контекст наблюдения за изменениями в каталогах.
+    @param out_watch Указатель на память куда будет сохранен указатель на контекст наблюдения.
+    @return True контекст создан успешно, false наблюдение не поддерживается или не удалось создать.
+*/
+KAPI bool platform_file_watch_create(file_watch** out_watch);
+
+/*
+    @brief Уничтожает контекст наблюдения за изменениями в каталогах.
+    @param watch Указатель на контекст наблюдения.
+*/
+KAPI void platform_file_watch_destroy(file_watch* watch);
+
+/*
+    @brief Добавляет каталог для наблюдения (без вложенных каталогов).
+    @param watch Указатель на контекст наблюдения.
+    @param path Указатель на строку пути к каталогу.
+    @return True каталог добавлен, false не удалось добавить.
+*/
+KAPI bool platform_file_watch_add(file_watch* watch, const char* path);
+
+/*
+    @brief Проверяет, были ли созданы, удалены или переименованы файлы в наблюдаемых каталогах.
+    NOTE: Не блокирует выполнение, накопленные события при этом сбрасываются.
+    @param watch Указатель на контекст наблюдения.
+    @return True обнаружены изменения с момента предыдущей проверки, false изменений нет.
+*/
+KAPI bool platform_file_watch_poll(file_watch* watch);
+
 /*
     @brief Читает все символы из файла.
     NOTE: Буфер нужно выделять достаточный для чтения файла.
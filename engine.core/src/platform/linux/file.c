@@ -10,19 +10,42 @@
     // Внешние подключения.
     #include <stdio.h>
     #include <string.h>
+    #include <fcntl.h>
+    #include <unistd.h>
     #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <sys/inotify.h>
+    #include <dirent.h>
 
     struct file {
         FILE* handle;
         u64 size;
     };
 
+    struct file_watch {
+        i32 fd;
+    };
+
+    // NOTE: События, изменяющие состав файлов каталога (изменение содержимого файлов не учитывается).
+    #define FILE_WATCH_EVENT_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+
     bool platform_file_exists(const char* path)
     {
         struct stat buffer;
         return stat(path, &buffer) == 0;
     }
 
+    bool platform_file_delete(const char* path)
+    {
+        if(!path)
+        {
+            kerror("Function '%s' requires a valid pointer to path.", __FUNCTION__);
+            return false;
+        }
+
+        return unlink(path) == 0;
+    }
+
     bool platform_file_open(const char* path, file_mode mode, file** out_file)
     {
         if(!path || !mode)
@@ -188,4 +211,256 @@
         return *out_size == file->size;
     }
 
+    bool platform_file_map(const char* path, file_mapping* out_mapping)
+    {
+        if(!path || !out_mapping)
+        {
+            kerror("Function '%s' requires a valid pointer to path and out_mapping.", __FUNCTION__);
+            return false;
+        }
+
+        out_mapping->data = null;
+        out_mapping->size = 0;
+
+        i32 fd = open(path, O_RDONLY);
+        if(fd == -1)
+        {
+            kerror("Function '%s': Error opening file '%s'.", __FUNCTION__, path);
+            return false;
+        }
+
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size < 0)
+        {
+            kerror("Function '%s': Failed to get file size of file '%s'.", __FUNCTION__, path);
+            close(fd);
+            return false;
+        }
+
+        // NOTE: Пустой файл не отображается (mmap не принимает нулевой размер), ему соответствует пустое отображение.
+        if(info.st_size == 0)
+        {
+            close(fd);
+            return true;
+        }
+
+        void* data = mmap(null, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // NOTE: Отображение остается действительным и после закрытия дескриптора.
+        close(fd);
+
+        if(data == MAP_FAILED)
+        {
+            kerror("Function '%s': Failed to map file '%s' into memory.", __FUNCTION__, path);
+            return false;
+        }
+
+        // Подсказки системе: файл читается от начала до конца и потребуется целиком.
+        madvise(data, info.st_size, MADV_SEQUENTIAL);
+        madvise(data, info.st_size, MADV_WILLNEED);
+
+        out_mapping->data = data;
+        out_mapping->size = info.st_size;
+        return true;
+    }
+
+    void platform_file_unmap(file_mapping* mapping)
+    {
+        if(!mapping)
+        {
+            kerror("Function '%s' requires a valid pointer to mapping.", __FUNCTION__);
+            return;
+        }
+
+        if(mapping->data)
+        {
+            munmap((void*)mapping->data, mapping->size);
+        }
+
+        mapping->data = null;
+        mapping->size = 0;
+    }
+
+    bool platform_file_map_writable(const char* path, u64 size, file_mapping* out_mapping)
+    {
+        if(!path || !size || !out_mapping)
+        {
+            kerror("Function '%s' requires a valid pointer to path, out_mapping and non-zero size.", __FUNCTION__);
+            return false;
+        }
+
+        out_mapping->data = null;
+        out_mapping->size = 0;
+
+        i32 fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(fd == -1)
+        {
+            kerror("Function '%s': Error creating file '%s'.", __FUNCTION__, path);
+            return false;
+        }
+
+        if(ftruncate(fd, size) != 0)
+        {
+            kerror("Function '%s': Failed to set size of file '%s'.", __FUNCTION__, path);
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(null, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        // NOTE: Отображение остается действительным и после закрытия дескриптора.
+        close(fd);
+
+        if(data == MAP_FAILED)
+        {
+            kerror("Function '%s': Failed to map file '%s' into memory.", __FUNCTION__, path);
+            return false;
+        }
+
+        out_mapping->data = data;
+        out_mapping->size = size;
+        return true;
+    }
+
+    bool platform_directory_list(const char* path, PFN_directory_entry callback, void* user_data)
+    {
+        if(!path || !callback)
+        {
+            kerror("Function '%s' requires a valid pointer to path and callback.", __FUNCTION__);
+            return false;
+        }
+
+        DIR* directory = opendir(path);
+        if(!directory)
+        {
+            kerror("Function '%s': Error opening directory '%s'.", __FUNCTION__, path);
+            return false;
+        }
+
+        bool result = true;
+        struct dirent* entry = null;
+
+        while(result && (entry = readdir(directory)))
+        {
+            const char* name = entry->d_name;
+            if(name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            {
+                continue;
+            }
+
+            u8 type = entry->d_type;
+
+            // NOTE: Не все файловые системы сообщают тип записи, тогда он запрашивается отдельно.
+            if(type == DT_UNKNOWN || type == DT_LNK)
+            {
+                struct stat info;
+                if(fstatat(dirfd(directory), name, &info, 0) != 0)
+                {
+                    continue;
+                }
+
+                type = S_ISDIR(info.st_mode) ? DT_DIR : (S_ISREG(info.st_mode) ? DT_REG : DT_UNKNOWN);
+            }
+
+            if(type == DT_REG)
+            {
+                result = callback(name, DIRECTORY_ENTRY_TYPE_FILE, user_data);
+            }
+            else if(type == DT_DIR)
+            {
+                result = callback(name, DIRECTORY_ENTRY_TYPE_DIRECTORY, user_data);
+            }
+        }
+
+        closedir(directory);
+        return result;
+    }
+
+    bool platform_file_watch_create(file_watch** out_watch)
+    {
+        if(!out_watch)
+        {
+            kerror("Function '%s' requires a valid pointer to out_watch.", __FUNCTION__);
+            return false;
+        }
+
+        i32 fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(fd == -1)
+        {
+            kerror("Function '%s': Failed to initialize inotify.", __FUNCTION__);
+            return false;
+        }
+
+        *out_watch = kallocate_tc(file_watch, 1, MEMORY_TAG_FILE);
+        (*out_watch)->fd = fd;
+        return true;
+    }
+
+    void platform_file_watch_destroy(file_watch* watch)
+    {
+        if(!watch)
+        {
+            kerror("Function '%s' requires a valid pointer to watch.", __FUNCTION__);
+            return;
+        }
+
+        // NOTE: Закрытие дескриптора удаляет и все наблюдения.
+        close(watch->fd);
+        kfree(watch, MEMORY_TAG_FILE);
+    }
+
+    bool platform_file_watch_add(file_watch* watch, const char* path)
+    {
+        if(!watch || !path)
+        {
+            kerror("Function '%s' requires a valid pointer to watch and path.", __FUNCTION__);
+            return false;
+        }
+
+        if(inotify_add_watch(watch->fd, path, FILE_WATCH_EVENT_MASK | IN_ONLYDIR) == -1)
+        {
+            kerror("Function '%s': Failed to watch directory '%s'.", __FUNCTION__, path);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool platform_file_watch_poll(file_watch* watch)
+    {
+        if(!watch)
+        {
+            kerror("Function '%s' requires a valid pointer to watch.", __FUNCTION__);
+            return false;
+        }
+
+        // Буфер выровнен как требует структура события.
+        char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        bool changed = false;
+
+        // Вычитываются все накопленные события, сами события не разбираются.
+        while(true)
+        {
+            ssize_t length = read(watch->fd, buffer, sizeof(buffer));
+            if(length <= 0)
+            {
+                break;
+            }
+
+            for(char* ptr = buffer; ptr < buffer + length;)
+            {
+                const struct inotify_event* event = (const struct inotify_event*)ptr;
+
+                if(event->mask & (FILE_WATCH_EVENT_MASK | IN_Q_OVERFLOW))
+                {
+                    changed = true;
+                }
+
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+
+        return changed;
+    }
+
 #endif
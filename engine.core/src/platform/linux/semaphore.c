@@ -0,0 +1,104 @@
+// Собственные подключения.
+#include "platform/semaphore.h"
+#include "platform/memory.h"
+
+#if KPLATFORM_LINUX_FLAG
+
+    // Внешние подключения.
+    #include <logger.h>
+    #include <errno.h>
+    #include <time.h>
+    #include <semaphore.h>
+
+    bool platform_semaphore_create(u32 initial_count, semaphore* out_semaphore)
+    {
+        if(!out_semaphore)
+        {
+            kerror("Function '%s' required non-null pointer to memory.", __FUNCTION__);
+            return false;
+        }
+
+        sem_t* sem = platform_memory_allocate(sizeof(sem_t));
+        if(sem_init(sem, 0, initial_count) != 0)
+        {
+            kerror("Function '%s' failed to create (errno = %i).", __FUNCTION__, errno);
+            platform_memory_free(sem);
+            return false;
+        }
+
+        out_semaphore->internal_data = sem;
+        return true;
+    }
+
+    void platform_semaphore_destroy(semaphore* semaphore)
+    {
+        if(!semaphore || !semaphore->internal_data)
+        {
+            kerror("Function '%s' required a valid pointer to semaphore.", __FUNCTION__);
+            return;
+        }
+
+        if(sem_destroy((sem_t*)semaphore->internal_data) != 0)
+        {
+            kerror("Function '%s' unable to destroy semaphore (errno = %i).", __FUNCTION__, errno);
+        }
+
+        platform_memory_free(semaphore->internal_data);
+        semaphore->internal_data = null;
+    }
+
+    bool platform_semaphore_signal(semaphore* semaphore)
+    {
+        if(!semaphore || !semaphore->internal_data)
+        {
+            kerror("Function '%s' required a valid pointer to semaphore.", __FUNCTION__);
+            return false;
+        }
+
+        if(sem_post((sem_t*)semaphore->internal_data) != 0)
+        {
+            kerror("Function '%s' unable to signal semaphore (errno = %i).", __FUNCTION__, errno);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool platform_semaphore_wait(semaphore* semaphore, u64 timeout_ms)
+    {
+        if(!semaphore || !semaphore->internal_data)
+        {
+            kerror("Function '%s' required a valid pointer to semaphore.", __FUNCTION__);
+            return false;
+        }
+
+        // NOTE: sem_timedwait принимает абсолютное время по часам CLOCK_REALTIME.
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec  += timeout_ms / 1000;
+        ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if(ts.tv_nsec >= 1000000000)
+        {
+            ts.tv_sec  += 1;
+            ts.tv_nsec -= 1000000000;
+        }
+
+        while(sem_timedwait((sem_t*)semaphore->internal_data, &ts) != 0)
+        {
+            switch(errno)
+            {
+                case EINTR:
+                    // Прервано сигналом, ожидание продолжается.
+                    continue;
+                case ETIMEDOUT:
+                    return false;
+                default:
+                    kerror("Function '%s' an handled error has occurred while waiting a semaphore (errno = %i).", __FUNCTION__, errno);
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+#endif
@@ -9,8 +9,27 @@
     #include <time.h>
     #include <errno.h>
     #include <pthread.h>
+    #include <sched.h>
     #include <sys/sysinfo.h>
 
+    // Параметры запуска потока (освобождаются запущенным потоком).
+    typedef struct platform_thread_start {
+        PFN_thread_entry func;
+        void* params;
+    } platform_thread_start;
+
+    static void* platform_thread_run(void* data)
+    {
+        platform_thread_start start = *(platform_thread_start*)data;
+        platform_memory_free(data);
+
+        u32 result = start.func(start.params);
+
+        // Буфер сообщений потока освобождается для других потоков.
+        logger_thread_release();
+        return (void*)(ptr)result;
+    }
+
     void platform_thread_sleep(u64 time_ms)
     {
         struct timespec ts;
@@ -19,6 +38,11 @@
         nanosleep(&ts, null);
     }
 
+    void platform_thread_yield()
+    {
+        sched_yield();
+    }
+
     i32 platform_thread_get_processor_count()
     {
         // i32 processor_count = get_nprocs_conf();
@@ -37,10 +61,16 @@
             return false;
         }
 
-        i32 result = pthread_create((pthread_t*)&out_thread->thread_id, 0, (void* (*)(void*))func, params);
+        platform_thread_start* start = platform_memory_allocate(sizeof(platform_thread_start));
+        start->func = func;
+        start->params = params;
+
+        i32 result = pthread_create((pthread_t*)&out_thread->thread_id, 0, platform_thread_run, start);
 
         if(result != 0)
         {
+            platform_memory_free(start);
+
             switch(result)
             {
                 case EAGAIN:
@@ -153,6 +183,41 @@
         thread->thread_id = 0;
     }
 
+    bool platform_thread_join(thread* thread)
+    {
+        if(!thread || !thread->internal_data)
+        {
+            kerror("Function '%s' required a valid pointer to thread.", __FUNCTION__);
+            return false;
+        }
+
+        i32 result = pthread_join(*(pthread_t*)thread->internal_data, null);
+        if(result != 0)
+        {
+            switch(result)
+            {
+                case EDEADLK:
+                    kerror("Function '%s' failed to join thead: a deadlock was detected.", __FUNCTION__);
+                    break;
+                case EINVAL:
+                    kerror("Function '%s' failed to join thead: thread is not a joinable thread.", __FUNCTION__);
+                    break;
+                case ESRCH:
+                    kerror("Function '%s' failed to join thead: no thread with the id %#x could be found.", __FUNCTION__, thread->thread_id);
+                    break;
+                default:
+                    kerror("Function '%s' failed to join thead: an unknown error has occurred (errno = %i).", __FUNCTION__, result);
+                    break;
+            }
+            return false;
+        }
+
+        platform_memory_free(thread->internal_data);
+        thread->internal_data = null;
+        thread->thread_id = 0;
+        return true;
+    }
+
     bool platform_thread_is_active(thread* thread)
     {
         if(!thread || !thread->internal_data)
@@ -6,6 +6,50 @@
     // Внешние подключения.
     #include <time.h>
 
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <cpuid.h>
+        #include <x86intrin.h>
+        #define KPLATFORM_TIME_TSC 1
+    #else
+        #define KPLATFORM_TIME_TSC 0
+    #endif
+
+    // Время калибровки частоты TSC в наносекундах.
+    #define TSC_CALIBRATION_TIME_NS 5000000ULL
+
+    // NOTE: Значения вычисляются однократно и одинаково в любом потоке, поэтому гонка при инициализации безопасна.
+    static i32 tsc_available = -1;
+    static u64 ticks_frequency = 0;
+
+    static u64 time_monotonic_ns()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+        return (u64)now.tv_sec * 1000000000ULL + now.tv_nsec;
+    }
+
+    static bool time_tsc_available()
+    {
+        if(tsc_available < 0)
+        {
+            bool invariant = false;
+
+            #if KPLATFORM_TIME_TSC
+                // Инвариантный TSC: частота не зависит от состояния ядра (CPUID 0x80000007, EDX бит 8).
+                u32 eax, ebx, ecx, edx;
+                if(__get_cpuid_max(0x80000000, null) >= 0x80000007)
+                {
+                    __cpuid(0x80000007, eax, ebx, ecx, edx);
+                    invariant = (edx & (1 << 8)) != 0;
+                }
+            #endif
+
+            tsc_available = invariant;
+        }
+
+        return tsc_available;
+    }
+
     f64 platform_time_absolute()
     {
         struct timespec now;
@@ -13,4 +57,46 @@
         return now.tv_sec + now.tv_nsec * 0.000000001;
     }
 
+    u64 platform_time_ticks()
+    {
+        #if KPLATFORM_TIME_TSC
+            if(time_tsc_available())
+            {
+                return __rdtsc();
+            }
+        #endif
+
+        return time_monotonic_ns();
+    }
+
+    u64 platform_time_ticks_frequency()
+    {
+        if(ticks_frequency)
+        {
+            return ticks_frequency;
+        }
+
+        u64 frequency = 1000000000ULL;
+
+        #if KPLATFORM_TIME_TSC
+            if(time_tsc_available())
+            {
+                u64 start_ns = time_monotonic_ns();
+                u64 start_ticks = __rdtsc();
+                u64 elapsed_ns = 0;
+
+                while(elapsed_ns < TSC_CALIBRATION_TIME_NS)
+                {
+                    elapsed_ns = time_monotonic_ns() - start_ns;
+                }
+
+                u64 elapsed_ticks = __rdtsc() - start_ticks;
+                frequency = (u64)((f64)elapsed_ticks * 1000000000.0 / (f64)elapsed_ns);
+            }
+        #endif
+
+        ticks_frequency = frequency;
+        return frequency;
+    }
+
 #endif
@@ -9,6 +9,8 @@
     #include "memory/memory.h"
     #include "input_types.h"
     #include "containers/darray.h"
+    #include "platform/time.h"
+    #include "platform/thread.h"
     #include "window_wayland_xdg.h"
     #include "renderer/vulkan/vulkan_platform.h"
 
@@ -16,6 +18,36 @@
     #include <wayland-client.h>
     #include <vulkan/vulkan.h>
     #include <vulkan/vulkan_wayland.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <sys/eventfd.h>
+
+    // Размер очереди событий окна для потока событий (степень двойки).
+    #define WINDOW_EVENT_QUEUE_SIZE 1024
+
+    typedef enum window_event_type {
+        WINDOW_EVENT_CLOSE,
+        WINDOW_EVENT_RESIZE,
+        WINDOW_EVENT_KEYBOARD_KEY,
+        WINDOW_EVENT_MOUSE_MOVE,
+        WINDOW_EVENT_MOUSE_BUTTON,
+        WINDOW_EVENT_MOUSE_WHEEL,
+        WINDOW_EVENT_FOCUS
+    } window_event_type;
+
+    // Событие окна с временем поступления.
+    typedef struct window_event {
+        window_event_type type;
+        f64 time;
+        union {
+            // Для клавиш клавиатуры и кнопок мышки.
+            struct { u32 code; bool pressed; } key;
+            // Для перемещения курсора и изменения размеров окна.
+            struct { i32 x; i32 y; } position;
+            i32 zdelta;
+            bool focused;
+        };
+    } window_event;
 
     typedef struct platform_window_state {
         // Для работы с окном приложения.
@@ -40,6 +72,23 @@
         PFN_window_handler_focus        on_focus;
         // Флаги состояний.
         bool  do_resize;
+        // NOTE: Размер из последней настройки окна, пишет и читает только принимающий события поток. Размер
+        //       экземпляра окна обновляется при передаче события изменения размера, т.е. в основном потоке.
+        i32   configure_width;
+        i32   configure_height;
+        // Время поступления обрабатываемого события.
+        f64   event_time;
+        // Поток событий (используется если use_event_thread = true).
+        bool  use_event_thread;
+        bool  event_thread_running;
+        bool  event_thread_stopped;
+        i32   event_thread_wake_fd;
+        thread event_thread;
+        // Очередь событий: пишет только поток событий, читает только основной поток (без блокировок).
+        u32   event_queue_write;
+        u32   event_queue_read;
+        bool  event_queue_overflow;
+        window_event event_queue[WINDOW_EVENT_QUEUE_SIZE];
     } platform_window_state;
 
     // Объявления функций (обработчичи событий).
@@ -85,6 +134,10 @@
 
     static const char* message_missing_instance = "Function '%s' requires an instance of window.";
 
+    static void window_event_handle(window* instance, window_event* event);
+    static void window_event_dispatch(window* instance, const window_event* event);
+    static u32 window_event_thread_run(void* params);
+
     bool platform_window_create(u64* memory_requirement, window* instance, window_config* config)
     {
         // TODO: Защита от повтороного вызова для данного экземпляра!
@@ -103,6 +156,8 @@
         instance->width = config->width;
         instance->height = config->height;
         instance->title = config->title;
+        state->configure_width = config->width;
+        state->configure_height = config->height;
 
         // Инициализация WAYLAND клиента.
         if(!(state->wdisplay = wl_display_connect(null)))
@@ -154,6 +209,31 @@
         wl_surface_commit(state->wsurface);
         wl_display_roundtrip(state->wdisplay);
 
+        // Поток событий запускается после первой настройки, дальше события окна читает только он.
+        if(config->use_event_thread)
+        {
+            state->event_thread_wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if(state->event_thread_wake_fd == -1)
+            {
+                kerror("Function '%s': Failed to create event thread wake descriptor.", __FUNCTION__);
+                return false;
+            }
+
+            state->use_event_thread = true;
+            state->event_thread_running = true;
+
+            if(!platform_thread_create(window_event_thread_run, instance, false, &state->event_thread))
+            {
+                kerror("Function '%s': Failed to create window event thread.", __FUNCTION__);
+                close(state->event_thread_wake_fd);
+                state->use_event_thread = false;
+                state->event_thread_running = false;
+                return false;
+            }
+
+            kinfor("Window events are received by a separate thread.");
+        }
+
         return true;
     }
 
@@ -166,6 +246,26 @@
         }
 
         platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
+
+        if(state->use_event_thread)
+        {
+            // Остановка потока событий: флаг и пробуждение из ожидания дескриптора.
+            __atomic_store_n(&state->event_thread_running, false, __ATOMIC_RELEASE);
+            u64 value = 1;
+            if(write(state->event_thread_wake_fd, &value, sizeof(value)) != sizeof(value))
+            {
+                kwarng("Function '%s': Failed to wake window event thread.", __FUNCTION__);
+            }
+
+            if(!platform_thread_join(&state->event_thread))
+            {
+                kwarng("Function '%s': Failed to join window event thread.", __FUNCTION__);
+            }
+
+            close(state->event_thread_wake_fd);
+            state->use_event_thread = false;
+        }
+
         wl_pointer_destroy(state->wpointer);
         wl_keyboard_destroy(state->wkeyboard);
         wl_seat_destroy(state->wseat);
@@ -187,7 +287,167 @@
         }
 
         platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
-        return wl_display_dispatch_pending(state->wdisplay) != INVALID_ID;
+
+        if(!state->use_event_thread)
+        {
+            state->event_time = platform_time_absolute();
+            return wl_display_dispatch_pending(state->wdisplay) != INVALID_ID;
+        }
+
+        // Передача обработчикам всех событий, накопленных потоком событий.
+        u32 write_index = __atomic_load_n(&state->event_queue_write, __ATOMIC_ACQUIRE);
+        u32 read_index = state->event_queue_read;
+
+        while(read_index != write_index)
+        {
+            window_event_dispatch(instance, &state->event_queue[read_index & (WINDOW_EVENT_QUEUE_SIZE - 1)]);
+            read_index++;
+        }
+
+        __atomic_store_n(&state->event_queue_read, read_index, __ATOMIC_RELEASE);
+
+        if(__atomic_exchange_n(&state->event_queue_overflow, false, __ATOMIC_ACQ_REL))
+        {
+            kwarng("Function '%s': Window event queue overflow, some events were lost.", __FUNCTION__);
+        }
+
+        // Поток событий завершается сам только при разрыве соединения с дисплеем.
+        return !__atomic_load_n(&state->event_thread_stopped, __ATOMIC_ACQUIRE);
+    }
+
+    f64 platform_window_event_time(window* instance)
+    {
+        if(!instance)
+        {
+            kerror(message_missing_instance, __FUNCTION__);
+            return 0;
+        }
+
+        platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
+        return state->event_time;
+    }
+
+    void window_event_handle(window* instance, window_event* event)
+    {
+        platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
+
+        if(!state->use_event_thread)
+        {
+            event->time = state->event_time;
+            window_event_dispatch(instance, event);
+            return;
+        }
+
+        // Постановка в очередь (выполняется в потоке событий).
+        event->time = platform_time_absolute();
+
+        u32 write_index = state->event_queue_write;
+        u32 read_index = __atomic_load_n(&state->event_queue_read, __ATOMIC_ACQUIRE);
+
+        if(write_index - read_index >= WINDOW_EVENT_QUEUE_SIZE)
+        {
+            __atomic_store_n(&state->event_queue_overflow, true, __ATOMIC_RELEASE);
+            return;
+        }
+
+        state->event_queue[write_index & (WINDOW_EVENT_QUEUE_SIZE - 1)] = *event;
+        __atomic_store_n(&state->event_queue_write, write_index + 1, __ATOMIC_RELEASE);
+    }
+
+    void window_event_dispatch(window* instance, const window_event* event)
+    {
+        platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
+        state->event_time = event->time;
+
+        switch(event->type)
+        {
+            case WINDOW_EVENT_CLOSE:
+                if(state->on_close) state->on_close();
+                break;
+            case WINDOW_EVENT_RESIZE:
+                instance->width = event->position.x;
+                instance->height = event->position.y;
+                if(state->on_resize) state->on_resize(event->position.x, event->position.y);
+                // FIX: Этим достигается плавность изменения размера.
+                wl_surface_commit(state->wsurface);
+                break;
+            case WINDOW_EVENT_KEYBOARD_KEY:
+                if(state->on_keyboard_key) state->on_keyboard_key(event->key.code, event->key.pressed);
+                break;
+            case WINDOW_EVENT_MOUSE_MOVE:
+                if(state->on_mouse_move) state->on_mouse_move(event->position.x, event->position.y);
+                break;
+            case WINDOW_EVENT_MOUSE_BUTTON:
+                if(state->on_mouse_button) state->on_mouse_button(event->key.code, event->key.pressed);
+                break;
+            case WINDOW_EVENT_MOUSE_WHEEL:
+                if(state->on_mouse_wheel) state->on_mouse_wheel(event->zdelta);
+                break;
+            case WINDOW_EVENT_FOCUS:
+                if(state->on_focus) state->on_focus(event->focused);
+                break;
+        }
+    }
+
+    u32 window_event_thread_run(void* params)
+    {
+        window* instance = params;
+        platform_window_state* state = (void*)((u8*)instance + sizeof(struct window));
+        struct wl_display* display = state->wdisplay;
+
+        struct pollfd fds[2];
+        fds[0].fd = wl_display_get_fd(display);
+        fds[0].events = POLLIN;
+        fds[1].fd = state->event_thread_wake_fd;
+        fds[1].events = POLLIN;
+
+        while(__atomic_load_n(&state->event_thread_running, __ATOMIC_ACQUIRE))
+        {
+            // NOTE: Чтение из сокета дисплея только через prepare_read, чтобы не конфликтовать с другими очередями.
+            while(wl_display_prepare_read(display) != 0)
+            {
+                if(wl_display_dispatch_pending(display) == -1)
+                {
+                    break;
+                }
+            }
+
+            wl_display_flush(display);
+
+            if(poll(fds, 2, -1) <= 0 || (fds[1].revents & POLLIN))
+            {
+                wl_display_cancel_read(display);
+                continue;
+            }
+
+            if(fds[0].revents & POLLIN)
+            {
+                if(wl_display_read_events(display) == -1)
+                {
+                    kerror("Function '%s': Failed to read wayland events, stopping event thread.", __FUNCTION__);
+                    break;
+                }
+            }
+            else
+            {
+                wl_display_cancel_read(display);
+
+                if(fds[0].revents & (POLLERR | POLLHUP))
+                {
+                    kerror("Function '%s': Wayland display connection lost, stopping event thread.", __FUNCTION__);
+                    break;
+                }
+            }
+
+            if(wl_display_dispatch_pending(display) == -1)
+            {
+                kerror("Function '%s': Failed to dispatch wayland events, stopping event thread.", __FUNCTION__);
+                break;
+            }
+        }
+
+        __atomic_store_n(&state->event_thread_stopped, true, __ATOMIC_RELEASE);
+        return 0;
     }
 
     void platform_window_set_on_close_handler(window* instance, PFN_window_handler_close handler)
@@ -312,38 +572,30 @@
 
         if(state->do_resize)
         {
-            if(state->on_resize)
-            {
-                state->on_resize(instance->width, instance->height);
-            }
-
-            // FIX: Этим достигается плавность изменения размера.
-            wl_surface_commit(state->wsurface);
+            window_event event = { .type = WINDOW_EVENT_RESIZE };
+            event.position.x = state->configure_width;
+            event.position.y = state->configure_height;
+            window_event_handle(instance, &event);
             state->do_resize = false;
         }
     }
 
     void xtoplevel_configure(void* data, struct xdg_toplevel* xtoplevel, i32 width, i32 height, struct wl_array* states)
     {
-        window* instance = data;
         platform_window_state* state = (void*)((u8*)data + sizeof(struct window));
 
-        if(width && height && (instance->width != width || instance->height != height))
+        if(width && height && (state->configure_width != width || state->configure_height != height))
         {
             state->do_resize = true;
-            instance->width  = width;
-            instance->height = height;
+            state->configure_width  = width;
+            state->configure_height = height;
         }
     }
 
     void xtoplevel_close(void* data, struct xdg_toplevel* xtoplevel)
     {
-        platform_window_state* state = (void*)((u8*)data + sizeof(struct window));
-
-        if(state->on_close)
-        {
-            state->on_close();
-        }
+        window_event event = { .type = WINDOW_EVENT_CLOSE };
+        window_event_handle(data, &event);
     }
 
     void xtoplevel_configure_bounds(void* data, struct xdg_toplevel* xtoplevel, i32 width, i32 height)
@@ -458,13 +710,10 @@
 
     void kb_key(void* data, struct wl_keyboard* wkeyboard, u32 serial, u32 time, u32 key, u32 state)
     {
-        platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
-        if(wstate->on_keyboard_key)
-        {
-            bool pressed = state == WL_KEYBOARD_KEY_STATE_PRESSED ? true : false;
-            wstate->on_keyboard_key(kb_translate_keycode(key), pressed);
-        }
+        window_event event = { .type = WINDOW_EVENT_KEYBOARD_KEY };
+        event.key.code = kb_translate_keycode(key);
+        event.key.pressed = state == WL_KEYBOARD_KEY_STATE_PRESSED ? true : false;
+        window_event_handle(data, &event);
     }
 
     void kb_mods(void* data, struct wl_keyboard* wkeyboard, u32 serial, u32 depressed, u32 latched, u32 locked, u32 group)
@@ -496,12 +745,9 @@
 
     void pt_enter(void* data, struct wl_pointer* wpointer, u32 serial, struct wl_surface* wsurface, wl_fixed_t x, wl_fixed_t y)
     {
-        platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
-        if(wstate->on_focus)
-        {
-            wstate->on_focus(true);
-        }
+        window_event event = { .type = WINDOW_EVENT_FOCUS };
+        event.focused = true;
+        window_event_handle(data, &event);
 
         // TODO: Сокрытие курсора!
         // wl_pointer_set_cursor(context->wpointer, serial, null, 0, 0);
@@ -509,50 +755,34 @@
 
     void pt_leave(void* data, struct wl_pointer* wpointer, u32 serial, struct wl_surface* wsurface)
     {
-        platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
-        if(wstate->on_focus)
-        {
-            wstate->on_focus(false);
-        }
+        window_event event = { .type = WINDOW_EVENT_FOCUS };
+        event.focused = false;
+        window_event_handle(data, &event);
     }
 
     void pt_motion(void* data, struct wl_pointer* wpointer, u32 time, wl_fixed_t x, wl_fixed_t y)
     {
-        platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-        
         // Преобразование координат.
-        x = wl_fixed_to_int(x);
-        y = wl_fixed_to_int(y);
-
-        if(wstate->on_mouse_move)
-        {
-            wstate->on_mouse_move(x, y);
-        }
+        window_event event = { .type = WINDOW_EVENT_MOUSE_MOVE };
+        event.position.x = wl_fixed_to_int(x);
+        event.position.y = wl_fixed_to_int(y);
+        window_event_handle(data, &event);
     }
 
     void pt_button(void* data, struct wl_pointer* wpointer, u32 serial, u32 time, u32 button, u32 state)
     {
-        platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
-        if(wstate->on_mouse_button)
-        {
-            bool pressed = state == WL_POINTER_BUTTON_STATE_PRESSED ? true : false;
-            wstate->on_mouse_button(pt_translate_btncode(button), pressed);
-        }
+        window_event event = { .type = WINDOW_EVENT_MOUSE_BUTTON };
+        event.key.code = pt_translate_btncode(button);
+        event.key.pressed = state == WL_POINTER_BUTTON_STATE_PRESSED ? true : false;
+        window_event_handle(data, &event);
     }
 
     void pt_axis(void* data, struct wl_pointer* wpointer, u32 time, u32 axis, wl_fixed_t value)
     {
-        platform_window_state* wstate = (void*)((u8*)data + sizeof(struct window));
-
         // Преобразование значения.
-        value = wl_fixed_to_int(value);
-
-        if(wstate->on_mouse_wheel)
-        {
-            wstate->on_mouse_wheel(value);
-        }
+        window_event event = { .type = WINDOW_EVENT_MOUSE_WHEEL };
+        event.zdelta = wl_fixed_to_int(value);
+        window_event_handle(data, &event);
     }
 
     void pt_frame(void* data, struct wl_pointer* wpointer)
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <defines.h>
+
+// @brief Контекст семафора, позволяет потоку ожидать сигнала от другого потока без активного опроса.
+typedef struct semaphore {
+    void* internal_data;
+} semaphore;
+
+/*
+    @brief Создает семафор.
+    @param initial_count Начальное значение счетчика семафора.
+    @param out_semaphore Указатель на память для сохранения созданного семафора.
+    @return True семафор успешно создан, false если не удалось.
+*/
+KAPI bool platform_semaphore_create(u32 initial_count, semaphore* out_semaphore);
+
+/*
+    @brief Уничтожает предоставленный семафор.
+    @param semaphore Указатель на семафор который будет уничтожен.
+*/
+KAPI void platform_semaphore_destroy(semaphore* semaphore);
+
+/*
+    @brief Увеличивает счетчик семафора, пробуждая один ожидающий поток.
+    @param semaphore Указатель на семафор который необходимо просигнализировать.
+    @return True сигнал успешно отправлен, false если не удалось.
+*/
+KAPI bool platform_semaphore_signal(semaphore* semaphore);
+
+/*
+    @brief Ожидает сигнала семафора не дольше заданного времени и уменьшает его счетчик.
+    @param semaphore Указатель на семафор сигнала которого необходимо дождаться.
+    @param timeout_ms Максимальное время ожидания в миллисекундах.
+    @return True сигнал получен, false если истекло время ожидания или произошла ошибка.
+*/
+KAPI bool platform_semaphore_wait(semaphore* semaphore, u64 timeout_ms);
@@ -17,6 +17,11 @@ typedef u32 (*PFN_thread_entry)(void*);
 */
 KAPI void platform_thread_sleep(u64 time_ms);
 
+/*
+    @brief Уступает оставшееся время кванта потока в котором вызывается другим готовым потокам.
+*/
+KAPI void platform_thread_yield();
+
 /*
     @brief Возвращает количество логических ядер процессора.
     @return Количество логических ядер процессора.
@@ -51,6 +56,13 @@ KAPI void platform_thread_detach(thread* thread);
 */
 KAPI void platform_thread_cancel(thread* thread);
 
+/*
+    @brief Ожидает завершения работы потока и освобождает его ресурсы.
+    @param thread Поток завершения которого необходимо дождаться.
+    @return True поток завершен, false если не удалось дождаться.
+*/
+KAPI bool platform_thread_join(thread* thread);
+
 /*
     @brief Проверяет активность потока в данный момент.
     @param thread Поток который необходимо проверить.
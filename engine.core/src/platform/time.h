@@ -7,3 +7,18 @@
     @return Текущее значение таймера в секундах.
 */
 KAPI f64 platform_time_absolute();
+
+/*
+    @brief Возвращает текущее значение счетчика высокого разрешения.
+    NOTE: Предназначено для дешевых замеров в горячих участках кода. Использует счетчик тактов процессора (TSC),
+          если он инвариантный, иначе монотонный системный таймер в наносекундах.
+    @return Текущее значение счетчика в тиках.
+*/
+KAPI u64 platform_time_ticks();
+
+/*
+    @brief Возвращает частоту счетчика высокого разрешения.
+    NOTE: При первом вызове частота TSC калибруется по системному таймеру (несколько миллисекунд).
+    @return Количество тиков в секунду.
+*/
+KAPI u64 platform_time_ticks_frequency();
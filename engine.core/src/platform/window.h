@@ -10,6 +10,9 @@ typedef struct window_config {
     i32 width;
     // @brief Высота окна в пикселях.
     i32 height;
+    // @brief Принимать события окна в отдельном потоке (события ставятся в очередь и передаются обработчикам
+    //        при вызове 'platform_window_dispatch').
+    bool use_event_thread;
 } window_config;
 
 // @brief Контекст окна.
@@ -54,6 +57,15 @@ KAPI void platform_window_destroy(window* instance);
 */
 KAPI bool platform_window_dispatch(window* instance);
 
+/*
+    @brief Возвращает время поступления события, которое передается обработчику в данный момент.
+    NOTE: Имеет смысл только внутри обработчиков событий окна. При приеме событий в отдельном потоке - время приема
+          события потоком, иначе время вызова 'platform_window_dispatch'.
+    @param instance Указатель на выделенную память экземпляра окна.
+    @return Время поступления события в секундах (в шкале 'platform_time_absolute').
+*/
+KAPI f64 platform_window_event_time(window* instance);
+
 /*
     @brief Задает обработчик на закрытие окна.
     @param instance Указатель на выделенную память экземпляра окна.
@@ -0,0 +1,105 @@
+// Собственные подключения.
+#include "renderer/draw_sort.h"
+
+// Внутренние подключения.
+#include "memory/memory.h"
+
+#define DRAW_SORT_RADIX_BITS 8
+#define DRAW_SORT_RADIX_SIZE (1 << DRAW_SORT_RADIX_BITS)
+#define DRAW_SORT_RADIX_PASSES (64 / DRAW_SORT_RADIX_BITS)
+
+// Биты неотрицательного числа с плавающей точкой упорядочены так же, как сами числа.
+static u32 draw_sort_depth_bits(f32 depth)
+{
+    union { f32 f; u32 u; } bits;
+    bits.f = depth > 0.0f ? depth : 0.0f;
+    return bits.u;
+}
+
+u64 draw_sort_key_create(u16 view, draw_sort_layer layer, u32 shader_id, u32 material_id, u32 geometry_id, f32 depth)
+{
+    u64 key = ((u64)(view & 0xf) << 60) | ((u64)(layer & 0xf) << 56);
+    u64 shader = shader_id & 0xff;
+    u64 material = material_id & 0xffff;
+    u64 depth_bits = draw_sort_depth_bits(depth);
+
+    if(layer == DRAW_SORT_LAYER_TRANSPARENT)
+    {
+        // Дальние геометрии раньше ближних.
+        return key | ((~depth_bits & 0xffffffff) << 24) | (shader << 16) | material;
+    }
+
+    // Одинаковые геометрии рядом (для инстансирования), внутри - от ближних к дальним.
+    // NOTE: Идентификаторы от 4096 совпадают в поле с меньшими (см. draw_sort_key_create).
+    u64 geometry = geometry_id & 0xfff;
+    return key | (shader << 48) | (material << 32) | (geometry << 20) | (depth_bits >> 12);
+}
+
+void draw_sort_radix(u32 count, u64* keys, u32* values, u64* temp_keys, u32* temp_values)
+{
+    if(count < 2)
+    {
+        return;
+    }
+
+    // Гистограммы всех разрядов за один проход.
+    u32 histograms[DRAW_SORT_RADIX_PASSES][DRAW_SORT_RADIX_SIZE];
+    kzero_tc(histograms, u32, DRAW_SORT_RADIX_PASSES * DRAW_SORT_RADIX_SIZE);
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        u64 key = keys[i];
+        for(u32 p = 0; p < DRAW_SORT_RADIX_PASSES; ++p)
+        {
+            histograms[p][(key >> (p * DRAW_SORT_RADIX_BITS)) & (DRAW_SORT_RADIX_SIZE - 1)]++;
+        }
+    }
+
+    u64* src_keys = keys;
+    u32* src_values = values;
+    u64* dst_keys = temp_keys;
+    u32* dst_values = temp_values;
+
+    for(u32 p = 0; p < DRAW_SORT_RADIX_PASSES; ++p)
+    {
+        u32* histogram = histograms[p];
+        u32 shift = p * DRAW_SORT_RADIX_BITS;
+
+        // Разряд одинаков у всех ключей: проход ничего не меняет.
+        if(histogram[(src_keys[0] >> shift) & (DRAW_SORT_RADIX_SIZE - 1)] == count)
+        {
+            continue;
+        }
+
+        // Префиксные суммы - начальные позиции корзин.
+        u32 offset = 0;
+        for(u32 b = 0; b < DRAW_SORT_RADIX_SIZE; ++b)
+        {
+            u32 bucket_count = histogram[b];
+            histogram[b] = offset;
+            offset += bucket_count;
+        }
+
+        for(u32 i = 0; i < count; ++i)
+        {
+            u32 position = histogram[(src_keys[i] >> shift) & (DRAW_SORT_RADIX_SIZE - 1)]++;
+            dst_keys[position] = src_keys[i];
+            dst_values[position] = src_values[i];
+        }
+
+        u64* swap_keys = src_keys;
+        src_keys = dst_keys;
+        dst_keys = swap_keys;
+
+        u32* swap_values = src_values;
+        src_values = dst_values;
+        dst_values = swap_values;
+    }
+
+    // Нечетное количество проходов: результат во временных массивах.
+    if(src_keys != keys)
+    {
+        kcopy_tc(keys, src_keys, u64, count);
+        kcopy_tc(values, src_values, u32, count);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <defines.h>
+
+// @brief Слой отрисовки, задает порядок групп геометрий внутри вида.
+typedef enum draw_sort_layer {
+    // @brief Непрозрачные геометрии, сортируются по состоянию (шейдер, материал, геометрия), затем от ближних к дальним.
+    DRAW_SORT_LAYER_OPAQUE = 0,
+    // @brief Прозрачные геометрии, сортируются от дальних к ближним, затем по состоянию.
+    DRAW_SORT_LAYER_TRANSPARENT = 1,
+    DRAW_SORT_LAYER_MAX = 16
+} draw_sort_layer;
+
+/*
+    @brief Создает 64-битный ключ сортировки отрисовки (по возрастанию).
+    NOTE: Разметка ключа (от старших битов к младшим):
+          - непрозрачный слой: вид (4) | слой (4) | шейдер (8) | материал (16) | геометрия (12) | глубина (20);
+          - прозрачный слой:   вид (4) | слой (4) | инвертированная глубина (32) | шейдер (8) | материал (16).
+          Идентификаторы обрезаются до своей разрядности. Непрозрачные отрисовки одной геометрии и материала
+          идут подряд, что позволяет объединять их в инстансированные отрисовки; глубина непрозрачного слоя
+          сравнивается по старшим 20 битам числа, прозрачного - точно.
+          Поле геометрии хранит младшие 12 бит идентификатора: геометрии с идентификаторами, равными по модулю 4096
+          (начиная с 4096), попадают в одно значение поля и могут чередоваться при одинаковых шейдере и материале,
+          тогда их отрисовки перестают идти подряд и не объединяются в инстансированные.
+    @param view Идентификатор вида.
+    @param layer Слой отрисовки.
+    @param shader_id Идентификатор шейдера.
+    @param material_id Идентификатор материала.
+    @param geometry_id Идентификатор геометрии (не влияет на прозрачный слой).
+    @param depth Расстояние до камеры (отрицательные значения считаются нулем).
+    @return Ключ сортировки.
+*/
+KAPI u64 draw_sort_key_create(u16 view, draw_sort_layer layer, u32 shader_id, u32 material_id, u32 geometry_id, f32 depth);
+
+/*
+    @brief Устойчиво сортирует ключи по возрастанию вместе со связанными значениями (поразрядная сортировка LSD).
+    NOTE: Разряды по 8 бит, разряды, одинаковые у всех ключей, пропускаются.
+    @param count Количество элементов.
+    @param keys Массив ключей, после вызова отсортирован.
+    @param values Массив значений (например, индексов отрисовки), переставляется вместе с ключами.
+    @param temp_keys Временный массив ключей размером не меньше count.
+    @param temp_values Временный массив значений размером не меньше count.
+*/
+KAPI void draw_sort_radix(u32 count, u64* keys, u32* values, u64* temp_keys, u32* temp_values);
@@ -0,0 +1,440 @@
+// Собственные подключения.
+#include "renderer/occlusion_buffer.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "math/kmath.h"
+#include "math/kmath_simd.h"
+#include "systems/job_system.h"
+
+// NOTE: Размер плитки иерархии глубины, одна строка плиток растеризуется одним заданием.
+#define OCCLUSION_TILE_SIZE 8
+// NOTE: Относительный запас глубины, чтобы объект не перекрывал сам себя своим же окклюдером.
+#define OCCLUSION_DEPTH_BIAS 0.001f
+
+// Треугольник окклюдера в пространстве экрана.
+typedef struct occlusion_triangle {
+    // Коэффициенты функций ребер: E(x, y) = a * x + b * y + c.
+    f32 edge_a[3];
+    f32 edge_b[3];
+    f32 edge_c[3];
+    // Коэффициенты обратной глубины: D(x, y) = a * x + b * y + c.
+    f32 depth_a;
+    f32 depth_b;
+    f32 depth_c;
+    // Диапазон обратной глубины вершин (ограничивает погрешность интерполяции у вырожденных треугольников).
+    f32 depth_min;
+    f32 depth_max;
+    // Границы треугольника в пикселях.
+    i32 min_x;
+    i32 max_x;
+    i32 min_y;
+    i32 max_y;
+} occlusion_triangle;
+
+struct occlusion_buffer {
+    u32 width;
+    u32 height;
+    u32 tile_count_x;
+    u32 tile_count_y;
+    u32 max_triangle_count;
+    u32 triangle_count;
+    f32 near_clip;
+    mat4 view_projection;
+    // Обратная глубина 1/w ближайшего окклюдера в каждом пикселе (0 - окклюдеров нет).
+    f32* depth;
+    // Минимальная (самая дальняя) обратная глубина в каждой плитке.
+    f32* tile_min;
+    occlusion_triangle* triangles;
+};
+
+// Индексы треугольников прямоугольника (вершины как в 'occlusion_box_corners').
+static const u32 occlusion_box_indices[36] = {
+    0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,
+    0, 4, 5, 0, 5, 1,  2, 3, 7, 2, 7, 6,
+    0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3
+};
+
+static bool occlusion_buffer_valid(occlusion_buffer* buffer, const char* func_name)
+{
+    if(!buffer || !buffer->depth)
+    {
+        if(func_name) kerror("Function '%s' requires a valid pointer to occlusion buffer.", func_name);
+        return false;
+    }
+    return true;
+}
+
+static void occlusion_box_corners(const extents_3d* extents, vec3* out_corners)
+{
+    for(u32 i = 0; i < 8; ++i)
+    {
+        out_corners[i].x = (i & 4) ? extents->max.x : extents->min.x;
+        out_corners[i].y = (i & 2) ? extents->max.y : extents->min.y;
+        out_corners[i].z = (i & 1) ? extents->max.z : extents->min.z;
+    }
+}
+
+bool occlusion_buffer_create(u64* memory_requirement, void* memory, occlusion_buffer_config* config, occlusion_buffer** out_buffer)
+{
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->width || !config->height || config->width % OCCLUSION_TILE_SIZE || config->height % OCCLUSION_TILE_SIZE)
+    {
+        kerror("Function '%s': Buffer size must be a non-zero multiple of %u.", __FUNCTION__, OCCLUSION_TILE_SIZE);
+        return false;
+    }
+
+    u32 tile_count = (config->width / OCCLUSION_TILE_SIZE) * (config->height / OCCLUSION_TILE_SIZE);
+    u64 depth_size = sizeof(f32) * config->width * config->height;
+    u64 tile_size = sizeof(f32) * tile_count;
+    u64 triangle_size = sizeof(occlusion_triangle) * config->max_triangle_count;
+
+    // NOTE: Дополнительные 16 байт для выравнивания буфера глубины под SIMD.
+    *memory_requirement = sizeof(occlusion_buffer) + 16 + depth_size + tile_size + triangle_size;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    if(!out_buffer)
+    {
+        kerror("Function '%s' requires a valid pointer to save pointer of occlusion buffer.", __FUNCTION__);
+        return false;
+    }
+
+    kzero(memory, *memory_requirement);
+    occlusion_buffer* buffer = memory;
+
+    buffer->width = config->width;
+    buffer->height = config->height;
+    buffer->tile_count_x = config->width / OCCLUSION_TILE_SIZE;
+    buffer->tile_count_y = config->height / OCCLUSION_TILE_SIZE;
+    buffer->max_triangle_count = config->max_triangle_count;
+    buffer->view_projection = mat4_identity();
+
+    ptr depth_address = get_aligned((ptr)memory + sizeof(occlusion_buffer), 16);
+    buffer->depth = (f32*)depth_address;
+    buffer->tile_min = (f32*)(depth_address + depth_size);
+    buffer->triangles = (occlusion_triangle*)(depth_address + depth_size + tile_size);
+
+    *out_buffer = buffer;
+    return true;
+}
+
+void occlusion_buffer_destroy(occlusion_buffer* buffer)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__)) return;
+
+    buffer->depth = null;
+    buffer->tile_min = null;
+    buffer->triangles = null;
+    buffer->triangle_count = 0;
+}
+
+void occlusion_buffer_begin(occlusion_buffer* buffer, mat4 view_projection, f32 near_clip)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__)) return;
+
+    buffer->view_projection = view_projection;
+    buffer->near_clip = near_clip;
+    buffer->triangle_count = 0;
+}
+
+// Переводит вершину в пространство экрана: x, y в пикселях, z = 1/w. False если вершина перед ближней плоскостью.
+static bool occlusion_project(occlusion_buffer* buffer, vec3 position, mat4 model_view_projection, vec3* out_screen)
+{
+    vec4 clip = vec4_mul_mat4(vec4_from_vec3(position, 1.0f), model_view_projection);
+    if(clip.w < buffer->near_clip)
+    {
+        return false;
+    }
+
+    f32 inv_w = 1.0f / clip.w;
+    out_screen->x = (clip.x * inv_w * 0.5f + 0.5f) * buffer->width;
+    out_screen->y = (clip.y * inv_w * 0.5f + 0.5f) * buffer->height;
+    out_screen->z = inv_w;
+    return true;
+}
+
+// Подготавливает треугольник к растеризации (функции ребер и плоскость глубины).
+static void occlusion_setup_triangle(occlusion_buffer* buffer, vec3 v0, vec3 v1, vec3 v2)
+{
+    // Обход против часовой стрелки, вырожденные треугольники пропускаются.
+    f32 area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if(kabs(area) < K_FLOAT_EPSILON)
+    {
+        return;
+    }
+    if(area < 0.0f)
+    {
+        vec3 t = v1;
+        v1 = v2;
+        v2 = t;
+        area = -area;
+    }
+
+    f32 min_x = KMIN(v0.x, KMIN(v1.x, v2.x));
+    f32 max_x = KMAX(v0.x, KMAX(v1.x, v2.x));
+    f32 min_y = KMIN(v0.y, KMIN(v1.y, v2.y));
+    f32 max_y = KMAX(v0.y, KMAX(v1.y, v2.y));
+    if(max_x < 0.0f || max_y < 0.0f || min_x >= buffer->width || min_y >= buffer->height)
+    {
+        return;
+    }
+
+    occlusion_triangle* t = &buffer->triangles[buffer->triangle_count++];
+    t->min_x = KMAX((i32)min_x, 0);
+    t->max_x = KMIN((i32)max_x, (i32)buffer->width - 1);
+    t->min_y = KMAX((i32)min_y, 0);
+    t->max_y = KMIN((i32)max_y, (i32)buffer->height - 1);
+
+    // Ребро i противоположно вершине i, значение функции ребра равно барицентрической координате * area.
+    vec3 v[3] = { v0, v1, v2 };
+    f32 inv_area = 1.0f / area;
+    t->depth_min = KMIN(v0.z, KMIN(v1.z, v2.z));
+    t->depth_max = KMAX(v0.z, KMAX(v1.z, v2.z));
+    t->depth_a = t->depth_b = t->depth_c = 0.0f;
+    for(u32 i = 0; i < 3; ++i)
+    {
+        vec3 a = v[(i + 1) % 3];
+        vec3 b = v[(i + 2) % 3];
+        t->edge_a[i] = -(b.y - a.y);
+        t->edge_b[i] = b.x - a.x;
+        t->edge_c[i] = -(t->edge_a[i] * a.x + t->edge_b[i] * a.y);
+
+        t->depth_a += v[i].z * t->edge_a[i] * inv_area;
+        t->depth_b += v[i].z * t->edge_b[i] * inv_area;
+        t->depth_c += v[i].z * t->edge_c[i] * inv_area;
+    }
+}
+
+bool occlusion_buffer_add_occluder(occlusion_buffer* buffer, const occluder* o)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__)) return false;
+
+    if(!o)
+    {
+        kerror("Function '%s' requires a valid pointer to occluder.", __FUNCTION__);
+        return false;
+    }
+
+    vec3 box_corners[8];
+    const vec3* vertices = o->vertices;
+    const u32* indices = o->indices;
+    u32 index_count = o->index_count;
+
+    if(!vertices)
+    {
+        occlusion_box_corners(&o->extents, box_corners);
+        vertices = box_corners;
+        indices = occlusion_box_indices;
+        index_count = 36;
+    }
+
+    mat4 model_view_projection = mat4_mul(o->model, buffer->view_projection);
+
+    for(u32 i = 0; i + 2 < index_count; i += 3)
+    {
+        if(buffer->triangle_count >= buffer->max_triangle_count)
+        {
+            kwarng("Function '%s': Max triangle count %u reached, occluder truncated.", __FUNCTION__, buffer->max_triangle_count);
+            return false;
+        }
+
+        // NOTE: Отсечение по ближней плоскости не выполняется: такие треугольники не участвуют (консервативно).
+        vec3 s0, s1, s2;
+        if(occlusion_project(buffer, vertices[indices[i]], model_view_projection, &s0)
+        && occlusion_project(buffer, vertices[indices[i + 1]], model_view_projection, &s1)
+        && occlusion_project(buffer, vertices[indices[i + 2]], model_view_projection, &s2))
+        {
+            occlusion_setup_triangle(buffer, s0, s1, s2);
+        }
+    }
+
+    return true;
+}
+
+// Растеризует все треугольники в строки плиток [begin, end) и обновляет их минимальную глубину.
+static void occlusion_rasterize_bands(void* context, u32 begin, u32 end)
+{
+    occlusion_buffer* buffer = context;
+    ksimd_f32x4 pixel_offsets = ksimd_set(0.5f, 1.5f, 2.5f, 3.5f);
+
+    for(u32 band = begin; band < end; ++band)
+    {
+        i32 band_min_y = band * OCCLUSION_TILE_SIZE;
+        i32 band_max_y = band_min_y + OCCLUSION_TILE_SIZE - 1;
+
+        f32* band_depth = buffer->depth + band_min_y * buffer->width;
+        kzero_tc(band_depth, f32, buffer->width * OCCLUSION_TILE_SIZE);
+
+        for(u32 t = 0; t < buffer->triangle_count; ++t)
+        {
+            occlusion_triangle* tri = &buffer->triangles[t];
+            i32 min_y = KMAX(tri->min_y, band_min_y);
+            i32 max_y = KMIN(tri->max_y, band_max_y);
+            if(min_y > max_y)
+            {
+                continue;
+            }
+
+            // Начало строки выровнено на 4 пикселя.
+            i32 min_x = tri->min_x & ~3;
+
+            ksimd_f32x4 edge_a0 = ksimd_set1(tri->edge_a[0]);
+            ksimd_f32x4 edge_a1 = ksimd_set1(tri->edge_a[1]);
+            ksimd_f32x4 edge_a2 = ksimd_set1(tri->edge_a[2]);
+            ksimd_f32x4 depth_a = ksimd_set1(tri->depth_a);
+            ksimd_f32x4 depth_min = ksimd_set1(tri->depth_min);
+            ksimd_f32x4 depth_max = ksimd_set1(tri->depth_max);
+
+            for(i32 y = min_y; y <= max_y; ++y)
+            {
+                f32 py = y + 0.5f;
+                ksimd_f32x4 row_e0 = ksimd_set1(tri->edge_b[0] * py + tri->edge_c[0]);
+                ksimd_f32x4 row_e1 = ksimd_set1(tri->edge_b[1] * py + tri->edge_c[1]);
+                ksimd_f32x4 row_e2 = ksimd_set1(tri->edge_b[2] * py + tri->edge_c[2]);
+                ksimd_f32x4 row_depth = ksimd_set1(tri->depth_b * py + tri->depth_c);
+                f32* row = buffer->depth + y * buffer->width;
+
+                for(i32 x = min_x; x <= tri->max_x; x += 4)
+                {
+                    ksimd_f32x4 px = ksimd_add(ksimd_set1((f32)x), pixel_offsets);
+                    ksimd_f32x4 e0 = ksimd_add(ksimd_mul(edge_a0, px), row_e0);
+                    ksimd_f32x4 e1 = ksimd_add(ksimd_mul(edge_a1, px), row_e1);
+                    ksimd_f32x4 e2 = ksimd_add(ksimd_mul(edge_a2, px), row_e2);
+                    ksimd_f32x4 inside = ksimd_min(e0, ksimd_min(e1, e2));
+
+                    ksimd_f32x4 depth = ksimd_add(ksimd_mul(depth_a, px), row_depth);
+                    depth = ksimd_max(ksimd_min(depth, depth_max), depth_min);
+                    ksimd_f32x4 old = ksimd_load(row + x);
+                    ksimd_store(row + x, ksimd_select_nonneg(inside, ksimd_max(old, depth), old));
+                }
+            }
+        }
+
+        // Минимальная глубина плиток полосы.
+        for(u32 tx = 0; tx < buffer->tile_count_x; ++tx)
+        {
+            ksimd_f32x4 tile_min = ksimd_set1(K_FLOAT_MAX);
+            for(i32 y = band_min_y; y <= band_max_y; ++y)
+            {
+                f32* row = buffer->depth + y * buffer->width + tx * OCCLUSION_TILE_SIZE;
+                tile_min = ksimd_min(tile_min, ksimd_min(ksimd_load(row), ksimd_load(row + 4)));
+            }
+
+            KALIGN(16) f32 values[4];
+            ksimd_store(values, tile_min);
+            buffer->tile_min[band * buffer->tile_count_x + tx] = KMIN(KMIN(values[0], values[1]), KMIN(values[2], values[3]));
+        }
+    }
+}
+
+void occlusion_buffer_rasterize(occlusion_buffer* buffer)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__)) return;
+
+    job_system_parallel_for(buffer->tile_count_y, 1, occlusion_rasterize_bands, buffer);
+}
+
+bool occlusion_buffer_test_aabb(occlusion_buffer* buffer, const vec3* center, const vec3* extents)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__) || !center || !extents) return true;
+
+    // Границы прямоугольника на экране и ближайшая точка (максимальная обратная глубина).
+    f32 min_x = K_FLOAT_MAX, min_y = K_FLOAT_MAX;
+    f32 max_x = -K_FLOAT_MAX, max_y = -K_FLOAT_MAX;
+    f32 nearest = 0.0f;
+
+    extents_3d box = { vec3_sub(*center, *extents), vec3_add(*center, *extents) };
+    vec3 corners[8];
+    occlusion_box_corners(&box, corners);
+
+    for(u32 i = 0; i < 8; ++i)
+    {
+        vec3 screen;
+        if(!occlusion_project(buffer, corners[i], buffer->view_projection, &screen))
+        {
+            return true;
+        }
+
+        min_x = KMIN(min_x, screen.x);
+        max_x = KMAX(max_x, screen.x);
+        min_y = KMIN(min_y, screen.y);
+        max_y = KMAX(max_y, screen.y);
+        nearest = KMAX(nearest, screen.z);
+    }
+
+    if(max_x < 0.0f || max_y < 0.0f || min_x >= buffer->width || min_y >= buffer->height)
+    {
+        return true;
+    }
+
+    i32 x0 = KMAX((i32)min_x, 0);
+    i32 x1 = KMIN((i32)max_x, (i32)buffer->width - 1);
+    i32 y0 = KMAX((i32)min_y, 0);
+    i32 y1 = KMIN((i32)max_y, (i32)buffer->height - 1);
+
+    // Объект перекрыт, если все окклюдеры в его области ближе него.
+    f32 threshold = nearest * (1.0f + OCCLUSION_DEPTH_BIAS);
+
+    for(i32 ty = y0 / OCCLUSION_TILE_SIZE; ty <= y1 / OCCLUSION_TILE_SIZE; ++ty)
+    {
+        for(i32 tx = x0 / OCCLUSION_TILE_SIZE; tx <= x1 / OCCLUSION_TILE_SIZE; ++tx)
+        {
+            if(buffer->tile_min[ty * buffer->tile_count_x + tx] > threshold)
+            {
+                continue;
+            }
+
+            // Плитка перекрыта частично: проверка пикселей внутри области.
+            i32 py0 = KMAX(y0, ty * OCCLUSION_TILE_SIZE);
+            i32 py1 = KMIN(y1, ty * OCCLUSION_TILE_SIZE + OCCLUSION_TILE_SIZE - 1);
+            i32 px0 = KMAX(x0, tx * OCCLUSION_TILE_SIZE);
+            i32 px1 = KMIN(x1, tx * OCCLUSION_TILE_SIZE + OCCLUSION_TILE_SIZE - 1);
+
+            for(i32 y = py0; y <= py1; ++y)
+            {
+                const f32* row = buffer->depth + y * buffer->width;
+                for(i32 x = px0; x <= px1; ++x)
+                {
+                    if(row[x] <= threshold)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+u32 occlusion_buffer_test_aabb_array(occlusion_buffer* buffer, const vec3* centers, const vec3* extents, u32 count, u8* visible)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__) || !centers || !extents || !visible) return 0;
+
+    u32 occluded_count = 0;
+    for(u32 i = 0; i < count; ++i)
+    {
+        if(visible[i] && !occlusion_buffer_test_aabb(buffer, &centers[i], &extents[i]))
+        {
+            visible[i] = 0;
+            occluded_count++;
+        }
+    }
+    return occluded_count;
+}
+
+f32 occlusion_buffer_get_depth(occlusion_buffer* buffer, u32 x, u32 y)
+{
+    if(!occlusion_buffer_valid(buffer, __FUNCTION__) || x >= buffer->width || y >= buffer->height) return 0.0f;
+    return buffer->depth[y * buffer->width + x];
+}
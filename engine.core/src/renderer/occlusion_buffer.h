@@ -0,0 +1,103 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+
+// @brief Контекст программного буфера глубины для отсечения перекрытых объектов.
+typedef struct occlusion_buffer occlusion_buffer;
+
+// @brief Конфигурация буфера перекрытия.
+typedef struct occlusion_buffer_config {
+    // @brief Ширина буфера в пикселях (кратна 8).
+    u32 width;
+    // @brief Высота буфера в пикселях (кратна 8).
+    u32 height;
+    // @brief Максимальное количество треугольников окклюдеров за кадр.
+    u32 max_triangle_count;
+} occlusion_buffer_config;
+
+// @brief Окклюдер - геометрия, не выходящая за поверхность видимого объекта (например, подмножество его треугольников).
+typedef struct occluder {
+    // @brief Вершины в локальном пространстве, null если окклюдер задан прямоугольником 'extents'.
+    const vec3* vertices;
+    // @brief Количество вершин.
+    u32 vertex_count;
+    // @brief Индексы треугольников.
+    const u32* indices;
+    // @brief Количество индексов (кратно 3).
+    u32 index_count;
+    // @brief Прямоугольник в локальном пространстве (используется если 'vertices' равен null).
+    extents_3d extents;
+    // @brief Матрица модели.
+    mat4 model;
+} occluder;
+
+/*
+    @brief Создает буфер перекрытия, вызывается дважды: первый раз для получения требований к памяти, второй для создания.
+    @param memory_requirement Указатель на переменную для получения требований к памяти.
+    @param memory Указатель на выделенную память, для получения требований к памяти передать null.
+    @param config Конфигурация буфера.
+    @param out_buffer Указатель для сохранения указателя на буфер.
+    @return True операция завершилась успешно, false операция завершилась неудачей.
+*/
+KAPI bool occlusion_buffer_create(u64* memory_requirement, void* memory, occlusion_buffer_config* config, occlusion_buffer** out_buffer);
+
+/*
+    @brief Уничтожает буфер перекрытия.
+    @param buffer Указатель на буфер.
+*/
+KAPI void occlusion_buffer_destroy(occlusion_buffer* buffer);
+
+/*
+    @brief Начинает новый кадр: очищает список окклюдеров и задает матрицу вида/проекции.
+    @param buffer Указатель на буфер.
+    @param view_projection Объединенная матрица вида/проекции (mat4_mul(view, projection)).
+    @param near_clip Расстояние до ближней плоскости отсечения.
+*/
+KAPI void occlusion_buffer_begin(occlusion_buffer* buffer, mat4 view_projection, f32 near_clip);
+
+/*
+    @brief Добавляет окклюдер в текущий кадр (треугольники, пересекающие ближнюю плоскость, пропускаются).
+    @param buffer Указатель на буфер.
+    @param o Указатель на окклюдер.
+    @return True если окклюдер добавлен полностью, false если превышено количество треугольников.
+*/
+KAPI bool occlusion_buffer_add_occluder(occlusion_buffer* buffer, const occluder* o);
+
+/*
+    @brief Растеризует окклюдеры текущего кадра и строит иерархию глубины.
+    NOTE: Строки буфера делятся на полосы, которые растеризуются параллельно системой заданий
+          (если она запущена), каждая полоса по 4 пикселя за раз с помощью SIMD.
+    @param buffer Указатель на буфер.
+*/
+KAPI void occlusion_buffer_rasterize(occlusion_buffer* buffer);
+
+/*
+    @brief Проверяет, может ли быть виден выровненный по осям прямоугольник.
+    NOTE: Проверка консервативная: прямоугольники за ближней плоскостью или вне экрана считаются видимыми.
+    @param buffer Указатель на буфер.
+    @param center Центр прямоугольника в мировом пространстве.
+    @param extents Половинные размеры прямоугольника.
+    @return True если прямоугольник может быть виден, false если полностью перекрыт.
+*/
+KAPI bool occlusion_buffer_test_aabb(occlusion_buffer* buffer, const vec3* center, const vec3* extents);
+
+/*
+    @brief Проверяет массив прямоугольников, отмеченных видимыми, и снимает отметку с перекрытых.
+    @param buffer Указатель на буфер.
+    @param centers Массив центров прямоугольников.
+    @param extents Массив половинных размеров прямоугольников.
+    @param count Количество прямоугольников.
+    @param visible Массив отметок видимости (1 - проверяется, 0 - пропускается).
+    @return Количество перекрытых прямоугольников.
+*/
+KAPI u32 occlusion_buffer_test_aabb_array(occlusion_buffer* buffer, const vec3* centers, const vec3* extents, u32 count, u8* visible);
+
+/*
+    @brief Получает значение буфера в пикселе (для отладки и тестов).
+    @param buffer Указатель на буфер.
+    @param x Координата пикселя по горизонтали.
+    @param y Координата пикселя по вертикали (0 - низ экрана).
+    @return Обратная глубина 1/w ближайшего окклюдера, 0 если окклюдеров нет.
+*/
+KAPI f32 occlusion_buffer_get_depth(occlusion_buffer* buffer, u32 x, u32 y);
@@ -27,12 +27,17 @@ bool renderer_backend_create(renderer_backend_type type, renderer_backend* out_r
         out_renderer_backend->texture_destroy                    = vulkan_texture_destroy;
         out_renderer_backend->texture_resize                     = vulkan_texture_resize;
         out_renderer_backend->texture_write_data                 = vulkan_texture_write_data;
+        out_renderer_backend->texture_upload_complete            = vulkan_texture_upload_complete;
         out_renderer_backend->texture_map_acquire_resources      = vulkan_texture_map_acquire_resources;
         out_renderer_backend->texture_map_release_resources      = vulkan_texture_map_release_resources;
 
         out_renderer_backend->geometry_create                    = vulkan_geometry_create;
         out_renderer_backend->geometry_destroy                   = vulkan_geometry_destroy;
         out_renderer_backend->geometry_draw                      = vulkan_geometry_draw;
+        out_renderer_backend->geometry_draw_instanced            = vulkan_geometry_draw_instanced;
+        out_renderer_backend->geometry_draw_batch                = vulkan_geometry_draw_batch;
+        out_renderer_backend->indirect_draw_set                  = vulkan_indirect_draw_set;
+        out_renderer_backend->draw_call_count_get                = vulkan_draw_call_count_get;
 
         out_renderer_backend->shader_create                      = vulkan_shader_create;
         out_renderer_backend->shader_destroy                     = vulkan_shader_destroy;
@@ -45,6 +50,7 @@ bool renderer_backend_create(renderer_backend_type type, renderer_backend* out_r
         out_renderer_backend->shader_acquire_instance_resources  = vulkan_shader_acquire_instance_resources;
         out_renderer_backend->shader_release_instance_resources  = vulkan_shader_release_instance_resources;
         out_renderer_backend->shader_set_uniform                 = vulkan_shader_set_uniform;
+        out_renderer_backend->shader_push_draw_constants         = vulkan_shader_push_draw_constants;
 
         out_renderer_backend->render_target_create               = vulkan_render_target_create;
         out_renderer_backend->render_target_destroy              = vulkan_render_target_destroy;
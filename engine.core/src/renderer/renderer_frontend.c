@@ -6,6 +6,7 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "debug/assert.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "containers/freelist.h"
 #include "resources/resource_types.h"
@@ -286,6 +287,7 @@ void renderer_on_resize(i32 width, i32 height)
 bool renderer_draw_frame(render_packet* packet)
 {
     if(!system_status_valid(__FUNCTION__)) return false;
+    KPROFILE_FUNCTION();
 
     // Производить генерацию кадров даже, если исход плохой!
     state_ptr->backend.frame_number++;
@@ -299,8 +301,15 @@ bool renderer_draw_frame(render_packet* packet)
         state_ptr->resizing = false;
     }
 
-    if(state_ptr->backend.frame_begin(packet->delta_time))
+    KPROFILE_BEGIN("frame_begin");
+    bool frame_began = state_ptr->backend.frame_begin(packet->delta_time);
+    KPROFILE_END();
+
+    if(frame_began)
     {
+        // Новый буфер команд: шейдеры и экземпляры привязываются заново.
+        shader_system_bindings_reset();
+
         u8 attachment_index = state_ptr->backend.window_attachment_index_get();
 
         for(u32 i = 0; i < packet->view_count; ++i)
@@ -312,6 +321,7 @@ bool renderer_draw_frame(render_packet* packet)
             }
         }
 
+        KPROFILE_SCOPE("frame_end");
         if(!state_ptr->backend.frame_end(packet->delta_time))
         {
             kerror("Failed to complete function 'renderer_end_frame'. Shutting down.");
@@ -341,6 +351,11 @@ void renderer_texture_write_data(texture* texture, u32 offset, u32 size, const v
     state_ptr->backend.texture_write_data(texture, offset, size, pixels);
 }
 
+bool renderer_texture_upload_complete(texture* texture)
+{
+    return state_ptr->backend.texture_upload_complete(texture);
+}
+
 void renderer_texture_destroy(texture* texture)
 {
     state_ptr->backend.texture_destroy(texture);
@@ -374,6 +389,28 @@ void renderer_geometry_draw(geometry_render_data* data)
     state_ptr->backend.geometry_draw(data);
 }
 
+void renderer_geometry_draw_instanced(geometry_render_data* data, u32 instance_count)
+{
+    state_ptr->backend.geometry_draw_instanced(data, instance_count);
+}
+
+void renderer_geometry_draw_batch(geometry_render_data* data, u32 count)
+{
+    state_ptr->backend.geometry_draw_batch(data, count);
+}
+
+bool renderer_indirect_draw_set(bool enabled)
+{
+    if(!system_status_valid(__FUNCTION__)) return false;
+    return state_ptr->backend.indirect_draw_set(enabled);
+}
+
+u32 renderer_draw_call_count()
+{
+    if(!system_status_valid(__FUNCTION__)) return 0;
+    return state_ptr->backend.draw_call_count_get();
+}
+
 bool renderer_shader_create(shader* s, const shader_config* config, renderpass* pass, u8 stage_count, const char** stage_filenames, shader_stage* stages)
 {
     return state_ptr->backend.shader_create(s, config, pass, stage_count, stage_filenames, stages);
@@ -429,6 +466,11 @@ bool renderer_shader_set_uniform(shader* s, shader_uniform* uniform, const void*
     return state_ptr->backend.shader_set_uniform(s, uniform, value);
 }
 
+bool renderer_shader_push_draw_constants(shader* s, const mat4* model, u32 material_index)
+{
+    return state_ptr->backend.shader_push_draw_constants(s, model, material_index);
+}
+
 void renderer_render_target_create(u8 attachment_count, texture** attachments, renderpass* pass, u32 width, u32 height, render_target* out_target)
 {
     state_ptr->backend.render_target_create(attachment_count, attachments, pass, width, height, out_target);    
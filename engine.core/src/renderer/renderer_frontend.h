@@ -69,6 +69,15 @@ void renderer_texture_resize(texture* t, u32 new_width, u32 new_height);
 */
 void renderer_texture_write_data(texture* t, u32 offset, u32 size, const void* pixels);
 
+/*
+    @brief Проверяет, что загрузка данных текстуры на GPU завершена.
+    NOTE: Не блокирует кадр, только опрашивает состояние загрузки. Используется системой текстур,
+          чтобы подменять текстуру только после того, как ее данные находятся в памяти GPU.
+    @param t Указатель на текстуру для проверки.
+    @return True если данные текстуры загружены и могут использоваться, false если загрузка еще выполняется.
+*/
+bool renderer_texture_upload_complete(texture* t);
+
 /*
     @brief Уничтожает предоставленную текстуру, освобождая память графического процессора.
     @param t Указатель на текстуру, которую необходимо уничтожить.
@@ -117,6 +126,39 @@ void renderer_geometry_destroy(geometry* geometry);
 */
 void renderer_geometry_draw(geometry_render_data* data);
 
+/*
+    @brief Рисует несколько экземпляров геометрии одной инстансированной отрисовкой.
+    NOTE: Должно вызываться между началом и концом прохода визуализатора, шейдер должен объявлять
+          атрибуты экземпляра (instance_attribute=mat4,... в конфигурации шейдера).
+    @param data Массив геометрических данных одной геометрии и уровня детализации, матрицы моделей
+           элементов записываются в буфер экземпляров текущего кадра.
+    @param instance_count Количество экземпляров (элементов массива).
+*/
+void renderer_geometry_draw_instanced(geometry_render_data* data, u32 instance_count);
+
+/*
+    @brief Рисует пакет геометрий одного материала.
+    NOTE: Соседние элементы с одинаковой геометрией и уровнем детализации объединяются в экземпляры.
+          При включенной косвенной отрисовке весь пакет записывается одной командой vkCmdDrawIndexedIndirect,
+          иначе каждая группа экземпляров рисуется отдельным вызовом.
+    @param data Массив геометрических данных, отсортированный по геометрии и уровню детализации.
+    @param count Количество элементов массива.
+*/
+void renderer_geometry_draw_batch(geometry_render_data* data, u32 count);
+
+/*
+    @brief Выбирает способ отрисовки пакетов геометрий (может меняться между кадрами).
+    @param enabled True для косвенной отрисовки, false для прямых вызовов отрисовки.
+    @return True если выбранный способ используется, false если косвенная отрисовка не поддерживается устройством.
+*/
+bool renderer_indirect_draw_set(bool enabled);
+
+/*
+    @brief Получает количество вызовов отрисовки, записанных в последнем завершенном кадре.
+    @return Количество вызовов отрисовки (прямых и косвенных команд).
+*/
+u32 renderer_draw_call_count();
+
 /*
     @brief Создает внутренние ресурсы шейдера, используя предоставленные параметры.
     @param s Указатель на шейдер для создания внутренних ресурсов.
@@ -206,6 +248,15 @@ bool renderer_shader_release_instance_resources(shader* s, u32 instance_id);
 */
 bool renderer_shader_set_uniform(shader* s, shader_uniform* uniform, const void* value);
 
+/*
+    @brief Записывает push-константы отрисовки указанного шейдера (матрицу модели и индекс материала).
+    @param s Указатель на шейдер.
+    @param model Указатель на матрицу модели, null чтобы не записывать.
+    @param material_index Индекс материала.
+    @return True операция завершена успешно, false в случае ошибок.
+*/
+bool renderer_shader_push_draw_constants(shader* s, const mat4* model, u32 material_index);
+
 /*
     @brief Создает новую цель визуализации используя предоставленные данные.
     @apram attachment_count Количество вложений (указателей на текстуры).
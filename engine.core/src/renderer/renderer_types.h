@@ -13,6 +13,8 @@
 // TODO: Подчистить заголовочные файлы данным способом!
 struct shader;
 struct shader_uniform;
+struct bvh;
+struct occluder;
 
 // @brief Режимы отображения визуализации (для отладки).
 typedef enum renderer_view_mode {
@@ -31,6 +33,8 @@ typedef enum renderer_backend_type {
 typedef struct geometry_render_data {
     mat4 model;
     geometry* geometry;
+    // @brief Выбранный уровень детализации геометрии (игнорируется, если уровней нет).
+    u8 lod;
 } geometry_render_data;
 
 // @brief Представляет флаги очистки прохода визуализатора (комбинируемые).
@@ -107,6 +111,10 @@ typedef enum renderbuffer_type {
     RENDERBUFFER_TYPE_READ,
     // @brief Использование буфера для хранения данных.
     RENDERBUFFER_TYPE_STORAGE,
+    // @brief Использование буфера для данных экземпляров (видим для CPU, обновляется каждый кадр).
+    RENDERBUFFER_TYPE_INSTANCE,
+    // @brief Использование буфера для команд косвенной отрисовки (видим для CPU, обновляется каждый кадр).
+    RENDERBUFFER_TYPE_INDIRECT,
 } renderbuffer_type;
 
 // @brief Контекст экземпляра буфера визуализатора.
@@ -261,6 +269,13 @@ typedef struct renderer_backend {
     */
     void (*texture_write_data)(texture* t, u32 offset, u32 size, const void* pixels);
 
+    /*
+        @brief Проверяет, что загрузка данных текстуры на GPU завершена (без ожидания).
+        @param t Указатель на текстуру для проверки.
+        @return True если данные текстуры загружены и могут использоваться, false если загрузка еще выполняется.
+    */
+    bool (*texture_upload_complete)(texture* t);
+
     /*
         @brief Получает внутренние ресурсы для предоставленной карты текстуры.
         @param map Указатель на карту текстуры для получения ресурсов.
@@ -299,6 +314,33 @@ typedef struct renderer_backend {
     */
     void (*geometry_draw)(geometry_render_data* data);
 
+    /*
+        @brief Рисует несколько экземпляров геометрии одной инстансированной отрисовкой.
+        @param data Массив геометрических данных одной геометрии и уровня детализации (матрицы моделей
+               записываются в буфер экземпляров кадра).
+        @param instance_count Количество экземпляров (элементов массива).
+    */
+    void (*geometry_draw_instanced)(geometry_render_data* data, u32 instance_count);
+
+    /*
+        @brief Рисует пакет геометрий одного материала (соседние одинаковые геометрии объединяются в экземпляры).
+        @param data Массив геометрических данных, отсортированный по геометрии и уровню детализации.
+        @param count Количество элементов массива.
+    */
+    void (*geometry_draw_batch)(geometry_render_data* data, u32 count);
+
+    /*
+        @brief Включает или выключает косвенную отрисовку пакетов геометрий.
+        @param enabled True для косвенной отрисовки, false для прямых вызовов отрисовки.
+        @return True если выбранный способ используется, false если косвенная отрисовка не поддерживается.
+    */
+    bool (*indirect_draw_set)(bool enabled);
+
+    /*
+        @brief Получает количество вызовов отрисовки, записанных в последнем завершенном кадре.
+    */
+    u32 (*draw_call_count_get)();
+
     /*
         @brief Создает внутренние ресурсы шейдера, используя предоставленные параметры.
         @param s Указатель на шейдер для создания внутренних ресурсов.
@@ -387,6 +429,15 @@ typedef struct renderer_backend {
     */
     bool (*shader_set_uniform)(struct shader* frontend_shader, struct shader_uniform* uniform, const void* value);
 
+    /*
+        @brief Записывает push-константы отрисовки указанного шейдера (без поиска uniform переменных).
+        @param s Указатель на шейдер.
+        @param model Указатель на матрицу модели, null чтобы не записывать.
+        @param material_index Индекс материала.
+        @return True операция завершена успешно, false в случае ошибок.
+    */
+    bool (*shader_push_draw_constants)(struct shader* s, const mat4* model, u32 material_index);
+
     /*
         @brief Создает новую цель визуализации используя предоставленные данные.
         @apram attachment_count Количество вложений (указателей на текстуры).
@@ -597,6 +648,10 @@ typedef struct render_view_packet {
     vec3 view_position;
     vec4 ambient_color;
     u32 geometry_count;
+    // @brief Количество геометрий, отсеченных при построении пакета (не попавших в 'geometries').
+    u32 culled_geometry_count;
+    // @brief Количество геометрий из 'culled_geometry_count', отсеченных как перекрытые окклюдерами.
+    u32 occluded_geometry_count;
     geometry_render_data* geometries;
     const char* custom_shader_name;
     void* extended_data;
@@ -605,6 +660,12 @@ typedef struct render_view_packet {
 typedef struct mesh_packet_data {
     u32 mesh_count;
     mesh** meshes;
+    // @brief Индекс сцены (BVH по геометриям сеток), если задан - используется вместо перебора сеток.
+    struct bvh* scene;
+    // @brief Количество окклюдеров.
+    u32 occluder_count;
+    // @brief Окклюдеры для программного отсечения перекрытых геометрий (см. occlusion_buffer).
+    const struct occluder* occluders;
 } mesh_packet_data;
 
 typedef struct skybox_packet_data {
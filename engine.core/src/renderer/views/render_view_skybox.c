@@ -3,6 +3,7 @@
 
 // Внутренние подключения.
 #include "logger.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "math/kmath.h"
 #include "systems/shader_system.h"
@@ -91,6 +92,8 @@ void render_view_skybox_on_resize(render_view* self, u32 width, u32 height)
 
 bool render_view_skybox_on_build_packet(const render_view* self, void* data, render_view_packet* out_packet)
 {
+    KPROFILE_FUNCTION();
+
     if(!view_state_valid(self, __FUNCTION__) || !data || !out_packet)
     {
         kerror("Function '%s' requires a valid pointer to a packet and a data.", __FUNCTION__);
@@ -3,9 +3,10 @@
 
 // Внутренние подключения.
 #include "logger.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "math/kmath.h"
-#include "math/transform.h"
+#include "systems/transform_system.h"
 #include "containers/darray.h"
 #include "systems/material_system.h"
 #include "systems/shader_system.h"
@@ -83,6 +84,8 @@ void render_view_ui_on_resize(render_view* self, u32 width, u32 height)
 
 bool render_view_ui_on_build_packet(const render_view* self, void* data, render_view_packet* out_packet)
 {
+    KPROFILE_FUNCTION();
+
     if(!view_state_valid(self, __FUNCTION__) || !data || !out_packet)
     {
         kerror("Function '%s' requires a valid pointer to a packet and a data.", __FUNCTION__);
@@ -104,9 +107,9 @@ bool render_view_ui_on_build_packet(const render_view* self, void* data, render_
 
         for(u32 j = 0; j < m->geometry_count; ++j)
         {
-            geometry_render_data render_data;
+            geometry_render_data render_data = {};
             render_data.geometry = m->geometries[j];
-            render_data.model = transform_get_world(&m->transform);
+            render_data.model = transform_system_get_world(m->transform_id);
 
             darray_push(out_packet->geometries, render_data);
             out_packet->geometry_count++;
@@ -177,7 +180,7 @@ bool render_view_ui_on_render(const render_view* self, const render_view_packet*
             }
 
             // Применение локальной позиции объекта.
-            material_system_apply_local(m, &packet->geometries[i].model);
+            material_system_apply_draw(m, &packet->geometries[i].model);
 
             // Нарисовать!
             renderer_geometry_draw(&packet->geometries[i]);
@@ -3,16 +3,31 @@
 
 // Внутренние подключения.
 #include "logger.h"
+#include "debug/profiler.h"
 #include "event.h"
 #include "memory/memory.h"
 #include "math/kmath.h"
-#include "math/transform.h"
+#include "math/geometry_utils.h"
+#include "systems/transform_system.h"
+#include "containers/bvh.h"
+#include "renderer/occlusion_buffer.h"
+#include "renderer/draw_sort.h"
 #include "containers/darray.h"
+#include "systems/job_system.h"
 #include "systems/material_system.h"
 #include "systems/shader_system.h"
 #include "systems/camera_system.h"
 #include "renderer/renderer_frontend.h"
 
+// Количество кандидатов в одной части параллельного отсечения.
+#define RENDER_VIEW_WORLD_CULL_CHUNK_SIZE 256
+
+// Результаты части параллельного отсечения.
+typedef struct render_view_world_cull_chunk {
+    u32 visible_count;
+    u32 occluded_count;
+} render_view_world_cull_chunk;
+
 typedef struct render_view_world_internal_data {
     u32 shader_id;
     f32 fov;
@@ -22,12 +37,38 @@ typedef struct render_view_world_internal_data {
     camera* world_camera;
     vec4 ambient_color;
     u32 render_mode;
+    // NOTE: Временные массивы отсечения, переиспользуются между кадрами.
+    geometry_render_data* cull_candidates;
+    vec3* cull_centers;
+    vec3* cull_extents;
+    u8* cull_visible;
+    // NOTE: Каждая часть пишет результаты в свой диапазон [begin, end), затем они объединяются по порядку частей.
+    geometry_render_data* cull_draws;
+    u64* cull_keys;
+    render_view_world_cull_chunk* cull_chunks;
+    // Индексы отрисовок и временные массивы поразрядной сортировки.
+    u32* sort_indices;
+    u64* sort_temp_keys;
+    u32* sort_temp_indices;
+    u32 cull_count;
+    u32 cull_capacity;
+    // Программный буфер глубины для отсечения перекрытых геометрий.
+    occlusion_buffer* occlusion;
+    void* occlusion_memory;
+    // NOTE: Уровни детализации предыдущего кадра по идентификатору геометрии (для гистерезиса).
+    u8* lod_states;
+    u32 lod_state_capacity;
 } render_view_world_internal_data;
 
-typedef struct geometry_distance {
-    geometry_render_data g;
-    f32 distance;            // Дистанция относительно камеры.
-} geometry_distance;
+// Контекст параллельного отсечения кандидатов.
+typedef struct render_view_world_cull_context {
+    render_view_world_internal_data* data;
+    const frustum* view_frustum;
+    // Проверять ли кандидатов буфером перекрытия.
+    bool occlusion;
+    // Идентификатор вида для ключей сортировки.
+    u16 view_id;
+} render_view_world_cull_context;
 
 static bool view_state_valid(const render_view* self, const char* func_name)
 {
@@ -39,57 +80,182 @@ static bool view_state_valid(const render_view* self, const char* func_name)
     return true;
 }
 
-static void swap(geometry_distance* a, geometry_distance* b)
+static void render_view_world_cull_buffers_free(render_view_world_internal_data* data)
 {
-    geometry_distance t  = *a;
-    *a = *b;
-    *b = t;
+    if(data->cull_capacity == 0) return;
+
+    kfree(data->cull_candidates, MEMORY_TAG_ARRAY);
+    kfree(data->cull_centers, MEMORY_TAG_ARRAY);
+    kfree(data->cull_extents, MEMORY_TAG_ARRAY);
+    kfree(data->cull_visible, MEMORY_TAG_ARRAY);
+    kfree(data->cull_draws, MEMORY_TAG_ARRAY);
+    kfree(data->cull_keys, MEMORY_TAG_ARRAY);
+    kfree(data->cull_chunks, MEMORY_TAG_ARRAY);
+    kfree(data->sort_indices, MEMORY_TAG_ARRAY);
+    kfree(data->sort_temp_keys, MEMORY_TAG_ARRAY);
+    kfree(data->sort_temp_indices, MEMORY_TAG_ARRAY);
+    data->cull_candidates = null;
+    data->cull_centers = null;
+    data->cull_extents = null;
+    data->cull_visible = null;
+    data->cull_draws = null;
+    data->cull_keys = null;
+    data->cull_chunks = null;
+    data->sort_indices = null;
+    data->sort_temp_keys = null;
+    data->sort_temp_indices = null;
+    data->cull_capacity = 0;
+}
+
+// Добавляет геометрию сетки в кандидаты на отсечение вместе с ее прямоугольником в мировом пространстве.
+static void render_view_world_add_candidate(render_view_world_internal_data* data, mesh* m, u32 geometry_index)
+{
+    if(data->cull_count >= data->cull_capacity)
+    {
+        return;
+    }
+
+    u32 index = data->cull_count++;
+    geometry_render_data* render_data = &data->cull_candidates[index];
+    render_data->geometry = m->geometries[geometry_index];
+    render_data->model = transform_system_get_world(m->transform_id);
+    render_data->lod = 0;
+    aabb_transform(&render_data->geometry->extents, render_data->model, &data->cull_centers[index], &data->cull_extents[index]);
 }
 
-static i32 partition(geometry_distance* arr, i32 low_index, i32 high_index, bool ascending)
+// Расширяет массив уровней детализации предыдущего кадра до указанного идентификатора геометрии.
+static void render_view_world_lod_states_reserve(render_view_world_internal_data* data, u32 max_geometry_id)
 {
-    geometry_distance pivot = arr[high_index];
-    i32 i = (low_index - 1);
+    if(max_geometry_id < data->lod_state_capacity)
+    {
+        return;
+    }
 
-    for(i32 j = low_index; j <= high_index - 1; ++j)
+    u32 capacity = data->lod_state_capacity ? data->lod_state_capacity : 256;
+    while(capacity <= max_geometry_id)
     {
-        if(ascending)
+        capacity *= 2;
+    }
+
+    u8* states = kallocate_tc(u8, capacity, MEMORY_TAG_ARRAY);
+    kzero_tc(states, u8, capacity);
+    if(data->lod_states)
+    {
+        kcopy_tc(states, data->lod_states, u8, data->lod_state_capacity);
+        kfree(data->lod_states, MEMORY_TAG_ARRAY);
+    }
+
+    data->lod_states = states;
+    data->lod_state_capacity = capacity;
+}
+
+/*
+    @brief Выбирает уровень детализации видимой геометрии по ее размеру на экране.
+    NOTE: Вызывается из частей параллельного отсечения и только читает состояния предыдущего кадра, массив
+          состояний должен быть заранее расширен (см. render_view_world_lod_states_reserve). Новые состояния
+          записываются последовательно после объединения частей (см. render_view_world_lod_states_update).
+*/
+static void render_view_world_select_lod(
+    render_view_world_internal_data* data, geometry_render_data* render_data, const vec3* center, const vec3* extents
+)
+{
+    geometry* g = render_data->geometry;
+    if(g->lod_count < 2 || g->id >= data->lod_state_capacity)
+    {
+        render_data->lod = 0;
+        return;
+    }
+
+    // Видимый диаметр ограничивающей сферы относительно высоты экрана.
+    f32 radius = vec3_length(*extents);
+    f32 distance = vec3_distance(*center, data->world_camera->position);
+    f32 screen_size = distance > radius ? radius / (distance * ktan(data->fov * 0.5f)) : K_FLOAT_MAX;
+
+    render_data->lod = geometry_select_lod(g->lod_count, data->lod_states[g->id], screen_size);
+}
+
+/*
+    @brief Сохраняет уровни детализации видимых геометрий для гистерезиса следующего кадра.
+    NOTE: Все экземпляры общей геометрии выбирают уровень от одного состояния предыдущего кадра, новым
+          состоянием становится самый детальный из выбранных ими уровней. Результат не зависит от порядка
+          экземпляров и распределения частей по потокам.
+*/
+static void render_view_world_lod_states_update(render_view_world_internal_data* data, u32 visible_count)
+{
+    for(u32 i = 0; i < visible_count; ++i)
+    {
+        geometry* g = data->cull_draws[i].geometry;
+        if(g->lod_count >= 2 && g->id < data->lod_state_capacity)
         {
-            if(arr[j].distance < pivot.distance)
-            {
-                ++i;
-                swap(&arr[i], &arr[j]);
-            }
+            data->lod_states[g->id] = INVALID_ID_U8;
         }
-        else
+    }
+
+    for(u32 i = 0; i < visible_count; ++i)
+    {
+        geometry* g = data->cull_draws[i].geometry;
+        if(g->lod_count >= 2 && g->id < data->lod_state_capacity)
         {
-            if(arr[j].distance > pivot.distance)
-            {
-                ++i;
-                swap(&arr[i], &arr[j]);
-            }
+            data->lod_states[g->id] = KMIN(data->lod_states[g->id], data->cull_draws[i].lod);
         }
     }
+}
 
-    swap(&arr[i + 1], &arr[high_index]);
-    return i + 1;
+static bool render_view_world_add_candidate_callback(void* context, u32 proxy_id, void* user_data, u32 user_index)
+{
+    render_view_world_add_candidate(context, user_data, user_index);
+    return true;
 }
 
 /*
-    @brief Функция сортировки геометрий.
-    @param arr Массив геометрий с дистанцией до камеры для сортировки.
-    @param low_index Начальный индекс с которого нужно выполнять сортировку (обычно с 0).
-    @param high_index Конечноый индекс до которого нужно выполнять сортировку (для всего массива -1).
-    @param ascending True сортировка в порядке возрастания, false в порядке убывания.
+    @brief Отсекает часть кандидатов (пирамида, перекрытие), выбирает уровни детализации и строит ключи
+           сортировки видимых геометрий.
+    NOTE: Части выполняются параллельно, каждая пишет только в свой диапазон массивов и свою запись результатов.
 */
-static void quick_sort(geometry_distance* arr, i32 low_index, i32 high_index, bool ascending)
+static void render_view_world_cull_range(void* context, u32 begin, u32 end)
 {
-    if(low_index < high_index)
+    render_view_world_cull_context* ctx = context;
+    render_view_world_internal_data* data = ctx->data;
+    render_view_world_cull_chunk* chunk = &data->cull_chunks[begin / RENDER_VIEW_WORLD_CULL_CHUNK_SIZE];
+    u32 count = end - begin;
+
+    frustum_intersects_aabb_array(
+        ctx->view_frustum, &data->cull_centers[begin], &data->cull_extents[begin], count, &data->cull_visible[begin]
+    );
+
+    chunk->occluded_count = 0;
+    if(ctx->occlusion)
     {
-        i32 partition_index = partition(arr, low_index, high_index, ascending);
+        chunk->occluded_count = occlusion_buffer_test_aabb_array(
+            data->occlusion, &data->cull_centers[begin], &data->cull_extents[begin], count, &data->cull_visible[begin]
+        );
+    }
+
+    chunk->visible_count = 0;
+    vec3 camera_position = data->world_camera->position;
 
-        quick_sort(arr, low_index, partition_index - 1, ascending);
-        quick_sort(arr, partition_index + 1, high_index, ascending);
+    for(u32 i = begin; i < end; ++i)
+    {
+        if(!data->cull_visible[i])
+        {
+            continue;
+        }
+
+        geometry_render_data render_data = data->cull_candidates[i];
+        render_view_world_select_lod(data, &render_data, &data->cull_centers[i], &data->cull_extents[i]);
+
+        material* m = render_data.geometry->material;
+        draw_sort_layer layer = (m->diffuse_map.texture->flags & TEXTURE_FLAG_HAS_TRANSPARENCY) == 0
+                              ? DRAW_SORT_LAYER_OPAQUE : DRAW_SORT_LAYER_TRANSPARENT;
+
+        vec3 center = vec3_transform(render_data.geometry->center, 1.0f, render_data.model);
+        f32 distance = vec3_distance(center, camera_position);
+
+        u32 index = begin + chunk->visible_count++;
+        data->cull_draws[index] = render_data;
+        data->cull_keys[index] = draw_sort_key_create(
+            ctx->view_id, layer, m->shader_id, m->id, render_data.geometry->id, distance
+        );
     }
 }
 
@@ -141,6 +307,22 @@ bool render_view_world_on_create(render_view* self)
     // TODO: Получение из сцены.
     data->ambient_color = (vec4){{0.25f, 0.25f, 0.25f, 1.0f}};
 
+    // TODO: Установка из конфигурации.
+    occlusion_buffer_config occlusion_config;
+    occlusion_config.width = 256;
+    occlusion_config.height = 128;
+    occlusion_config.max_triangle_count = 16384;
+    u64 occlusion_memory_requirement = 0;
+    occlusion_buffer_create(&occlusion_memory_requirement, null, &occlusion_config, null);
+    data->occlusion_memory = kallocate(occlusion_memory_requirement, MEMORY_TAG_RENDERER);
+    if(!occlusion_buffer_create(&occlusion_memory_requirement, data->occlusion_memory, &occlusion_config, &data->occlusion))
+    {
+        kwarng("Function '%s': Failed to create occlusion buffer, occlusion culling disabled.", __FUNCTION__);
+        kfree(data->occlusion_memory, MEMORY_TAG_RENDERER);
+        data->occlusion_memory = null;
+        data->occlusion = null;
+    }
+
     event_register(EVENT_CODE_SET_RENDER_MODE, self->internal_data, render_view_world_on_event);
 
     return true;
@@ -150,6 +332,24 @@ void render_view_world_on_destroy(render_view* self)
 {
     if(!view_state_valid(self, __FUNCTION__)) return;
     event_unregister(EVENT_CODE_SET_RENDER_MODE, self->internal_data, render_view_world_on_event);
+    render_view_world_cull_buffers_free(self->internal_data);
+
+    render_view_world_internal_data* data = self->internal_data;
+    if(data->occlusion)
+    {
+        occlusion_buffer_destroy(data->occlusion);
+        kfree(data->occlusion_memory, MEMORY_TAG_RENDERER);
+        data->occlusion = null;
+        data->occlusion_memory = null;
+    }
+
+    if(data->lod_states)
+    {
+        kfree(data->lod_states, MEMORY_TAG_ARRAY);
+        data->lod_states = null;
+        data->lod_state_capacity = 0;
+    }
+
     kfree(self->internal_data, MEMORY_TAG_RENDERER);
     self->internal_data = null;
 }
@@ -178,6 +378,8 @@ void render_view_world_on_resize(render_view* self, u32 width, u32 height)
 
 bool render_view_world_on_build_packet(const render_view* self, void* data, render_view_packet* out_packet)
 {
+    KPROFILE_FUNCTION();
+
     if(!view_state_valid(self, __FUNCTION__) || !data || !out_packet)
     {
         kerror("Function '%s' requires a valid pointer to a packet and a data.", __FUNCTION__);
@@ -195,51 +397,129 @@ bool render_view_world_on_build_packet(const render_view* self, void* data, rend
     out_packet->view_position = camera_position_get(internal_data->world_camera);
     out_packet->ambient_color = internal_data->ambient_color;
 
-    geometry_distance* geometry_distances = darray_create(geometry_distance);
+    mat4 view_projection = mat4_mul(out_packet->view_matrix, out_packet->projection_matrix);
+    frustum view_frustum = frustum_from_view_projection(view_projection);
 
-    for(u32 i = 0; i < mesh_data->mesh_count; ++i)
+    // Подготовка временных массивов отсечения.
+    u32 total_count = 0;
+    if(mesh_data->scene)
     {
-        mesh* m = mesh_data->meshes[i];
-        mat4 model = transform_get_world(&m->transform);
-
-        for(u32 j = 0; j < m->geometry_count; ++j)
+        total_count = bvh_get_proxy_count(mesh_data->scene);
+    }
+    else
+    {
+        for(u32 i = 0; i < mesh_data->mesh_count; ++i)
         {
-            geometry_render_data render_data;
-            render_data.geometry = m->geometries[j];
-            render_data.model = model;
+            total_count += mesh_data->meshes[i]->geometry_count;
+        }
+    }
 
-            // Добавление сеток без прозрачности.
-            if((m->geometries[j]->material->diffuse_map.texture->flags & TEXTURE_FLAG_HAS_TRANSPARENCY) == 0)
+    if(total_count > internal_data->cull_capacity)
+    {
+        render_view_world_cull_buffers_free(internal_data);
+        internal_data->cull_capacity = total_count;
+        internal_data->cull_candidates = kallocate_tc(geometry_render_data, total_count, MEMORY_TAG_ARRAY);
+        internal_data->cull_centers = kallocate_tc(vec3, total_count, MEMORY_TAG_ARRAY);
+        internal_data->cull_extents = kallocate_tc(vec3, total_count, MEMORY_TAG_ARRAY);
+        internal_data->cull_visible = kallocate_tc(u8, total_count, MEMORY_TAG_ARRAY);
+        internal_data->cull_draws = kallocate_tc(geometry_render_data, total_count, MEMORY_TAG_ARRAY);
+        internal_data->cull_keys = kallocate_tc(u64, total_count, MEMORY_TAG_ARRAY);
+        internal_data->sort_indices = kallocate_tc(u32, total_count, MEMORY_TAG_ARRAY);
+        internal_data->sort_temp_keys = kallocate_tc(u64, total_count, MEMORY_TAG_ARRAY);
+        internal_data->sort_temp_indices = kallocate_tc(u32, total_count, MEMORY_TAG_ARRAY);
+        u32 chunk_capacity = (total_count + RENDER_VIEW_WORLD_CULL_CHUNK_SIZE - 1) / RENDER_VIEW_WORLD_CULL_CHUNK_SIZE;
+        internal_data->cull_chunks = kallocate_tc(render_view_world_cull_chunk, chunk_capacity, MEMORY_TAG_ARRAY);
+    }
+
+    // Кандидаты: геометрии из индекса сцены, пересекающие пирамиду, либо все геометрии всех сеток.
+    internal_data->cull_count = 0;
+    if(mesh_data->scene)
+    {
+        bvh_query_frustum(mesh_data->scene, &view_frustum, render_view_world_add_candidate_callback, internal_data);
+    }
+    else
+    {
+        for(u32 i = 0; i < mesh_data->mesh_count; ++i)
+        {
+            mesh* m = mesh_data->meshes[i];
+            for(u32 j = 0; j < m->geometry_count; ++j)
             {
-                darray_push(out_packet->geometries, render_data);
-                out_packet->geometry_count++;
+                render_view_world_add_candidate(internal_data, m, j);
             }
-            // Добавление сеток с прозрачностью.
-            else
-            {
-                vec3 center = vec3_transform(render_data.geometry->center, 1.0f, model);
-                f32 distance = vec3_distance(center, internal_data->world_camera->position);
+        }
+    }
 
-                geometry_distance gdist;
-                gdist.distance = kabs(distance);
-                gdist.g = render_data;
+    u32 candidate_count = internal_data->cull_count;
 
-                darray_push(geometry_distances, gdist);
-            }
+    // Растеризация окклюдеров (сама делится на полосы) до параллельного отсечения.
+    render_view_world_cull_context cull_context = { internal_data, &view_frustum, false, self->id };
+    if(internal_data->occlusion && mesh_data->occluder_count > 0 && candidate_count > 0)
+    {
+        occlusion_buffer_begin(internal_data->occlusion, view_projection, internal_data->near_clip);
+        for(u32 i = 0; i < mesh_data->occluder_count; ++i)
+        {
+            occlusion_buffer_add_occluder(internal_data->occlusion, &mesh_data->occluders[i]);
+        }
+        occlusion_buffer_rasterize(internal_data->occlusion);
+        cull_context.occlusion = true;
+    }
+
+    // Состояния уровней детализации расширяются заранее, части только читают их.
+    u32 max_geometry_id = 0;
+    for(u32 i = 0; i < candidate_count; ++i)
+    {
+        u32 id = internal_data->cull_candidates[i].geometry->id;
+        if(id != INVALID_ID && id > max_geometry_id)
+        {
+            max_geometry_id = id;
+        }
+    }
+    render_view_world_lod_states_reserve(internal_data, max_geometry_id);
+
+    // Точное отсечение кандидатов частями параллельно.
+    job_system_parallel_for(candidate_count, RENDER_VIEW_WORLD_CULL_CHUNK_SIZE, render_view_world_cull_range, &cull_context);
+
+    // Объединение результатов в порядке частей: порядок отрисовки не зависит от распределения частей по потокам.
+    u32 chunk_count = (candidate_count + RENDER_VIEW_WORLD_CULL_CHUNK_SIZE - 1) / RENDER_VIEW_WORLD_CULL_CHUNK_SIZE;
+    u32 visible_count = 0;
+    out_packet->occluded_geometry_count = 0;
+
+    for(u32 c = 0; c < chunk_count; ++c)
+    {
+        render_view_world_cull_chunk* chunk = &internal_data->cull_chunks[c];
+        u32 begin = c * RENDER_VIEW_WORLD_CULL_CHUNK_SIZE;
+
+        // NOTE: Видимые геометрии сдвигаются к началу массивов, запись никогда не опережает чтение.
+        if(chunk->visible_count > 0 && visible_count != begin)
+        {
+            kmove_tc(&internal_data->cull_draws[visible_count], &internal_data->cull_draws[begin], geometry_render_data, chunk->visible_count);
+            kmove_tc(&internal_data->cull_keys[visible_count], &internal_data->cull_keys[begin], u64, chunk->visible_count);
         }
+
+        visible_count += chunk->visible_count;
+        out_packet->occluded_geometry_count += chunk->occluded_count;
     }
 
-    // Сортировка дистанций.
-    u32 geometry_count = darray_length(geometry_distances);
-    quick_sort(geometry_distances, 0, geometry_count - 1, false);
+    out_packet->geometry_count = visible_count;
+    out_packet->culled_geometry_count = total_count - visible_count;
+
+    render_view_world_lod_states_update(internal_data, visible_count);
 
-    for(u32 i = 0; i < geometry_count; ++i)
+    // Сортировка по ключам: непрозрачные по состоянию и от ближних к дальним, затем прозрачные от дальних к ближним.
+    for(u32 i = 0; i < visible_count; ++i)
     {
-        darray_push(out_packet->geometries, geometry_distances[i].g);
-        out_packet->geometry_count++;
+        internal_data->sort_indices[i] = i;
     }
 
-    darray_destroy(geometry_distances);
+    draw_sort_radix(
+        visible_count, internal_data->cull_keys, internal_data->sort_indices, internal_data->sort_temp_keys,
+        internal_data->sort_temp_indices
+    );
+
+    for(u32 i = 0; i < visible_count; ++i)
+    {
+        darray_push(out_packet->geometries, internal_data->cull_draws[internal_data->sort_indices[i]]);
+    }
 
     return true;
 }
@@ -283,16 +563,20 @@ bool render_view_world_on_render(const render_view* self, const render_view_pack
         }
 
         u32 count = packet->geometry_count;
-        for(u32 i = 0; i < count; ++i)
+        for(u32 i = 0; i < count;)
         {
-            material* m = null;
-            if(packet->geometries[i].geometry->material)
-            {
-                m = packet->geometries[i].geometry->material;
-            }
-            else
+            geometry_render_data* render_data = &packet->geometries[i];
+            material* m = render_data->geometry->material ? render_data->geometry->material : material_system_get_default();
+
+            // NOTE: Ключи сортировки группируют объекты по материалу, а внутри него по геометрии, поэтому
+            //       пакет материала - непрерывный диапазон, а одинаковые геометрии в нем идут подряд.
+            u32 batch = 1;
+            while(i + batch < count)
             {
-                m = material_system_get_default();
+                geometry* g = packet->geometries[i + batch].geometry;
+                material* next = g->material ? g->material : material_system_get_default();
+                if(next != m) break;
+                ++batch;
             }
 
             // Применение материала.
@@ -300,6 +584,7 @@ bool render_view_world_on_render(const render_view* self, const render_view_pack
             if(!material_system_apply_instance(m, needs_update))
             {
                 kwarng("Failed to apply WORLD instance '%s'. Skipping draw.", m->name);
+                i += batch;
                 continue;
             }
             else
@@ -307,11 +592,13 @@ bool render_view_world_on_render(const render_view* self, const render_view_pack
                 m->render_frame_number = frame_number;
             }
 
-            // Применение локальной позиции объекта.
-            material_system_apply_local(m, &packet->geometries[i].model);
+            // Индекс материала - единственное значение на пакет, матрицы моделей идут через экземпляры.
+            material_system_apply_draw(m, null);
 
-            // Нарисовать!
-            renderer_geometry_draw(&packet->geometries[i]);
+            // Нарисовать! Матрицы моделей передаются через буфер экземпляров, способ отрисовки
+            // (прямой или косвенный) выбирается визуализатором.
+            renderer_geometry_draw_batch(render_data, batch);
+            i += batch;
         }
 
         if(!renderer_renderpass_end(pass))
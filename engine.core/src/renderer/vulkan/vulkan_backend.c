@@ -8,6 +8,8 @@
 #include "renderer/vulkan/vulkan_command_buffer.h"
 #include "renderer/vulkan/vulkan_image.h"
 #include "renderer/vulkan/vulkan_pipeline.h"
+#include "renderer/vulkan/vulkan_staging.h"
+#include "renderer/vulkan/vulkan_bindless.h"
 
 // Внутренние подключения.
 #include "logger.h"
@@ -29,6 +31,9 @@ static vulkan_context* context = null;
 // Константы для шейдеров.
 const u32 DESC_SET_INDEX_GLOBAL   = 0;
 const u32 DESC_SET_INDEX_INSTANCE = 1;
+// Наборы шейдеров без привязки: массив текстур контекста и буфер материалов шейдера.
+const u32 DESC_SET_INDEX_BINDLESS = 1;
+const u32 DESC_SET_INDEX_MATERIAL = 2;
 
 // NOTE: Если установлен - используется пользовательский распределитель памяти для Vulkan.
 #ifdef KVULKAN_USE_CUSTOM_ALLOCATOR_FLAG
@@ -299,12 +304,69 @@ i32 find_memory_index(u32 type_filter, u32 property_flags)
     return -1;
 }
 
+// Откладывает освобождение диапазона буфера, который еще могут читать кадры в полете.
+static void vulkan_retire_buffer_range(renderbuffer* buffer, u64 size, u64 offset)
+{
+    vulkan_retired_resource retired = {0};
+    retired.frame_number = context->frame_number;
+    retired.buffer = buffer;
+    retired.offset = offset;
+    retired.size = size;
+    darray_push(context->retired_resources, retired);
+}
+
+// Откладывает уничтожение изображения, которое еще могут читать кадры в полете или загружать пакеты передачи.
+static void vulkan_retire_image(vulkan_image* image)
+{
+    vulkan_retired_resource retired = {0};
+    retired.frame_number = context->frame_number;
+    retired.image = image;
+    darray_push(context->retired_resources, retired);
+}
+
+/*
+    Освобождает отложенные ресурсы, кадры которых завершены.
+    NOTE: Вызывается после ожидания ограждения кадра: кадр, использовавший слот ограждения, был отправлен
+          max_frames_in_flight кадров назад, поэтому все кадры до него включительно завершены. Загрузки в
+          повторно используемую память отправляются только после этого и не пересекаются с чтением кадров,
+          в том числе на выделенной очереди передачи.
+*/
+static void vulkan_retired_resources_release(bool all)
+{
+    u32 length = darray_length(context->retired_resources);
+    u32 i = 0;
+    while(i < length)
+    {
+        vulkan_retired_resource* retired = &context->retired_resources[i];
+        if(!all && context->frame_number - retired->frame_number < context->swapchain.max_frames_in_flight)
+        {
+            i++;
+            continue;
+        }
+
+        if(retired->image)
+        {
+            vulkan_image_destroy(context, retired->image);
+            kfree(retired->image, MEMORY_TAG_TEXTURE);
+        }
+        else if(!renderer_renderbuffer_free(retired->buffer, retired->size, retired->offset))
+        {
+            kerror("Function '%s': Failed to free retired buffer range.", __FUNCTION__);
+        }
+
+        darray_pop_at(context->retired_resources, i, null);
+        length--;
+    }
+}
+
 void command_buffers_create()
 {
     if(!context->graphics_command_buffers)
     {
         context->graphics_command_buffers = darray_reserve(vulkan_command_buffer, context->swapchain.image_count);
         kzero_tc(context->graphics_command_buffers, vulkan_command_buffer, context->swapchain.image_count);
+        context->acquire_command_buffers = darray_reserve(vulkan_command_buffer, context->swapchain.image_count);
+        kzero_tc(context->acquire_command_buffers, vulkan_command_buffer, context->swapchain.image_count);
     }
 
     for(u32 i = 0; i < context->swapchain.image_count; ++i)
@@ -314,7 +376,13 @@ void command_buffers_create()
             vulkan_command_buffer_free(context, context->device.graphics_queue.command_pool, &context->graphics_command_buffers[i]);
         }
 
+        if(context->acquire_command_buffers[i].handle)
+        {
+            vulkan_command_buffer_free(context, context->device.graphics_queue.command_pool, &context->acquire_command_buffers[i]);
+        }
+
         vulkan_command_buffer_allocate(context, context->device.graphics_queue.command_pool, true, &context->graphics_command_buffers[i]);
+        vulkan_command_buffer_allocate(context, context->device.graphics_queue.command_pool, true, &context->acquire_command_buffers[i]);
     }
 }
 
@@ -349,6 +417,7 @@ bool swapchain_recreate()
     for(u32 i = 0; i < context->swapchain.image_count; ++i)
     {
         vulkan_command_buffer_free(context, context->device.graphics_queue.command_pool, &context->graphics_command_buffers[i]);
+        vulkan_command_buffer_free(context, context->device.graphics_queue.command_pool, &context->acquire_command_buffers[i]);
     }
 
     // Сообщить визуализатору что требуется обновление целей визуализации.
@@ -784,6 +853,25 @@ bool vulkan_backend_initialize(renderer_backend* backend, const renderer_backend
     kzero_tc(context->images_in_flight, VkFence, context->swapchain.image_count);
     ktrace("Vulkan sync objects created.");
 
+    // Кольцо промежуточного буфера для всех загрузок на GPU.
+    const u64 staging_ring_size = 32 * 1024 * 1024;
+    if(!vulkan_staging_create(context, staging_ring_size))
+    {
+        kerror("Function '%s': Failed to create staging ring.", __FUNCTION__);
+        return false;
+    }
+    ktrace("Vulkan staging ring created.");
+
+    context->frame_number = 0;
+    context->retired_resources = darray_create(vulkan_retired_resource);
+
+    // Массив текстур без привязки (только при поддержке индексирования дескрипторов).
+    if(!vulkan_bindless_create(context))
+    {
+        kerror("Function '%s': Failed to create bindless texture array.", __FUNCTION__);
+        return false;
+    }
+
     // TODO: Начало временного создания буферов вершин и индексов. Перенести!
     const u64 vertex_buffer_size = sizeof(struct vertex_3d) * 1024 * 1024;
     const u64 index_buffer_size = sizeof(u32) * 1024 * 1024;
@@ -802,6 +890,27 @@ bool vulkan_backend_initialize(renderer_backend* backend, const renderer_backend
     }
     renderer_renderbuffer_bind(&context->object_index_buffer, 0);
 
+    // Буфер экземпляров записывается CPU каждый кадр, поэтому отображается один раз.
+    const u64 instance_buffer_size = sizeof(mat4) * VULKAN_MAX_INSTANCE_COUNT * context->swapchain.max_frames_in_flight;
+    if(!renderer_renderbuffer_create(RENDERBUFFER_TYPE_INSTANCE, instance_buffer_size, false, &context->object_instance_buffer))
+    {
+        kerror("Function '%s': Failed to create instance buffer.", __FUNCTION__);
+        return false;
+    }
+    renderer_renderbuffer_bind(&context->object_instance_buffer, 0);
+    context->instance_mapped = vulkan_buffer_map_memory(&context->object_instance_buffer, 0, instance_buffer_size);
+
+    // Команды косвенной отрисовки так же записываются CPU каждый кадр.
+    const u64 indirect_buffer_size = sizeof(VkDrawIndexedIndirectCommand) * VULKAN_MAX_INDIRECT_COUNT * context->swapchain.max_frames_in_flight;
+    if(!renderer_renderbuffer_create(RENDERBUFFER_TYPE_INDIRECT, indirect_buffer_size, false, &context->object_indirect_buffer))
+    {
+        kerror("Function '%s': Failed to create indirect buffer.", __FUNCTION__);
+        return false;
+    }
+    renderer_renderbuffer_bind(&context->object_indirect_buffer, 0);
+    context->indirect_mapped = vulkan_buffer_map_memory(&context->object_indirect_buffer, 0, indirect_buffer_size);
+    context->indirect_draw_enabled = false;
+
     // Отметить все геометрии как недействительные.
     for(u32 i = 0; i < VULKAN_SHADER_MAX_GEOMETRY_COUNT; ++i)
     {
@@ -819,9 +928,26 @@ void vulkan_backend_shutdown(renderer_backend* backend)
 
     vkDeviceWaitIdle(context->device.logical);
 
+    vulkan_staging_destroy(context);
+    ktrace("Vulkan staging ring destroyed.");
+
+    // Устройство простаивает, отложенные ресурсы освобождаются сразу.
+    vulkan_retired_resources_release(true);
+    darray_destroy(context->retired_resources);
+    context->retired_resources = null;
+
+    vulkan_bindless_destroy(context);
+    ktrace("Vulkan bindless texture array destroyed.");
+
     // TODO: Начало удаления буферов. Перенести.
     renderer_renderbuffer_destroy(&context->object_vertex_buffer);
     renderer_renderbuffer_destroy(&context->object_index_buffer);
+    vulkan_buffer_unmap_memory(&context->object_instance_buffer, 0, 0);
+    context->instance_mapped = null;
+    renderer_renderbuffer_destroy(&context->object_instance_buffer);
+    vulkan_buffer_unmap_memory(&context->object_indirect_buffer, 0, 0);
+    context->indirect_mapped = null;
+    renderer_renderbuffer_destroy(&context->object_indirect_buffer);
     // TODO: Конец удаления буферов.
 
     // Уничтожение объектов сингхронизации.
@@ -858,10 +984,17 @@ void vulkan_backend_shutdown(renderer_backend* backend)
             {
                 vulkan_command_buffer_free(context, context->device.graphics_queue.command_pool, &context->graphics_command_buffers[i]);
             }
+
+            if(context->acquire_command_buffers[i].handle)
+            {
+                vulkan_command_buffer_free(context, context->device.graphics_queue.command_pool, &context->acquire_command_buffers[i]);
+            }
         }
 
         darray_destroy(context->graphics_command_buffers);
         context->graphics_command_buffers = null;
+        darray_destroy(context->acquire_command_buffers);
+        context->acquire_command_buffers = null;
     }
     ktrace("Vulkan command buffers destroyed.");
 
@@ -997,6 +1130,20 @@ bool vulkan_backend_frame_begin(f32 delta_time)
     vulkan_command_buffer_reset(command_buffer);
     vulkan_command_buffer_begin(command_buffer, false, false, false);
 
+    // Новый буфер команд не содержит привязок.
+    context->bound_vertex_buffer = VK_NULL_HANDLE;
+    context->bound_index_buffer = VK_NULL_HANDLE;
+
+    // Область буфера экземпляров этого кадра свободна: fence кадра уже дождались.
+    context->instance_count = 0;
+    context->instance_buffer_bound = false;
+    context->indirect_count = 0;
+    context->draw_call_count = 0;
+
+    // Слоты текстур и диапазоны буферов, освобожденные завершенными кадрами, снова доступны.
+    vulkan_bindless_frame_begin(context);
+    vulkan_retired_resources_release(false);
+
     // Область просмотра.
     VkViewport viewport = {0};
     viewport.x = 0.0f;
@@ -1025,6 +1172,10 @@ bool vulkan_backend_frame_end(f32 delta_time)
 
     // Конец записи команд.
     vulkan_command_buffer_end(command_buffer);
+    context->frame_draw_call_count = context->draw_call_count;
+
+    // Загрузки кадра отправляются одним пакетом раньше команд кадра.
+    vulkan_staging_flush(context, false);
 
     // Проверка, что предыдущий кадр не использует этот кадр (т.е. его fence находится в режиме ожидания).
     if(context->images_in_flight[context->image_index] != VK_NULL_HANDLE)
@@ -1048,16 +1199,46 @@ bool vulkan_backend_frame_end(f32 delta_time)
     }
 
     // Отправляем в очередь и ждем завершения операции.
+    VkCommandBuffer command_buffers[2];
+    u32 command_buffer_count = 0;
+
+    VkSemaphore wait_semaphores[2] = { context->image_available_semaphores[context->current_frame], context->staging.timeline };
+    uint64_t wait_values[2] = { 0, context->staging.submitted_value };
+
+    // Каждый семафор ждет ответа от pipeline о завершении.
+    VkPipelineStageFlags flags[2] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+    u32 wait_semaphore_count = 1;
+
+    // Получение владения загрузками выделенной очереди передачи: ожидание выполняет GPU, а не CPU.
+    if(context->staging.dedicated && darray_length(context->staging.acquires) > 0)
+    {
+        vulkan_command_buffer* acquire_buffer = &context->acquire_command_buffers[context->image_index];
+        vulkan_command_buffer_reset(acquire_buffer);
+        vulkan_command_buffer_begin(acquire_buffer, true, false, false);
+        u32 acquire_count = vulkan_staging_acquire_record(context, acquire_buffer);
+        vulkan_command_buffer_end(acquire_buffer);
+
+        if(acquire_count > 0)
+        {
+            command_buffers[command_buffer_count++] = acquire_buffer->handle;
+            wait_semaphore_count = 2;
+        }
+    }
+    command_buffers[command_buffer_count++] = command_buffer->handle;
+
+    // NOTE: Значение для двоичного семафора игнорируется.
+    VkTimelineSemaphoreSubmitInfo timelineinfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineinfo.waitSemaphoreValueCount = wait_semaphore_count;
+    timelineinfo.pWaitSemaphoreValues = wait_values;
+
     VkSubmitInfo submitinfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-    submitinfo.commandBufferCount = 1;
-    submitinfo.pCommandBuffers = &command_buffer->handle;
+    submitinfo.pNext = &timelineinfo;
+    submitinfo.commandBufferCount = command_buffer_count;
+    submitinfo.pCommandBuffers = command_buffers;
     submitinfo.signalSemaphoreCount = 1;
     submitinfo.pSignalSemaphores = &context->queue_complete_semaphores[context->current_frame];
-    submitinfo.waitSemaphoreCount = 1;
-    submitinfo.pWaitSemaphores = &context->image_available_semaphores[context->current_frame];
-
-    // Каждый семафор ждет ответа от pipeline о завершении.
-    VkPipelineStageFlags flags[1] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+    submitinfo.waitSemaphoreCount = wait_semaphore_count;
+    submitinfo.pWaitSemaphores = wait_semaphores;
     submitinfo.pWaitDstStageMask = flags;
 
     result = vkQueueSubmit(
@@ -1069,7 +1250,13 @@ bool vulkan_backend_frame_end(f32 delta_time)
         return false;
     }
 
+    context->frame_number++;
+
     vulkan_command_buffer_update_submitted(command_buffer);
+    if(command_buffer_count > 1)
+    {
+        vulkan_command_buffer_update_submitted(&context->acquire_command_buffers[context->image_index]);
+    }
 
     // Возвращаем изображение в цепочку обмена.
     vulkan_swapchain_present(
@@ -1320,12 +1507,15 @@ void vulkan_texture_create_writable(texture* t)
 
 void vulkan_texture_destroy(texture* t)
 {
-    vkDeviceWaitIdle(context->device.logical);
-
     if(t->internal_data)
     {
-        vulkan_image_destroy(context, t->internal_data);
-        kfree(t->internal_data, MEMORY_TAG_TEXTURE);
+        vulkan_image* image = t->internal_data;
+        vulkan_staging_forget(context, VK_NULL_HANDLE, image->handle);
+
+        // NOTE: Изображение могут читать кадры в полете, а неотправленный пакет загрузки - записывать. Пакеты
+        //       отправляются в конце кадра и ожидаются его отправкой, поэтому после завершения кадров в полете
+        //       изображение свободно и уничтожается без ожидания GPU (например, при подмене перезагруженной текстуры).
+        vulkan_retire_image(image);
     }
 
     kzero_tc(t, texture, 1);
@@ -1340,6 +1530,10 @@ void vulkan_texture_resize(texture* t, u32 new_width, u32 new_height)
     }
 
     vulkan_image* image = t->internal_data;
+
+    // Неотправленные загрузки могут ссылаться на изображение.
+    vulkan_staging_flush(context, true);
+    vulkan_staging_forget(context, VK_NULL_HANDLE, image->handle);
     vulkan_image_destroy(context, image);
 
     VkFormat image_format = channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM);
@@ -1366,48 +1560,63 @@ void vulkan_texture_write_data(texture* t, u32 offset, u32 size, const void* pix
     vulkan_image* image = t->internal_data;
     VkFormat image_format = channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM);
 
-    // Создание промедуточного буфера.
-    renderbuffer staging;
-    if(!renderer_renderbuffer_create(RENDERBUFFER_TYPE_STAGING, size, false, &staging))
+    // Копирование и переходы макета записываются в пакет загрузки кадра.
+    if(!vulkan_staging_upload_image(context, t->type, image, image_format, size, pixels))
     {
-        kerror("Function '%s': Failed to create staging buffer for texture write.", __FUNCTION__);
+        kerror("Function '%s': Failed to upload texture data.", __FUNCTION__);
         return;
     }
-    renderer_renderbuffer_bind(&staging, 0);
 
-    // Загрузка текстуры в промежуточный буфер.
-    vulkan_buffer_load_range(&staging, 0, size, pixels);
+    t->generation++;
+}
 
-    vulkan_command_buffer command_buffer;
-    VkCommandPool pool = context->device.graphics_queue.command_pool;
-    VkQueue queue = context->device.graphics_queue.handle;
-    vulkan_command_buffer_allocate_and_begin_single_use(context, pool, &command_buffer);
+bool vulkan_texture_upload_complete(texture* t)
+{
+    if(!t || !t->internal_data)
+    {
+        kerror("Function '%s' requires a valid pointer to texture and their internal data.", __FUNCTION__);
+        return false;
+    }
 
-    // Изменение текущий макета на оптимальный для приема данных.
-    vulkan_image_transition_layout(
-        context, t->type, &command_buffer, image, &image_format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-    );
+    vulkan_image* image = t->internal_data;
+    return vulkan_staging_is_complete(context, image->upload_value);
+}
 
-    // Копирование данных из буфера.
-    vulkan_image_copy_from_buffer(context, t->type, image, ((vulkan_buffer*)staging.internal_data)->handle, &command_buffer);
+// Упаковывает параметры сэмплера карты текстуры в ключ для поиска общего сэмплера.
+static u32 vulkan_sampler_key(texture_map* map)
+{
+    return (u32)map->filter_minify | ((u32)map->filter_magnify << 4) | ((u32)map->repeat_u << 8)
+         | ((u32)map->repeat_v << 12) | ((u32)map->repeat_w << 16);
+}
 
-    // Переход от оптимальной компоновки для получения данных к оптимальной компоновке только для чтения шейдеров.
-    vulkan_image_transition_layout(
-        context, t->type, &command_buffer, image, &image_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    );
+bool vulkan_texture_map_acquire_resources(texture_map* map)
+{
+    // Карты с одинаковыми параметрами используют общий сэмплер.
+    u32 key = vulkan_sampler_key(map);
+    vulkan_sampler_entry* free_entry = null;
 
-    vulkan_command_buffer_end_single_use(context, pool, &command_buffer, queue);
+    for(u32 i = 0; i < VULKAN_MAX_SAMPLER_COUNT; ++i)
+    {
+        vulkan_sampler_entry* entry = &context->samplers[i];
+        if(entry->handle && entry->key == key)
+        {
+            entry->reference_count++;
+            map->internal_data = entry->handle;
+            return true;
+        }
 
-    // Уничтожение толко после записи буфера команд, потому что во время выполнение может оказаться нулевыми данными!
-    renderer_renderbuffer_unbind(&staging);
-    renderer_renderbuffer_destroy(&staging);
+        if(!entry->handle && !free_entry)
+        {
+            free_entry = entry;
+        }
+    }
 
-    t->generation++;
-}
+    if(!free_entry)
+    {
+        kerror("Function '%s': Sampler count exceeds limit %u.", __FUNCTION__, VULKAN_MAX_SAMPLER_COUNT);
+        return false;
+    }
 
-bool vulkan_texture_map_acquire_resources(texture_map* map)
-{
     // Создание сэмплера для текстуры.
     VkSamplerCreateInfo sampler_info = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
 
@@ -1429,13 +1638,17 @@ bool vulkan_texture_map_acquire_resources(texture_map* map)
     sampler_info.minLod = 0.0f;
     sampler_info.maxLod = 0.0f;
 
-    VkResult result = vkCreateSampler(context->device.logical, &sampler_info, context->allocator, (VkSampler*)&map->internal_data);
+    VkResult result = vkCreateSampler(context->device.logical, &sampler_info, context->allocator, &free_entry->handle);
     if(!vulkan_result_is_success(result))
     {
         kerror("Function '%s': Error creating texture sampler: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        free_entry->handle = null;
         return false;
     }
 
+    free_entry->key = key;
+    free_entry->reference_count = 1;
+    map->internal_data = free_entry->handle;
     return true;
 }
 
@@ -1444,11 +1657,28 @@ void vulkan_texture_map_release_resources(texture_map* map)
     if(!map || !map->internal_data)
     {
         kerror("Function '%s' requires a valid pointer to texture map and their internal data.", __FUNCTION__);
+        return;
     }
 
-    vkDeviceWaitIdle(context->device.logical);
+    for(u32 i = 0; i < VULKAN_MAX_SAMPLER_COUNT; ++i)
+    {
+        vulkan_sampler_entry* entry = &context->samplers[i];
+        if(entry->handle != map->internal_data)
+        {
+            continue;
+        }
+
+        entry->reference_count--;
+        if(entry->reference_count == 0)
+        {
+            vkDeviceWaitIdle(context->device.logical);
+            vkDestroySampler(context->device.logical, entry->handle, context->allocator);
+            entry->handle = null;
+            entry->key = 0;
+        }
+        break;
+    }
 
-    vkDestroySampler(context->device.logical, map->internal_data, context->allocator);
     map->internal_data = null;
 }
 
@@ -1552,23 +1782,17 @@ bool vulkan_geometry_create(
 
     if(is_reupload)
     {
-        // Освобождение данных вершин.
+        // NOTE: Старые данные еще могут читать кадры в полете, а загрузка в освобожденный диапазон может выполняться
+        //       выделенной очередью передачи без синхронизации с ними, поэтому диапазоны освобождаются только
+        //       после завершения этих кадров.
         total_size = old_range.vertex_element_size * old_range.vertex_count;
-        if(!renderer_renderbuffer_free(&context->object_vertex_buffer, total_size, old_range.vertex_buffer_offset))
-        {
-            kerror("Function '%s': Free operation failed during reupload of vertex data.", __FUNCTION__);
-            return false;
-        }
+        vulkan_retire_buffer_range(&context->object_vertex_buffer, total_size, old_range.vertex_buffer_offset);
 
         // Освобождение данных индексов, если доступно.
         total_size = old_range.index_element_size * old_range.index_count;
         if(total_size > 0)
         {
-            if(!renderer_renderbuffer_free(&context->object_index_buffer, total_size, old_range.index_buffer_offset))
-            {
-                kerror("Function '%s': Free operation failed during reupload of vertex data.", __FUNCTION__);
-                return false;
-            }
+            vulkan_retire_buffer_range(&context->object_index_buffer, total_size, old_range.index_buffer_offset);
         }
     }
 
@@ -1610,28 +1834,217 @@ void vulkan_geometry_destroy(geometry* geometry)
     internal_data->generation = INVALID_ID;
 }
 
+// Рисует геометрию, экземпляры читаются начиная с first_instance привязанного буфера экземпляров.
+static void vulkan_geometry_draw_internal(geometry_render_data* data, u32 instance_count, u32 first_instance)
+{
+    vulkan_geometry_data* buffer_data = &context->geometries[data->geometry->internal_id];
+    vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
+
+    // NOTE: Повторная привязка уже привязанных буферов пропускается в vulkan_buffer_draw.
+    if(!vulkan_buffer_draw(&context->object_vertex_buffer, buffer_data->vertex_buffer_offset, buffer_data->vertex_count, true))
+    {
+        kerror("Function '%s': Failed to bind vertex buffer.", __FUNCTION__);
+        return;
+    }
+
+    if(buffer_data->index_count == 0)
+    {
+        vkCmdDraw(command_buffer->handle, buffer_data->vertex_count, instance_count, 0, first_instance);
+        context->draw_call_count++;
+        return;
+    }
+
+    // Привязывается начало индексов геометрии, чтобы уровни детализации не требовали повторной привязки.
+    if(!vulkan_buffer_draw(&context->object_index_buffer, buffer_data->index_buffer_offset, buffer_data->index_count, true))
+    {
+        kerror("Function '%s': Failed to bind index buffer.", __FUNCTION__);
+        return;
+    }
+
+    // Уровень детализации - диапазон общего буфера индексов геометрии.
+    u32 first_index = 0;
+    u32 index_count = buffer_data->index_count;
+    if(data->lod < data->geometry->lod_count)
+    {
+        const geometry_lod* lod = &data->geometry->lods[data->lod];
+        first_index = lod->index_offset;
+        index_count = lod->index_count;
+    }
+
+    vkCmdDrawIndexed(command_buffer->handle, index_count, instance_count, first_index, 0, first_instance);
+    context->draw_call_count++;
+}
+
 void vulkan_geometry_draw(geometry_render_data* data)
 {
     // Игнорирование не загруженных геометрий.
     if(!data->geometry || data->geometry->internal_id == INVALID_ID) return;
 
-    vulkan_geometry_data* buffer_data = &context->geometries[data->geometry->internal_id];
-    bool includies_index_data = buffer_data->index_count > 0;
+    vulkan_geometry_draw_internal(data, 1, 0);
+}
+
+// Записывает матрицы моделей в буфер экземпляров текущего кадра, возвращает количество записанных экземпляров.
+static u32 vulkan_instances_write(geometry_render_data* data, u32 instance_count, u32* out_first_instance)
+{
+    u32 available_count = VULKAN_MAX_INSTANCE_COUNT - context->instance_count;
+    if(instance_count > available_count)
+    {
+        kwarng("Function '%s': Instance buffer is full, %u instances skipped.", __FUNCTION__, instance_count - available_count);
+        instance_count = available_count;
+        if(!instance_count) return 0;
+    }
+
+    // Привязка области текущего кадра один раз за буфер команд.
+    u64 frame_offset = sizeof(mat4) * VULKAN_MAX_INSTANCE_COUNT * context->current_frame;
+    if(!context->instance_buffer_bound)
+    {
+        vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
+        vulkan_buffer* instance_buffer = context->object_instance_buffer.internal_data;
+        VkDeviceSize offsets[1] = { frame_offset };
+        vkCmdBindVertexBuffers(command_buffer->handle, 1, 1, &instance_buffer->handle, offsets);
+        context->instance_buffer_bound = true;
+    }
+
+    // Запись матриц моделей экземпляров.
+    u32 first_instance = context->instance_count;
+    mat4* models = (mat4*)(context->instance_mapped + frame_offset) + first_instance;
+    for(u32 i = 0; i < instance_count; ++i)
+    {
+        models[i] = data[i].model;
+    }
+    context->instance_count += instance_count;
+
+    *out_first_instance = first_instance;
+    return instance_count;
+}
+
+// Возвращает количество соседних элементов с той же геометрией и уровнем детализации.
+static u32 vulkan_geometry_run_length(geometry_render_data* data, u32 count)
+{
+    u32 run = 1;
+    while(run < count && data[run].geometry == data->geometry && data[run].lod == data->lod)
+    {
+        ++run;
+    }
+    return run;
+}
+
+void vulkan_geometry_draw_instanced(geometry_render_data* data, u32 instance_count)
+{
+    // Игнорирование не загруженных геометрий.
+    if(!instance_count || !data->geometry || data->geometry->internal_id == INVALID_ID) return;
 
-    if(!vulkan_buffer_draw(&context->object_vertex_buffer, buffer_data->vertex_buffer_offset, buffer_data->vertex_count, includies_index_data))
+    u32 first_instance = 0;
+    instance_count = vulkan_instances_write(data, instance_count, &first_instance);
+    if(!instance_count) return;
+
+    vulkan_geometry_draw_internal(data, instance_count, first_instance);
+}
+
+void vulkan_geometry_draw_batch(geometry_render_data* data, u32 count)
+{
+    if(!context->indirect_draw_enabled)
     {
-        kerror("Function '%s': Failed to draw vertex buffer.", __FUNCTION__);
+        // Прямая отрисовка: отдельный вызов на каждую группу экземпляров.
+        for(u32 i = 0; i < count;)
+        {
+            u32 run = vulkan_geometry_run_length(&data[i], count - i);
+            vulkan_geometry_draw_instanced(&data[i], run);
+            i += run;
+        }
         return;
     }
 
-    if(includies_index_data)
+    u64 frame_offset = sizeof(VkDrawIndexedIndirectCommand) * VULKAN_MAX_INDIRECT_COUNT * context->current_frame;
+    VkDrawIndexedIndirectCommand* commands = (VkDrawIndexedIndirectCommand*)(context->indirect_mapped + frame_offset);
+    u32 first_command = context->indirect_count;
+
+    for(u32 i = 0; i < count;)
     {
-        if(!vulkan_buffer_draw(&context->object_index_buffer, buffer_data->index_buffer_offset, buffer_data->index_count, false))
+        geometry_render_data* render_data = &data[i];
+        u32 run = vulkan_geometry_run_length(render_data, count - i);
+        i += run;
+
+        // Игнорирование не загруженных геометрий.
+        if(!render_data->geometry || render_data->geometry->internal_id == INVALID_ID) continue;
+
+        // Команда задает смещения в элементах общих буферов, поэтому смещения геометрии должны быть кратны
+        // размерам элементов. Остальные геометрии рисуются прямым вызовом.
+        vulkan_geometry_data* buffer_data = &context->geometries[render_data->geometry->internal_id];
+        if(buffer_data->index_count == 0 || context->indirect_count >= VULKAN_MAX_INDIRECT_COUNT
+        || buffer_data->vertex_buffer_offset % buffer_data->vertex_element_size != 0
+        || buffer_data->index_buffer_offset % buffer_data->index_element_size != 0)
         {
-            kerror("Function '%s': Failed to draw index buffer.", __FUNCTION__);
-            return;
+            vulkan_geometry_draw_instanced(render_data, run);
+            continue;
         }
+
+        u32 first_instance = 0;
+        u32 instance_count = vulkan_instances_write(render_data, run, &first_instance);
+        if(!instance_count) continue;
+
+        // Уровень детализации - диапазон индексов геометрии.
+        u32 first_index = 0;
+        u32 index_count = buffer_data->index_count;
+        if(render_data->lod < render_data->geometry->lod_count)
+        {
+            const geometry_lod* lod = &render_data->geometry->lods[render_data->lod];
+            first_index = lod->index_offset;
+            index_count = lod->index_count;
+        }
+
+        VkDrawIndexedIndirectCommand* command = &commands[context->indirect_count++];
+        command->indexCount = index_count;
+        command->instanceCount = instance_count;
+        command->firstIndex = (u32)(buffer_data->index_buffer_offset / buffer_data->index_element_size) + first_index;
+        command->vertexOffset = (i32)(buffer_data->vertex_buffer_offset / buffer_data->vertex_element_size);
+        command->firstInstance = first_instance;
+    }
+
+    u32 command_count = context->indirect_count - first_command;
+    if(!command_count) return;
+
+    // Общие буферы привязываются с нулевым смещением, смещения геометрий заданы в командах.
+    vulkan_buffer_draw(&context->object_vertex_buffer, 0, 0, true);
+    vulkan_buffer_draw(&context->object_index_buffer, 0, 0, true);
+
+    vulkan_command_buffer* command_buffer = &context->graphics_command_buffers[context->image_index];
+    vulkan_buffer* indirect_buffer = context->object_indirect_buffer.internal_data;
+    VkDeviceSize command_offset = frame_offset + sizeof(VkDrawIndexedIndirectCommand) * first_command;
+    const u32 stride = sizeof(VkDrawIndexedIndirectCommand);
+
+    if(context->device.features.multiDrawIndirect)
+    {
+        vkCmdDrawIndexedIndirect(command_buffer->handle, indirect_buffer->handle, command_offset, command_count, stride);
+        context->draw_call_count++;
+        return;
+    }
+
+    // Без multiDrawIndirect допускается только одна команда за вызов.
+    for(u32 i = 0; i < command_count; ++i)
+    {
+        vkCmdDrawIndexedIndirect(command_buffer->handle, indirect_buffer->handle, command_offset + stride * i, 1, stride);
+    }
+    context->draw_call_count += command_count;
+}
+
+bool vulkan_indirect_draw_set(bool enabled)
+{
+    // NOTE: Смещение экземпляров задается в команде, что требует drawIndirectFirstInstance.
+    if(enabled && !context->device.features.drawIndirectFirstInstance)
+    {
+        kwarng("Function '%s': Device does not support drawIndirectFirstInstance, direct draws are used.", __FUNCTION__);
+        context->indirect_draw_enabled = false;
+        return false;
     }
+
+    context->indirect_draw_enabled = enabled;
+    return true;
+}
+
+u32 vulkan_draw_call_count_get()
+{
+    return context->frame_draw_call_count;
 }
 
 bool vulkan_shader_create(struct shader* s, const shader_config* config, renderpass* pass, u8 stage_count, const char** stage_filenames, shader_stage* stages)
@@ -1746,10 +2159,31 @@ bool vulkan_shader_create(struct shader* s, const shader_config* config, renderp
         }
     }
 
+    // Режим без привязки: текстуры экземпляров берутся из общего массива контекста, а uniform-переменные
+    // экземпляров и индексы текстур - из буфера материалов. Без поддержки устройства или без файлов
+    // стадий для этого режима используются наборы дескрипторов экземпляров.
+    u32 bindless_stage_count = config->bindless_stage_filenames ? darray_length(config->bindless_stage_filenames) : 0;
+    vk_shader->bindless = context->bindless.enabled && bindless_stage_count > 0
+                       && bindless_stage_count == vk_shader->config.stage_count
+                       && (vk_shader->instance_uniform_count > 0 || vk_shader->instance_uniform_sampler_count > 0);
+
+    if(vk_shader->bindless)
+    {
+        for(u32 i = 0; i < vk_shader->config.stage_count; ++i)
+        {
+            string_ncopy(vk_shader->config.stages[i].file_name, config->bindless_stage_filenames[i], 255);
+        }
+    }
+
     // HACK: Максимальное число ubo дескрипторных наборов.
     vk_shader->config.pool_sizes[0] = (VkDescriptorPoolSize){VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1024};
     // HACK: Максимальное число image sampler дескрипторных наборов.
     vk_shader->config.pool_sizes[1] = (VkDescriptorPoolSize){VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096};
+    if(vk_shader->bindless)
+    {
+        // Единственный набор буфера материалов.
+        vk_shader->config.pool_sizes[1] = (VkDescriptorPoolSize){VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1};
+    }
 
     // Глобальный набор дескрипторов (UBO).
     if(vk_shader->global_uniform_count > 0 || vk_shader->global_uniform_sampler_count > 0)
@@ -1780,8 +2214,19 @@ bool vulkan_shader_create(struct shader* s, const shader_config* config, renderp
         vk_shader->config.descriptor_set_count++;
     }
 
+    // Без привязки второй набор содержит только буфер материалов.
+    if(vk_shader->bindless)
+    {
+        vulkan_descriptor_set_config* set_config = &vk_shader->config.descriptor_sets[vk_shader->config.descriptor_set_count];
+        set_config->bindings[0].binding = 0;
+        set_config->bindings[0].descriptorCount = 1;
+        set_config->bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        set_config->bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        set_config->binding_count = 1;
+        vk_shader->config.descriptor_set_count++;
+    }
     // При изпользовании экземпляров, добавляется второй набор дескрипторов (UBO).
-    if(vk_shader->instance_uniform_count > 0 || vk_shader->instance_uniform_sampler_count > 0)
+    else if(vk_shader->instance_uniform_count > 0 || vk_shader->instance_uniform_sampler_count > 0)
     {
         vulkan_descriptor_set_config* set_config = &vk_shader->config.descriptor_sets[vk_shader->config.descriptor_set_count];
 
@@ -1848,6 +2293,14 @@ void vulkan_shader_destroy(shader* shader)
     vk_shader->uniform_buffer_mapped_block = null;
     renderer_renderbuffer_destroy(&vk_shader->uniform_buffer);
 
+    // Буфер материалов.
+    if(vk_shader->material_buffer_mapped_block)
+    {
+        vulkan_buffer_unmap_memory(&vk_shader->material_buffer, 0, VK_WHOLE_SIZE);
+        vk_shader->material_buffer_mapped_block = null;
+        renderer_renderbuffer_destroy(&vk_shader->material_buffer);
+    }
+
     // Pipeline.
     vulkan_pipeline_destroy(context, &vk_shader->pipeline);
 
@@ -1861,6 +2314,61 @@ void vulkan_shader_destroy(shader* shader)
     shader->internal_data = null;
 }
 
+// Смещение индексов текстур в элементе буфера материалов (после uniform-переменных экземпляра).
+static u64 vulkan_shader_material_slots_offset(shader* shader)
+{
+    return get_aligned(shader->ubo_size, sizeof(u32));
+}
+
+// Создает буфер материалов шейдера без привязки и его набор дескрипторов.
+static bool vulkan_shader_material_buffer_create(shader* shader)
+{
+    vulkan_shader* vk_shader = shader->internal_data;
+
+    // NOTE: Элемент буфера соответствует структуре std430: uniform-переменные экземпляра в порядке shadercfg,
+    //       затем индексы текстур (u32) в массиве без привязки, размер выровнен до 16 байт.
+    u64 slots_size = sizeof(u32) * shader->instance_texture_count;
+    vk_shader->material_stride = get_aligned(vulkan_shader_material_slots_offset(shader) + slots_size, 16);
+
+    u64 buffer_size = (u64)vk_shader->material_stride * VULKAN_SHADER_MAX_MATERIAL_COUNT;
+    if(!renderer_renderbuffer_create(RENDERBUFFER_TYPE_STORAGE, buffer_size, false, &vk_shader->material_buffer))
+    {
+        kerror("Function '%s': Failed to create vulkan buffer.", __FUNCTION__);
+        return false;
+    }
+    renderer_renderbuffer_bind(&vk_shader->material_buffer, 0);
+    vk_shader->material_buffer_mapped_block = vulkan_buffer_map_memory(&vk_shader->material_buffer, 0, VK_WHOLE_SIZE);
+
+    VkDescriptorSetAllocateInfo allocate_info = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocate_info.descriptorPool = vk_shader->descriptor_pool;
+    allocate_info.descriptorSetCount = 1;
+    allocate_info.pSetLayouts = &vk_shader->descriptor_set_layouts[1];
+
+    VkResult result = vkAllocateDescriptorSets(context->device.logical, &allocate_info, &vk_shader->material_descriptor_set);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to allocate material descriptor set: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        return false;
+    }
+
+    // Набор ссылается на весь буфер и больше не обновляется.
+    VkDescriptorBufferInfo buffer_info;
+    buffer_info.buffer = ((vulkan_buffer*)vk_shader->material_buffer.internal_data)->handle;
+    buffer_info.offset = 0;
+    buffer_info.range = VK_WHOLE_SIZE;
+
+    VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = vk_shader->material_descriptor_set;
+    write.dstBinding = 0;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.descriptorCount = 1;
+    write.pBufferInfo = &buffer_info;
+    vkUpdateDescriptorSets(context->device.logical, 1, &write, 0, null);
+
+    ktrace("Shader '%s' uses bindless textures (material stride %u bytes).", shader->name, vk_shader->material_stride);
+    return true;
+}
+
 bool vulkan_shader_initialize(shader* shader)
 {
     if(!shader_status_valid(shader, __FUNCTION__)) return false;
@@ -1897,16 +2405,34 @@ bool vulkan_shader_initialize(shader* shader)
     };
 
     // Получение атрибутов.
-    u32 attribute_count = darray_length(shader->attributes);
-    u32 attribute_offset = 0;
+    // NOTE: Атрибуты вершин читаются из binding 0, атрибуты экземпляров из binding 1. Матрица занимает
+    //       четыре последовательных местоположения по одному столбцу vec4.
+    u32 shader_attribute_count = darray_length(shader->attributes);
+    u32 attribute_count = 0;
+    u32 attribute_offsets[2] = { 0, 0 };
     VkVertexInputAttributeDescription* attrs = vk_shader->config.attributes;
-    for(u32 i = 0; i < attribute_count; ++i)
+    for(u32 i = 0; i < shader_attribute_count; ++i)
     {
-        attrs[i].location = i;
-        attrs[i].binding = 0; // NOTE: binding 0 описывает пачуку атрибутов как единый пакет данных (т.е. единый элемент данных).
-        attrs[i].offset = attribute_offset;
-        attrs[i].format = attribute_types[shader->attributes[i].type];
-        attribute_offset += shader->attributes[i].size;
+        shader_attribute* attribute = &shader->attributes[i];
+        u32 binding = attribute->per_instance ? 1 : 0;
+        bool is_matrix = attribute->type == SHADER_ATTRIB_TYPE_MATRIX_4;
+        u32 column_count = is_matrix ? 4 : 1;
+
+        if(attribute_count + column_count > VULKAN_SHADER_MAX_ATTRIBUTES)
+        {
+            kerror("Function '%s': Shader '%s' exceeds %u vertex attributes.", __FUNCTION__, shader->name, VULKAN_SHADER_MAX_ATTRIBUTES);
+            return false;
+        }
+
+        for(u32 c = 0; c < column_count; ++c)
+        {
+            attrs[attribute_count].location = attribute_count;
+            attrs[attribute_count].binding = binding;
+            attrs[attribute_count].offset = attribute_offsets[binding];
+            attrs[attribute_count].format = is_matrix ? VK_FORMAT_R32G32B32A32_SFLOAT : attribute_types[attribute->type];
+            attribute_offsets[binding] += is_matrix ? 16 : attribute->size;
+            attribute_count++;
+        }
     }
 
     // Пул дескрипторов.
@@ -1960,9 +2486,22 @@ bool vulkan_shader_initialize(shader* shader)
         stage_create_infos[i] = vk_shader->stages[i].shader_stage_create_info;
     }
 
+    // Без привязки между глобальным набором и набором материалов находится массив текстур контекста.
+    VkDescriptorSetLayout pipeline_layouts[3] = {
+        vk_shader->descriptor_set_layouts[DESC_SET_INDEX_GLOBAL], vk_shader->descriptor_set_layouts[1], null
+    };
+    u32 pipeline_layout_count = vk_shader->config.descriptor_set_count;
+    if(vk_shader->bindless)
+    {
+        pipeline_layouts[DESC_SET_INDEX_BINDLESS] = context->bindless.layout;
+        pipeline_layouts[DESC_SET_INDEX_MATERIAL] = vk_shader->descriptor_set_layouts[1];
+        pipeline_layout_count = 3;
+    }
+
     bool pipeline_result = vulkan_graphics_pipeline_create(
-        context, vk_shader->renderpass, shader->attribute_stride, attribute_count, vk_shader->config.attributes,
-        vk_shader->config.descriptor_set_count, vk_shader->descriptor_set_layouts, vk_shader->config.stage_count,
+        context, vk_shader->renderpass, shader->attribute_stride, shader->instance_attribute_stride, attribute_count,
+        vk_shader->config.attributes,
+        pipeline_layout_count, pipeline_layouts, vk_shader->config.stage_count,
         stage_create_infos, viewport, scissor, vk_shader->config.cull_mode, false, true, shader->push_constant_range_count,
         shader->push_constant_ranges, &vk_shader->pipeline
     );
@@ -1987,7 +2526,9 @@ bool vulkan_shader_initialize(shader* shader)
 
     // Создание uniform буфера.
     // TODO: Максимальное количество должно быть настраиваемым или должна быть долгосрочная поддержка изменения размера буфера.
-    u64 total_buffer_size = shader->global_ubo_stride + (shader->ubo_stride * VULKAN_SHADER_MAX_MATERIAL_COUNT);
+    // NOTE: Без привязки данные экземпляров хранятся в буфере материалов.
+    u64 instance_buffer_size = vk_shader->bindless ? 0 : shader->ubo_stride * VULKAN_SHADER_MAX_MATERIAL_COUNT;
+    u64 total_buffer_size = shader->global_ubo_stride + instance_buffer_size;
     if(!renderer_renderbuffer_create(RENDERBUFFER_TYPE_UNIFORM, total_buffer_size, true, &vk_shader->uniform_buffer))
     {
         kerror("Function '%s': Failed to create vulkan buffer for object shader.", __FUNCTION__);
@@ -2020,6 +2561,12 @@ bool vulkan_shader_initialize(shader* shader)
     allocate_info.pSetLayouts = global_layouts;
     VK_CHECK(vkAllocateDescriptorSets(logical, &allocate_info, vk_shader->global_descriptor_sets));
 
+    if(vk_shader->bindless && !vulkan_shader_material_buffer_create(shader))
+    {
+        kerror("Function '%s': Failed to create material buffer for shader '%s'.", __FUNCTION__, shader->name);
+        return false;
+    }
+
     return true;
 }
 
@@ -2098,9 +2645,76 @@ bool vulkan_shader_apply_globals(shader* shader)
         command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_shader->pipeline.layout, 0, 1, &global_descriptor, 0, null
     );
 
+    // Без привязки массив текстур и буфер материалов привязываются один раз для всех экземпляров.
+    if(vk_shader->bindless)
+    {
+        VkDescriptorSet bindless_sets[2] = { context->bindless.set, vk_shader->material_descriptor_set };
+        vkCmdBindDescriptorSets(
+            command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_shader->pipeline.layout, DESC_SET_INDEX_BINDLESS, 2,
+            bindless_sets, 0, null
+        );
+    }
+
     return true;
 }
 
+// Возвращает текстуру карты или текстуру по умолчанию для ее назначения, если текстура еще не загружена.
+static texture* vulkan_texture_map_resolve(texture_map* map)
+{
+    texture* t = map->texture;
+    if(t->generation != INVALID_ID)
+    {
+        return t;
+    }
+
+    switch(map->use)
+    {
+        case TEXTURE_USE_MAP_DIFFUSE:
+            return texture_system_get_default_diffuse_texture();
+        case TEXTURE_USE_MAP_SPECULAR:
+            return texture_system_get_default_specular_texture();
+        case TEXTURE_USE_MAP_NORMAL:
+            return texture_system_get_default_normal_texture();
+        default:
+            kwarng("Function '%s': Undefined texture use %d", __FUNCTION__, map->use);
+            return texture_system_get_default_texture();
+    }
+}
+
+// Обновляет слоты текстур экземпляра в массиве без привязки и записывает их индексы в буфер материалов.
+static void vulkan_shader_bindless_slots_write(shader* shader, vulkan_shader_instance_state* state)
+{
+    vulkan_shader* vk_shader = shader->internal_data;
+    u32* slot_indices = POINTER_GET_OFFSET(vk_shader->material_buffer_mapped_block, state->offset + vulkan_shader_material_slots_offset(shader));
+
+    // Зарезервированный слот заменяет слоты, которые не удалось выделить.
+    vulkan_image* default_image = texture_system_get_default_texture()->internal_data;
+    vulkan_bindless_default_texture_set(context, default_image->view);
+
+    for(u32 i = 0; i < shader->instance_texture_count; ++i)
+    {
+        texture_map* map = state->instance_texture_maps[i];
+        texture* t = vulkan_texture_map_resolve(map);
+        vulkan_image* image = t->internal_data;
+        vulkan_bindless_slot* slot = &state->texture_slots[i];
+
+        // Дескриптор переписывается только при замене текстуры (в том числе ее пересоздании) или сэмплера.
+        if(slot->index == INVALID_ID || slot->texture != t || slot->generation != t->generation
+        || slot->view != image->view || slot->sampler != map->internal_data)
+        {
+            // NOTE: Старый слот еще может читаться кадрами в полете.
+            vulkan_bindless_texture_release(context, slot->index, false);
+            slot->index = vulkan_bindless_texture_acquire(context, image->view, map->internal_data);
+            slot->texture = t;
+            slot->generation = t->generation;
+            slot->view = image->view;
+            slot->sampler = map->internal_data;
+        }
+
+        slot_indices[i] = slot->index != INVALID_ID ? slot->index : VULKAN_BINDLESS_DEFAULT_SLOT;
+    }
+}
+
 bool vulkan_shader_apply_instance(struct shader* shader, bool needs_update)
 {
     if(!shader_status_valid(shader, __FUNCTION__)) return false;
@@ -2112,11 +2726,21 @@ bool vulkan_shader_apply_instance(struct shader* shader, bool needs_update)
         return false;
     }
 
-    u32 image_index = context->image_index;
-    VkCommandBuffer command_buffer = context->graphics_command_buffers[image_index].handle;
-
     // Получение данных экземпляра.
     vulkan_shader_instance_state* object_state = &vk_shader->instance_states[shader->bound_instance_id];
+
+    // Без привязки экземпляр выбирается индексом материала в константах отрисовки, наборы не меняются.
+    if(vk_shader->bindless)
+    {
+        if(needs_update)
+        {
+            vulkan_shader_bindless_slots_write(shader, object_state);
+        }
+        return true;
+    }
+
+    u32 image_index = context->image_index;
+    VkCommandBuffer command_buffer = context->graphics_command_buffers[image_index].handle;
     VkDescriptorSet object_descriptor_set = object_state->descriptor_set_state.descriptor_sets[image_index];
 
     if(needs_update)
@@ -2165,28 +2789,9 @@ bool vulkan_shader_apply_instance(struct shader* shader, bool needs_update)
             for(u32 i = 0; i < total_sampler_count; ++i)
             {
                 texture_map* map = vk_shader->instance_states[shader->bound_instance_id].instance_texture_maps[i];
-                texture* t = map->texture;
 
                 // Переопределение недействительной текстуры.
-                if(t->generation == INVALID_ID)
-                {
-                    switch(map->use)
-                    {
-                        case TEXTURE_USE_MAP_DIFFUSE:
-                            t = texture_system_get_default_diffuse_texture();
-                            break;
-                        case TEXTURE_USE_MAP_SPECULAR:
-                            t = texture_system_get_default_specular_texture();
-                            break;
-                        case TEXTURE_USE_MAP_NORMAL:
-                            t = texture_system_get_default_normal_texture();
-                            break;
-                        default:
-                            kwarng("Function '%s': Undefined texture use %d", __FUNCTION__, map->use);
-                            t = texture_system_get_default_texture();
-                            break;
-                    }
-                }
+                texture* t = vulkan_texture_map_resolve(map);
 
                 vulkan_image* image = t->internal_data;
                 image_infos[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -2253,8 +2858,7 @@ bool vulkan_shader_acquire_instance_resources(shader* s, texture_map** maps, u32
     }
 
     vulkan_shader_instance_state* instance_state = &vk_shader->instance_states[*out_instance_id];
-    u8 sampler_binding_index = vk_shader->config.descriptor_sets[DESC_SET_INDEX_INSTANCE].sampler_binding_index;
-    u32 instance_texture_count = vk_shader->config.descriptor_sets[DESC_SET_INDEX_INSTANCE].bindings[sampler_binding_index].descriptorCount;
+    u32 instance_texture_count = s->instance_texture_count;
     instance_state->instance_texture_maps = kallocate_tc(texture_map*, s->instance_texture_count, MEMORY_TAG_ARRAY);
     kcopy_tc(instance_state->instance_texture_maps, maps, texture_map*, s->instance_texture_count);
 
@@ -2268,6 +2872,24 @@ bool vulkan_shader_acquire_instance_resources(shader* s, texture_map** maps, u32
         }
     }
 
+    // Без привязки экземпляр занимает элемент буфера материалов с индексом экземпляра.
+    if(vk_shader->bindless)
+    {
+        instance_state->offset = (ptr)(*out_instance_id) * vk_shader->material_stride;
+        kzero(POINTER_GET_OFFSET(vk_shader->material_buffer_mapped_block, instance_state->offset), vk_shader->material_stride);
+
+        instance_state->texture_slots = kallocate_tc(vulkan_bindless_slot, instance_texture_count, MEMORY_TAG_ARRAY);
+        for(u32 i = 0; i < instance_texture_count; ++i)
+        {
+            instance_state->texture_slots[i].index = INVALID_ID;
+            instance_state->texture_slots[i].texture = null;
+            instance_state->texture_slots[i].generation = INVALID_ID;
+            instance_state->texture_slots[i].view = null;
+            instance_state->texture_slots[i].sampler = null;
+        }
+        return true;
+    }
+
     // Выделение места в UBO по шагу, а не по размеру.
     u64 size = s->ubo_stride;
     if(size > 0)
@@ -2334,17 +2956,36 @@ bool vulkan_shader_release_instance_resources(shader* shader, u32 instance_id)
     // Ожидание завершения всех операций, использующих набор дескрипторов.
     vkDeviceWaitIdle(context->device.logical);
 
-    // Освобождение 5 набора дескрипторов (по одному на кадр).
-    VkResult result = vkFreeDescriptorSets(
-        context->device.logical, vk_shader->descriptor_pool, 5, instance_state->descriptor_set_state.descriptor_sets
-    );
-
-    if(result != VK_SUCCESS)
+    if(vk_shader->bindless)
     {
-        kerror("Function '%s': Failed to free object shader descriptor sets!", __FUNCTION__);
+        // Устройство простаивает, поэтому слоты возвращаются сразу.
+        for(u32 i = 0; i < shader->instance_texture_count; ++i)
+        {
+            vulkan_bindless_texture_release(context, instance_state->texture_slots[i].index, true);
+        }
+        kfree(instance_state->texture_slots, MEMORY_TAG_ARRAY);
+        instance_state->texture_slots = null;
     }
+    else
+    {
+        // Освобождение 5 набора дескрипторов (по одному на кадр).
+        VkResult result = vkFreeDescriptorSets(
+            context->device.logical, vk_shader->descriptor_pool, 5, instance_state->descriptor_set_state.descriptor_sets
+        );
 
-    kzero_tc(instance_state->descriptor_set_state.descriptor_sets, vulkan_descriptor_state, VULKAN_SHADER_MAX_BINDINGS);
+        if(result != VK_SUCCESS)
+        {
+            kerror("Function '%s': Failed to free object shader descriptor sets!", __FUNCTION__);
+        }
+
+        kzero_tc(instance_state->descriptor_set_state.descriptor_sets, vulkan_descriptor_state, VULKAN_SHADER_MAX_BINDINGS);
+
+        // TODO: Размер ubo_stride не проверсяется.
+        if(!renderer_renderbuffer_free(&vk_shader->uniform_buffer, shader->ubo_stride, instance_state->offset))
+        {
+            kerror("Function '%s': Failed to free uniform buffer range.", __FUNCTION__);
+        }
+    }
 
     if(instance_state->instance_texture_maps)
     {
@@ -2352,12 +2993,6 @@ bool vulkan_shader_release_instance_resources(shader* shader, u32 instance_id)
         instance_state->instance_texture_maps = null;
     }
 
-    // TODO: Размер ubo_stride не проверсяется.
-    if(!renderer_renderbuffer_free(&vk_shader->uniform_buffer, shader->ubo_stride, instance_state->offset))
-    {
-        kerror("Function '%s': Failed to free uniform buffer range.", __FUNCTION__);
-    }
-
     instance_state->offset = INVALID_ID;
     instance_state->id = INVALID_ID;
 
@@ -2394,14 +3029,49 @@ bool vulkan_shader_set_uniform(shader* shader, struct shader_uniform* uniform, c
         else
         {
             // Отображение соответствующей области памяти и скопирование данных.
+            // NOTE: Без привязки данные экземпляра находятся в буфере материалов.
+            bool material_data = vk_shader->bindless && uniform->scope == SHADER_SCOPE_INSTANCE;
+            void* block = material_data ? vk_shader->material_buffer_mapped_block : vk_shader->uniform_buffer_mapped_block;
             u64 uniform_offset = shader->bound_ubo_offset + uniform->offset;
-            void* addr = POINTER_GET_OFFSET(vk_shader->uniform_buffer_mapped_block, uniform_offset);
+            void* addr = POINTER_GET_OFFSET(block, uniform_offset);
             kcopy(addr, value, uniform->size);
         }
     }
     return true;
 }
 
+bool vulkan_shader_push_draw_constants(shader* shader, const mat4* model, u32 material_index)
+{
+    vulkan_shader* vk_shader = shader->internal_data;
+    VkCommandBuffer command_buffer = context->graphics_command_buffers[context->image_index].handle;
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    shader_uniform* model_uniform = shader->draw_model_index != INVALID_ID_U16 && model
+                                  ? &shader->uniforms[shader->draw_model_index] : null;
+    shader_uniform* material_uniform = shader->draw_material_index != INVALID_ID_U16
+                                     ? &shader->uniforms[shader->draw_material_index] : null;
+
+    // Соседние диапазоны записываются одной командой.
+    if(model_uniform && material_uniform && model_uniform->offset + sizeof(mat4) == material_uniform->offset)
+    {
+        struct { mat4 model; u32 material_index; } block = { *model, material_index };
+        vkCmdPushConstants(command_buffer, vk_shader->pipeline.layout, stages, model_uniform->offset, sizeof(mat4) + sizeof(u32), &block);
+        return true;
+    }
+
+    if(model_uniform)
+    {
+        vkCmdPushConstants(command_buffer, vk_shader->pipeline.layout, stages, model_uniform->offset, sizeof(mat4), model);
+    }
+
+    if(material_uniform)
+    {
+        vkCmdPushConstants(command_buffer, vk_shader->pipeline.layout, stages, material_uniform->offset, sizeof(u32), &material_index);
+    }
+
+    return true;
+}
+
 void vulkan_render_target_create(u8 attachment_count, texture** attachments, renderpass* pass, u32 width, u32 height, render_target* out_target)
 {
     VkImageView attachment_views[32]; // Максимальное количество!
@@ -2507,26 +3177,23 @@ bool vulkan_buffer_is_host_cached(vulkan_buffer* buffer)
 
 bool vulkan_buffer_copy_range_internal(VkBuffer src, ptr src_offset, VkBuffer dest, ptr dest_offset, ptr size)
 {
-    VkQueue queue = context->device.graphics_queue.handle;
-    VkCommandPool pool = context->device.graphics_queue.command_pool;
-
-    // Ожидание завершения операций в очереди.
-    vkQueueWaitIdle(queue);
+    // Копирование выполняется в очереди графики после ожидающих загрузок и получения владения ими,
+    // после него данные сразу доступны (чтение, изменение размера).
+    vulkan_staging_flush(context, true);
 
-    // Создание временного буфера команд.
     vulkan_command_buffer command_buffer;
+    VkCommandPool pool = context->device.graphics_queue.command_pool;
     vulkan_command_buffer_allocate_and_begin_single_use(context, pool, &command_buffer);
 
-    // Подготовить команду копирования и добавить в буфер команд.
-    VkBufferCopy copy_region;
-    copy_region.srcOffset = src_offset;
-    copy_region.dstOffset = dest_offset;
-    copy_region.size = size;
-    vkCmdCopyBuffer(command_buffer.handle, src, dest, 1, &copy_region);
+    if(context->staging.dedicated)
+    {
+        vulkan_staging_acquire_record(context, &command_buffer);
+    }
 
-    // Отправить на выполнение временный буфер команд.
-    vulkan_command_buffer_end_single_use(context, pool, &command_buffer, queue);
+    VkBufferCopy region = { src_offset, dest_offset, size };
+    vkCmdCopyBuffer(command_buffer.handle, src, dest, 1, &region);
 
+    vulkan_command_buffer_end_single_use(context, pool, &command_buffer, context->device.graphics_queue.handle);
     return true;
 }
 
@@ -2566,8 +3233,20 @@ bool vulkan_buffer_create(renderbuffer* buffer)
             internal_buffer.memory_property_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
             break;
         case RENDERBUFFER_TYPE_STORAGE:
-            kerror("Function '%s': Storage buffer not yet supported.", __FUNCTION__);
-            return false;
+            internal_buffer.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            internal_buffer.memory_property_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            internal_buffer.memory_property_flags |= context->device.memory_local_host_visible_support ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT : 0;
+            break;
+        case RENDERBUFFER_TYPE_INSTANCE:
+            internal_buffer.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+            internal_buffer.memory_property_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            internal_buffer.memory_property_flags |= context->device.memory_local_host_visible_support ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT : 0;
+            break;
+        case RENDERBUFFER_TYPE_INDIRECT:
+            internal_buffer.usage = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+            internal_buffer.memory_property_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            internal_buffer.memory_property_flags |= context->device.memory_local_host_visible_support ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT : 0;
+            break;
         default:
             kerror("Function '%s' called with unsupported buffer type: %i.", __FUNCTION__, buffer->type);
             return false;;
@@ -2628,6 +3307,10 @@ void vulkan_buffer_destroy(renderbuffer* buffer)
 
     vulkan_buffer* internal_buffer = buffer->internal_data;
 
+    // Неотправленные загрузки могут ссылаться на буфер.
+    vulkan_staging_flush(context, true);
+    vulkan_staging_forget(context, internal_buffer->handle, VK_NULL_HANDLE);
+
     // Освобождение памяти.
     if(internal_buffer->memory)
     {
@@ -2865,24 +3548,12 @@ bool vulkan_buffer_load_range(renderbuffer* buffer, ptr offset, ptr size, const
 
     if(vulkan_buffer_is_device_local(internal_buffer) && !vulkan_buffer_is_host_visible(internal_buffer))
     {
-        // Создание промежуточного буфера для загрузки в видеопамять.
-        renderbuffer staging;
-        if(!renderer_renderbuffer_create(RENDERBUFFER_TYPE_STAGING, size, false, &staging))
+        // Загрузка в видеопамять через кольцо промежуточного буфера (без ожидания очереди).
+        if(!vulkan_staging_upload_buffer(context, internal_buffer->handle, offset, size, data))
         {
-            kerror("Function '%': Failed to create staging buffer.", __FUNCTION__);
+            kerror("Function '%s': Failed to upload buffer range.", __FUNCTION__);
             return false;
         }
-        renderer_renderbuffer_bind(&staging, 0);
-
-        // Загрузка данных в промежуточный буфер.
-        vulkan_buffer_load_range(&staging, 0, size, data);
-
-        // Копирование из промежуточного буфер в видеопамять.
-        vulkan_buffer_copy_range(&staging, 0, buffer, offset, size);
-
-        // Уничтожение буфера чтения.
-        renderer_renderbuffer_unbind(&staging);
-        renderer_renderbuffer_destroy(&staging);
     }
     else
     {
@@ -2920,25 +3591,38 @@ bool vulkan_buffer_draw(renderbuffer* buffer, ptr offset, u32 element_count, boo
     if(buffer->type == RENDERBUFFER_TYPE_VERTEX)
     {
         // Установка смещения для буфера вершин.
-        VkDeviceSize offsets[1] = { offset };
-        vkCmdBindVertexBuffers(command_buffer->handle, 0, 1, &internal_buffer->handle, offsets);
+        // Исключает повторную привязку того же буфера с тем же смещением.
+        if(context->bound_vertex_buffer != internal_buffer->handle || context->bound_vertex_offset != offset)
+        {
+            VkDeviceSize offsets[1] = { offset };
+            vkCmdBindVertexBuffers(command_buffer->handle, 0, 1, &internal_buffer->handle, offsets);
+            context->bound_vertex_buffer = internal_buffer->handle;
+            context->bound_vertex_offset = offset;
+        }
 
         // Отрисовка вершин.
         if(!bind_only)
         {
             vkCmdDraw(command_buffer->handle, element_count, 1, 0, 0);
+            context->draw_call_count++;
         }
     }
     else if(buffer->type == RENDERBUFFER_TYPE_INDEX)
     {
         // Установка смещения для буфера индексов.
-        vkCmdBindIndexBuffer(command_buffer->handle, internal_buffer->handle, offset, VK_INDEX_TYPE_UINT32);
+        if(context->bound_index_buffer != internal_buffer->handle || context->bound_index_offset != offset)
+        {
+            vkCmdBindIndexBuffer(command_buffer->handle, internal_buffer->handle, offset, VK_INDEX_TYPE_UINT32);
+            context->bound_index_buffer = internal_buffer->handle;
+            context->bound_index_offset = offset;
+        }
 
         // Отрисовка вершин по индексам.
         if(!bind_only)
         {
             // TODO: VUID-vkCmdDrawIndexed-None-08114
             vkCmdDrawIndexed(command_buffer->handle, element_count, 1, 0, 0, 0);
+            context->draw_call_count++;
         }
     }
     else
@@ -23,12 +23,17 @@ void vulkan_texture_create_writable(texture* t);
 void vulkan_texture_destroy(texture* t);
 void vulkan_texture_resize(texture* t, u32 new_width, u32 new_height);
 void vulkan_texture_write_data(texture* t, u32 offset, u32 size, const void* pixels);
+bool vulkan_texture_upload_complete(texture* t);
 bool vulkan_texture_map_acquire_resources(texture_map* map);
 void vulkan_texture_map_release_resources(texture_map* map);
 
 bool vulkan_geometry_create(geometry* geometry, u32 vertex_size, u32 vertex_count, const void* vertices, u32 index_size, u32 index_count, const void* indices);
 void vulkan_geometry_destroy(geometry* geometry);
 void vulkan_geometry_draw(geometry_render_data* data);
+void vulkan_geometry_draw_instanced(geometry_render_data* data, u32 instance_count);
+void vulkan_geometry_draw_batch(geometry_render_data* data, u32 count);
+bool vulkan_indirect_draw_set(bool enabled);
+u32 vulkan_draw_call_count_get();
 
 bool vulkan_shader_create(struct shader* s, const shader_config* config, renderpass* pass, u8 stage_count, const char** stage_filenames, shader_stage* stages);
 void vulkan_shader_destroy(struct shader* shader);
@@ -41,6 +46,7 @@ bool vulkan_shader_apply_instance(struct shader* shader, bool needs_update);
 bool vulkan_shader_acquire_instance_resources(struct shader* shader, texture_map** maps, u32* out_instance_id);
 bool vulkan_shader_release_instance_resources(struct shader* shader, u32 instance_id);
 bool vulkan_shader_set_uniform(struct shader* shader, struct shader_uniform* uniform, const void* value);
+bool vulkan_shader_push_draw_constants(struct shader* shader, const mat4* model, u32 material_index);
 
 void vulkan_render_target_create(u8 attachment_count, texture** attachments, renderpass* pass, u32 width, u32 height, render_target* out_target);
 void vulkan_render_target_destroy(render_target* target, bool free_internal_memory);
@@ -0,0 +1,253 @@
+// Собственные подключения.
+#include "renderer/vulkan/vulkan_bindless.h"
+#include "renderer/vulkan/vulkan_utils.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "containers/darray.h"
+
+bool vulkan_bindless_create(vulkan_context* context)
+{
+    vulkan_bindless* bindless = &context->bindless;
+    bindless->enabled = false;
+
+    if(!context->device.descriptor_indexing_support)
+    {
+        kinfor("Descriptor indexing is not supported, materials use per-instance descriptor sets.");
+        return true;
+    }
+
+    bindless->capacity = VULKAN_BINDLESS_MAX_TEXTURES;
+    if(context->device.bindless_max_texture_count < bindless->capacity)
+    {
+        bindless->capacity = context->device.bindless_max_texture_count;
+    }
+
+    // Частично заполненный массив, обновляемый после привязки набора (в том числе пока кадры в полете).
+    VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+                                           | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+                                           | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo flagsinfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO };
+    flagsinfo.bindingCount = 1;
+    flagsinfo.pBindingFlags = &binding_flags;
+
+    VkDescriptorSetLayoutBinding binding = {0};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = bindless->capacity;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutinfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    layoutinfo.pNext = &flagsinfo;
+    layoutinfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutinfo.bindingCount = 1;
+    layoutinfo.pBindings = &binding;
+
+    VkResult result = vkCreateDescriptorSetLayout(context->device.logical, &layoutinfo, context->allocator, &bindless->layout);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to create bindless descriptor set layout with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        return false;
+    }
+
+    VkDescriptorPoolSize pool_size = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, bindless->capacity };
+
+    VkDescriptorPoolCreateInfo poolinfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolinfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolinfo.maxSets = 1;
+    poolinfo.poolSizeCount = 1;
+    poolinfo.pPoolSizes = &pool_size;
+
+    result = vkCreateDescriptorPool(context->device.logical, &poolinfo, context->allocator, &bindless->pool);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to create bindless descriptor pool with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        vulkan_bindless_destroy(context);
+        return false;
+    }
+
+    VkDescriptorSetAllocateInfo allocinfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocinfo.descriptorPool = bindless->pool;
+    allocinfo.descriptorSetCount = 1;
+    allocinfo.pSetLayouts = &bindless->layout;
+
+    result = vkAllocateDescriptorSets(context->device.logical, &allocinfo, &bindless->set);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to allocate bindless descriptor set with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        vulkan_bindless_destroy(context);
+        return false;
+    }
+
+    // Сэмплер текстуры по умолчанию, сама текстура записывается при первом использовании массива.
+    VkSamplerCreateInfo samplerinfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+    samplerinfo.minFilter = VK_FILTER_LINEAR;
+    samplerinfo.magFilter = VK_FILTER_LINEAR;
+    samplerinfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerinfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerinfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerinfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    samplerinfo.compareOp = VK_COMPARE_OP_ALWAYS;
+    samplerinfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+
+    result = vkCreateSampler(context->device.logical, &samplerinfo, context->allocator, &bindless->default_sampler);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to create bindless default sampler with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        vulkan_bindless_destroy(context);
+        return false;
+    }
+
+    // Слот текстуры по умолчанию не выделяется.
+    bindless->next_slot = VULKAN_BINDLESS_DEFAULT_SLOT + 1;
+    bindless->default_written = false;
+    bindless->frame_number = 0;
+    bindless->free_slots = darray_create(u32);
+    bindless->retired = darray_create(vulkan_bindless_retired);
+    bindless->enabled = true;
+
+    kinfor("Bindless texture array created with %u slots.", bindless->capacity);
+    return true;
+}
+
+void vulkan_bindless_destroy(vulkan_context* context)
+{
+    vulkan_bindless* bindless = &context->bindless;
+
+    if(bindless->free_slots)
+    {
+        darray_destroy(bindless->free_slots);
+        bindless->free_slots = null;
+    }
+
+    if(bindless->retired)
+    {
+        darray_destroy(bindless->retired);
+        bindless->retired = null;
+    }
+
+    if(bindless->default_sampler)
+    {
+        vkDestroySampler(context->device.logical, bindless->default_sampler, context->allocator);
+        bindless->default_sampler = null;
+    }
+    bindless->default_written = false;
+
+    // Набор освобождается вместе с пулом.
+    if(bindless->pool)
+    {
+        vkDestroyDescriptorPool(context->device.logical, bindless->pool, context->allocator);
+        bindless->pool = null;
+        bindless->set = null;
+    }
+
+    if(bindless->layout)
+    {
+        vkDestroyDescriptorSetLayout(context->device.logical, bindless->layout, context->allocator);
+        bindless->layout = null;
+    }
+
+    bindless->enabled = false;
+}
+
+void vulkan_bindless_frame_begin(vulkan_context* context)
+{
+    vulkan_bindless* bindless = &context->bindless;
+    if(!bindless->enabled)
+    {
+        return;
+    }
+
+    bindless->frame_number++;
+
+    // Кадр, освободивший слот, завершен, когда с тех пор начались все остальные кадры в полете.
+    u32 length = darray_length(bindless->retired);
+    u32 i = 0;
+    while(i < length)
+    {
+        vulkan_bindless_retired* retired = &bindless->retired[i];
+        if(bindless->frame_number - retired->frame_number > context->swapchain.max_frames_in_flight)
+        {
+            darray_push(bindless->free_slots, retired->slot);
+            darray_pop_at(bindless->retired, i, null);
+            length--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+// Записывает дескриптор текстуры в слот массива.
+static void vulkan_bindless_slot_write(vulkan_context* context, u32 slot, VkImageView view, VkSampler sampler)
+{
+    VkDescriptorImageInfo imageinfo = {0};
+    imageinfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageinfo.imageView = view;
+    imageinfo.sampler = sampler;
+
+    VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = context->bindless.set;
+    write.dstBinding = 0;
+    write.dstArrayElement = slot;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.descriptorCount = 1;
+    write.pImageInfo = &imageinfo;
+
+    vkUpdateDescriptorSets(context->device.logical, 1, &write, 0, null);
+}
+
+void vulkan_bindless_default_texture_set(vulkan_context* context, VkImageView view)
+{
+    vulkan_bindless* bindless = &context->bindless;
+    if(!bindless->enabled || bindless->default_written)
+    {
+        return;
+    }
+
+    vulkan_bindless_slot_write(context, VULKAN_BINDLESS_DEFAULT_SLOT, view, bindless->default_sampler);
+    bindless->default_written = true;
+}
+
+u32 vulkan_bindless_texture_acquire(vulkan_context* context, VkImageView view, VkSampler sampler)
+{
+    vulkan_bindless* bindless = &context->bindless;
+    u32 slot = INVALID_ID;
+
+    if(darray_length(bindless->free_slots) > 0)
+    {
+        darray_pop(bindless->free_slots, &slot);
+    }
+    else if(bindless->next_slot < bindless->capacity)
+    {
+        slot = bindless->next_slot++;
+    }
+    else
+    {
+        kerror("Function '%s': Bindless texture array is full (%u slots).", __FUNCTION__, bindless->capacity);
+        return INVALID_ID;
+    }
+
+    vulkan_bindless_slot_write(context, slot, view, sampler);
+    return slot;
+}
+
+void vulkan_bindless_texture_release(vulkan_context* context, u32 slot, bool immediate)
+{
+    vulkan_bindless* bindless = &context->bindless;
+    if(!bindless->enabled || slot == INVALID_ID)
+    {
+        return;
+    }
+
+    if(immediate)
+    {
+        darray_push(bindless->free_slots, slot);
+        return;
+    }
+
+    vulkan_bindless_retired retired = { slot, bindless->frame_number };
+    darray_push(bindless->retired, retired);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <defines.h>
+#include <renderer/vulkan/vulkan_types.h>
+
+/*
+    @brief Создает общий массив дескрипторов текстур, если устройство поддерживает индексирование дескрипторов.
+    NOTE: Если поддержки нет, массив не создается (vulkan_bindless.enabled равен false) и шейдеры используют
+          наборы дескрипторов экземпляров.
+    @param context Указатель на контекст Vulkan.
+    @return True в случае успеха или отсутствия поддержки, false если есть ошибки.
+*/
+bool vulkan_bindless_create(vulkan_context* context);
+
+/*
+    @brief Уничтожает общий массив дескрипторов текстур.
+    @param context Указатель на контекст Vulkan.
+*/
+void vulkan_bindless_destroy(vulkan_context* context);
+
+/*
+    @brief Начинает новый кадр: возвращает в свободные слоты, освобожденные кадрами, которые уже завершились.
+    @param context Указатель на контекст Vulkan.
+*/
+void vulkan_bindless_frame_begin(vulkan_context* context);
+
+/*
+    @brief Записывает текстуру по умолчанию в зарезервированный слот VULKAN_BINDLESS_DEFAULT_SLOT.
+    NOTE: Слот записывается один раз, т.к. его могут читать кадры в полете. Используется вместо слотов,
+          которые не удалось выделить.
+    @param context Указатель на контекст Vulkan.
+    @param view Представление изображения текстуры по умолчанию.
+*/
+void vulkan_bindless_default_texture_set(vulkan_context* context, VkImageView view);
+
+/*
+    @brief Выделяет слот массива и записывает в него дескриптор текстуры.
+    NOTE: Набор создан с обновлением после привязки, поэтому запись не мешает кадрам в полете.
+    @param context Указатель на контекст Vulkan.
+    @param view Представление изображения текстуры.
+    @param sampler Сэмплер текстуры.
+    @return Индекс слота (никогда не VULKAN_BINDLESS_DEFAULT_SLOT), INVALID_ID если массив заполнен.
+*/
+u32 vulkan_bindless_texture_acquire(vulkan_context* context, VkImageView view, VkSampler sampler);
+
+/*
+    @brief Освобождает слот массива.
+    @param context Указатель на контекст Vulkan.
+    @param slot Индекс слота.
+    @param immediate True если GPU гарантированно не использует слот (например, после ожидания устройства),
+                     false чтобы вернуть слот только после завершения кадров в полете.
+*/
+void vulkan_bindless_texture_release(vulkan_context* context, u32 slot, bool immediate);
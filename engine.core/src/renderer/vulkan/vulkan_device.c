@@ -26,6 +26,7 @@ VkResult vulkan_device_create(renderer_backend* backend, vulkan_context* context
     // TODO: Вынести на верхние уровни и сделать настраиваемым.
     vulkan_device_requirements requirements = {0};
     requirements.sampler_anisotropy = true;
+    requirements.timeline_semaphore = true;
     requirements.device_type        = VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
     requirements.extensions         = darray_create(const char*);
     darray_push(requirements.extensions, &VK_KHR_SWAPCHAIN_EXTENSION_NAME);
@@ -107,8 +108,27 @@ VkResult vulkan_device_create(renderer_backend* backend, vulkan_context* context
     // TODO: Сделать настраиваемым конфигурацией.
     VkPhysicalDeviceFeatures features = {0};
     features.samplerAnisotropy = requirements.sampler_anisotropy ? VK_TRUE : VK_FALSE;
+    // Необязательные функции косвенной отрисовки, включаются при наличии поддержки.
+    features.multiDrawIndirect = context->device.features.multiDrawIndirect;
+    features.drawIndirectFirstInstance = context->device.features.drawIndirectFirstInstance;
+
+    // Семафоры временной шкалы для пакетов загрузки.
+    VkPhysicalDeviceVulkan12Features features12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+    features12.timelineSemaphore = requirements.timeline_semaphore ? VK_TRUE : VK_FALSE;
+
+    // Необязательное индексирование дескрипторов для массива текстур без привязки.
+    if(context->device.descriptor_indexing_support)
+    {
+        features12.descriptorIndexing = VK_TRUE;
+        features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        features12.descriptorBindingPartiallyBound = VK_TRUE;
+        features12.runtimeDescriptorArray = VK_TRUE;
+        features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        features12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    }
 
     VkDeviceCreateInfo deviceinfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+    deviceinfo.pNext = &features12;
     deviceinfo.queueCreateInfoCount = index;
     deviceinfo.pQueueCreateInfos = queueinfo;
     deviceinfo.pEnabledFeatures = &features;
@@ -148,13 +168,33 @@ VkResult vulkan_device_create(renderer_backend* backend, vulkan_context* context
         kfatal("Failed to create qraphics command pool with result: %s", vulkan_result_get_string(result, true));
     }
 
-    ktrace("Vulkan command pools created (Now only graphics!).");
+    // Создание пула команд для выделенной очереди передачи (при общей очереди используется пул графики).
+    if(!transfer_shares_graphics_queue)
+    {
+        poolinfo.queueFamilyIndex = context->device.transfer_queue.index;
+        result = vkCreateCommandPool(context->device.logical, &poolinfo, context->allocator, &context->device.transfer_queue.command_pool);
+        if(!vulkan_result_is_success(result))
+        {
+            kfatal("Failed to create transfer command pool with result: %s", vulkan_result_get_string(result, true));
+        }
+    }
+    else
+    {
+        context->device.transfer_queue.command_pool = context->device.graphics_queue.command_pool;
+    }
+
+    ktrace("Vulkan command pools created (graphics and transfer).");
     return VK_SUCCESS;
 }
 
 void vulkan_device_destroy(renderer_backend* backend, vulkan_context* context)
 {
     // Уничтожение пулов команд.
+    if(context->device.transfer_queue.command_pool != context->device.graphics_queue.command_pool)
+    {
+        vkDestroyCommandPool(context->device.logical, context->device.transfer_queue.command_pool, context->allocator);
+    }
+    context->device.transfer_queue.command_pool = null;
     vkDestroyCommandPool(context->device.logical, context->device.graphics_queue.command_pool, context->allocator);
     context->device.graphics_queue.command_pool = null;
     ktrace("Vulkan command pools destroyed.");
@@ -287,6 +327,43 @@ VkResult vulkan_create_devices_info(renderer_backend* backend, vulkan_context* c
         vkGetPhysicalDeviceFeatures(physical_devices[i], &devices[i].features);
         vkGetPhysicalDeviceMemoryProperties(physical_devices[i], &devices[i].memory);
 
+        // Семафоры временной шкалы входят в ядро начиная с Vulkan 1.2.
+        if(devices[i].properties.apiVersion >= VK_API_VERSION_1_2)
+        {
+            VkPhysicalDeviceVulkan12Features features12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+            VkPhysicalDeviceFeatures2 features2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+            features2.pNext = &features12;
+            vkGetPhysicalDeviceFeatures2(physical_devices[i], &features2);
+            devices[i].timeline_semaphore_support = features12.timelineSemaphore == VK_TRUE;
+
+            // Индексирование дескрипторов (ядро Vulkan 1.2), используется массивом текстур без привязки.
+            devices[i].descriptor_indexing_support = features12.descriptorIndexing == VK_TRUE
+                                                  && features12.shaderSampledImageArrayNonUniformIndexing == VK_TRUE
+                                                  && features12.descriptorBindingPartiallyBound == VK_TRUE
+                                                  && features12.runtimeDescriptorArray == VK_TRUE
+                                                  && features12.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE
+                                                  && features12.descriptorBindingUpdateUnusedWhilePending == VK_TRUE;
+
+            if(devices[i].descriptor_indexing_support)
+            {
+                VkPhysicalDeviceVulkan12Properties properties12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES };
+                VkPhysicalDeviceProperties2 properties2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+                properties2.pNext = &properties12;
+                vkGetPhysicalDeviceProperties2(physical_devices[i], &properties2);
+
+                u32 max_count = properties12.maxPerStageDescriptorUpdateAfterBindSampledImages;
+                if(properties12.maxDescriptorSetUpdateAfterBindSampledImages < max_count)
+                {
+                    max_count = properties12.maxDescriptorSetUpdateAfterBindSampledImages;
+                }
+                if(properties12.maxUpdateAfterBindDescriptorsInAllPools < max_count)
+                {
+                    max_count = properties12.maxUpdateAfterBindDescriptorsInAllPools;
+                }
+                devices[i].bindless_max_texture_count = max_count;
+            }
+        }
+
         // Создание массива с информацией по очередям устройства.
         u32 queue_family_count = 0;
         vkGetPhysicalDeviceQueueFamilyProperties(physical_devices[i], &queue_family_count, null);
@@ -589,6 +666,13 @@ VkResult vulkan_select_device(vulkan_context* context, vulkan_device* devices, v
             continue;
         }
 
+        // Проверка поддержки семафоров временной шкалы.
+        if(requirements->timeline_semaphore && !devices[i].timeline_semaphore_support)
+        {
+            ktrace("Vulkan physical device (index %u) does not support timeline semaphores. Skipping...", i);
+            continue;
+        }
+
         // Проверка поддерживаемых режимов показов и формата поверхнисти.
         if(devices[i].swapchain_support.format_count < 1 || devices[i].swapchain_support.present_mode_count < 1)
         {
@@ -26,7 +26,7 @@ KINLINE VkCullModeFlagBits cull_mode_translate(face_cull_mode mode)
 }
 
 bool vulkan_graphics_pipeline_create(
-    vulkan_context* context, vulkan_renderpass* renderpass, u32 stride, u32 attribute_count, 
+    vulkan_context* context, vulkan_renderpass* renderpass, u32 stride, u32 instance_stride, u32 attribute_count,
     VkVertexInputAttributeDescription* attributes, u32 descriptor_set_layout_count, 
     VkDescriptorSetLayout* descriptor_set_layouts, u32 stage_count, VkPipelineShaderStageCreateInfo* stages,
     VkViewport viewport, VkRect2D scissor, face_cull_mode cull_mode, bool is_wireframe,
@@ -107,15 +107,21 @@ bool vulkan_graphics_pipeline_create(
 
     // Первая стадия конвейера (вход вертексов).
     // В шейдере это строка layout(location = 0) in vec3 in_position; - атрибут!
-    VkVertexInputBindingDescription binding_description = {0};
-    binding_description.binding = 0;      // Индекс привязки к буферу данных.
-    binding_description.stride = stride;  // Описывает расстояние между элементами данных буфера.
-    binding_description.inputRate = VK_VERTEX_INPUT_RATE_VERTEX; // Переход к следующей записи данных для каждой вершины.
+    VkVertexInputBindingDescription binding_descriptions[2];
+    kzero_tc(binding_descriptions, VkVertexInputBindingDescription, 2);
+    binding_descriptions[0].binding = 0;      // Индекс привязки к буферу данных.
+    binding_descriptions[0].stride = stride;  // Описывает расстояние между элементами данных буфера.
+    binding_descriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX; // Переход к следующей записи данных для каждой вершины.
+
+    // Данные экземпляров (например, матрицы моделей) - переход к следующей записи для каждого экземпляра.
+    binding_descriptions[1].binding = 1;
+    binding_descriptions[1].stride = instance_stride;
+    binding_descriptions[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
     // Выршинный шейдер: передаваемые атрибуты и привязки.
     VkPipelineVertexInputStateCreateInfo vertex_input_info = { VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
-    vertex_input_info.vertexBindingDescriptionCount = 1;
-    vertex_input_info.pVertexBindingDescriptions = &binding_description;
+    vertex_input_info.vertexBindingDescriptionCount = instance_stride > 0 ? 2 : 1;
+    vertex_input_info.pVertexBindingDescriptions = binding_descriptions;
     vertex_input_info.vertexAttributeDescriptionCount = attribute_count;
     vertex_input_info.pVertexAttributeDescriptions = attributes; // Данные передаваемые в вершинный шейдер.
 
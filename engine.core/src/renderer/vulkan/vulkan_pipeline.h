@@ -6,7 +6,7 @@
 /*
 */
 bool vulkan_graphics_pipeline_create(
-    vulkan_context* context, vulkan_renderpass* renderpass, u32 stride, u32 attribute_count, 
+    vulkan_context* context, vulkan_renderpass* renderpass, u32 stride, u32 instance_stride, u32 attribute_count,
     VkVertexInputAttributeDescription* attributes, u32 descriptor_set_layout_count, 
     VkDescriptorSetLayout* descriptor_set_layouts, u32 stage_count, VkPipelineShaderStageCreateInfo* stages,
     VkViewport viewport, VkRect2D scissor, face_cull_mode cull_mode, bool is_wireframe,
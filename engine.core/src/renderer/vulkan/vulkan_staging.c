@@ -0,0 +1,563 @@
+// Собственные подключения.
+#include "renderer/vulkan/vulkan_staging.h"
+#include "renderer/vulkan/vulkan_command_buffer.h"
+#include "renderer/vulkan/vulkan_image.h"
+#include "renderer/vulkan/vulkan_utils.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "containers/darray.h"
+
+// Выравнивание выделений в кольце (покрывает размеры текселей и требования копирования).
+#define VULKAN_STAGING_ALIGNMENT 16
+
+// Возвращает значение семафора временной шкалы, достигнутое GPU.
+static u64 vulkan_staging_completed_value(vulkan_context* context)
+{
+    uint64_t value = 0;
+    VkResult result = vkGetSemaphoreCounterValue(context->device.logical, context->staging.timeline, &value);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to get upload timeline value with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        return 0;
+    }
+    return value;
+}
+
+// Освобождает память завершенных пакетов (пакеты одной очереди завершаются по порядку отправки).
+static void vulkan_staging_retire(vulkan_context* context)
+{
+    vulkan_staging* staging = &context->staging;
+    u64 completed_value = vulkan_staging_completed_value(context);
+
+    for(u32 i = 0; i < VULKAN_STAGING_BATCH_COUNT; ++i)
+    {
+        vulkan_staging_batch* batch = &staging->batches[i];
+        if(batch->submitted && batch->value <= completed_value)
+        {
+            batch->submitted = false;
+            batch->command_buffer.state = VULKAN_COMMAND_BUFFER_STATE_READY;
+            if(batch->end_mark > staging->tail)
+            {
+                staging->tail = batch->end_mark;
+            }
+        }
+    }
+}
+
+static void vulkan_staging_wait_value(vulkan_context* context, u64 value)
+{
+    uint64_t wait_value = value;
+
+    VkSemaphoreWaitInfo waitinfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitinfo.semaphoreCount = 1;
+    waitinfo.pSemaphores = &context->staging.timeline;
+    waitinfo.pValues = &wait_value;
+
+    VkResult result = vkWaitSemaphores(context->device.logical, &waitinfo, U64_MAX);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to wait upload timeline with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+    }
+    vulkan_staging_retire(context);
+}
+
+// Добавляет ожидающий барьер получения владения для текущего пакета.
+static void vulkan_staging_push_acquire(vulkan_context* context, vulkan_staging_acquire* acquire)
+{
+    vulkan_staging* staging = &context->staging;
+    acquire->value = staging->batches[staging->current_batch].value;
+    darray_push(staging->acquires, *acquire);
+}
+
+// Возвращает текущий пакет, начиная запись в него при необходимости.
+static vulkan_command_buffer* vulkan_staging_begin(vulkan_context* context)
+{
+    vulkan_staging* staging = &context->staging;
+    vulkan_staging_batch* batch = &staging->batches[staging->current_batch];
+
+    if(staging->recording)
+    {
+        return &batch->command_buffer;
+    }
+
+    // Пакет все еще выполняется с прошлого круга.
+    if(batch->submitted)
+    {
+        vulkan_staging_wait_value(context, batch->value);
+    }
+
+    vulkan_command_buffer_reset(&batch->command_buffer);
+    vulkan_command_buffer_begin(&batch->command_buffer, true, false, false);
+
+    // Копирования не начинаются, пока ранее отправленные в эту же очередь команды читают память, в которую они пишут.
+    // NOTE: Барьер действует только в пределах очереди. На выделенной очереди передачи память назначения не
+    //       переиспользуется до завершения кадров, читавших ее (см. vulkan_retire_buffer_range).
+    vkCmdPipelineBarrier(
+        batch->command_buffer.handle, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, null, 0, null, 0, null
+    );
+
+    // Значение назначается при начале записи, чтобы барьеры получения владения знали свой пакет.
+    batch->value = staging->submitted_value + 1;
+    staging->recording = true;
+    return &batch->command_buffer;
+}
+
+/*
+    @brief Выделяет непрерывный диапазон в кольце, при нехватке места отправляет текущий пакет и ждет старые.
+    NOTE: Может отправить текущий пакет, поэтому буфер команд нужно получать после выделения.
+*/
+static bool vulkan_staging_allocate(vulkan_context* context, VkDeviceSize size, VkDeviceSize* out_offset)
+{
+    vulkan_staging* staging = &context->staging;
+
+    if(size > staging->capacity)
+    {
+        return false;
+    }
+
+    while(true)
+    {
+        vulkan_staging_retire(context);
+
+        u64 start = (staging->head + VULKAN_STAGING_ALIGNMENT - 1) & ~(u64)(VULKAN_STAGING_ALIGNMENT - 1);
+        u64 position = start % staging->capacity;
+
+        // Диапазон не разрывается: остаток до конца кольца пропускается.
+        if(position + size > staging->capacity)
+        {
+            start += staging->capacity - position;
+            position = 0;
+        }
+
+        if(start + size - staging->tail <= staging->capacity)
+        {
+            staging->head = start + size;
+            *out_offset = position;
+            return true;
+        }
+
+        // Память занята текущим пакетом: отправить его, чтобы она освободилась после выполнения.
+        if(staging->recording)
+        {
+            vulkan_staging_flush(context, false);
+            continue;
+        }
+
+        // Ожидание самого старого отправленного пакета.
+        vulkan_staging_batch* oldest = null;
+        for(u32 i = 0; i < VULKAN_STAGING_BATCH_COUNT; ++i)
+        {
+            vulkan_staging_batch* batch = &staging->batches[i];
+            if(batch->submitted && (!oldest || batch->end_mark < oldest->end_mark))
+            {
+                oldest = batch;
+            }
+        }
+
+        if(!oldest)
+        {
+            // Нет выполняющихся пакетов - кольцо свободно целиком.
+            staging->head = 0;
+            staging->tail = 0;
+            continue;
+        }
+
+        vulkan_staging_wait_value(context, oldest->value);
+    }
+}
+
+bool vulkan_staging_create(vulkan_context* context, u64 capacity)
+{
+    vulkan_staging* staging = &context->staging;
+    kzero_tc(staging, vulkan_staging, 1);
+
+    staging->buffer.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    staging->buffer.memory_property_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    VkBufferCreateInfo buffer_info = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    buffer_info.size = capacity;
+    buffer_info.usage = staging->buffer.usage;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VK_CHECK(vkCreateBuffer(context->device.logical, &buffer_info, context->allocator, &staging->buffer.handle));
+
+    vkGetBufferMemoryRequirements(context->device.logical, staging->buffer.handle, &staging->buffer.memory_requirements);
+    staging->buffer.memory_index = context->find_memory_index(
+        staging->buffer.memory_requirements.memoryTypeBits, staging->buffer.memory_property_flags
+    );
+    if(staging->buffer.memory_index == INVALID_ID)
+    {
+        kerror("Function '%s': Unable to create staging ring beacuse the required memory type index was not found.", __FUNCTION__);
+        return false;
+    }
+
+    VkMemoryAllocateInfo allocate_info = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocate_info.allocationSize = staging->buffer.memory_requirements.size;
+    allocate_info.memoryTypeIndex = (u32)staging->buffer.memory_index;
+
+    VkResult result = vkAllocateMemory(context->device.logical, &allocate_info, context->allocator, &staging->buffer.memory);
+    if(!vulkan_result_is_success(result))
+    {
+        kerror("Function '%s': Failed to allocate staging ring memory with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        return false;
+    }
+    kallocate_report(staging->buffer.memory_requirements.size, MEMORY_TAG_VULKAN);
+
+    VK_CHECK(vkBindBufferMemory(context->device.logical, staging->buffer.handle, staging->buffer.memory, 0));
+
+    // Память отображается один раз на все время жизни кольца.
+    void* mapped = null;
+    VK_CHECK(vkMapMemory(context->device.logical, staging->buffer.memory, 0, capacity, 0, &mapped));
+    staging->mapped = mapped;
+    staging->capacity = capacity;
+
+    // Пакеты отправляются в выделенную очередь передачи, если ее семейство отличается от графики.
+    staging->dedicated = context->device.transfer_queue.index != context->device.graphics_queue.index;
+    staging->queue = staging->dedicated ? &context->device.transfer_queue : &context->device.graphics_queue;
+    staging->acquires = darray_create(vulkan_staging_acquire);
+
+    VkSemaphoreTypeCreateInfo typeinfo = { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+    typeinfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeinfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreinfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    semaphoreinfo.pNext = &typeinfo;
+    VK_CHECK(vkCreateSemaphore(context->device.logical, &semaphoreinfo, context->allocator, &staging->timeline));
+
+    for(u32 i = 0; i < VULKAN_STAGING_BATCH_COUNT; ++i)
+    {
+        vulkan_command_buffer_allocate(context, staging->queue->command_pool, true, &staging->batches[i].command_buffer);
+    }
+
+    ktrace("Vulkan staging uses %s queue.", staging->dedicated ? "dedicated transfer" : "graphics");
+    return true;
+}
+
+void vulkan_staging_destroy(vulkan_context* context)
+{
+    vulkan_staging* staging = &context->staging;
+    if(!staging->buffer.handle)
+    {
+        return;
+    }
+
+    vulkan_staging_flush(context, true);
+
+    for(u32 i = 0; i < VULKAN_STAGING_BATCH_COUNT; ++i)
+    {
+        vulkan_command_buffer_free(context, staging->queue->command_pool, &staging->batches[i].command_buffer);
+    }
+
+    vkDestroySemaphore(context->device.logical, staging->timeline, context->allocator);
+    darray_destroy(staging->acquires);
+
+    vkUnmapMemory(context->device.logical, staging->buffer.memory);
+    vkFreeMemory(context->device.logical, staging->buffer.memory, context->allocator);
+    vkDestroyBuffer(context->device.logical, staging->buffer.handle, context->allocator);
+    kfree_report(staging->buffer.memory_requirements.size, MEMORY_TAG_VULKAN);
+
+    kzero_tc(staging, vulkan_staging, 1);
+}
+
+bool vulkan_staging_upload_buffer(vulkan_context* context, VkBuffer dest, VkDeviceSize dest_offset, VkDeviceSize size, const void* data)
+{
+    vulkan_staging* staging = &context->staging;
+    const u8* bytes = data;
+
+    while(size > 0)
+    {
+        VkDeviceSize part_size = size < staging->capacity ? size : staging->capacity;
+        VkDeviceSize offset = 0;
+        if(!vulkan_staging_allocate(context, part_size, &offset))
+        {
+            kerror("Function '%s': Failed to allocate %llu bytes from staging ring.", __FUNCTION__, (u64)part_size);
+            return false;
+        }
+
+        kcopy(staging->mapped + offset, bytes, part_size);
+
+        vulkan_command_buffer* command_buffer = vulkan_staging_begin(context);
+        VkBufferCopy region = { offset, dest_offset, part_size };
+        vkCmdCopyBuffer(command_buffer->handle, staging->buffer.handle, dest, 1, &region);
+
+        // Освобождение диапазона очередью передачи, очередь графики получит его перед использованием.
+        if(staging->dedicated)
+        {
+            vulkan_staging_acquire acquire = {0};
+            acquire.is_image = false;
+            acquire.buffer_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            acquire.buffer_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            acquire.buffer_barrier.dstAccessMask = 0;
+            acquire.buffer_barrier.srcQueueFamilyIndex = context->device.transfer_queue.index;
+            acquire.buffer_barrier.dstQueueFamilyIndex = context->device.graphics_queue.index;
+            acquire.buffer_barrier.buffer = dest;
+            acquire.buffer_barrier.offset = dest_offset;
+            acquire.buffer_barrier.size = part_size;
+
+            vkCmdPipelineBarrier(
+                command_buffer->handle, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, null, 1,
+                &acquire.buffer_barrier, 0, null
+            );
+
+            // Получение: запись видна чтениям вершин, индексов, шейдеров и копированиям.
+            acquire.buffer_barrier.srcAccessMask = 0;
+            acquire.buffer_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            vulkan_staging_push_acquire(context, &acquire);
+        }
+
+        bytes += part_size;
+        dest_offset += part_size;
+        size -= part_size;
+    }
+
+    return true;
+}
+
+bool vulkan_staging_upload_image(
+    vulkan_context* context, texture_type type, vulkan_image* image, VkFormat format, VkDeviceSize size, const void* pixels
+)
+{
+    vulkan_staging* staging = &context->staging;
+    u32 layer_count = type == TEXTURE_TYPE_CUBE ? 6 : 1;
+    VkDeviceSize layer_size = size / layer_count;
+    VkDeviceSize row_size = layer_size / image->height;
+
+    if(row_size == 0 || row_size > staging->capacity)
+    {
+        kerror("Function '%s': Image row of %llu bytes does not fit the staging ring.", __FUNCTION__, (u64)row_size);
+        return false;
+    }
+
+    // Изменение текущий макета на оптимальный для приема данных.
+    vulkan_image_transition_layout(
+        context, type, vulkan_staging_begin(context), image, &format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+    );
+
+    // NOTE: Макет сохраняется между пакетами, поэтому полосы могут попасть в разные отправки.
+    u32 max_band_rows = (u32)(staging->capacity / row_size);
+    const u8* bytes = pixels;
+
+    for(u32 layer = 0; layer < layer_count; ++layer)
+    {
+        for(u32 row = 0; row < image->height;)
+        {
+            u32 band_rows = image->height - row;
+            if(band_rows > max_band_rows)
+            {
+                band_rows = max_band_rows;
+            }
+
+            VkDeviceSize band_size = row_size * band_rows;
+            VkDeviceSize offset = 0;
+            if(!vulkan_staging_allocate(context, band_size, &offset))
+            {
+                kerror("Function '%s': Failed to allocate %llu bytes from staging ring.", __FUNCTION__, (u64)band_size);
+                return false;
+            }
+
+            kcopy(staging->mapped + offset, bytes, band_size);
+
+            VkBufferImageCopy region;
+            kzero_tc(&region, VkBufferImageCopy, 1);
+            region.bufferOffset = offset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = layer;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset.y = (i32)row;
+            region.imageExtent.width = image->width;
+            region.imageExtent.height = band_rows;
+            region.imageExtent.depth = 1;
+
+            vulkan_command_buffer* command_buffer = vulkan_staging_begin(context);
+            vkCmdCopyBufferToImage(
+                command_buffer->handle, staging->buffer.handle, image->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region
+            );
+
+            bytes += band_size;
+            row += band_rows;
+        }
+    }
+
+    vulkan_command_buffer* command_buffer = vulkan_staging_begin(context);
+    image->upload_value = staging->batches[staging->current_batch].value;
+
+    if(!staging->dedicated)
+    {
+        // Переход от оптимальной компоновки для получения данных к оптимальной компоновке только для чтения шейдеров.
+        vulkan_image_transition_layout(
+            context, type, command_buffer, image, &format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        );
+        return true;
+    }
+
+    // Освобождение изображения очередью передачи вместе с переходом макета (повторяется при получении).
+    vulkan_staging_acquire acquire = {0};
+    acquire.is_image = true;
+    acquire.image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    acquire.image_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    acquire.image_barrier.dstAccessMask = 0;
+    acquire.image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    acquire.image_barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    acquire.image_barrier.srcQueueFamilyIndex = context->device.transfer_queue.index;
+    acquire.image_barrier.dstQueueFamilyIndex = context->device.graphics_queue.index;
+    acquire.image_barrier.image = image->handle;
+    acquire.image_barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    acquire.image_barrier.subresourceRange.baseMipLevel = 0;
+    acquire.image_barrier.subresourceRange.levelCount = 1;
+    acquire.image_barrier.subresourceRange.baseArrayLayer = 0;
+    acquire.image_barrier.subresourceRange.layerCount = layer_count;
+
+    vkCmdPipelineBarrier(
+        command_buffer->handle, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, null, 0, null, 1,
+        &acquire.image_barrier
+    );
+
+    acquire.image_barrier.srcAccessMask = 0;
+    acquire.image_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vulkan_staging_push_acquire(context, &acquire);
+
+    return true;
+}
+
+u32 vulkan_staging_acquire_record(vulkan_context* context, vulkan_command_buffer* command_buffer)
+{
+    vulkan_staging* staging = &context->staging;
+    u32 acquire_count = (u32)darray_length(staging->acquires);
+    u32 recorded_count = 0;
+
+    // NOTE: Барьеры текущего (не отправленного) пакета остаются до его отправки.
+    for(u32 i = 0; i < acquire_count; ++i)
+    {
+        vulkan_staging_acquire* acquire = &staging->acquires[i];
+        if(acquire->value > staging->submitted_value)
+        {
+            staging->acquires[i - recorded_count] = *acquire;
+            continue;
+        }
+
+        if(acquire->is_image)
+        {
+            vkCmdPipelineBarrier(
+                command_buffer->handle, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, null, 0, null, 1,
+                &acquire->image_barrier
+            );
+        }
+        else
+        {
+            vkCmdPipelineBarrier(
+                command_buffer->handle, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, null, 1,
+                &acquire->buffer_barrier, 0, null
+            );
+        }
+        recorded_count++;
+    }
+
+    for(u32 i = 0; i < recorded_count; ++i)
+    {
+        darray_pop(staging->acquires, null);
+    }
+
+    staging->acquired_value = staging->submitted_value;
+    return recorded_count;
+}
+
+void vulkan_staging_forget(vulkan_context* context, VkBuffer buffer, VkImage image)
+{
+    vulkan_staging* staging = &context->staging;
+    u32 acquire_count = (u32)darray_length(staging->acquires);
+    u32 kept_count = 0;
+
+    for(u32 i = 0; i < acquire_count; ++i)
+    {
+        vulkan_staging_acquire* acquire = &staging->acquires[i];
+        if((acquire->is_image && acquire->image_barrier.image == image) || (!acquire->is_image && acquire->buffer_barrier.buffer == buffer))
+        {
+            continue;
+        }
+        staging->acquires[kept_count++] = *acquire;
+    }
+
+    for(u32 i = kept_count; i < acquire_count; ++i)
+    {
+        darray_pop(staging->acquires, null);
+    }
+}
+
+bool vulkan_staging_is_complete(vulkan_context* context, u64 value)
+{
+    vulkan_staging* staging = &context->staging;
+
+    // Пакет еще записывается или владение еще не получено очередью графики.
+    if(value > staging->acquired_value)
+    {
+        return false;
+    }
+
+    return value <= vulkan_staging_completed_value(context);
+}
+
+void vulkan_staging_flush(vulkan_context* context, bool wait)
+{
+    vulkan_staging* staging = &context->staging;
+
+    if(staging->recording)
+    {
+        vulkan_staging_batch* batch = &staging->batches[staging->current_batch];
+
+        // Результаты копирований видны всем последующим командам очереди (вершины, индексы, шейдеры, копирования).
+        VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            batch->command_buffer.handle, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, null, 0, null
+        );
+
+        vulkan_command_buffer_end(&batch->command_buffer);
+
+        // Завершение пакета сигнализирует его значение временной шкалы.
+        uint64_t signal_value = batch->value;
+        VkTimelineSemaphoreSubmitInfo timelineinfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+        timelineinfo.signalSemaphoreValueCount = 1;
+        timelineinfo.pSignalSemaphoreValues = &signal_value;
+
+        VkSubmitInfo submitinfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+        submitinfo.pNext = &timelineinfo;
+        submitinfo.commandBufferCount = 1;
+        submitinfo.pCommandBuffers = &batch->command_buffer.handle;
+        submitinfo.signalSemaphoreCount = 1;
+        submitinfo.pSignalSemaphores = &staging->timeline;
+
+        VkResult result = vkQueueSubmit(staging->queue->handle, 1, &submitinfo, null);
+        if(!vulkan_result_is_success(result))
+        {
+            kerror("Function '%s': Failed to submit upload batch with result: %s", __FUNCTION__, vulkan_result_get_string(result, true));
+        }
+
+        vulkan_command_buffer_update_submitted(&batch->command_buffer);
+        batch->end_mark = staging->head;
+        batch->submitted = true;
+        staging->submitted_value = batch->value;
+
+        // В общей очереди графики передача владения не нужна: порядок отправки и барьер пакета достаточны.
+        if(!staging->dedicated)
+        {
+            staging->acquired_value = staging->submitted_value;
+        }
+        staging->recording = false;
+        staging->current_batch = (staging->current_batch + 1) % VULKAN_STAGING_BATCH_COUNT;
+    }
+
+    if(!wait)
+    {
+        return;
+    }
+
+    if(staging->submitted_value > 0)
+    {
+        vulkan_staging_wait_value(context, staging->submitted_value);
+    }
+}
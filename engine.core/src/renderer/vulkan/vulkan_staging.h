@@ -0,0 +1,81 @@
+#pragma once
+
+#include <defines.h>
+#include <renderer/vulkan/vulkan_types.h>
+
+/*
+    @brief Создает постоянно отображенное кольцо промежуточного буфера и пакеты загрузки.
+    @param context Указатель на контекст Vulkan.
+    @param capacity Размер кольца в байтах.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool vulkan_staging_create(vulkan_context* context, u64 capacity);
+
+/*
+    @brief Отправляет незавершенный пакет, дожидается всех пакетов и уничтожает кольцо.
+    @param context Указатель на контекст Vulkan.
+*/
+void vulkan_staging_destroy(vulkan_context* context);
+
+/*
+    @brief Копирует данные в кольцо и записывает копирование в буфер в текущий пакет загрузки.
+    NOTE: Данные большие кольца загружаются частями.
+    @param context Указатель на контекст Vulkan.
+    @param dest Буфер назначения.
+    @param dest_offset Смещение в буфере назначения.
+    @param size Размер данных в байтах.
+    @param data Указатель на данные.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool vulkan_staging_upload_buffer(vulkan_context* context, VkBuffer dest, VkDeviceSize dest_offset, VkDeviceSize size, const void* data);
+
+/*
+    @brief Копирует пиксели в кольцо и записывает в текущий пакет загрузки переходы макета и копирование в изображение.
+    NOTE: Изображение загружается полосами строк (по слоям), если не помещается в кольцо целиком.
+    @param context Указатель на контекст Vulkan.
+    @param type Тип текстуры.
+    @param image Указатель на изображение.
+    @param format Формат изображения.
+    @param size Размер данных всех слоев в байтах.
+    @param pixels Указатель на пиксели.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool vulkan_staging_upload_image(
+    vulkan_context* context, texture_type type, vulkan_image* image, VkFormat format, VkDeviceSize size, const void* pixels
+);
+
+/*
+    @brief Записывает барьеры получения владения для всех отправленных пакетов в буфер команд очереди графики.
+    NOTE: Нужен только при выделенной очереди передачи. Отправка буфера команд должна ожидать семафор временной
+          шкалы со значением последнего отправленного пакета (vulkan_staging.submitted_value).
+    @param context Указатель на контекст Vulkan.
+    @param command_buffer Буфер команд очереди графики вне прохода визуализации.
+    @return Количество записанных барьеров.
+*/
+u32 vulkan_staging_acquire_record(vulkan_context* context, vulkan_command_buffer* command_buffer);
+
+/*
+    @brief Удаляет ожидающие барьеры получения владения для уничтожаемого буфера или изображения.
+    @param context Указатель на контекст Vulkan.
+    @param buffer Уничтожаемый буфер или VK_NULL_HANDLE.
+    @param image Уничтожаемое изображение или VK_NULL_HANDLE.
+*/
+void vulkan_staging_forget(vulkan_context* context, VkBuffer buffer, VkImage image);
+
+/*
+    @brief Проверяет, что загрузка пакета с указанным значением временной шкалы выполнена и получена очередью графики.
+    NOTE: Не блокирует, только опрашивает значение семафора.
+    @param context Указатель на контекст Vulkan.
+    @param value Значение временной шкалы пакета (например, vulkan_image.upload_value).
+    @return True если данные загружены и могут использоваться кадром без ожидания, false если еще нет.
+*/
+bool vulkan_staging_is_complete(vulkan_context* context, u64 value);
+
+/*
+    @brief Отправляет текущий пакет загрузки в выделенную очередь передачи (или в очередь графики, если она общая).
+    NOTE: Вызывается в конце кадра перед отправкой команд кадра, поэтому кадр видит все загрузки.
+          Завершение пакета сигнализирует семафор временной шкалы, ожидание CPU выполняется только при wait.
+    @param context Указатель на контекст Vulkan.
+    @param wait True дождаться завершения всех отправленных пакетов (например, перед чтением или уничтожением).
+*/
+void vulkan_staging_flush(vulkan_context* context, bool wait);
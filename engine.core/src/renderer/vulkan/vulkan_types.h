@@ -49,6 +49,8 @@ typedef struct vulkan_image {
     u32 height;
     // @brief Флаг указывающий на использование памяти GPU.
     bool use_device_local;
+    // @brief Значение временной шкалы пакета последней загрузки (0 - загрузок не было).
+    u64 upload_value;
 } vulkan_image;
 
 typedef enum vulkan_renderpass_state {
@@ -101,6 +103,9 @@ typedef struct vulkan_command_buffer {
     vulkan_command_buffer_state state;
 } vulkan_command_buffer;
 
+// @brief Количество пакетов загрузки, которые могут одновременно выполняться на GPU.
+#define VULKAN_STAGING_BATCH_COUNT 4
+
 typedef struct vulkan_device_queue {
     // @brief Указатель на очередь.
     VkQueue handle;
@@ -112,6 +117,134 @@ typedef struct vulkan_device_queue {
     u32 count;
 } vulkan_device_queue;
 
+// @brief Пакет загрузки: все копирования из кольца промежуточного буфера, отправляемые одним буфером команд.
+typedef struct vulkan_staging_batch {
+    // @brief Буфер команд пакета.
+    vulkan_command_buffer command_buffer;
+    // @brief Значение семафора временной шкалы, которое сигнализируется по завершении пакета.
+    u64 value;
+    // @brief Позиция головы кольца на момент отправки (после завершения пакета память до нее свободна).
+    u64 end_mark;
+    // @brief Указывает, что пакет отправлен и еще может выполняться.
+    bool submitted;
+} vulkan_staging_batch;
+
+// @brief Барьер получения владения ресурсом очередью графики после загрузки выделенной очередью передачи.
+typedef struct vulkan_staging_acquire {
+    // @brief Значение временной шкалы пакета, освободившего ресурс.
+    u64 value;
+    // @brief Указывает, что барьер относится к изображению, иначе к диапазону буфера.
+    bool is_image;
+    // @brief Барьер диапазона буфера.
+    VkBufferMemoryBarrier buffer_barrier;
+    // @brief Барьер изображения.
+    VkImageMemoryBarrier image_barrier;
+} vulkan_staging_acquire;
+
+// @brief Слот массива текстур без привязки, освобожденный до завершения кадров в полете.
+typedef struct vulkan_bindless_retired {
+    // @brief Индекс слота.
+    u32 slot;
+    // @brief Номер кадра, в котором слот был освобожден.
+    u64 frame_number;
+} vulkan_bindless_retired;
+
+// @brief Общий массив дескрипторов всех текстур (индексирование дескрипторов, ядро Vulkan 1.2).
+typedef struct vulkan_bindless {
+    // @brief Указывает, что массив создан и шейдеры могут использовать режим без привязки.
+    bool enabled;
+    // @brief Количество слотов массива.
+    u32 capacity;
+    // @brief Макет набора дескрипторов (binding 0 - массив сэмплеров текстур).
+    VkDescriptorSetLayout layout;
+    // @brief Пул дескрипторов с поддержкой обновления после привязки.
+    VkDescriptorPool pool;
+    // @brief Единственный набор дескрипторов массива.
+    VkDescriptorSet set;
+    // @brief Следующий никогда не использованный слот.
+    u32 next_slot;
+    // @brief Стек свободных слотов (используется darray).
+    u32* free_slots;
+    // @brief Освобожденные слоты, ожидающие завершения кадров в полете (используется darray).
+    vulkan_bindless_retired* retired;
+    // @brief Сэмплер слота текстуры по умолчанию.
+    VkSampler default_sampler;
+    // @brief Указывает, что в слот VULKAN_BINDLESS_DEFAULT_SLOT записана текстура по умолчанию.
+    bool default_written;
+    // @brief Счетчик кадров для отложенного освобождения слотов.
+    u64 frame_number;
+} vulkan_bindless;
+
+// @brief Слот текстуры экземпляра шейдера в массиве без привязки.
+typedef struct vulkan_bindless_slot {
+    // @brief Индекс слота, INVALID_ID если не выделен.
+    u32 index;
+    // @brief Текстура, записанная в слот (для обнаружения замены текстуры).
+    texture* texture;
+    // @brief Поколение текстуры на момент записи (дескриптор может быть переиспользован после изменения размера).
+    u32 generation;
+    // @brief Представление изображения, записанное в слот.
+    VkImageView view;
+    // @brief Сэмплер, записанный в слот.
+    VkSampler sampler;
+} vulkan_bindless_slot;
+
+// @brief Общий сэмплер, используемый картами текстур с одинаковыми параметрами.
+typedef struct vulkan_sampler_entry {
+    // @brief Упакованные параметры фильтрации и повторения.
+    u32 key;
+    // @brief Количество карт текстур, использующих сэмплер.
+    u32 reference_count;
+    // @brief Сэмплер, VK_NULL_HANDLE если запись свободна.
+    VkSampler handle;
+} vulkan_sampler_entry;
+
+// @brief Ресурс, освобождение которого отложено до завершения кадров в полете.
+typedef struct vulkan_retired_resource {
+    // @brief Количество отправленных кадров на момент освобождения.
+    u64 frame_number;
+    // @brief Изображение текстуры, которое уничтожается вместе с внутренними данными, или null.
+    vulkan_image* image;
+    // @brief Буфер, диапазон которого освобождается, если не задано изображение.
+    renderbuffer* buffer;
+    // @brief Смещение диапазона в байтах.
+    u64 offset;
+    // @brief Размер диапазона в байтах.
+    u64 size;
+} vulkan_retired_resource;
+
+// @brief Постоянно отображенное кольцо промежуточного буфера для всех загрузок на GPU.
+typedef struct vulkan_staging {
+    // @brief Промежуточный буфер (только источник копирования).
+    vulkan_buffer buffer;
+    // @brief Постоянно отображенная память буфера.
+    u8* mapped;
+    // @brief Размер кольца в байтах.
+    u64 capacity;
+    // @brief Монотонная позиция головы (следующая запись), смещение в кольце - по модулю размера.
+    u64 head;
+    // @brief Монотонная позиция хвоста (начало памяти, которую еще читает GPU).
+    u64 tail;
+    // @brief Пакеты загрузки.
+    vulkan_staging_batch batches[VULKAN_STAGING_BATCH_COUNT];
+    // @brief Индекс текущего (записываемого) пакета.
+    u32 current_batch;
+    // @brief Указывает, что в текущий пакет записываются команды.
+    bool recording;
+    // @brief Указывает, что пакеты отправляются в выделенную очередь передачи (с передачей владения).
+    bool dedicated;
+    // @brief Очередь, в которую отправляются пакеты.
+    vulkan_device_queue* queue;
+    // @brief Семафор временной шкалы пакетов загрузки.
+    VkSemaphore timeline;
+    // @brief Значение временной шкалы последнего отправленного пакета.
+    u64 submitted_value;
+    // @brief Значение временной шкалы, до которого владение получено очередью графики.
+    u64 acquired_value;
+    // @brief Ожидающие барьеры получения владения (используется darray).
+    vulkan_staging_acquire* acquires;
+} vulkan_staging;
+
 // TODO: Вместо массивов darray использовать array.
 typedef struct vulkan_device_swapchain_support {
     // @brief Флаги возможностей.
@@ -134,6 +267,8 @@ typedef struct vulkan_device_requirements {
     const char** extensions;
     // @brief Поддержка анизотропной фильтрации.
     bool sampler_anisotropy;
+    // @brief Поддержка семафоров временной шкалы.
+    bool timeline_semaphore;
 } vulkan_device_requirements;
 
 typedef struct vulkan_device {
@@ -159,6 +294,12 @@ typedef struct vulkan_device {
     VkPhysicalDeviceMemoryProperties memory;
     // @brief Поддержка прямой видимости памяти устройства.
     bool memory_local_host_visible_support;
+    // @brief Поддержка семафоров временной шкалы (Vulkan 1.2).
+    bool timeline_semaphore_support;
+    // @brief Поддержка индексирования дескрипторов для массива текстур без привязки (Vulkan 1.2).
+    bool descriptor_indexing_support;
+    // @brief Максимальное количество текстур в массиве без привязки (ограничение устройства).
+    u32 bindless_max_texture_count;
     // @brief Формат буфера глубины.
     VkFormat depth_format;
     // @brief Количество каналов выбранного формата глубины.
@@ -180,7 +321,17 @@ typedef struct vulkan_pipeline {
 #define VULKAN_SHADER_MAX_INSTANCE_TEXTURES 31
 #define VULKAN_SHADER_MAX_STAGES            8
 #define VULKAN_SHADER_MAX_ATTRIBUTES        16
+// @brief Максимальное количество экземпляров (матриц моделей) за кадр.
+#define VULKAN_MAX_INSTANCE_COUNT           16384
+// @brief Максимальное количество команд косвенной отрисовки за кадр.
+#define VULKAN_MAX_INDIRECT_COUNT           4096
 #define VULKAN_SHADER_MAX_UNIFORMS          128
+// @brief Максимальное количество текстур в массиве без привязки.
+#define VULKAN_BINDLESS_MAX_TEXTURES        4096
+// @brief Слот массива без привязки, зарезервированный для текстуры по умолчанию.
+#define VULKAN_BINDLESS_DEFAULT_SLOT        0
+// @brief Максимальное количество различных сэмплеров.
+#define VULKAN_MAX_SAMPLER_COUNT            64
 #define VULKAN_SHADER_MAX_BINDINGS          2
 #define VULKAN_SHADER_MAX_PUSH_CONST_RANGES 32
 #define VULKAN_SHADER_MAX_DESCRIPTOR_COUNT  2
@@ -267,6 +418,8 @@ typedef struct vulkan_shader_instance_state {
     vulkan_shader_descriptor_set_state descriptor_set_state;
     // @brief Указатель на карты текстур экземпляра.
     texture_map** instance_texture_maps;
+    // @brief Слоты карт текстур в массиве без привязки (только для шейдеров без привязки).
+    vulkan_bindless_slot* texture_slots;
 } vulkan_shader_instance_state;
 
 // @brief Стадия конкретного модуля шейдера (+конвейер).
@@ -315,6 +468,16 @@ typedef struct vulkan_shader {
     u8 instance_uniform_sampler_count;
     // @brief Количество обычных uniform-переменных локального уровня.
     u8 local_uniform_count;
+    // @brief Шейдер использует массив текстур без привязки и буфер материалов вместо наборов экземпляров.
+    bool bindless;
+    // @brief Буфер материалов: uniform-переменные экземпляров и индексы текстур (только без привязки).
+    renderbuffer material_buffer;
+    // @brief Отображенная память буфера материалов.
+    void* material_buffer_mapped_block;
+    // @brief Шаг элемента буфера материалов (выравнивание std430).
+    u32 material_stride;
+    // @brief Набор дескрипторов буфера материалов.
+    VkDescriptorSet material_descriptor_set;
 } vulkan_shader;
 
 #define VULKAN_MAX_REGISTERED_RENDERPASSES 31
@@ -341,6 +504,8 @@ typedef struct vulkan_context {
 
     // @brief Графические коммандные буферы (используется darray).
     vulkan_command_buffer* graphics_command_buffers;
+    // @brief Буферы команд получения владения загрузками, отправляются перед командами кадра (используется darray).
+    vulkan_command_buffer* acquire_command_buffers;
     // @brief Готовое для визуализации (используется darray).
     VkSemaphore* image_available_semaphores;
     // @brief Завершение визуализации (используется darray).
@@ -364,6 +529,52 @@ typedef struct vulkan_context {
     renderbuffer object_vertex_buffer;
     renderbuffer object_index_buffer;
 
+    // @brief Буфер экземпляров, по области на каждый кадр в полете (VULKAN_MAX_INSTANCE_COUNT матриц).
+    renderbuffer object_instance_buffer;
+    // @brief Постоянно отображенная память буфера экземпляров.
+    u8* instance_mapped;
+    // @brief Количество экземпляров, записанных в текущем кадре.
+    u32 instance_count;
+    // @brief Указывает, что буфер экземпляров привязан в текущем буфере команд.
+    bool instance_buffer_bound;
+
+    // @brief Буфер команд косвенной отрисовки, по области на каждый кадр в полете (VULKAN_MAX_INDIRECT_COUNT команд).
+    renderbuffer object_indirect_buffer;
+    // @brief Постоянно отображенная память буфера команд косвенной отрисовки.
+    u8* indirect_mapped;
+    // @brief Количество команд косвенной отрисовки, записанных в текущем кадре.
+    u32 indirect_count;
+    // @brief Указывает, что пакеты геометрий рисуются командами косвенной отрисовки.
+    bool indirect_draw_enabled;
+
+    // @brief Количество вызовов отрисовки, записанных в текущем кадре.
+    u32 draw_call_count;
+    // @brief Количество вызовов отрисовки в последнем завершенном кадре.
+    u32 frame_draw_call_count;
+
+    // @brief Количество кадров, отправленных в очередь графики.
+    u64 frame_number;
+    // @brief Ресурсы, ожидающие завершения кадров в полете (используется darray).
+    vulkan_retired_resource* retired_resources;
+
+    // @brief Буфер вершин, привязанный в текущем буфере команд (VK_NULL_HANDLE если не привязан).
+    VkBuffer bound_vertex_buffer;
+    // @brief Смещение привязанного буфера вершин.
+    VkDeviceSize bound_vertex_offset;
+    // @brief Буфер индексов, привязанный в текущем буфере команд (VK_NULL_HANDLE если не привязан).
+    VkBuffer bound_index_buffer;
+    // @brief Смещение привязанного буфера индексов.
+    VkDeviceSize bound_index_offset;
+
+    // @brief Кольцо промежуточного буфера для загрузок на GPU.
+    vulkan_staging staging;
+
+    // @brief Массив текстур без привязки.
+    vulkan_bindless bindless;
+
+    // @brief Общие сэмплеры карт текстур.
+    vulkan_sampler_entry samplers[VULKAN_MAX_SAMPLER_COUNT];
+
     // TODO: Сделать динамическим размер.
     vulkan_geometry_data geometries[VULKAN_SHADER_MAX_GEOMETRY_COUNT];
 
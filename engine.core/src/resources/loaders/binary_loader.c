@@ -16,8 +16,8 @@ bool binary_loader_load(resource_loader* self, const char* name, void* params, r
     char full_file_path[512];
     string_format_unsafe(full_file_path, format_str, resource_system_base_path(), name);
 
-    file* f;
-    if(!platform_file_open(full_file_path, FILE_MODE_READ | FILE_MODE_BINARY, &f))
+    resource_file f;
+    if(!resource_system_file_open(name, &f))
     {
         kerror("Function '%s': Unable to open binary file '%s' for reading.", __FUNCTION__, full_file_path);
         return false;
@@ -26,19 +26,17 @@ bool binary_loader_load(resource_loader* self, const char* name, void* params, r
     // TODO: Должен использоваться распределитель памяти.
     out_resource->full_path = string_duplicate(full_file_path);
 
-    u64 file_size = platform_file_size(f);
-
     // TODO: Должен использоваться распределитель памяти.
-    u8* resource_data = kallocate_tc(u8, file_size, MEMORY_TAG_FILE);
-    u64 read_size = 0;
-    if(!platform_file_read_all_bytes(f, resource_data, &read_size))
+    // NOTE: Пустой файл загружается как ресурс без данных.
+    u8* resource_data = null;
+    u64 read_size = f.size;
+    if(read_size)
     {
-        kerror("Function '%s': Unable to read binary file '%s'.", __FUNCTION__, full_file_path);
-        platform_file_close(f);
-        return false;
+        resource_data = kallocate_tc(u8, read_size, MEMORY_TAG_FILE);
+        kcopy(resource_data, f.data, read_size);
     }
 
-    platform_file_close(f);
+    resource_system_file_close(&f);
 
     out_resource->data = resource_data;
     out_resource->data_size = read_size;
@@ -60,6 +58,8 @@ resource_loader binary_resource_loader_create()
     loader.load = binary_loader_load;
     loader.unload = binary_loader_unload;
     loader.type_path = "";
+    loader.extensions = null;
+    loader.extension_count = 0;
 
     return loader;
 }
@@ -15,29 +15,29 @@
 #define STBI_NO_STDIO
 #include "vendor/stb_image.h"
 
+// Расширения файлов изображений в порядке приоритета.
+static const char* image_extensions[] = { ".tga", ".png", ".jpg", ".bmp" };
+
 bool image_loader_load(resource_loader* self, const char* name, void* params, resource* out_resource)
 {
 
     image_resouce_params* typed_params = params;
 
-    char* format_str = "%s/%s/%s%s";
     const i32 required_channel_count = 4;
     stbi_set_flip_vertically_on_load_thread(typed_params->flip_y);
+    char file_path[512];
     char full_file_path[512];
 
-    #define IMAGE_EXTENSION_COUNT 4
-    char* extentions[IMAGE_EXTENSION_COUNT] = { ".tga", ".png", ".jpg", ".bmp" };
-    bool found = false;
+    // Поиск файла с расширением наибольшего приоритета по индексу ресурсов.
+    bool found = resource_system_file_resolve(self, name, sizeof(file_path), file_path, null);
 
-    // Поиск расширений.
-    for(u32 i = 0; i < IMAGE_EXTENSION_COUNT; ++i)
+    if(found)
+    {
+        string_format_unsafe(full_file_path, "%s/%s", resource_system_base_path(), file_path);
+    }
+    else
     {
-        string_format_unsafe(full_file_path, format_str, resource_system_base_path(), self->type_path, name, extentions[i]);
-        if(platform_file_exists(full_file_path))
-        {
-            found = true;
-            break;
-        }
+        string_format_unsafe(full_file_path, "%s/%s/%s", resource_system_base_path(), self->type_path, name);
     }
 
     out_resource->data = null;
@@ -51,49 +51,26 @@ bool image_loader_load(resource_loader* self, const char* name, void* params, re
         return false;
     }
 
-    file* f;
-    if(!platform_file_open(full_file_path, FILE_MODE_READ | FILE_MODE_BINARY, &f))
+    // NOTE: Декодирование выполняется прямо из отображенных страниц файла, без промежуточного буфера.
+    resource_file image_file;
+    if(!resource_system_file_open(file_path, &image_file))
     {
         kerror("Function '%s': Unable to read file: %s.", __FUNCTION__, full_file_path);
-        platform_file_close(f);
-        return false;
-    }
-
-    u64 file_size = 0;
-    if(!(file_size = platform_file_size(f)))
-    {
-        kerror("Function '%s': Unable to get size of file: %s.", __FUNCTION__, full_file_path);
-        platform_file_close(f);
-        return false;
-    }
-
-    // TODO: память выделена, но вот в какой момент ее можно освободить?
-    u8* raw_data = kallocate(file_size, MEMORY_TAG_TEXTURE);
-    u64 read_bytes = 0;
-    bool read_result = platform_file_read_all_bytes(f, raw_data, &read_bytes);
-    platform_file_close(f);
-
-    if(!read_result || read_bytes != file_size)
-    {
-        kerror("Function '%s': Unable to read file: %s.", __FUNCTION__, full_file_path);
-        kfree(raw_data, MEMORY_TAG_TEXTURE);
         return false;
     }
 
     i32 width;
     i32 height;
     i32 channel_count;
-    u8* data = stbi_load_from_memory(raw_data, file_size, &width, &height, &channel_count, required_channel_count);
+    u8* data = stbi_load_from_memory(image_file.data, image_file.size, &width, &height, &channel_count, required_channel_count);
+    resource_system_file_close(&image_file);
+
     if(!data)
     {
         kerror("Function '%s': Image resource loader failed to load file: %s.", __FUNCTION__, full_file_path);
-        kfree(raw_data, MEMORY_TAG_TEXTURE);
         return false;
     }
 
-    // TODO: Масло масленное, но пока что сойдет и так!
-    kfree(raw_data, MEMORY_TAG_TEXTURE);
-
     image_resouce_data* resource_data = kallocate_tc(image_resouce_data, 1, MEMORY_TAG_TEXTURE);
     resource_data->pixels = data;
     resource_data->width = width;
@@ -124,6 +101,8 @@ resource_loader image_resource_loader_create()
     loader.load = image_loader_load;
     loader.unload = image_loader_unload;
     loader.type_path = "textures";
+    loader.extensions = image_extensions;
+    loader.extension_count = sizeof(image_extensions) / sizeof(image_extensions[0]);
 
     return loader;
 }
@@ -5,20 +5,31 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "kstring.h"
+#include "kstring_view.h"
 #include "memory/memory.h"
 #include "resources/resource_types.h"
 #include "systems/resource_system.h"
 #include "math/kmath.h"
 #include "platform/file.h"
 
+// Расширение файлов материалов.
+static const char* material_extensions[] = { ".kmt" };
+
 bool material_loader_load(resource_loader* self, const char* name, void* params, resource* out_resource)
 {
-    char* format_str = "%s/%s/%s%s";
+    char file_path[512];
     char full_file_path[512];
-    string_format_unsafe(full_file_path, format_str, resource_system_base_path(), self->type_path, name, ".kmt");
+    resource_file f;
+
+    if(!resource_system_file_resolve(self, name, sizeof(file_path), file_path, null))
+    {
+        kerror("Function '%s': Unable to find material file '%s/%s/%s.kmt'.", __FUNCTION__, resource_system_base_path(), self->type_path, name);
+        return false;
+    }
+
+    string_format_unsafe(full_file_path, "%s/%s", resource_system_base_path(), file_path);
 
-    file* f;
-    if(!platform_file_open(full_file_path, FILE_MODE_READ, &f))
+    if(!resource_system_file_open(file_path, &f))
     {
         kerror("Function '%s': Unable to open material file '%s' for reading.", __FUNCTION__, full_file_path);
         return false;
@@ -36,98 +47,81 @@ bool material_loader_load(resource_loader* self, const char* name, void* params,
     resource_data->diffuse_color = vec4_one(); // белый.
     string_ncopy(resource_data->name, name, MATERIAL_NAME_MAX_LENGTH);
 
-    char bufferline[512] = "";
-    char* p = bufferline;
-    u64 line_length = 0;
-    u32 line_number = 1;
+    // Разбор файла целиком из отображенной памяти, без копирования строк.
+    string_tokenizer tokenizer;
+    string_tokenizer_create(f.data, f.size, &tokenizer);
+    kstring_view line;
 
-    // Построчное чтение файла.
-    while(platform_file_read_line(f, 511, p, &line_length))
+    while(string_tokenizer_next_line(&tokenizer, &line))
     {
-        char* trimmed = string_trim(bufferline);
-        line_length = string_length(trimmed);
+        kstring_view trimmed = string_view_trim(line);
 
         // Пропуск пустых строк и коментариев.
-        if(line_length < 1 || trimmed[0] == '#')
+        if(trimmed.length < 1 || trimmed.data[0] == '#')
         {
-            line_number++;
             continue;
         }
 
-        i32 equal_index = string_index_of(trimmed, '=');
+        i64 equal_index = string_view_index_of(trimmed, '=');
         if(equal_index == INVALID_ID)
         {
 
             kwarng(
                 "Potential formatting issue found in file '%s': '=' token not found. Skipping line %u.",
-                full_file_path, line_number
+                full_file_path, tokenizer.line_number
             );
-            line_number++;
             continue;
         }
 
-        // Максимальное количество символов для имени переменной - 64.
-        char raw_var_name[64];
-        kzero_tc(raw_var_name, char, 64);
-        string_mid(raw_var_name, trimmed, 0, equal_index);
-        char* trimmed_var_name = string_trim(raw_var_name);
-
-        // Максимальное количество символов для значения - 446 (511–65).
-        char raw_value[446];
-        kzero_tc(raw_value, char, 446);
-        string_mid(raw_value, trimmed, equal_index + 1, -1);
-        char* trimmed_value = string_trim(raw_value);
+        kstring_view var_name = string_view_trim(string_view_sub(trimmed, 0, equal_index));
+        kstring_view value = string_view_trim(string_view_sub(trimmed, equal_index + 1, -1));
 
         // Процесс формирования.
-        if(string_equali(trimmed_var_name, "version"))
+        if(string_view_equali(var_name, "version"))
         {
             // TODO: Версия.
         }
-        else if(string_equali(trimmed_var_name, "name"))
+        else if(string_view_equali(var_name, "name"))
         {
-            string_ncopy(resource_data->name, trimmed_value, MATERIAL_NAME_MAX_LENGTH);
+            string_view_copy(resource_data->name, MATERIAL_NAME_MAX_LENGTH, value);
         }
-        else if(string_equali(trimmed_var_name, "diffuse_map_name"))
+        else if(string_view_equali(var_name, "diffuse_map_name"))
         {
-            string_ncopy(resource_data->diffuse_map_name, trimmed_value, TEXTURE_NAME_MAX_LENGTH);
+            string_view_copy(resource_data->diffuse_map_name, TEXTURE_NAME_MAX_LENGTH, value);
         }
-        else if(string_equali(trimmed_var_name, "specular_map_name"))
+        else if(string_view_equali(var_name, "specular_map_name"))
         {
-            string_ncopy(resource_data->specular_map_name, trimmed_value, TEXTURE_NAME_MAX_LENGTH);
+            string_view_copy(resource_data->specular_map_name, TEXTURE_NAME_MAX_LENGTH, value);
         }
-        else if(string_equali(trimmed_var_name, "normal_map_name"))
+        else if(string_view_equali(var_name, "normal_map_name"))
         {
-            string_ncopy(resource_data->normal_map_name, trimmed_value, TEXTURE_NAME_MAX_LENGTH);
+            string_view_copy(resource_data->normal_map_name, TEXTURE_NAME_MAX_LENGTH, value);
         }
-        else if(string_equali(trimmed_var_name, "diffuse_color"))
+        else if(string_view_equali(var_name, "diffuse_color"))
         {
-            if(!string_to_vec4(trimmed_value, &resource_data->diffuse_color))
+            if(!string_view_to_vec4(value, &resource_data->diffuse_color))
             {
                 kwarng("Error parsing diffuse_color in file '%s'. Using default of white instead.", full_file_path);
-                // NOTE: Уже задано выше.
+                resource_data->diffuse_color = vec4_one();
             }
         }
-        else if(string_equali(trimmed_var_name, "shininess"))
+        else if(string_view_equali(var_name, "shininess"))
         {
-            if(!string_to_f32(trimmed_value, &resource_data->shininess))
+            if(!string_view_to_f32(value, &resource_data->shininess))
             {
                 kwarng("Error parsing shininess in file '%s'. Using default of 32.0 instead.", full_file_path);
                 resource_data->shininess = 32.0f;
             }
         }
-        else if(string_equali(trimmed_var_name, "shader"))
+        else if(string_view_equali(var_name, "shader"))
         {
-            resource_data->shader_name = string_duplicate(trimmed_value);
+            resource_data->shader_name = string_view_duplicate(value);
         }
 
         // TODO: Другие поля.
-
-        // Очистка буфера.
-        kzero(bufferline, sizeof(char) * 512);
-        line_number++;
     }
 
-    platform_file_close(f);
+    resource_system_file_close(&f);
 
     out_resource->data = resource_data;
     out_resource->data_size = sizeof(material_config);
@@ -152,6 +146,8 @@ resource_loader material_resource_loader_create()
     loader.load = material_loader_load;
     loader.unload = material_loader_unload;
     loader.type_path = "materials";
+    loader.extensions = material_extensions;
+    loader.extension_count = 1;
 
     return loader;
 }
@@ -5,6 +5,7 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "kstring.h"
+#include "kstring_view.h"
 #include "math/kmath.h"
 #include "math/geometry_utils.h"
 #include "memory/memory.h"
@@ -19,15 +20,30 @@
 #define FILETYPE_KSM 0
 #define FILETYPE_OBJ 1
 
+// Версии формата ksm: вторая добавляет уровни детализации геометрий, третья окклюдеры.
+#define KSM_VERSION_NO_LODS      0x0001U
+#define KSM_VERSION_NO_OCCLUDERS 0x0002U
+#define KSM_VERSION              0x0003U
+
+// Наибольшее количество треугольников окклюдера одной геометрии (буфер перекрытия принимает 16384 за кадр).
+#define MESH_OCCLUDER_MAX_TRIANGLE_COUNT 256
+
 // Известные файлы загрузчику.
 static const loader_filetype_entry supported_filetypes[SUPPORTED_FILETYPE_COUNT] = {
     [FILETYPE_KSM] = {".ksm", LOADER_FILETYPE_MESH_KSM, true  },
     [FILETYPE_OBJ] = {".obj", LOADER_FILETYPE_MESH_OBJ, false }
 };
 
-bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geometries_darray);
-bool load_ksm_file(file* ksm_file, geometry_config** out_geometries_darray);
+// Расширения известных файлов для индекса ресурсов (в порядке таблицы, ksm в приоритете).
+static const char* supported_extensions[SUPPORTED_FILETYPE_COUNT] = {
+    [FILETYPE_KSM] = ".ksm",
+    [FILETYPE_OBJ] = ".obj"
+};
+
+bool load_obj_file(const resource_file* obj_file, const char* name, geometry_config** out_geometries_darray);
+bool load_ksm_file(const resource_file* ksm_file, geometry_config** out_geometries_darray);
 bool write_ksm_file(const char* name, geometry_config* geometries);
+static void mesh_generate_occluder(geometry_config* config);
 
 bool mesh_loader_load(struct resource_loader* self, const char* name, void* params, resource* out_resource)
 {
@@ -36,26 +52,19 @@ bool mesh_loader_load(struct resource_loader* self, const char* name, void* para
         return false;
     }
 
-    char* format_str = "%s/%s/%s%s";
+    char  path_str[512];
     char  filepath_str[512];
     loader_filetype type = LOADER_FILETYPE_NOT_FOUND;
-    file* f;
+    resource_file f = {};
 
-    // Попытка найти поддерживаемый файл.
-    for(u32 i = 0; i < SUPPORTED_FILETYPE_COUNT; ++i)
+    // Поиск поддерживаемого файла одним поиском по индексу ресурсов, без обращения к файловой системе.
+    // NOTE: И бинарный ksm, и текстовый obj разбираются прямо из отображенного в память архива или файла.
+    u32 filetype_index = 0;
+    if(resource_system_file_resolve(self, name, sizeof(path_str), path_str, &filetype_index)
+    && resource_system_file_open(path_str, &f))
     {
-        string_format_unsafe(filepath_str, format_str, resource_system_base_path(), self->type_path, name, supported_filetypes[i].extension);
-
-        if(platform_file_exists(filepath_str))
-        {
-            file_mode mode = supported_filetypes[i].is_binary ? FILE_MODE_READ | FILE_MODE_BINARY : FILE_MODE_READ;
-
-            if(platform_file_open(filepath_str, mode, &f))
-            {
-                type = supported_filetypes[i].type;
-                break;
-            }
-        }
+        string_format_unsafe(filepath_str, "%s/%s", resource_system_base_path(), path_str);
+        type = supported_filetypes[filetype_index].type;
     }
 
     if(type == LOADER_FILETYPE_NOT_FOUND)
@@ -71,10 +80,10 @@ bool mesh_loader_load(struct resource_loader* self, const char* name, void* para
     switch(type)
     {
         case LOADER_FILETYPE_MESH_KSM:
-            result = load_ksm_file(f, &resource_data);
+            result = load_ksm_file(&f, &resource_data);
             break;
         case LOADER_FILETYPE_MESH_OBJ:
-            result = load_obj_file(f, name, &resource_data);
+            result = load_obj_file(&f, name, &resource_data);
             write_ksm_file(name, resource_data);
             break;
         default:
@@ -83,11 +92,19 @@ bool mesh_loader_load(struct resource_loader* self, const char* name, void* para
             break; // NOTE: LOADER_FILETYPE_NOT_FOUND тут не должен оказаться (смотри условия выше)!
     }
 
-    platform_file_close(f);
+    resource_system_file_close(&f);
 
     if(!result)
     {
         kerror("Function '%s': Failed to process mesh file '%s'.", __FUNCTION__, filepath_str);
+
+        // Освобождение уже прочитанных геометрий.
+        u64 count = darray_length(resource_data);
+        for(u64 i = 0; i < count; ++i)
+        {
+            geometry_system_config_dispose(&resource_data[i]);
+        }
+
         darray_destroy(resource_data);
         out_resource->data = null;
         out_resource->data_size = 0;
@@ -133,56 +150,186 @@ resource_loader mesh_resource_loader_create()
     loader.load = mesh_loader_load;
     loader.unload = mesh_loader_unload;
     loader.type_path = "models";
+    loader.extensions = supported_extensions;
+    loader.extension_count = SUPPORTED_FILETYPE_COUNT;
 
     return loader;
 }
 
 //-------------------------------------- KSM ----------------------------------------------
 
-bool load_ksm_file(file* ksm_file, geometry_config** out_geometries_darray)
+// @brief Курсор чтения отображенного в память ksm файла.
+typedef struct ksm_reader {
+    const u8* data;
+    u64 size;
+    u64 offset;
+} ksm_reader;
+
+/*
+    @brief Возвращает указатель на очередные данные файла и сдвигает курсор.
+    @param reader Указатель на курсор чтения.
+    @param size Количество байт которое требуется прочитать.
+    @return Указатель на данные внутри отображения, null если файл закончился раньше.
+*/
+static const void* ksm_reader_take(ksm_reader* reader, u64 size)
+{
+    if(size > reader->size - reader->offset)
+    {
+        return null;
+    }
+
+    const void* data = reader->data + reader->offset;
+    reader->offset += size;
+    return data;
+}
+
+/*
+    @brief Копирует очередные данные файла по указанному адресу и сдвигает курсор.
+    @param reader Указатель на курсор чтения.
+    @param size Количество байт которое требуется прочитать.
+    @param dest Указатель на память куда скопировать данные.
+    @return True данные прочитаны, false файл закончился раньше.
+*/
+static bool ksm_reader_read(ksm_reader* reader, u64 size, void* dest)
 {
-    // NOTE: Ниже игнорируется результат чтения!
+    const void* data = ksm_reader_take(reader, size);
+    if(!data)
+    {
+        return false;
+    }
 
-    u16 version = 0;
-    platfrom_file_read(ksm_file, sizeof(u16), &version);
+    kcopy(dest, data, size);
+    return true;
+}
 
-    u32 name_length = 0;
-    char name[GEOMETRY_NAME_MAX_LENGTH];
-    platfrom_file_read(ksm_file, sizeof(u32), &name_length);
-    platfrom_file_read(ksm_file, sizeof(char) * name_length, name);
+/*
+    @brief Читает строку в формате [длина u32][символы] в буфер заданного размера.
+    @param reader Указатель на курсор чтения.
+    @param max_length Размер буфера строки (с учетом завершающего нуля).
+    @param dest Указатель на буфер строки.
+    @return True строка прочитана, false файл поврежден.
+*/
+static bool ksm_reader_read_string(ksm_reader* reader, u32 max_length, char* dest)
+{
+    u32 length = 0;
+    if(!ksm_reader_read(reader, sizeof(u32), &length) || !length || length > max_length)
+    {
+        return false;
+    }
 
+    if(!ksm_reader_read(reader, sizeof(char) * length, dest))
+    {
+        return false;
+    }
+
+    dest[length - 1] = '\0';
+    return true;
+}
+
+bool load_ksm_file(const resource_file* ksm_file, geometry_config** out_geometries_darray)
+{
+    ksm_reader reader = { .data = ksm_file->data, .size = ksm_file->size, .offset = 0 };
+
+    u16 version = 0;
+    char name[GEOMETRY_NAME_MAX_LENGTH];
     u64 geometry_count = 0;
-    platfrom_file_read(ksm_file, sizeof(u64), &geometry_count);
+
+    if(!ksm_reader_read(&reader, sizeof(u16), &version)
+    || !ksm_reader_read_string(&reader, GEOMETRY_NAME_MAX_LENGTH, name)
+    || !ksm_reader_read(&reader, sizeof(u64), &geometry_count))
+    {
+        kerror("Function '%s': Invalid or truncated ksm header.", __FUNCTION__);
+        return false;
+    }
+
+    if(version != KSM_VERSION_NO_LODS && version != KSM_VERSION_NO_OCCLUDERS && version != KSM_VERSION)
+    {
+        kerror("Function '%s': Unsupported ksm version %u of file '%s'.", __FUNCTION__, version, name);
+        return false;
+    }
 
     for(u64 i = 0; i < geometry_count; ++i)
     {
         geometry_config gconf = {};
 
-        // Имя сетки геометрии.
-        u32 g_name_length = 0;
-        platfrom_file_read(ksm_file, sizeof(u32), &g_name_length);
-        platfrom_file_read(ksm_file, sizeof(char) * g_name_length, gconf.name);
-
-        // Имя материала геометрии.
-        u32 m_name_length = 0;
-        platfrom_file_read(ksm_file, sizeof(u32), &m_name_length);
-        platfrom_file_read(ksm_file, sizeof(char) * m_name_length, gconf.material_name);
+        // Имя сетки геометрии и имя материала геометрии.
+        if(!ksm_reader_read_string(&reader, GEOMETRY_NAME_MAX_LENGTH, gconf.name)
+        || !ksm_reader_read_string(&reader, MATERIAL_NAME_MAX_LENGTH, gconf.material_name))
+        {
+            kerror("Function '%s': Invalid geometry name in ksm file '%s'.", __FUNCTION__, name);
+            return false;
+        }
 
         // Размеры и центр геометрии.
-        platfrom_file_read(ksm_file, sizeof(vec3), &gconf.center);
-        platfrom_file_read(ksm_file, sizeof(extents_3d), &gconf.extents);
+        // Вершины (размер/количество) и индексы (размер/количество).
+        if(!ksm_reader_read(&reader, sizeof(vec3), &gconf.center)
+        || !ksm_reader_read(&reader, sizeof(extents_3d), &gconf.extents)
+        || !ksm_reader_read(&reader, sizeof(u32), &gconf.vertex_size)
+        || !ksm_reader_read(&reader, sizeof(u32), &gconf.vertex_count))
+        {
+            kerror("Function '%s': Truncated geometry '%s' in ksm file '%s'.", __FUNCTION__, gconf.name, name);
+            return false;
+        }
 
-        // Вершины (размер/количество/данные вершин)
-        platfrom_file_read(ksm_file, sizeof(u32), &gconf.vertex_size);
-        platfrom_file_read(ksm_file, sizeof(u32), &gconf.vertex_count);
-        gconf.vertices = kallocate(gconf.vertex_size * gconf.vertex_count, MEMORY_TAG_ARRAY);
-        platfrom_file_read(ksm_file, gconf.vertex_size * gconf.vertex_count, gconf.vertices);
+        // NOTE: Данные вершин копируются один раз: из страниц файла сразу в память конфигурации.
+        u64 vertices_size = (u64)gconf.vertex_size * gconf.vertex_count;
+        const void* vertices = ksm_reader_take(&reader, vertices_size);
 
-        // Индексы (размер/количество/данные индексов)
-        platfrom_file_read(ksm_file, sizeof(u32), &gconf.index_size);
-        platfrom_file_read(ksm_file, sizeof(u32), &gconf.index_count);
-        gconf.indices = kallocate(gconf.index_size * gconf.index_count, MEMORY_TAG_ARRAY);
-        platfrom_file_read(ksm_file, gconf.index_size * gconf.index_count, gconf.indices);
+        if(!vertices
+        || !ksm_reader_read(&reader, sizeof(u32), &gconf.index_size)
+        || !ksm_reader_read(&reader, sizeof(u32), &gconf.index_count))
+        {
+            kerror("Function '%s': Truncated geometry '%s' in ksm file '%s'.", __FUNCTION__, gconf.name, name);
+            return false;
+        }
+
+        u64 indices_size = (u64)gconf.index_size * gconf.index_count;
+        const void* indices = ksm_reader_take(&reader, indices_size);
+
+        if(!indices)
+        {
+            kerror("Function '%s': Truncated geometry '%s' in ksm file '%s'.", __FUNCTION__, gconf.name, name);
+            return false;
+        }
+
+        // Уровни детализации (в файлах первой версии отсутствуют).
+        if(version >= KSM_VERSION_NO_OCCLUDERS
+        && (!ksm_reader_read(&reader, sizeof(u8), &gconf.lod_count) || gconf.lod_count > GEOMETRY_LOD_MAX_COUNT
+        || !ksm_reader_read(&reader, sizeof(geometry_lod) * gconf.lod_count, gconf.lods)))
+        {
+            kerror("Function '%s': Invalid lods of geometry '%s' in ksm file '%s'.", __FUNCTION__, gconf.name, name);
+            return false;
+        }
+
+        // Окклюдер (количество/индексы, в файлах до третьей версии отсутствует).
+        const void* occluder_indices = null;
+        if(version >= KSM_VERSION)
+        {
+            if(!ksm_reader_read(&reader, sizeof(u32), &gconf.occluder_index_count)
+            || gconf.occluder_index_count % 3 != 0
+            || !(occluder_indices = ksm_reader_take(&reader, sizeof(u32) * (u64)gconf.occluder_index_count)))
+            {
+                kerror("Function '%s': Invalid occluder of geometry '%s' in ksm file '%s'.", __FUNCTION__, gconf.name, name);
+                return false;
+            }
+        }
+
+        gconf.vertices = kallocate(vertices_size, MEMORY_TAG_ARRAY);
+        kcopy(gconf.vertices, vertices, vertices_size);
+
+        gconf.indices = kallocate(indices_size, MEMORY_TAG_ARRAY);
+        kcopy(gconf.indices, indices, indices_size);
+
+        if(gconf.occluder_index_count)
+        {
+            gconf.occluder_indices = kallocate_tc(u32, gconf.occluder_index_count, MEMORY_TAG_ARRAY);
+            kcopy_tc(gconf.occluder_indices, occluder_indices, u32, gconf.occluder_index_count);
+        }
+        else if(version < KSM_VERSION)
+        {
+            // NOTE: Старые файлы не перезаписываются, окклюдер строится при каждой загрузке.
+            mesh_generate_occluder(&gconf);
+        }
 
         darray_push(*out_geometries_darray, gconf);
     }
@@ -208,7 +355,7 @@ bool write_ksm_file(const char* name, geometry_config* geometries)
         return false;
     }
 
-    u16 version = 0x0001U;
+    u16 version = KSM_VERSION;
     platform_file_write(ksm_file, sizeof(u16), &version);
 
     u32 name_length = string_length(name) + 1;
@@ -245,6 +392,14 @@ bool write_ksm_file(const char* name, geometry_config* geometries)
         platform_file_write(ksm_file, sizeof(u32), &g->index_size);
         platform_file_write(ksm_file, sizeof(u32), &g->index_count);
         platform_file_write(ksm_file, g->index_size * g->index_count, g->indices);
+
+        // Уровни детализации (количество/диапазоны индексов).
+        platform_file_write(ksm_file, sizeof(u8), &g->lod_count);
+        platform_file_write(ksm_file, sizeof(geometry_lod) * g->lod_count, g->lods);
+
+        // Окклюдер (количество/индексы).
+        platform_file_write(ksm_file, sizeof(u32), &g->occluder_index_count);
+        platform_file_write(ksm_file, sizeof(u32) * g->occluder_index_count, g->occluder_indices);
     }
 
     platform_file_close(ksm_file);
@@ -279,61 +434,68 @@ typedef struct index_entry {
 
 /*
     @brief Выполняет разбор obj файла модели и запись в предоставленные динамические массивы.
-    @param obj_file Указатель на открытый obj файл модели.
+    @param obj_file Указатель на открытый (отображенный в память) obj файл модели.
     @param positions Указатель на динамический массив позиций вершин (указатель на darray).
     @param normals Указатель на динамический массив нормалей вершин (указатель на darray).
     @param texcoords Указатель на динамический массив координат текстур вершин (указатель на darray).
     @param groups Указатель на динамический массив групп индексов вершин (указатель на darray).
     @param out_material_filename Указатель на массив символов для записи имени файла материалов (без расширения).
 */
-bool parse_obj_file(file* obj_file, vec3** positions, vec3** normals, vec2** texcoords, mesh_group_data** groups, char* out_material_filename)
+bool parse_obj_file(const resource_file* obj_file, vec3** positions, vec3** normals, vec2** texcoords, mesh_group_data** groups, char* out_material_filename)
 {
-    u64 normal_count = 0;
-    u64 texcoord_count = 0;
     u64 group_current_index = 0;
-    char bufferline[512] = "";
-    u64 line_length = 0;
-    // u32 line_number = 1;
-    
-    while(platform_file_read_line(obj_file, 511, bufferline, &line_length))
+
+    // Разбор файла целиком из отображенной памяти, без копирования строк.
+    string_tokenizer tokenizer;
+    string_tokenizer_create(obj_file->data, obj_file->size, &tokenizer);
+    kstring_view line;
+
+    while(string_tokenizer_next_line(&tokenizer, &line))
     {
         // Пропуск пустых строк и коментариев.
-        if(line_length < 1 || bufferline[0] == '#')
+        if(line.length < 1 || line.data[0] == '#')
         {
-            // line_number++;
             continue;
         }
 
-        if(string_nequali(bufferline, "mtllib ", 7))
+        kstring_view rest = line;
+        kstring_view keyword;
+        if(!string_view_next_token(&rest, &keyword))
+        {
+            continue;
+        }
+
+        if(string_view_equali(keyword, "mtllib"))
         {
             // TODO: Может быть несколько файлов.
-            platform_string_sscanf(&bufferline[7], "%s", out_material_filename);
+            kstring_view filename;
+            if(string_view_next_token(&rest, &filename))
+            {
+                string_view_copy(out_material_filename, MATERIAL_NAME_MAX_LENGTH, filename);
+            }
         }
-        else if(string_nequali(bufferline, "v ", 2))
+        else if(string_view_equali(keyword, "v"))
         {
             vec3 pos;
-            string_to_vec3(&bufferline[2], &pos);
+            string_view_to_vec3(rest, &pos);
             darray_push(*positions, pos);
         }
-        else if(string_nequali(bufferline, "vt ", 3))
+        else if(string_view_equali(keyword, "vt"))
         {
             vec2 tex;
-            string_to_vec2(&bufferline[3], &tex);
+            string_view_to_vec2(rest, &tex);
             darray_push(*texcoords, tex);
-            texcoord_count++;
         }
-        else if(string_nequali(bufferline, "vn ", 3))
+        else if(string_view_equali(keyword, "vn"))
         {
             vec3 nor;
-            string_to_vec3(&bufferline[3], &nor);
+            string_view_to_vec3(rest, &nor);
             darray_push(*normals, nor);
-            normal_count++;
         }
-        else if(string_nequali(bufferline, "usemtl ", 7))
+        else if(string_view_equali(keyword, "usemtl"))
         {
             mesh_group_data new_group;
-            string_ncopy(new_group.material_name, &bufferline[7], MATERIAL_NAME_MAX_LENGTH);
-            string_trim(new_group.material_name);
+            string_view_copy(new_group.material_name, MATERIAL_NAME_MAX_LENGTH, string_view_trim(rest));
             new_group.faces = darray_reserve(mesh_face_data, 16384);
 
             darray_push(*groups, new_group);
@@ -342,44 +504,53 @@ bool parse_obj_file(file* obj_file, vec3** positions, vec3** normals, vec2** tex
             group_current_index = darray_length(*groups) - 1;
 
         }
-        else if(string_nequali(bufferline, "s ", 2))
+        else if(string_view_equali(keyword, "s"))
         {
             // TODO: Обработать!
         }
-        else if(string_nequali(bufferline, "g ", 2))
+        else if(string_view_equali(keyword, "g"))
         {
             // TODO: Обработать!
             
         }
-        else if(string_nequali(bufferline, "f ", 2))
+        else if(string_view_equali(keyword, "f"))
         {
             // face                        vert 1      vert 2      vert 3
             // f 1 2 3             ==        1            2           3
             // f 1/1/1 2/2/2 3/3/3 == pos/tex/norm pos/tex/norm pos/tex/norm
+            // f 1//1 2//2 3//3    == pos//norm    pos//norm    pos//norm
             mesh_face_data face;
+            kzero_tc(&face, mesh_face_data, 1);
 
-            if(normal_count == 0 || texcoord_count == 0)
-            {
-                platform_string_sscanf(
-                    &bufferline[2], "%d %d %d",
-                    &face.vertices[0].position_index, &face.vertices[1].position_index, &face.vertices[2].position_index
-                );
-            }
-            else
+            kstring_view vertex;
+            for(u32 i = 0; i < 3 && string_view_next_token(&rest, &vertex); ++i)
             {
-                platform_string_sscanf(
-                    &bufferline[2], "%d/%d/%d %d/%d/%d %d/%d/%d",
-                    &face.vertices[0].position_index, &face.vertices[0].texcoord_index, &face.vertices[0].normal_index,
-                    &face.vertices[1].position_index, &face.vertices[1].texcoord_index, &face.vertices[1].normal_index,
-                    &face.vertices[2].position_index, &face.vertices[2].texcoord_index, &face.vertices[2].normal_index
-                );
+                u32* indices[3] = {
+                    &face.vertices[i].position_index, &face.vertices[i].texcoord_index, &face.vertices[i].normal_index
+                };
+
+                // Отсутствующие индексы остаются нулевыми.
+                for(u32 j = 0; j < 3 && vertex.length > 0; ++j)
+                {
+                    i64 index = 0;
+                    if(string_view_parse_i64(&vertex, &index))
+                    {
+                        *indices[j] = (u32)index;
+                    }
+
+                    if(vertex.length > 0 && vertex.data[0] == '/')
+                    {
+                        vertex = string_view_sub(vertex, 1, -1);
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
             }
 
             darray_push((*groups)[group_current_index].faces, face);
         }
-
-        kzero_tc(bufferline, char, 512);
-        // line_number++;
     }
 
     // NOTE: Раскоментировать для отладки.
@@ -704,7 +875,89 @@ bool import_mtl_file(const char* mtl_filename, const char* kmt_filename)
     return true;
 }
 
-bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geometries_darray)
+/*
+    @brief Строит уровни детализации геометрии упрощением сетки и объединяет их в один буфер индексов.
+    NOTE: Каждый следующий уровень содержит примерно вдвое меньше треугольников. Построение прекращается,
+          если упрощение дает меньше 10% выигрыша (например, сетка состоит из одних швов и границ).
+    @param config Указатель на конфигурацию геометрии с индексами, выделенными kallocate.
+*/
+static void mesh_generate_lods(geometry_config* config)
+{
+    // Допустимое отклонение поверхности уровня относительно размера геометрии.
+    static const f32 lod_errors[GEOMETRY_LOD_MAX_COUNT] = { 0.0f, 0.0025f, 0.01f, 0.04f };
+
+    u32* levels = kallocate_tc(u32, config->index_count * GEOMETRY_LOD_MAX_COUNT, MEMORY_TAG_ARRAY);
+    kcopy_tc(levels, config->indices, u32, config->index_count);
+
+    config->lod_count = 1;
+    config->lods[0].index_offset = 0;
+    config->lods[0].index_count = config->index_count;
+    u32 total_count = config->index_count;
+
+    for(u8 i = 1; i < GEOMETRY_LOD_MAX_COUNT; ++i)
+    {
+        u32 previous_count = config->lods[i - 1].index_count;
+        u32 target_count = (previous_count / 6) * 3;
+        u32* level = levels + total_count;
+
+        u32 count = geometry_simplify(
+            config->vertex_count, config->vertices, config->index_count, config->indices, target_count,
+            lod_errors[i], level
+        );
+
+        if(!count || count > previous_count - previous_count / 10)
+        {
+            break;
+        }
+
+        config->lods[i].index_offset = total_count;
+        config->lods[i].index_count = count;
+        config->lod_count++;
+        total_count += count;
+    }
+
+    kfree(config->indices, MEMORY_TAG_ARRAY);
+    config->indices = kallocate_tc(u32, total_count, MEMORY_TAG_ARRAY);
+    kcopy_tc(config->indices, levels, u32, total_count);
+    config->index_count = total_count;
+    kfree(levels, MEMORY_TAG_ARRAY);
+}
+
+/*
+    @brief Строит консервативный окклюдер геометрии по самому подробному уровню детализации.
+    NOTE: Окклюдер - подмножество треугольников поверхности (смотри geometry_generate_occluder), поэтому в отличие
+          от ограничивающего прямоугольника или упрощенных уровней не перекрывает видимое и для невыпуклых сеток.
+    @param config Указатель на конфигурацию геометрии с вершинами vertex_3d и индексами u32.
+*/
+static void mesh_generate_occluder(geometry_config* config)
+{
+    if(config->vertex_size != sizeof(vertex_3d) || config->index_size != sizeof(u32) || !config->index_count)
+    {
+        return;
+    }
+
+    u32 offset = config->lod_count ? config->lods[0].index_offset : 0;
+    u32 count = config->lod_count ? config->lods[0].index_count : config->index_count;
+    u32 max_index_count = MESH_OCCLUDER_MAX_TRIANGLE_COUNT * 3;
+
+    u32* indices = kallocate_tc(u32, max_index_count, MEMORY_TAG_ARRAY);
+    u32 index_count = geometry_generate_occluder(
+        config->vertex_count, config->vertices, count, (u32*)config->indices + offset, max_index_count, indices
+    );
+
+    if(!index_count)
+    {
+        kfree(indices, MEMORY_TAG_ARRAY);
+        return;
+    }
+
+    config->occluder_index_count = index_count;
+    config->occluder_indices = kallocate_tc(u32, index_count, MEMORY_TAG_ARRAY);
+    kcopy_tc(config->occluder_indices, indices, u32, index_count);
+    kfree(indices, MEMORY_TAG_ARRAY);
+}
+
+bool load_obj_file(const resource_file* obj_file, const char* name, geometry_config** out_geometries_darray)
 {
     char mtl_filename[MATERIAL_NAME_MAX_LENGTH];
     vec3* positions = darray_reserve(vec3, 16384);
@@ -725,7 +978,7 @@ bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geome
         // TODO: Временная функция импорта материалов из mtl в kmt.
         import_mtl_file(mtl_filename, groups[i].material_name);
 
-        geometry_config new_config;
+        geometry_config new_config = {};
         string_ncopy(new_config.name, name, GEOMETRY_NAME_MAX_LENGTH);
         string_append_u64(new_config.name, new_config.name, i);
 
@@ -770,6 +1023,10 @@ bool load_obj_file(file* obj_file, const char* name, geometry_config** out_geome
         new_config.vertices = vertices;
         new_config.indices = indices;
 
+        // Уровни детализации и окклюдер записываются в ksm файл вместе с геометрией.
+        mesh_generate_lods(&new_config);
+        mesh_generate_occluder(&new_config);
+
         // NOTE: Раскоментировать для отладки.
         // kdebug("LOAD OBJECT FILE -> GROUP %llu:", i);
         // kdebug("Vertices count %llu", new_config.vertex_count);
@@ -5,12 +5,40 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "kstring.h"
+#include "kstring_view.h"
 #include "memory/memory.h"
 #include "containers/darray.h"
 #include "resources/resource_types.h"
 #include "systems/resource_system.h"
 #include "platform/file.h"
 
+// Расширение файлов конфигурации шейдеров.
+static const char* shader_extensions[] = { ".shadercfg" };
+
+/*
+    @brief Разделяет значение по запятым на обрезанные части без выделения памяти.
+    @param value Представление значения.
+    @param max_count Максимальное количество частей для записи.
+    @param out_fields Указатель на массив представлений для записи частей.
+    @return Общее количество частей (может быть больше max_count).
+*/
+static u32 shader_loader_split_fields(kstring_view value, u32 max_count, kstring_view* out_fields)
+{
+    u32 count = 0;
+    kstring_view field;
+
+    while(string_view_split_next(&value, ',', &field))
+    {
+        if(count < max_count)
+        {
+            out_fields[count] = string_view_trim(field);
+        }
+        count++;
+    }
+
+    return count;
+}
+
 bool shader_loader_load(resource_loader* self, const char* name, void* params, resource* out_resource)
 {
     if(!resource_loader_load_valid(self, name, out_resource, __FUNCTION__))
@@ -18,12 +46,19 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
         return false;
     }
 
-    char* format_str = "%s/%s/%s%s";
-    char  filepath_str[512];                // TODO: Сделать общей константой длинну. Добавить в проверку длину имени!
-    string_format_unsafe(filepath_str, format_str, resource_system_base_path(), self->type_path, name, ".shadercfg");
+    char  path_str[512];                    // TODO: Сделать общей константой длинну. Добавить в проверку длину имени!
+    char  filepath_str[512];
+    resource_file f;
+
+    if(!resource_system_file_resolve(self, name, sizeof(path_str), path_str, null))
+    {
+        kerror("Function '%s': Unable to find shader config file '%s/%s/%s.shadercfg'.", __FUNCTION__, resource_system_base_path(), self->type_path, name);
+        return false;
+    }
+
+    string_format_unsafe(filepath_str, "%s/%s", resource_system_base_path(), path_str);
 
-    file* f;
-    if(!platform_file_open(filepath_str, FILE_MODE_READ, &f))
+    if(!resource_system_file_open(path_str, &f))
     {
         kerror("Function '%s': Unable to open shader config file '%s' for reading.", __FUNCTION__, filepath_str);
         return false;
@@ -40,108 +75,109 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
     resource_data->stages = darray_create(shader_stage);
     resource_data->stage_names = darray_create(char*);
     resource_data->stage_filenames = darray_create(char*);
+    resource_data->bindless_stage_filenames = darray_create(char*);
     resource_data->cull_mode = FACE_CULL_MODE_BACK;
     resource_data->renderpass_name = null;
     resource_data->name = null;
 
-    char bufferline[512] = "";
-    u64 line_length = 0;
-    u32 line_number = 1;
+    // Разбор файла целиком из отображенной памяти, без копирования строк.
+    string_tokenizer tokenizer;
+    string_tokenizer_create(f.data, f.size, &tokenizer);
+    kstring_view line;
 
-    while(platform_file_read_line(f, 511, bufferline, &line_length))
+    while(string_tokenizer_next_line(&tokenizer, &line))
     {
-        char* trimmed = string_trim(bufferline);
-        line_length = string_length(trimmed);
+        kstring_view trimmed = string_view_trim(line);
 
         // Пропуск пустых строк и коментариев.
-        if(line_length < 1 || trimmed[0] == '#')
+        if(trimmed.length < 1 || trimmed.data[0] == '#')
         {
-            line_number++;
             continue;
         }
 
         // Поиск смещения токена '='.
-        i32 equal_index = string_index_of(trimmed, '=');
+        i64 equal_index = string_view_index_of(trimmed, '=');
         if(equal_index == -1)
         {
             kwarng(
                 "Function '%s': Potential formatting issue found in file '%s': '=' token not found. Skipping line %u.",
-                __FUNCTION__, filepath_str, line_number
+                __FUNCTION__, filepath_str, tokenizer.line_number
             );
-            line_number++;
             continue;
         }
 
-        // Максимальная длина имени 64 символа.
-        char raw_var_name[64];
-        kzero_tc(raw_var_name, char, 64);
-        string_mid(raw_var_name, trimmed, 0, equal_index);
-        char* trimmed_var_name = string_trim(raw_var_name);
-
-        // Максимальная длина переменой 446 (511-65 с учетом токена '=').
-        char raw_value[446];
-        kzero_tc(raw_value, char, 446);
-        string_mid(raw_value, trimmed, equal_index + 1, -1); // Читать до конца строки.
-        char* trimmed_value = string_trim(raw_value);
+        kstring_view var_name = string_view_trim(string_view_sub(trimmed, 0, equal_index));
+        kstring_view value = string_view_trim(string_view_sub(trimmed, equal_index + 1, -1));
 
         // Обработка переменной.
-        if(string_equali(trimmed_var_name, "version"))
+        if(string_view_equali(var_name, "version"))
         {
             // TODO: Сделать версию файла.
         }
-        else if(string_equali(trimmed_var_name, "name"))
+        else if(string_view_equali(var_name, "name"))
         {
-            resource_data->name = string_duplicate(trimmed_value);
+            resource_data->name = string_view_duplicate(value);
         }
-        else if(string_equali(trimmed_var_name, "renderpass"))
+        else if(string_view_equali(var_name, "renderpass"))
         {
-            resource_data->renderpass_name = string_duplicate(trimmed_value);
+            resource_data->renderpass_name = string_view_duplicate(value);
         }
-        else if(string_equali(trimmed_var_name, "stages"))
+        else if(string_view_equali(var_name, "stages"))
         {
-            u32 count = string_split(trimmed_value, ',', true, true, &resource_data->stage_names);
+            kstring_view stage_name;
+            u32 count = 0;
 
-            if(resource_data->stage_count == 0)
-            {
-                resource_data->stage_count = count;
-            }
-            else if(resource_data->stage_count != count)
+            while(string_view_split_next(&value, ',', &stage_name))
             {
-                kerror(
-                    "Function '%s': Invalid file layout. Count mismatch between stage names and stage filenames.",
-                    __FUNCTION__
-                );
-            }
-
-            char** stage_names = resource_data->stage_names;
+                stage_name = string_view_trim(stage_name);
+                char* stage_name_str = string_view_duplicate(stage_name);
+                darray_push(resource_data->stage_names, stage_name_str);
+                count++;
 
-            for(u8 i = 0; i < resource_data->stage_count; ++i)
-            {
-                if(string_equali(stage_names[i], "frag") || string_equali(stage_names[i], "fragment"))
+                if(string_view_equali(stage_name, "frag") || string_view_equali(stage_name, "fragment"))
                 {
                     darray_push(resource_data->stages, SHADER_STAGE_FRAGMENT);
                 }
-                else if(string_equali(stage_names[i], "vert") || string_equali(stage_names[i], "vertex"))
+                else if(string_view_equali(stage_name, "vert") || string_view_equali(stage_name, "vertex"))
                 {
                     darray_push(resource_data->stages, SHADER_STAGE_VERTEX);
                 }
-                else if(string_equali(stage_names[i], "geom") || string_equali(stage_names[i], "geometry"))
+                else if(string_view_equali(stage_name, "geom") || string_view_equali(stage_name, "geometry"))
                 {
                     darray_push(resource_data->stages, SHADER_STAGE_GEOMETRY);
                 }
-                else if(string_equali(stage_names[i], "comp") || string_equali(stage_names[i], "compute"))
+                else if(string_view_equali(stage_name, "comp") || string_view_equali(stage_name, "compute"))
                 {
                     darray_push(resource_data->stages, SHADER_STAGE_COMPUTE);
                 }
                 else
                 {
-                    kerror("Function '%s': Invalid file layout. Unrecognized stage '%s'", __FUNCTION__, stage_names[i]);
+                    kerror("Function '%s': Invalid file layout. Unrecognized stage '%s'", __FUNCTION__, stage_name_str);
                 }
             }
+
+            if(resource_data->stage_count == 0)
+            {
+                resource_data->stage_count = count;
+            }
+            else if(resource_data->stage_count != count)
+            {
+                kerror(
+                    "Function '%s': Invalid file layout. Count mismatch between stage names and stage filenames.",
+                    __FUNCTION__
+                );
+            }
         }
-        else if(string_equali(trimmed_var_name, "stagefiles"))
+        else if(string_view_equali(var_name, "stagefiles"))
         {
-            u32 count = string_split(trimmed_value, ',', true, true, &resource_data->stage_filenames);
+            kstring_view stage_filename;
+            u32 count = 0;
+
+            while(string_view_split_next(&value, ',', &stage_filename))
+            {
+                darray_push(resource_data->stage_filenames, string_view_duplicate(string_view_trim(stage_filename)));
+                count++;
+            }
 
             if(resource_data->stage_count == 0)
             {
@@ -155,25 +191,34 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
                 );
             }
         }
-        else if(string_equali(trimmed_var_name, "cull_mode"))
+        else if(string_view_equali(var_name, "bindless_stagefiles"))
+        {
+            // NOTE: Необязательные стадии для массива текстур без привязки, порядок как у 'stagefiles'.
+            kstring_view stage_filename;
+            while(string_view_split_next(&value, ',', &stage_filename))
+            {
+                darray_push(resource_data->bindless_stage_filenames, string_view_duplicate(string_view_trim(stage_filename)));
+            }
+        }
+        else if(string_view_equali(var_name, "cull_mode"))
         {
-            if(string_equali(trimmed_value, "front"))
+            if(string_view_equali(value, "front"))
             {
                 resource_data->cull_mode = FACE_CULL_MODE_FRONT;
             }
-            else if(string_equali(trimmed_value, "front_and_back"))
+            else if(string_view_equali(value, "front_and_back"))
             {
                 resource_data->cull_mode = FACE_CULL_MODE_FRONT_AND_BACK;
             }
-            else if(string_equali(trimmed_value, "none"))
+            else if(string_view_equali(value, "none"))
             {
                 resource_data->cull_mode = FACE_CULL_MODE_NONE;
             }
         }
-        else if(string_equali(trimmed_var_name, "attribute"))
+        else if(string_view_equali(var_name, "attribute") || string_view_equali(var_name, "instance_attribute"))
         {
-            char** fields = darray_create(char*);
-            u32 filed_count = string_split(trimmed_value, ',', true, true, &fields);
+            kstring_view fields[2];
+            u32 filed_count = shader_loader_split_fields(value, 2, fields);
 
             if(filed_count != 2)
             {
@@ -185,53 +230,59 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
             else
             {
                 shader_attribute_config attribute;
+                attribute.per_instance = string_view_equali(var_name, "instance_attribute");
 
-                if(string_equali(fields[0], "f32"))
+                if(string_view_equali(fields[0], "f32"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_FLOAT32;
                     attribute.size = 4;
                 }
-                else if(string_equali(fields[0], "vec2"))
+                else if(string_view_equali(fields[0], "vec2"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_FLOAT32_2;
                     attribute.size = 8;
                 }
-                else if(string_equali(fields[0], "vec3"))
+                else if(string_view_equali(fields[0], "vec3"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_FLOAT32_3;
                     attribute.size = 12;
                 }
-                else if(string_equali(fields[0], "vec4"))
+                else if(string_view_equali(fields[0], "vec4"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_FLOAT32_4;
                     attribute.size = 16;
                 }
-                else if(string_equali(fields[0], "u8"))
+                else if(string_view_equali(fields[0], "mat4"))
+                {
+                    attribute.type = SHADER_ATTRIB_TYPE_MATRIX_4;
+                    attribute.size = 64;
+                }
+                else if(string_view_equali(fields[0], "u8"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_UINT8;
                     attribute.size = 1;
                 }
-                else if(string_equali(fields[0], "u16"))
+                else if(string_view_equali(fields[0], "u16"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_UINT16;
                     attribute.size = 2;
                 }
-                else if(string_equali(fields[0], "u32"))
+                else if(string_view_equali(fields[0], "u32"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_UINT32;
                     attribute.size = 4;
                 }
-                else if(string_equali(fields[0], "i8"))
+                else if(string_view_equali(fields[0], "i8"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_INT8;
                     attribute.size = 1;
                 }
-                else if(string_equali(fields[0], "i16"))
+                else if(string_view_equali(fields[0], "i16"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_INT16;
                     attribute.size = 2;
                 }
-                else if(string_equali(fields[0], "i32"))
+                else if(string_view_equali(fields[0], "i32"))
                 {
                     attribute.type = SHADER_ATTRIB_TYPE_INT32;
                     attribute.size = 4;
@@ -239,7 +290,7 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
                 else
                 {
                     kerror(
-                        "Function '%s': Invalid file layout. Attribute type must be f32, vec2, vec3, vec4, i8, i16, i32, u8, u16, or u32.",
+                        "Function '%s': Invalid file layout. Attribute type must be f32, vec2, vec3, vec4, mat4, i8, i16, i32, u8, u16, or u32.",
                         __FUNCTION__
                     );
 
@@ -249,19 +300,16 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
                     attribute.size = 4;
                 }
 
-                attribute.name = string_duplicate(fields[1]);
+                attribute.name = string_view_duplicate(fields[1]);
 
                 darray_push(resource_data->attributes, attribute);
                 resource_data->attribute_count++;
             }
-
-            string_cleanup_split_array(fields);
-            darray_destroy(fields);
         }
-        else if(string_equali(trimmed_var_name, "uniform"))
+        else if(string_view_equali(var_name, "uniform"))
         {
-            char** fields = darray_create(char*);
-            u32 field_count = string_split(trimmed_value, ',', true, true, &fields);
+            kstring_view fields[3];
+            u32 field_count = shader_loader_split_fields(value, 3, fields);
 
             if (field_count != 3)
             {
@@ -274,62 +322,62 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
             {
                 shader_uniform_config uniform;
 
-                if(string_equali(fields[0], "f32"))
+                if(string_view_equali(fields[0], "f32"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_FLOAT32;
                     uniform.size = 4;
                 }
-                else if(string_equali(fields[0], "vec2"))
+                else if(string_view_equali(fields[0], "vec2"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_FLOAT32_2;
                     uniform.size = 8;
                 }
-                else if(string_equali(fields[0], "vec3"))
+                else if(string_view_equali(fields[0], "vec3"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_FLOAT32_3;
                     uniform.size = 12;
                 }
-                else if(string_equali(fields[0], "vec4"))
+                else if(string_view_equali(fields[0], "vec4"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_FLOAT32_4;
                     uniform.size = 16;
                 }
-                else if(string_equali(fields[0], "u8"))
+                else if(string_view_equali(fields[0], "u8"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_UINT8;
                     uniform.size = 1;
                 }
-                else if(string_equali(fields[0], "u16"))
+                else if(string_view_equali(fields[0], "u16"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_UINT16;
                     uniform.size = 2;
                 }
-                else if(string_equali(fields[0], "u32"))
+                else if(string_view_equali(fields[0], "u32"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_UINT32;
                     uniform.size = 4;
                 }
-                else if(string_equali(fields[0], "i8"))
+                else if(string_view_equali(fields[0], "i8"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_INT8;
                     uniform.size = 1;
                 }
-                else if(string_equali(fields[0], "i16"))
+                else if(string_view_equali(fields[0], "i16"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_INT16;
                     uniform.size = 2;
                 }
-                else if(string_equali(fields[0], "i32"))
+                else if(string_view_equali(fields[0], "i32"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_INT32;
                     uniform.size = 4;
                 }
-                else if(string_equali(fields[0], "mat4"))
+                else if(string_view_equali(fields[0], "mat4"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_MATRIX_4;
                     uniform.size = 64;
                 }
-                else if(string_equali(fields[0], "samp") || string_equali(fields[0], "sampler"))
+                else if(string_view_equali(fields[0], "samp") || string_view_equali(fields[0], "sampler"))
                 {
                     uniform.type = SHADER_UNIFORM_TYPE_SAMPLER;
                     uniform.size = 0; // У сэмплера нет размера.
@@ -347,15 +395,15 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
                     uniform.size = 4;
                 }
 
-                if(string_equal(fields[1], "0"))
+                if(string_view_equal(fields[1], "0"))
                 {
                     uniform.scope = SHADER_SCOPE_GLOBAL;
                 }
-                else if(string_equal(fields[1], "1"))
+                else if(string_view_equal(fields[1], "1"))
                 {
                     uniform.scope = SHADER_SCOPE_INSTANCE;
                 }
-                else if(string_equal(fields[1], "2"))
+                else if(string_view_equal(fields[1], "2"))
                 {
                     uniform.scope = SHADER_SCOPE_LOCAL;
                 }
@@ -370,23 +418,17 @@ bool shader_loader_load(resource_loader* self, const char* name, void* params, r
                     uniform.scope = SHADER_SCOPE_GLOBAL;
                 }
 
-                uniform.name = string_duplicate(fields[2]);
+                uniform.name = string_view_duplicate(fields[2]);
 
                 darray_push(resource_data->uniforms, uniform);
                 resource_data->uniform_count++;
             }
-
-            string_cleanup_split_array(fields);
-            darray_destroy(fields);
         }
 
         // TODO: Сделать больше полей.
-
-        kzero_tc(bufferline, char, 512);
-        line_number++;
     }
 
-    platform_file_close(f);
+    resource_system_file_close(&f);
 
     out_resource->data = resource_data;
     out_resource->data_size = sizeof(shader_config);
@@ -400,6 +442,9 @@ void shader_loader_unload(struct resource_loader* self, resource* resource)
     string_cleanup_split_array(data->stage_filenames);
     darray_destroy(data->stage_filenames);
 
+    string_cleanup_split_array(data->bindless_stage_filenames);
+    darray_destroy(data->bindless_stage_filenames);
+
     string_cleanup_split_array(data->stage_names);
     darray_destroy(data->stage_names);
 
@@ -432,6 +477,8 @@ resource_loader shader_resource_loader_create()
     loader.load = shader_loader_load;
     loader.unload = shader_loader_unload;
     loader.type_path = "shaders";
+    loader.extensions = shader_extensions;
+    loader.extension_count = 1;
 
     return loader;
 }
@@ -0,0 +1,272 @@
+// Собственные подключения.
+#include "resources/pak.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "kstring.h"
+#include "memory/memory.h"
+
+// Побайтное сравнение строк (для сортировки и двоичного поиска по индексу).
+static i32 pak_name_compare(const char* lstr, const char* rstr)
+{
+    while(*lstr && *lstr == *rstr)
+    {
+        lstr++;
+        rstr++;
+    }
+
+    return (i32)(u8)*lstr - (i32)(u8)*rstr;
+}
+
+bool pak_open(const char* path, pak* out_pak)
+{
+    if(!path || !out_pak)
+    {
+        kerror("Function '%s' requires a valid pointer to path and out_pak.", __FUNCTION__);
+        return false;
+    }
+
+    kzero_tc(out_pak, pak, 1);
+
+    if(!platform_file_map(path, &out_pak->mapping))
+    {
+        return false;
+    }
+
+    const u8* data = out_pak->mapping.data;
+    u64 size = out_pak->mapping.size;
+    const pak_header* header = (const pak_header*)data;
+
+    if(size < sizeof(pak_header) || header->magic != PAK_MAGIC || header->version != PAK_VERSION)
+    {
+        kerror("Function '%s': File '%s' is not a resource archive or has unsupported version.", __FUNCTION__, path);
+        pak_close(out_pak);
+        return false;
+    }
+
+    u64 index_size = (u64)header->entry_count * sizeof(pak_entry);
+    if(header->index_offset + index_size > size || header->names_offset > size)
+    {
+        kerror("Function '%s': Resource archive '%s' is truncated.", __FUNCTION__, path);
+        pak_close(out_pak);
+        return false;
+    }
+
+    out_pak->entry_count = header->entry_count;
+    out_pak->entries = (const pak_entry*)(data + header->index_offset);
+    out_pak->names = (const char*)(data + header->names_offset);
+
+    // Проверка границ записей, чтобы в дальнейшем поиск не требовал проверок.
+    for(u32 i = 0; i < out_pak->entry_count; ++i)
+    {
+        const pak_entry* entry = &out_pak->entries[i];
+        u64 name_end = header->names_offset + entry->name_offset + entry->name_length;
+
+        if(name_end >= size || out_pak->names[entry->name_offset + entry->name_length] != '\0'
+        || entry->data_offset + entry->data_size > size)
+        {
+            kerror("Function '%s': Resource archive '%s' has invalid entry %u.", __FUNCTION__, path, i);
+            pak_close(out_pak);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void pak_close(pak* pak)
+{
+    if(!pak)
+    {
+        kerror("Function '%s' requires a valid pointer to pak.", __FUNCTION__);
+        return;
+    }
+
+    if(pak->mapping.data)
+    {
+        platform_file_unmap(&pak->mapping);
+    }
+
+    kzero_tc(pak, struct pak, 1);
+}
+
+bool pak_find(const pak* pak, const char* name, const void** out_data, u64* out_size)
+{
+    if(!pak || !name || !pak->entry_count)
+    {
+        return false;
+    }
+
+    // Двоичный поиск по отсортированному индексу.
+    u32 low = 0;
+    u32 high = pak->entry_count;
+
+    while(low < high)
+    {
+        u32 middle = low + (high - low) / 2;
+        const pak_entry* entry = &pak->entries[middle];
+        i32 result = pak_name_compare(&pak->names[entry->name_offset], name);
+
+        if(result == 0)
+        {
+            if(out_data)
+            {
+                *out_data = (const u8*)pak->mapping.data + entry->data_offset;
+            }
+
+            if(out_size)
+            {
+                *out_size = entry->data_size;
+            }
+
+            return true;
+        }
+
+        if(result < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return false;
+}
+
+bool pak_write(const char* path, u32 file_count, const char** names, const char** paths)
+{
+    if(!path || !file_count || !names || !paths)
+    {
+        kerror("Function '%s' requires a valid pointer to path, names, paths and file count greater than zero.", __FUNCTION__);
+        return false;
+    }
+
+    // Сортировка порядка записей по именам (вставками, файлов немного).
+    u32* order = kallocate_tc(u32, file_count, MEMORY_TAG_ARRAY);
+    for(u32 i = 0; i < file_count; ++i)
+    {
+        u32 current = i;
+        u32 j = i;
+
+        while(j > 0 && pak_name_compare(names[order[j - 1]], names[current]) > 0)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+
+        order[j] = current;
+    }
+
+    for(u32 i = 1; i < file_count; ++i)
+    {
+        if(pak_name_compare(names[order[i - 1]], names[order[i]]) == 0)
+        {
+            kerror("Function '%s': Duplicate entry name '%s'.", __FUNCTION__, names[order[i]]);
+            kfree(order, MEMORY_TAG_ARRAY);
+            return false;
+        }
+    }
+
+    // Отображение упаковываемых файлов и расчет размещения.
+    file_mapping* mappings = kallocate_tc(file_mapping, file_count, MEMORY_TAG_ARRAY);
+    pak_entry* entries = kallocate_tc(pak_entry, file_count, MEMORY_TAG_ARRAY);
+    kzero_tc(mappings, file_mapping, file_count);
+
+    u64 names_size = 0;
+    bool result = true;
+
+    for(u32 i = 0; i < file_count; ++i)
+    {
+        const char* name = names[order[i]];
+
+        if(!platform_file_map(paths[order[i]], &mappings[i]))
+        {
+            kerror("Function '%s': Unable to read file '%s'.", __FUNCTION__, paths[order[i]]);
+            result = false;
+            break;
+        }
+
+        entries[i].name_offset = names_size;
+        entries[i].name_length = string_length(name);
+        entries[i].data_size = mappings[i].size;
+        names_size += entries[i].name_length + 1;
+    }
+
+    pak_header header = {};
+    header.magic = PAK_MAGIC;
+    header.version = PAK_VERSION;
+    header.entry_count = file_count;
+    header.index_offset = sizeof(pak_header);
+    header.names_offset = header.index_offset + sizeof(pak_entry) * file_count;
+
+    u64 data_offset = header.names_offset + names_size;
+    for(u32 i = 0; result && i < file_count; ++i)
+    {
+        data_offset = get_aligned(data_offset, PAK_DATA_ALIGNMENT);
+        entries[i].data_offset = data_offset;
+        data_offset += entries[i].data_size;
+    }
+
+    // Запись архива.
+    file* f = null;
+    if(result && !platform_file_open(path, FILE_MODE_WRITE | FILE_MODE_BINARY, &f))
+    {
+        kerror("Function '%s': Cannot open file '%s' for binary writing.", __FUNCTION__, path);
+        result = false;
+    }
+
+    if(result)
+    {
+        const u8 padding[PAK_DATA_ALIGNMENT] = {};
+        u64 offset = 0;
+
+        result = platform_file_write(f, sizeof(pak_header), &header)
+              && platform_file_write(f, sizeof(pak_entry) * file_count, entries);
+        offset = header.names_offset;
+
+        for(u32 i = 0; result && i < file_count; ++i)
+        {
+            result = platform_file_write(f, entries[i].name_length + 1, names[order[i]]);
+        }
+        offset += names_size;
+
+        for(u32 i = 0; result && i < file_count; ++i)
+        {
+            u64 padding_size = entries[i].data_offset - offset;
+            if(padding_size)
+            {
+                result = platform_file_write(f, padding_size, padding);
+            }
+
+            // NOTE: Пустые файлы занимают в архиве только запись индекса.
+            if(entries[i].data_size)
+            {
+                result = result && platform_file_write(f, entries[i].data_size, mappings[i].data);
+            }
+            offset = entries[i].data_offset + entries[i].data_size;
+        }
+
+        platform_file_close(f);
+
+        if(!result)
+        {
+            kerror("Function '%s': Failed to write resource archive '%s'.", __FUNCTION__, path);
+        }
+    }
+
+    for(u32 i = 0; i < file_count; ++i)
+    {
+        if(mappings[i].data)
+        {
+            platform_file_unmap(&mappings[i]);
+        }
+    }
+
+    kfree(entries, MEMORY_TAG_ARRAY);
+    kfree(mappings, MEMORY_TAG_ARRAY);
+    kfree(order, MEMORY_TAG_ARRAY);
+
+    return result;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <defines.h>
+#include <platform/file.h>
+
+// @brief Сигнатура файла архива ресурсов ('KPAK').
+#define PAK_MAGIC 0x4B41504BU
+
+// @brief Текущая версия формата архива ресурсов.
+#define PAK_VERSION 1
+
+// @brief Выравнивание данных записей архива в байтах.
+#define PAK_DATA_ALIGNMENT 16
+
+/*
+    Формат архива ресурсов (все значения little-endian):
+      [pak_header]
+      [pak_entry * entry_count] - индекс, отсортированный по именам записей.
+      [имена записей]           - строки с завершающим нулем, например "textures/paving.png".
+      [данные записей]          - каждая запись выровнена по PAK_DATA_ALIGNMENT.
+*/
+
+// @brief Заголовок архива ресурсов.
+typedef struct pak_header {
+    // @brief Сигнатура архива (PAK_MAGIC).
+    u32 magic;
+    // @brief Версия формата архива.
+    u32 version;
+    // @brief Количество записей архива.
+    u32 entry_count;
+    // @brief Зарезервировано, должно быть равно нулю.
+    u32 reserved;
+    // @brief Смещение индекса записей от начала файла.
+    u64 index_offset;
+    // @brief Смещение блока имен записей от начала файла.
+    u64 names_offset;
+} pak_header;
+
+// @brief Запись индекса архива ресурсов.
+typedef struct pak_entry {
+    // @brief Смещение имени записи от начала блока имен.
+    u32 name_offset;
+    // @brief Длина имени записи без завершающего нуля.
+    u32 name_length;
+    // @brief Смещение данных записи от начала файла.
+    u64 data_offset;
+    // @brief Размер данных записи в байтах.
+    u64 data_size;
+} pak_entry;
+
+// @brief Открытый архив ресурсов.
+typedef struct pak {
+    // @brief Отображение файла архива в память.
+    file_mapping mapping;
+    // @brief Количество записей архива.
+    u32 entry_count;
+    // @brief Указатель на индекс записей (внутри отображения).
+    const pak_entry* entries;
+    // @brief Указатель на блок имен записей (внутри отображения).
+    const char* names;
+} pak;
+
+/*
+    @brief Открывает архив ресурсов, отображая его в память целиком.
+    @param path Указатель на строку пути к файлу архива.
+    @param out_pak Указатель на память для сохранения открытого архива.
+    @return True архив открыт успешно, false файл не найден или поврежден.
+*/
+KAPI bool pak_open(const char* path, pak* out_pak);
+
+/*
+    @brief Закрывает архив ресурсов.
+    NOTE: Все полученные из архива указатели на данные становятся недействительными.
+    @param pak Указатель на открытый архив.
+*/
+KAPI void pak_close(pak* pak);
+
+/*
+    @brief Ищет запись архива по имени (двоичный поиск по индексу).
+    @param pak Указатель на открытый архив.
+    @param name Указатель на строку имени записи, например "textures/paving.png".
+    @param out_data Указатель на память для сохранения указателя на данные записи, может быть null.
+    @param out_size Указатель на память для сохранения размера данных записи, может быть null.
+    @return True запись найдена, false не найдена.
+*/
+KAPI bool pak_find(const pak* pak, const char* name, const void** out_data, u64* out_size);
+
+/*
+    @brief Создает архив ресурсов из указанных файлов.
+    @param path Указатель на строку пути к создаваемому файлу архива.
+    @param file_count Количество упаковываемых файлов.
+    @param names Указатель на массив имен записей архива (уникальные).
+    @param paths Указатель на массив путей к упаковываемым файлам (соответствует массиву имен).
+    @return True архив создан успешно, false не удалось создать.
+*/
+KAPI bool pak_write(const char* path, u32 file_count, const char** names, const char** paths);
@@ -6,6 +6,7 @@
 #define TEXTURE_NAME_MAX_LENGTH 512
 #define MATERIAL_NAME_MAX_LENGTH 256
 #define GEOMETRY_NAME_MAX_LENGTH 256
+#define GEOMETRY_LOD_MAX_COUNT 4
 
 typedef enum resource_type {
     RESOURCE_TYPE_TEXT,
@@ -145,6 +146,14 @@ typedef struct material {
     u32 render_frame_number;
 } material;
 
+// @brief Уровень детализации геометрии: диапазон общего буфера индексов.
+typedef struct geometry_lod {
+    // @brief Смещение первого индекса уровня (в индексах).
+    u32 index_offset;
+    // @brief Количество индексов уровня.
+    u32 index_count;
+} geometry_lod;
+
 typedef struct geometry {
     // @brief Идентификатор геометрии.
     u32 id;
@@ -160,6 +169,18 @@ typedef struct geometry {
     char name[GEOMETRY_NAME_MAX_LENGTH];
     // @brief Используемый материал геометрии.
     material* material;
+    // @brief Количество уровней детализации (0 - геометрия рисуется целиком).
+    u8 lod_count;
+    // @brief Уровни детализации, 0 - самый подробный.
+    geometry_lod lods[GEOMETRY_LOD_MAX_COUNT];
+    // @brief Количество вершин окклюдера.
+    u32 occluder_vertex_count;
+    // @brief Позиции вершин окклюдера (локальные, null - окклюдера нет).
+    vec3* occluder_vertices;
+    // @brief Количество индексов окклюдера.
+    u32 occluder_index_count;
+    // @brief Индексы треугольников окклюдера.
+    u32* occluder_indices;
 } geometry;
 
 // @brief Объединяет в себе геометрии как единый объект.
@@ -170,8 +191,8 @@ typedef struct mesh {
     u16 geometry_count;
     // @brief Массив указателей на геометрии.
     geometry** geometries;
-    // @brief Массив преобразований над сеткой геометрий из локальных в мировые.
-    transform transform;
+    // @brief Идентификатор преобразования сетки геометрий из локальных в мировые (см. transform_system).
+    u32 transform_id;
 } mesh;
 
 typedef struct skybox {
@@ -240,6 +261,8 @@ typedef struct shader_attribute_config {
     u8 size;
     // @brief Тип данных атрибута.
     shader_attribute_type type;
+    // @brief Указывает, что атрибут читается из буфера экземпляров (один раз на экземпляр, а не на вершину).
+    bool per_instance;
 } shader_attribute_config;
 
 // @brief Конфигурация uniform переменой.
@@ -280,4 +303,6 @@ typedef struct shader_config {
     char** stage_names;
     // @brief Массив файлов стадий которые будут загружаться (используется darray).
     char** stage_filenames;
+    // @brief Массив файлов стадий для режима текстур без привязки (используется darray, может быть пустым).
+    char** bindless_stage_filenames;
 } shader_config;
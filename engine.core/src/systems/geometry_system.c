@@ -191,6 +191,11 @@ void geometry_system_config_dispose(geometry_config* config)
         kfree(config->indices, MEMORY_TAG_ARRAY);
     }
 
+    if(config->occluder_indices)
+    {
+        kfree(config->occluder_indices, MEMORY_TAG_ARRAY);
+    }
+
     kzero_tc(config, geometry_config, 1);
 }
 
@@ -351,6 +356,69 @@ bool geometry_create(geometry_config* config, geometry* g)
     g->center = config->center;
     g->extents = config->extents;
 
+    // Уровни детализации: некорректные диапазоны сводятся к одному уровню из всех индексов.
+    g->lod_count = 0;
+    if(config->lod_count > 0 && config->lod_count <= GEOMETRY_LOD_MAX_COUNT)
+    {
+        g->lod_count = config->lod_count;
+        for(u8 i = 0; i < config->lod_count; ++i)
+        {
+            const geometry_lod* lod = &config->lods[i];
+            if(!lod->index_count || lod->index_count % 3 != 0 || lod->index_offset + lod->index_count > config->index_count)
+            {
+                kwarng("Function '%s': Invalid lod %u of geometry '%s'. Ignoring lods.", __FUNCTION__, i, config->name);
+                g->lod_count = 0;
+                break;
+            }
+            g->lods[i] = *lod;
+        }
+    }
+
+    // Окклюдер: только используемые им вершины, сжатые в отдельный массив позиций.
+    g->occluder_vertex_count = 0;
+    g->occluder_vertices = null;
+    g->occluder_index_count = 0;
+    g->occluder_indices = null;
+    if(config->occluder_index_count && config->occluder_indices && config->vertex_size == sizeof(vertex_3d))
+    {
+        const vertex_3d* vertices = config->vertices;
+        u32* remap = kallocate_tc(u32, config->vertex_count, MEMORY_TAG_ARRAY);
+        kset_tc(remap, u32, config->vertex_count, 0xff);
+
+        g->occluder_index_count = config->occluder_index_count;
+        g->occluder_indices = kallocate_tc(u32, g->occluder_index_count, MEMORY_TAG_ARRAY);
+        g->occluder_vertices = kallocate_tc(vec3, g->occluder_index_count, MEMORY_TAG_ARRAY);
+
+        for(u32 i = 0; i < g->occluder_index_count; ++i)
+        {
+            u32 index = config->occluder_indices[i];
+            if(index >= config->vertex_count)
+            {
+                kwarng("Function '%s': Invalid occluder of geometry '%s'. Ignoring occluder.", __FUNCTION__, config->name);
+                g->occluder_index_count = 0;
+                break;
+            }
+
+            if(remap[index] == INVALID_ID)
+            {
+                remap[index] = g->occluder_vertex_count;
+                g->occluder_vertices[g->occluder_vertex_count++] = vertices[index].position;
+            }
+            g->occluder_indices[i] = remap[index];
+        }
+
+        kfree(remap, MEMORY_TAG_ARRAY);
+
+        if(!g->occluder_index_count)
+        {
+            kfree(g->occluder_indices, MEMORY_TAG_ARRAY);
+            kfree(g->occluder_vertices, MEMORY_TAG_ARRAY);
+            g->occluder_indices = null;
+            g->occluder_vertices = null;
+            g->occluder_vertex_count = 0;
+        }
+    }
+
     if(string_length(config->material_name) > 0)
     {
         g->material = material_system_acquire(config->material_name);
@@ -369,6 +437,17 @@ void geometry_destroy(geometry* g)
     // Уничтожение геометрии в памяти графического процессора.
     renderer_geometry_destroy(g);
 
+    if(g->occluder_vertices)
+    {
+        kfree(g->occluder_vertices, MEMORY_TAG_ARRAY);
+        kfree(g->occluder_indices, MEMORY_TAG_ARRAY);
+    }
+
+    g->occluder_vertex_count = 0;
+    g->occluder_vertices = null;
+    g->occluder_index_count = 0;
+    g->occluder_indices = null;
+
     g->id = INVALID_ID;
     g->internal_id = INVALID_ID;
     g->generation = INVALID_ID_U16;
@@ -547,6 +626,7 @@ geometry_config geometry_system_generate_cube_config(
     }
 
     geometry_config config;
+    kzero_tc(&config, geometry_config, 1);
     config.vertex_size = sizeof(vertex_3d);
     config.vertex_count = 4 * 6;
     config.vertices = kallocate_tc(vertex_3d, config.vertex_count, MEMORY_TAG_ARRAY);
@@ -695,5 +775,10 @@ geometry_config geometry_system_generate_cube_config(
 
     geometry_generate_tangent(config.vertex_count, config.vertices, config.index_count, config.indices);
 
+    // NOTE: Грани куба совпадают с его поверхностью, поэтому окклюдер - все треугольники.
+    config.occluder_index_count = config.index_count;
+    config.occluder_indices = kallocate_tc(u32, config.occluder_index_count, MEMORY_TAG_ARRAY);
+    kcopy_tc(config.occluder_indices, config.indices, u32, config.occluder_index_count);
+
     return config;
 }
@@ -18,8 +18,17 @@ typedef struct geometry_config {
     u32 vertex_count;
     void* vertices;
     u32 index_size;
+    // @brief Общее количество индексов всех уровней детализации.
     u32 index_count;
     void* indices;
+    // @brief Количество уровней детализации (0 - один уровень из всех индексов).
+    u8 lod_count;
+    // @brief Диапазоны индексов уровней детализации.
+    geometry_lod lods[GEOMETRY_LOD_MAX_COUNT];
+    // @brief Количество индексов окклюдера (0 - геометрия не перекрывает другие).
+    u32 occluder_index_count;
+    // @brief Индексы треугольников окклюдера (в массиве вершин геометрии, смотри geometry_generate_occluder).
+    u32* occluder_indices;
     vec3 center;
     extents_3d extents;
     char name[GEOMETRY_NAME_MAX_LENGTH];
@@ -3,10 +3,12 @@
 
 // Внутренние подключения.
 #include "logger.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "containers/ring_queue.h"
 #include "kmutex.h"
 #include "kthread.h"
+#include "ksemaphore.h"
 
 // Представляет рабочий поток для выполнения заданий.
 typedef struct job_thread {
@@ -18,6 +20,8 @@ typedef struct job_thread {
     job job;
     // Контекст мьютекса для доступа к данным задания.
     mutex job_mutex;
+    // Семафор для пробуждения потока при появлении работы.
+    semaphore wake_semaphore;
     // Тип заданий для этого потока (можно комбинировать).
     job_type type_mask;
 } job_thread;
@@ -36,6 +40,35 @@ typedef struct job_result_entry {
 
 #define MAX_JOB_RESULTS 512
 
+// Максимальное время ожидания сигнала простаивающим потоком заданий (в миллисекундах).
+#define JOB_THREAD_IDLE_TIMEOUT_MS 10
+
+// Состояния параллельного цикла.
+#define PARALLEL_FOR_IDLE    0
+#define PARALLEL_FOR_RUNNING 1
+#define PARALLEL_FOR_BUSY    2
+
+// Максимальное количество одновременно выполняемых (в том числе вложенных) параллельных циклов.
+#define PARALLEL_FOR_MAX_COUNT 4
+
+// Представляет выполняемый параллельный цикл.
+typedef struct job_parallel_for {
+    // Функция обработки части.
+    PFN_job_parallel_for func;
+    // Данные для функции обработки.
+    void* context;
+    // Количество элементов.
+    u32 count;
+    // Количество элементов в одной части.
+    u32 batch_size;
+    // Начало следующей необработанной части (атомарно).
+    u64 next;
+    // Состояние цикла PARALLEL_FOR_* (атомарно).
+    u32 active;
+    // Количество потоков заданий, участвующих в цикле (атомарно).
+    u32 helpers;
+} job_parallel_for;
+
 // Контекст системы заданий.
 typedef struct job_system_state {
     // Флаг состояния системы.
@@ -44,6 +77,8 @@ typedef struct job_system_state {
     u8 thread_count;
     // Потоки для выполнения заданий.
     job_thread job_threads[32];
+    // Количество еще не завершившихся потоков заданий (атомарно).
+    u32 live_thread_count;
     // Очереди.
     ring_queue* low_priority_queue;
     ring_queue* norm_priority_queue;
@@ -56,6 +91,8 @@ typedef struct job_system_state {
     job_result_entry pending_results[MAX_JOB_RESULTS];
     // Мьютекс для поступа к результатам заданий.
     mutex result_mutex;
+    // Параллельные циклы: вложенный цикл (например, внутри части внешнего) занимает следующий свободный слот.
+    job_parallel_for parallel_fors[PARALLEL_FOR_MAX_COUNT];
 } job_system_state;
 
 static job_system_state* state_ptr = null;
@@ -116,17 +153,67 @@ void store_result(PFN_job_on_complete callback, void* params, u32 param_size)
     
 }
 
+// Обрабатывает части параллельного цикла, пока они не закончатся.
+static void parallel_for_run_batches(job_parallel_for* pf)
+{
+    while(true)
+    {
+        u64 begin = __atomic_fetch_add(&pf->next, pf->batch_size, __ATOMIC_ACQ_REL);
+        if(begin >= pf->count) break;
+
+        u64 end = begin + pf->batch_size;
+        pf->func(pf->context, (u32)begin, end < pf->count ? (u32)end : pf->count);
+    }
+}
+
+// Подключает поток заданий к выполняемому параллельному циклу.
+static void parallel_for_help(job_parallel_for* pf)
+{
+    // NOTE: Счетчик увеличивается до проверки состояния, поэтому вызывающий поток дождется выхода этого потока,
+    //       а вне состояния PARALLEL_FOR_RUNNING данные цикла не используются.
+    __atomic_add_fetch(&pf->helpers, 1, __ATOMIC_SEQ_CST);
+
+    if(__atomic_load_n(&pf->active, __ATOMIC_SEQ_CST) == PARALLEL_FOR_RUNNING)
+    {
+        parallel_for_run_batches(pf);
+    }
+
+    __atomic_sub_fetch(&pf->helpers, 1, __ATOMIC_SEQ_CST);
+}
+
+/*
+    @brief Находит выполняемый параллельный цикл, которому нужна помощь.
+    NOTE: Поиск идет с последнего слота: вложенные циклы занимают слоты позже внешних, и их завершения
+          ждут части внешних циклов.
+    @return Указатель на цикл, null если выполняемых циклов нет.
+*/
+static job_parallel_for* parallel_for_find_running()
+{
+    for(u32 i = PARALLEL_FOR_MAX_COUNT; i > 0; --i)
+    {
+        job_parallel_for* pf = &state_ptr->parallel_fors[i - 1];
+        if(__atomic_load_n(&pf->active, __ATOMIC_ACQUIRE) == PARALLEL_FOR_RUNNING)
+        {
+            return pf;
+        }
+    }
+    return null;
+}
+
 // Выполняет ровно одну задачу поставленную в очередь.
 u32 job_thread_run(void* params)
 {
     u32 index = *((u32*)params);
-    job_thread* thread = &state_ptr->job_threads[index];
+    // NOTE: Указатель на систему сохраняется, чтобы сообщить о завершении потока и после обнуления state_ptr.
+    job_system_state* state = state_ptr;
+    job_thread* thread = &state->job_threads[index];
     u64 thread_id = thread->thread.thread_id;
     ktrace("Starting job thread #%i (id=%#x, type=%#x).", thread->index, thread_id, thread->type_mask);
 
     if(!kmutex_create(&thread->job_mutex))
     {
         kerror("Function '%s' failed to create job thread mutex! Aborting thread.");
+        __atomic_sub_fetch(&state->live_thread_count, 1, __ATOMIC_RELEASE);
         return 0;
     }
 
@@ -153,7 +240,9 @@ u32 job_thread_run(void* params)
 
         if(job.entry_point)
         {
+            KPROFILE_BEGIN("job");
             bool result = job.entry_point(job.param_data, job.result_data);
+            KPROFILE_END();
 
             // Сохранение результата.
             if(result && job.on_success)
@@ -191,14 +280,26 @@ u32 job_thread_run(void* params)
             }
         }
 
+        // Участие в параллельном цикле кадра.
+        job_parallel_for* pf = (thread->type_mask & JOB_TYPE_GENERAL) ? parallel_for_find_running() : null;
+        if(pf)
+        {
+            parallel_for_help(pf);
+            continue;
+        }
+
         if(state_ptr->running)
         {
-            // TODO: Другой сбособ: блокировка потока, до момента как будет записана задача, после чего послан сигнал на разблокировку!
-            kthread_sleep(&thread->thread, 10);
+            // NOTE: Поток пробуждается сигналом при назначении задания, запуске параллельного цикла или завершении
+            //       работы системы, ограничение времени ожидания только страхует от пропущенного сигнала.
+            ksemaphore_wait(&thread->wake_semaphore, JOB_THREAD_IDLE_TIMEOUT_MS);
         }
     }
 
     kmutex_destroy(&thread->job_mutex);
+
+    // NOTE: Последнее обращение к памяти системы, после него память может быть освобождена.
+    __atomic_sub_fetch(&state->live_thread_count, 1, __ATOMIC_RELEASE);
     return 1;
 }
 
@@ -250,13 +351,23 @@ bool job_system_initialize(u64* memory_requirement, void* memory, job_system_con
     kdebug("Spawning %i job threads.", state_ptr->thread_count);
 
     // Создание потоков для выполнения задач.
+    __atomic_store_n(&state_ptr->live_thread_count, state_ptr->thread_count, __ATOMIC_RELEASE);
     for(u8 i = 0; i < state_ptr->thread_count; ++i)
     {
         state_ptr->job_threads[i].index = i;
         state_ptr->job_threads[i].type_mask = config->type_masks[i];
 
+        // NOTE: Семафор создается до запуска потока, т.к. сигнал может быть отправлен сразу после его создания.
+        if(!ksemaphore_create(0, &state_ptr->job_threads[i].wake_semaphore))
+        {
+            __atomic_sub_fetch(&state_ptr->live_thread_count, state_ptr->thread_count - i, __ATOMIC_RELEASE);
+            kerror("Function '%s' failed creating job thread semaphore.", __FUNCTION__);
+            return false;
+        }
+
         if(!kthread_create(job_thread_run, &state_ptr->job_threads[i].index, false, &state_ptr->job_threads[i].thread))
         {
+            __atomic_sub_fetch(&state_ptr->live_thread_count, state_ptr->thread_count - i, __ATOMIC_RELEASE);
             kerror("Function '%s' failed creating job thread.", __FUNCTION__);
             return false;
         }
@@ -299,9 +410,22 @@ void job_system_shutdown()
     state_ptr->running = false;
     u64 thread_count = state_ptr->thread_count;
 
+    for(u8 i = 0; i < thread_count; ++i)
+    {
+        ksemaphore_signal(&state_ptr->job_threads[i].wake_semaphore);
+    }
+
+    // Ожидание выхода потоков из цикла заданий: отмена потока посреди цикла могла оставить его
+    // работающим с уже освобожденной памятью системы.
+    while(__atomic_load_n(&state_ptr->live_thread_count, __ATOMIC_ACQUIRE) > 0)
+    {
+        kthread_sleep(null, 1);
+    }
+
     for(u8 i = 0; i < thread_count; ++i)
     {
         kthread_destroy(&state_ptr->job_threads[i].thread);
+        ksemaphore_destroy(&state_ptr->job_threads[i].wake_semaphore);
     }
 
     ring_queue_destroy(state_ptr->low_priority_queue);
@@ -362,7 +486,11 @@ void process_queue(ring_queue* queue, mutex* queue_mutex)
             }
 
             // Что бы небыло дедлока, принудительный выход из цикла вынесен.
-            if(thread_fount) break;
+            if(thread_fount)
+            {
+                ksemaphore_signal(&thread->wake_semaphore);
+                break;
+            }
         }
 
         // Выход из цикла обработки, т.к. заданий на выполнения не осталось.
@@ -373,6 +501,7 @@ void process_queue(ring_queue* queue, mutex* queue_mutex)
 void job_system_update()
 {
     if(!system_status_valid(__FUNCTION__) || !state_ptr->running) return;
+    KPROFILE_FUNCTION();
 
     process_queue(state_ptr->high_priority_queue, &state_ptr->high_pri_queue_mutex);
     process_queue(state_ptr->norm_priority_queue, &state_ptr->norm_pri_queue_mutex);
@@ -456,7 +585,11 @@ void job_system_submit(job* job)
                     kerror("Failed to release lock on job thread mutex!");
                 }
 
-                if(found) return;
+                if(found)
+                {
+                    ksemaphore_signal(&thread->wake_semaphore);
+                    return;
+                }
             }
         }
     }
@@ -519,3 +652,66 @@ job job_create(
 
     return job;
 }
+
+void job_system_parallel_for(u32 count, u32 batch_size, PFN_job_parallel_for func, void* context)
+{
+    if(!func || !count) return;
+
+    if(!batch_size)
+    {
+        batch_size = count;
+    }
+
+    // Одна часть или недоступная система: обработка в вызывающем потоке.
+    if(count <= batch_size || !state_ptr || !state_ptr->running)
+    {
+        func(context, 0, count);
+        return;
+    }
+
+    // Захват свободного слота, при их отсутствии цикл обрабатывается в вызывающем потоке.
+    job_parallel_for* pf = null;
+    for(u32 i = 0; i < PARALLEL_FOR_MAX_COUNT && !pf; ++i)
+    {
+        u32 expected = PARALLEL_FOR_IDLE;
+        if(__atomic_compare_exchange_n(&state_ptr->parallel_fors[i].active, &expected, PARALLEL_FOR_BUSY, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            pf = &state_ptr->parallel_fors[i];
+        }
+    }
+
+    if(!pf)
+    {
+        func(context, 0, count);
+        return;
+    }
+
+    pf->func = func;
+    pf->context = context;
+    pf->count = count;
+    pf->batch_size = batch_size;
+    __atomic_store_n(&pf->next, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&pf->active, PARALLEL_FOR_RUNNING, __ATOMIC_SEQ_CST);
+
+    // Пробуждение простаивающих потоков: одну часть обрабатывает вызывающий поток.
+    u32 wake_count = (count + batch_size - 1) / batch_size - 1;
+    for(u8 i = 0; i < state_ptr->thread_count && wake_count > 0; ++i)
+    {
+        job_thread* thread = &state_ptr->job_threads[i];
+        if((thread->type_mask & JOB_TYPE_GENERAL) == 0) continue;
+
+        ksemaphore_signal(&thread->wake_semaphore);
+        wake_count--;
+    }
+
+    parallel_for_run_batches(pf);
+
+    // Все части розданы, ожидание потоков, которые еще обрабатывают свои части.
+    __atomic_store_n(&pf->active, PARALLEL_FOR_BUSY, __ATOMIC_SEQ_CST);
+    // NOTE: Помощники дорабатывают не больше одной части, поэтому ожидание короткое и поток только уступает квант.
+    while(__atomic_load_n(&pf->helpers, __ATOMIC_SEQ_CST))
+    {
+        kthread_yield();
+    }
+    __atomic_store_n(&pf->active, PARALLEL_FOR_IDLE, __ATOMIC_RELEASE);
+}
@@ -8,6 +8,9 @@ typedef bool (*PFN_job_entry)(void*, void*);
 // @brief Определения указателя функции для события завершения задания.
 typedef void (*PFN_job_on_complete)(void*) ;
 
+// @brief Определение указателя функции для обработки диапазона [begin, end) параллельного цикла.
+typedef void (*PFN_job_parallel_for)(void* context, u32 begin, u32 end);
+
 // @brief Тип задания.
 typedef enum job_type {
 
@@ -111,6 +114,20 @@ void job_system_update();
 */
 KAPI void job_system_submit(job* job);
 
+/*
+    @brief Синхронно обрабатывает диапазон [0, count) частями, распределяя их между вызывающим потоком и
+           свободными потоками заданий общего типа. Возвращает управление после обработки всех частей.
+    NOTE: Вызывающий поток обрабатывает части наравне с остальными, поэтому результат не зависит от
+          занятости потоков заданий. Допускаются вложенные вызовы из функции обработки части (например,
+          построение пакета представления, которое само делит работу на части). Если система не инициализирована
+          или заняты все слоты параллельных циклов, весь диапазон обрабатывается в вызывающем потоке.
+    @param count Количество элементов.
+    @param batch_size Количество элементов в одной части.
+    @param func Указатель на функцию обработки части (может вызываться из разных потоков одновременно).
+    @param context Указатель на данные для передачи в функцию обработки.
+*/
+KAPI void job_system_parallel_for(u32 count, u32 batch_size, PFN_job_parallel_for func, void* context);
+
 /*
     @brief Создает новое задание с указанием типа и приоритета.
     @param type Тип задания. Используется для определения того, в каком потоке выполняется задание.
@@ -21,7 +21,6 @@ typedef struct material_shader_uniform_locations {
     u16 diffuse_texture;
     u16 specular_texture;
     u16 normal_texture;
-    u16 model;
     u16 render_mode;
 } material_shader_uniform_locations;
 
@@ -139,7 +138,6 @@ bool material_system_initialize(u64* memory_requirement, void* memory, material_
     state_ptr->material_locations.diffuse_texture = INVALID_ID_U16;
     state_ptr->material_locations.specular_texture = INVALID_ID_U16;
     state_ptr->material_locations.normal_texture = INVALID_ID_U16;
-    state_ptr->material_locations.model = INVALID_ID_U16;
     state_ptr->material_locations.render_mode = INVALID_ID_U16;
 
     state_ptr->ui_shader_id = INVALID_ID;
@@ -304,7 +302,6 @@ material* material_system_acquire_from_config(material_config* config)
             state_ptr->material_locations.diffuse_texture = shader_system_uniform_index(s, "diffuse_texture");
             state_ptr->material_locations.specular_texture = shader_system_uniform_index(s, "specular_texture");
             state_ptr->material_locations.normal_texture = shader_system_uniform_index(s, "normal_texture");
-            state_ptr->material_locations.model = shader_system_uniform_index(s, "model");
             state_ptr->material_locations.render_mode = shader_system_uniform_index(s, "mode");
         }
         else if(state_ptr->ui_shader_id == INVALID_ID && string_equal(config->shader_name, BUILTIN_SHADER_NAME_UI))
@@ -461,6 +458,12 @@ bool material_system_apply_instance(material* m, bool needs_update)
         return null;
     }
 
+    // Экземпляр уже привязан и его uniform переменные не изменились.
+    if(!needs_update && shader_system_instance_is_applied(m->internal_id))
+    {
+        return true;
+    }
+
     MATERIAL_APPLY_OR_FAIL(shader_system_bind_instance(m->internal_id));
 
     if(needs_update)
@@ -498,7 +501,9 @@ bool material_system_apply_local(material* m, const mat4* model)
 
     if(m->shader_id == state_ptr->material_shader_id)
     {
-        return shader_system_uniform_set_by_index(state_ptr->material_locations.model, model);
+        // NOTE: Шейдер материалов получает матрицу модели как атрибут экземпляра (см. renderer_geometry_draw_instanced).
+        kerror("Function '%s': World shader uses per-instance model matrices.", __FUNCTION__);
+        return false;
     }
     else if(m->shader_id == state_ptr->ui_shader_id)
     {
@@ -509,6 +514,18 @@ bool material_system_apply_local(material* m, const mat4* model)
     return false;
 }
 
+bool material_system_apply_draw(material* m, const mat4* model)
+{
+    if(!material_system_status_valid(__FUNCTION__))
+    {
+        return false;
+    }
+
+    // NOTE: Индекс материала - идентификатор экземпляра шейдера, он же индекс элемента буфера материалов
+    //       в режиме текстур без привязки.
+    return shader_system_draw_constants_push(model, m->internal_id);
+}
+
 bool default_materials_create()
 {
     kzero_tc(&state_ptr->default_material, material, 1);
@@ -76,6 +76,7 @@ bool material_system_apply_global(
 
 /*
     @brief Применяет данные материала на уровне экземпляра для предоставленного материала.
+    NOTE: Если материал уже привязан и обновление не требуется, привязка пропускается.
     @param m Указатель на материал для которого нужно применить данные.
     @param needs_update Указывает, на необходимость обновить material или связать его.
     @return True в случае успеха, false если есть ошибки.
@@ -89,3 +90,13 @@ bool material_system_apply_instance(material* m, bool needs_update);
     @return True в случае успеха, false если есть ошибки.
 */
 bool material_system_apply_local(material* m, const mat4* model);
+
+/*
+    @brief Записывает push-константы отрисовки: матрицу модели и индекс материала (идентификатор экземпляра шейдера).
+    NOTE: Быстрый путь для цикла отрисовки, не выполняет поиск uniform переменных. Шейдер материала
+          должен быть используемым в данный момент.
+    @param m Указатель на материал, индекс которого будет применен.
+    @param model Указатель на матрицу модели, null если шейдер получает ее иначе (например, как атрибут экземпляра).
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool material_system_apply_draw(material* m, const mat4* model);
@@ -4,8 +4,10 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "kstring.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
 #include "containers/hashtable.h"
+#include "systems/job_system.h"
 #include "renderer/renderer_frontend.h"
 
 // TODO: Временно - сделать фабрику и регистрировать вместо этого.
@@ -13,6 +15,15 @@
 #include "renderer/views/render_view_ui.h"
 #include "renderer/views/render_view_skybox.h"
 
+// Контекст параллельного построения пакетов представлений.
+typedef struct render_view_system_build_context {
+    render_view** views;
+    void** data;
+    render_view_packet* out_packets;
+    // Количество пакетов, которые не удалось построить (атомарно).
+    u32 failed_count;
+} render_view_system_build_context;
+
 typedef struct render_view_system_state {
     render_view_system_config config;
     render_view* views;
@@ -250,9 +261,50 @@ bool render_view_system_build_packet(const render_view* view, void* data, render
         return false;
     }
 
+    KPROFILE_FUNCTION();
     return view->on_build_packet(view, data, out_packet);
 }
 
+static void render_view_system_build_packets_range(void* context, u32 begin, u32 end)
+{
+    render_view_system_build_context* ctx = context;
+
+    for(u32 i = begin; i < end; ++i)
+    {
+        if(!render_view_system_build_packet(ctx->views[i], ctx->data[i], &ctx->out_packets[i]))
+        {
+            kerror("Function '%s': Failed to build packet for view '%s'.", __FUNCTION__, ctx->views[i]->name);
+            __atomic_add_fetch(&ctx->failed_count, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+bool render_view_system_build_packets(u32 count, render_view** views, void** data, render_view_packet* out_packets)
+{
+    if(!system_status_valid(__FUNCTION__)) return false;
+
+    if(!views || !data || !out_packets)
+    {
+        kerror("Function '%s' requires valid pointers to views, data and packets.", __FUNCTION__);
+        return false;
+    }
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        if(!views[i])
+        {
+            kerror("Function '%s': View at index %u is null.", __FUNCTION__, i);
+            return false;
+        }
+    }
+
+    KPROFILE_FUNCTION();
+    render_view_system_build_context context = { views, data, out_packets, 0 };
+    job_system_parallel_for(count, 1, render_view_system_build_packets_range, &context);
+
+    return __atomic_load_n(&context.failed_count, __ATOMIC_ACQUIRE) == 0;
+}
+
 bool render_view_system_on_render(const render_view* view, render_view_packet* packet, u64 frame_number, u64 render_target_index)
 {
     if(!system_status_valid(__FUNCTION__)) return false;
@@ -263,5 +315,6 @@ bool render_view_system_on_render(const render_view* view, render_view_packet* p
         return false;
     }
 
+    KPROFILE_FUNCTION();
     return view->on_render(view, packet, frame_number, render_target_index);
 }
@@ -20,4 +20,18 @@ render_view* render_view_system_get(const char* name);
 
 bool render_view_system_build_packet(const render_view* view, void* data, render_view_packet* out_packet);
 
+/*
+    @brief Строит пакеты нескольких представлений параллельно с помощью системы заданий и возвращает
+           управление после построения всех пакетов.
+    NOTE: Каждое представление строится отдельной частью параллельного цикла, представления могут сами делить
+          работу на части (вложенные циклы). Функции построения не должны изменять общие данные, например
+          ленивые матрицы камер нужно вычислить заранее.
+    @param count Количество представлений.
+    @param views Массив указателей на представления.
+    @param data Массив указателей на данные представлений.
+    @param out_packets Массив пакетов для заполнения (по одному на представление).
+    @return True если все пакеты построены, false если хотя бы один не удалось построить.
+*/
+bool render_view_system_build_packets(u32 count, render_view** views, void** data, render_view_packet* out_packets);
+
 bool render_view_system_on_render(const render_view* view, render_view_packet* packet, u64 frame_number, u64 render_target_index);
@@ -4,7 +4,11 @@
 // Внутренние подключения.
 #include "logger.h"
 #include "kstring.h"
+#include "debug/profiler.h"
 #include "memory/memory.h"
+#include "resources/pak.h"
+#include "containers/darray.h"
+#include "platform/mutex.h"
 
 // Известые загрузчики ресурсов.
 #include "resources/loaders/image_loader.h"
@@ -14,9 +18,47 @@
 #include "resources/loaders/shader_loader.h"
 #include "resources/loaders/mesh_loader.h"
 
+// Запись индекса ресурсов: имя ресурса загрузчика и путь его файла.
+typedef struct resource_index_entry {
+    // Идентификатор загрузчика.
+    u32 loader_id;
+    // Индекс расширения файла в списке расширений загрузчика (меньше - выше приоритет).
+    u32 extension_index;
+    // Смещение имени ресурса (путь относительно каталога загрузчика без расширения), например "paving".
+    u32 name;
+    // Смещение пути файла относительно каталога ресурсов, например "textures/paving.png".
+    u32 path;
+} resource_index_entry;
+
+// Индекс ресурсов архива и каталога ресурсов по именам ресурсов загрузчиков с расширениями файлов.
+typedef struct resource_index {
+    // Строки имен и путей с завершающим нулем, подряд (darray).
+    char* strings;
+    // Записи, отсортированные по загрузчику, имени и приоритету расширения (darray).
+    resource_index_entry* entries;
+} resource_index;
+
+// Контекст обхода каталога при построении индекса.
+typedef struct resource_index_scan_context {
+    resource_index* index;
+    file_watch* watch;
+    // Полный путь к текущему каталогу.
+    const char* directory_path;
+    // Путь к текущему каталогу относительно каталога ресурсов ("" для корня).
+    const char* relative_path;
+} resource_index_scan_context;
+
 typedef struct resource_system_state {
     resource_system_config config;
     resource_loader* loaders;
+    // Архив ресурсов (используется если has_pak = true).
+    pak pak;
+    bool has_pak;
+    // Индекс файлов каталога ресурсов и его защита (загрузчики работают в потоках задач).
+    resource_index index;
+    mutex index_mutex;
+    // Наблюдение за каталогом ресурсов (null если отключено).
+    file_watch* watch;
 } resource_system_state;
 
 static resource_system_state* state_ptr = null;
@@ -24,6 +66,10 @@ static const char* message_not_initialized =
     "Function '%s' requires the resource system to be initialized. Call 'resource_system_initialize' first.";
 
 bool load(const char* name, resource_loader* loader, void* params, resource* out_resource);
+static void resource_index_build(resource_index* index, file_watch* watch);
+static void resource_index_refresh();
+static void resource_index_destroy(resource_index* index);
+static const resource_index_entry* resource_index_find(const resource_index* index, u32 loader_id, const char* name);
 
 bool resource_system_initialize(u64* memory_requirement, void* memory, resource_system_config* config)
 {
@@ -61,6 +107,8 @@ bool resource_system_initialize(u64* memory_requirement, void* memory, resource_
     // Запись данных конфигурации системы.
     state_ptr->config.max_loader_count = config->max_loader_count;
     state_ptr->config.asset_base_path = config->asset_base_path;
+    state_ptr->config.asset_pak_path = config->asset_pak_path;
+    state_ptr->config.watch_asset_changes = config->watch_asset_changes;
 
     // Получение и запись указателя на блок загрузчиков.
     void* loaders_block = (void*)((u8*)state_ptr + state_requirement);
@@ -72,6 +120,23 @@ bool resource_system_initialize(u64* memory_requirement, void* memory, resource_
         state_ptr->loaders[i].id = INVALID_ID;
     }
 
+    // Архив ресурсов не обязателен: при его отсутствии файлы читаются из каталога ресурсов.
+    if(config->asset_pak_path && platform_file_exists(config->asset_pak_path))
+    {
+        state_ptr->has_pak = pak_open(config->asset_pak_path, &state_ptr->pak);
+
+        if(state_ptr->has_pak)
+        {
+            kinfor("Resource archive '%s' mounted (%u entries).", config->asset_pak_path, state_ptr->pak.entry_count);
+        }
+    }
+
+    if(!platform_mutex_create(&state_ptr->index_mutex))
+    {
+        kerror("Function '%s': Failed to create index mutex.", __FUNCTION__);
+        return false;
+    }
+
     // NOTE: Автоматическая регистрация известных типов загрузчиков здесь.
     resource_system_register_loader(image_resource_loader_create());
     resource_system_register_loader(material_resource_loader_create());
@@ -80,6 +145,17 @@ bool resource_system_initialize(u64* memory_requirement, void* memory, resource_
     resource_system_register_loader(shader_resource_loader_create());
     resource_system_register_loader(mesh_resource_loader_create());
 
+    if(config->watch_asset_changes && !platform_file_watch_create(&state_ptr->watch))
+    {
+        kwarng("Function '%s': Asset directory changes will not be tracked.", __FUNCTION__);
+        state_ptr->watch = null;
+    }
+
+    // Однократный обход каталога ресурсов после регистрации загрузчиков (индекс строится по их расширениям):
+    // дальнейшие поиски файлов не обращаются к файловой системе.
+    resource_index_build(&state_ptr->index, state_ptr->watch);
+    kinfor("Resource index of '%s' built (%llu resources).", config->asset_base_path, darray_length(state_ptr->index.entries));
+
     return true;
 }
 
@@ -91,11 +167,41 @@ void resource_system_shutdown()
         return;
     }
 
-    // NOTE: Нечего уничтожать.
+    if(state_ptr->has_pak)
+    {
+        pak_close(&state_ptr->pak);
+        state_ptr->has_pak = false;
+    }
+
+    if(state_ptr->watch)
+    {
+        platform_file_watch_destroy(state_ptr->watch);
+        state_ptr->watch = null;
+    }
+
+    resource_index_destroy(&state_ptr->index);
+    platform_mutex_destroy(&state_ptr->index_mutex);
 
     state_ptr = null;
 }
 
+void resource_system_update()
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return;
+    }
+
+    KPROFILE_FUNCTION();
+    if(!state_ptr->watch || !platform_file_watch_poll(state_ptr->watch))
+    {
+        return;
+    }
+
+    resource_index_refresh();
+}
+
 KAPI bool resource_system_register_loader(resource_loader loader)
 {
     if(!state_ptr)
@@ -142,6 +248,13 @@ KAPI bool resource_system_register_loader(resource_loader loader)
 
     *empty_slot = loader; // Копирование структуры!
     empty_slot->id = empty_slot_id;
+
+    // Загрузчик, зарегистрированный после построения индекса, должен находить свои файлы.
+    if(loader.extension_count && state_ptr->index.entries)
+    {
+        resource_index_refresh();
+    }
+
     return true;
 }
 
@@ -225,6 +338,122 @@ KAPI const char* resource_system_base_path()
     return state_ptr->config.asset_base_path;
 }
 
+KAPI bool resource_system_file_resolve(
+    const resource_loader* loader, const char* name, u64 path_size, char* out_path, u32* out_extension_index
+)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return false;
+    }
+
+    if(!loader || !name || !out_path || !path_size)
+    {
+        kerror("Function '%s' requires a valid pointer to loader, name and out_path.", __FUNCTION__);
+        return false;
+    }
+
+    platform_mutex_lock(&state_ptr->index_mutex);
+
+    const resource_index_entry* entry = resource_index_find(&state_ptr->index, loader->id, name);
+    if(entry)
+    {
+        string_format(out_path, path_size, "%s", &state_ptr->index.strings[entry->path]);
+        if(out_extension_index)
+        {
+            *out_extension_index = entry->extension_index;
+        }
+    }
+
+    platform_mutex_unlock(&state_ptr->index_mutex);
+    return entry != null;
+}
+
+KAPI bool resource_system_file_open(const char* path, resource_file* out_file)
+{
+    if(!state_ptr)
+    {
+        kerror(message_not_initialized, __FUNCTION__);
+        return false;
+    }
+
+    if(!path || !out_file)
+    {
+        kerror("Function '%s' requires a valid pointer to path and out_file.", __FUNCTION__);
+        return false;
+    }
+
+    kzero_tc(out_file, resource_file, 1);
+
+    // Данные из архива используются напрямую, архив отображен в память целиком.
+    const void* data = null;
+    if(state_ptr->has_pak && pak_find(&state_ptr->pak, path, &data, &out_file->size))
+    {
+        out_file->data = data;
+        return true;
+    }
+
+    char full_path[512];
+    string_format(full_path, 512, "%s/%s", state_ptr->config.asset_base_path, path);
+
+    if(!platform_file_map(full_path, &out_file->mapping))
+    {
+        return false;
+    }
+
+    out_file->data = out_file->mapping.data;
+    out_file->size = out_file->mapping.size;
+    return true;
+}
+
+KAPI void resource_system_file_close(resource_file* file)
+{
+    if(!file)
+    {
+        kerror("Function '%s' requires a valid pointer to file.", __FUNCTION__);
+        return;
+    }
+
+    if(file->mapping.data)
+    {
+        platform_file_unmap(&file->mapping);
+    }
+
+    kzero_tc(file, resource_file, 1);
+}
+
+KAPI bool resource_system_file_read_line(resource_file* file, u64 buffer_size, char* buffer, u64* out_length)
+{
+    if(!file || !buffer || buffer_size < 2)
+    {
+        kerror("Function '%s' requires a valid pointer to file, buffer and buffer size greater then one.", __FUNCTION__);
+        return false;
+    }
+
+    if(file->offset >= file->size)
+    {
+        return false;
+    }
+
+    // Копирование до конца строки включительно (как fgets), с учетом размера буфера.
+    u64 length = 0;
+    while(length < buffer_size - 1 && file->offset < file->size)
+    {
+        char c = file->data[file->offset++];
+        buffer[length++] = c;
+
+        if(c == '\n')
+        {
+            break;
+        }
+    }
+
+    buffer[length] = '\0';
+    *out_length = length;
+    return true;
+}
+
 bool load(const char* name, resource_loader* loader, void* params, resource* out_resource)
 {
     if(!name || !loader || !out_resource)
@@ -237,3 +466,257 @@ bool load(const char* name, resource_loader* loader, void* params, resource* out
     out_resource->loader_id = loader->id;
     return loader->load(loader, name, params, out_resource);
 }
+
+// Побайтное сравнение строк (порядок совпадает с порядком индекса архива ресурсов).
+static i32 resource_index_compare(const char* lstr, const char* rstr)
+{
+    while(*lstr && *lstr == *rstr)
+    {
+        lstr++;
+        rstr++;
+    }
+
+    return (i32)(u8)*lstr - (i32)(u8)*rstr;
+}
+
+// Сравнивает ключ записи (загрузчик и имя ресурса) с заданным.
+static i32 resource_index_key_compare(const resource_index* index, const resource_index_entry* entry, u32 loader_id, const char* name)
+{
+    if(entry->loader_id != loader_id)
+    {
+        return entry->loader_id < loader_id ? -1 : 1;
+    }
+
+    return resource_index_compare(&index->strings[entry->name], name);
+}
+
+static u32 resource_index_push_string(resource_index* index, const char* str, u64 length)
+{
+    u32 offset = darray_length(index->strings);
+
+    for(u64 i = 0; i < length; ++i)
+    {
+        darray_push(index->strings, str[i]);
+    }
+    darray_push(index->strings, (char)'\0');
+
+    return offset;
+}
+
+// Добавляет файл в индекс для каждого загрузчика, в каталоге и с расширением которого он находится.
+static void resource_index_add(resource_index* index, const char* path)
+{
+    u64 path_length = string_length(path);
+
+    for(u32 i = 0; i < state_ptr->config.max_loader_count; ++i)
+    {
+        resource_loader* l = &state_ptr->loaders[i];
+        if(l->id == INVALID_ID || !l->extension_count)
+        {
+            continue;
+        }
+
+        // Путь относительно каталога загрузчика.
+        const char* relative = path;
+        u64 type_path_length = string_length(l->type_path);
+        if(type_path_length)
+        {
+            if(path_length <= type_path_length || path[type_path_length] != '/'
+            || !string_nequal(path, l->type_path, type_path_length))
+            {
+                continue;
+            }
+            relative = &path[type_path_length + 1];
+        }
+
+        u64 relative_length = path_length - (relative - path);
+        for(u32 j = 0; j < l->extension_count; ++j)
+        {
+            u64 extension_length = string_length(l->extensions[j]);
+            if(relative_length <= extension_length
+            || !string_equal(&relative[relative_length - extension_length], l->extensions[j]))
+            {
+                continue;
+            }
+
+            resource_index_entry entry;
+            entry.loader_id = l->id;
+            entry.extension_index = j;
+            entry.name = resource_index_push_string(index, relative, relative_length - extension_length);
+            entry.path = resource_index_push_string(index, path, path_length);
+            darray_push(index->entries, entry);
+            break;
+        }
+    }
+}
+
+static bool resource_index_scan_entry(const char* name, directory_entry_type type, void* user_data)
+{
+    resource_index_scan_context* context = user_data;
+
+    char relative_path[512];
+    if(context->relative_path[0])
+    {
+        string_format(relative_path, 512, "%s/%s", context->relative_path, name);
+    }
+    else
+    {
+        string_format(relative_path, 512, "%s", name);
+    }
+
+    if(type == DIRECTORY_ENTRY_TYPE_DIRECTORY)
+    {
+        char directory_path[512];
+        string_format(directory_path, 512, "%s/%s", context->directory_path, name);
+
+        resource_index_scan_context nested = *context;
+        nested.directory_path = directory_path;
+        nested.relative_path = relative_path;
+
+        if(nested.watch)
+        {
+            platform_file_watch_add(nested.watch, directory_path);
+        }
+
+        platform_directory_list(directory_path, resource_index_scan_entry, &nested);
+        return true;
+    }
+
+    resource_index_add(context->index, relative_path);
+    return true;
+}
+
+static void resource_index_build(resource_index* index, file_watch* watch)
+{
+    index->strings = darray_reserve(char, 4096);
+    index->entries = darray_reserve(resource_index_entry, 256);
+
+    // NOTE: Файлы архива и каталога с одинаковым путем дают одинаковые записи, открывается файл архива.
+    if(state_ptr->has_pak)
+    {
+        for(u32 i = 0; i < state_ptr->pak.entry_count; ++i)
+        {
+            resource_index_add(index, &state_ptr->pak.names[state_ptr->pak.entries[i].name_offset]);
+        }
+    }
+
+    resource_index_scan_context context;
+    context.index = index;
+    context.watch = watch;
+    context.directory_path = state_ptr->config.asset_base_path;
+    context.relative_path = "";
+
+    if(watch)
+    {
+        platform_file_watch_add(watch, context.directory_path);
+    }
+
+    platform_directory_list(context.directory_path, resource_index_scan_entry, &context);
+
+    // Сортировка Шелла по загрузчику, имени и приоритету расширения, для двоичного поиска.
+    resource_index_entry* entries = index->entries;
+    u32 count = darray_length(entries);
+
+    for(u32 gap = count / 2; gap > 0; gap /= 2)
+    {
+        for(u32 i = gap; i < count; ++i)
+        {
+            resource_index_entry current = entries[i];
+            u32 j = i;
+
+            while(j >= gap)
+            {
+                const resource_index_entry* prev = &entries[j - gap];
+                i32 result = resource_index_key_compare(index, prev, current.loader_id, &index->strings[current.name]);
+                if(result < 0 || (result == 0 && prev->extension_index <= current.extension_index))
+                {
+                    break;
+                }
+
+                entries[j] = entries[j - gap];
+                j -= gap;
+            }
+
+            entries[j] = current;
+        }
+    }
+}
+
+// Перестраивает индекс и заменяет им текущий (загрузчики в потоках задач продолжают работать с индексом).
+static void resource_index_refresh()
+{
+    // NOTE: Новые каталоги тоже должны наблюдаться, поэтому наблюдение пересоздается вместе с индексом.
+    file_watch* watch = null;
+    if(state_ptr->watch && !platform_file_watch_create(&watch))
+    {
+        watch = null;
+    }
+
+    resource_index index = {};
+    resource_index_build(&index, watch);
+
+    platform_mutex_lock(&state_ptr->index_mutex);
+    resource_index old_index = state_ptr->index;
+    state_ptr->index = index;
+    platform_mutex_unlock(&state_ptr->index_mutex);
+
+    resource_index_destroy(&old_index);
+    if(state_ptr->watch)
+    {
+        platform_file_watch_destroy(state_ptr->watch);
+    }
+    state_ptr->watch = watch;
+
+    ktrace("Resource index of '%s' refreshed (%llu resources).", state_ptr->config.asset_base_path, darray_length(index.entries));
+}
+
+static void resource_index_destroy(resource_index* index)
+{
+    if(index->strings)
+    {
+        darray_destroy(index->strings);
+    }
+
+    if(index->entries)
+    {
+        darray_destroy(index->entries);
+    }
+
+    index->strings = null;
+    index->entries = null;
+}
+
+// Возвращает запись ресурса с расширением наибольшего приоритета или null.
+static const resource_index_entry* resource_index_find(const resource_index* index, u32 loader_id, const char* name)
+{
+    if(!index->entries)
+    {
+        return null;
+    }
+
+    // Нижняя граница ключа: первая из записей ресурса имеет наименьший индекс расширения.
+    u32 low = 0;
+    u32 count = darray_length(index->entries);
+    u32 high = count;
+
+    while(low < high)
+    {
+        u32 middle = low + (high - low) / 2;
+
+        if(resource_index_key_compare(index, &index->entries[middle], loader_id, name) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if(low < count && resource_index_key_compare(index, &index->entries[low], loader_id, name) == 0)
+    {
+        return &index->entries[low];
+    }
+
+    return null;
+}
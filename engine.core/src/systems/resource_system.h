@@ -2,17 +2,38 @@
 
 #include <defines.h>
 #include <resources/resource_types.h>
+#include <platform/file.h>
 
 typedef struct resource_system_config {
     u32 max_loader_count;
     char* asset_base_path;
+    // @brief Путь к архиву ресурсов (pak), null если используются только файлы каталога ресурсов.
+    const char* asset_pak_path;
+    // @brief Отслеживать создание и удаление файлов в каталоге ресурсов (обновляет индекс файлов).
+    bool watch_asset_changes;
 } resource_system_config;
 
+// @brief Файл ресурса, полученный через виртуальную файловую систему ресурсов (только для чтения).
+typedef struct resource_file {
+    // @brief Указатель на данные файла.
+    const u8* data;
+    // @brief Размер данных файла в байтах.
+    u64 size;
+    // @brief Текущая позиция построчного чтения.
+    u64 offset;
+    // @brief Отображение отдельного файла (если данные получены не из архива).
+    file_mapping mapping;
+} resource_file;
+
 typedef struct resource_loader {
     u32 id;
     resource_type type;
     const char* custom_type;
     const char* type_path;
+    // @brief Расширения файлов ресурсов в порядке приоритета (статический массив), null если имя ресурса - путь файла.
+    const char** extensions;
+    // @brief Количество расширений файлов ресурсов.
+    u32 extension_count;
     bool (*load)(struct resource_loader* self, const char* name, void* params, resource* out_resource);
     void (*unload)(struct resource_loader* self, resource* resource);
 } resource_loader;
@@ -25,6 +46,12 @@ bool resource_system_initialize(u64* memory_requirement, void* memory, resource_
 */
 void resource_system_shutdown();
 
+/*
+    @brief Обновляет индекс файлов каталога ресурсов, если в каталоге были созданы или удалены файлы.
+    NOTE: Вызывается один раз за кадр из основного потока.
+*/
+void resource_system_update();
+
 /*
 */
 KAPI bool resource_system_register_loader(resource_loader loader);
@@ -45,3 +72,43 @@ KAPI void resource_system_unload(resource* resource);
 /*
 */
 KAPI const char* resource_system_base_path();
+
+/*
+    @brief Находит файл ресурса загрузчика по имени ресурса одним поиском в индексе ресурсов.
+    NOTE: Индекс строится по каталогам и расширениям загрузчиков при инициализации и изменении каталога ресурсов
+          и не обращается к файловой системе. Из файлов с одинаковым именем выбирается расширение наибольшего приоритета.
+    @param loader Указатель на загрузчик ресурса с расширениями файлов.
+    @param name Указатель на строку имени ресурса относительно каталога загрузчика, например "paving".
+    @param path_size Размер буфера пути в байтах.
+    @param out_path Указатель на буфер для сохранения пути относительно каталога ресурсов, например "textures/paving.png".
+    @param out_extension_index Указатель на память для сохранения индекса расширения файла (может быть null).
+    @return True файл найден, false не найден ни с одним из расширений.
+*/
+KAPI bool resource_system_file_resolve(
+    const resource_loader* loader, const char* name, u64 path_size, char* out_path, u32* out_extension_index
+);
+
+/*
+    @brief Открывает файл ресурса: сначала ищет в архиве ресурсов, затем в каталоге ресурсов.
+    NOTE: Данные не копируются, а указывают на отображенную в память область архива или файла.
+    @param path Указатель на строку пути относительно каталога ресурсов, например "textures/paving.png".
+    @param out_file Указатель на память для сохранения открытого файла.
+    @return True файл открыт успешно, false не найден.
+*/
+KAPI bool resource_system_file_open(const char* path, resource_file* out_file);
+
+/*
+    @brief Закрывает файл ресурса, открытый с помощью 'resource_system_file_open'.
+    @param file Указатель на открытый файл ресурса.
+*/
+KAPI void resource_system_file_close(resource_file* file);
+
+/*
+    @brief Читает очередную текстовую строку из файла ресурса (аналог 'platform_file_read_line').
+    @param file Указатель на открытый файл ресурса.
+    @param buffer_size Размер буфера и максимально возможное количество считываемых символов.
+    @param buffer Указатель на буфер, куда будет записана строка.
+    @param out_length Указатель на память, куда будет записано количество прочитаных символов.
+    @return True успешно считано, false достигнут конец файла.
+*/
+KAPI bool resource_system_file_read_line(resource_file* file, u64 buffer_size, char* buffer, u64* out_length);
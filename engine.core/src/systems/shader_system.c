@@ -19,6 +19,8 @@ typedef struct shader_system_state {
     hashtable* lookup;
     // @brief Идентификатор текущего связаного шейдера.
     u32 bound_shader_id;
+    // @brief Идентификатор экземпляра, uniform переменные которого применены (привязаны) в текущем кадре.
+    u32 applied_instance_id;
     // @brief Массив шейдеров.
     shader* shaders;
 } shader_system_state;
@@ -30,6 +32,7 @@ u32 get_shader_id(const char* shader_name);
 bool add_attribute(shader* shader, shader_attribute_config* config);
 bool add_sampler(shader* shader, shader_uniform_config* config);
 bool add_uniform(shader* shader, shader_uniform_config* config);
+u16 draw_constant_index(shader* shader, const char* uniform_name);
 bool uniform_add(shader* shader, const char* uniform_name, u32 size, shader_uniform_type type, shader_scope scope, u32 set_location, bool is_sampler);
 bool uniform_add_state_valid(shader* shader);
 bool uniform_name_valid(shader* shader, const char* uniform_name);
@@ -102,6 +105,7 @@ bool shader_system_initialize(u64* memory_requirement, void* memory, shader_syst
 
     state_ptr->config = *config;
     state_ptr->bound_shader_id = INVALID_ID;
+    state_ptr->applied_instance_id = INVALID_ID;
 
     // Помечает шейдеры как свободные (неиспользуемые).
     for(u32 i = 0; i < state_ptr->config.max_shader_count; ++i)
@@ -223,6 +227,10 @@ bool shader_system_create(const shader_config* config)
         }
     }
 
+    // Локальные uniform переменные, которые записываются быстрым путем в цикле отрисовки.
+    shader->draw_model_index = draw_constant_index(shader, "model");
+    shader->draw_material_index = draw_constant_index(shader, "material_index");
+
     if(!renderer_shader_initialize(shader))
     {
         kerror("Function '%s': Failed to initialize shader '%s'.", __FUNCTION__, shader->name);
@@ -329,6 +337,7 @@ bool shader_system_use_by_id(u32 shader_id)
     {
         shader* next_shader = shader_system_get_by_id(shader_id);
         state_ptr->bound_shader_id = shader_id;
+        state_ptr->applied_instance_id = INVALID_ID;
 
         if(!renderer_shader_use(next_shader))
         {
@@ -440,7 +449,46 @@ bool shader_system_apply_instance(bool needs_update)
         return false;
     }
 
-    return renderer_shader_apply_instance(&state_ptr->shaders[state_ptr->bound_shader_id], needs_update);
+    shader* s = &state_ptr->shaders[state_ptr->bound_shader_id];
+    if(!renderer_shader_apply_instance(s, needs_update))
+    {
+        state_ptr->applied_instance_id = INVALID_ID;
+        return false;
+    }
+
+    state_ptr->applied_instance_id = s->bound_instance_id;
+    return true;
+}
+
+bool shader_system_draw_constants_push(const mat4* model, u32 material_index)
+{
+    if(!shader_system_status_valid(__FUNCTION__))
+    {
+        return false;
+    }
+
+    return renderer_shader_push_draw_constants(&state_ptr->shaders[state_ptr->bound_shader_id], model, material_index);
+}
+
+bool shader_system_instance_is_applied(u32 instance_id)
+{
+    if(!shader_system_status_valid(__FUNCTION__))
+    {
+        return false;
+    }
+
+    return state_ptr->bound_shader_id != INVALID_ID && state_ptr->applied_instance_id == instance_id;
+}
+
+void shader_system_bindings_reset()
+{
+    if(!shader_system_status_valid(__FUNCTION__))
+    {
+        return;
+    }
+
+    state_ptr->bound_shader_id = INVALID_ID;
+    state_ptr->applied_instance_id = INVALID_ID;
 }
 
 bool shader_system_bind_instance(u32 instance_id)
@@ -509,6 +557,9 @@ bool add_attribute(shader* shader, shader_attribute_config* config)
         case SHADER_ATTRIB_TYPE_FLOAT32_4:
             size = 16;
             break;
+        case SHADER_ATTRIB_TYPE_MATRIX_4:
+            size = 64;
+            break;
         default:
             kerror(
                 "Function '%s': Unrecognized type, defaulting to size of 4. This probably is not what is desired.",
@@ -518,13 +569,22 @@ bool add_attribute(shader* shader, shader_attribute_config* config)
             break;
     }
 
-    shader->attribute_stride += size;
+    // Атрибуты экземпляров располагаются в отдельном буфере.
+    if(config->per_instance)
+    {
+        shader->instance_attribute_stride += size;
+    }
+    else
+    {
+        shader->attribute_stride += size;
+    }
 
     // Создание и отправка атрибута в массив.
     shader_attribute attr = {};
     attr.name = string_duplicate(config->name);
     attr.size = size;
     attr.type = config->type;
+    attr.per_instance = config->per_instance;
     darray_push(shader->attributes, attr);
 
     return true;
@@ -619,6 +679,27 @@ bool add_uniform(shader* shader, shader_uniform_config* config)
     return uniform_add(shader, config->name, config->size, config->type, config->scope, 0, false);
 }
 
+u16 draw_constant_index(shader* shader, const char* uniform_name)
+{
+    // NOTE: Отсутствие переменной не ошибка, шейдер просто не получает это значение.
+    u16 index = INVALID_ID_U16;
+    if(!hashtable_get(shader->uniform_lookup, uniform_name, &index) || index == INVALID_ID_U16)
+    {
+        return INVALID_ID_U16;
+    }
+
+    if(shader->uniforms[index].scope != SHADER_SCOPE_LOCAL)
+    {
+        kwarng(
+            "Function '%s': Shader '%s' uniform '%s' is not local and cannot be pushed per draw.",
+            __FUNCTION__, shader->name, uniform_name
+        );
+        return INVALID_ID_U16;
+    }
+
+    return index;
+}
+
 bool uniform_add(shader* shader, const char* uniform_name, u32 size, shader_uniform_type type, shader_scope scope, u32 set_location, bool is_sampler)
 {
     u32 uniform_count = darray_length(shader->uniforms);
@@ -56,6 +56,8 @@ typedef struct shader_attribute {
     u32 size;
     // @brief Тип атрибута.
     shader_attribute_type type;
+    // @brief Указывает, что атрибут читается из буфера экземпляров.
+    bool per_instance;
 } shader_attribute;
 
 typedef struct shader {
@@ -107,6 +109,12 @@ typedef struct shader {
     range push_constant_ranges[32];
     // @brief Размер всех атрибутов вместе взятых (размер вершины).
     u16 attribute_stride;
+    // @brief Размер всех атрибутов экземпляра (размер элемента буфера экземпляров, 0 - шейдер без экземпляров).
+    u16 instance_attribute_stride;
+    // @brief Индекс локальной uniform переменной 'model' для push-констант отрисовки (INVALID_ID_U16 если нет).
+    u16 draw_model_index;
+    // @brief Индекс локальной uniform переменной 'material_index' для push-констант отрисовки (INVALID_ID_U16 если нет).
+    u16 draw_material_index;
     // @brief Номер кадра для синхронизации (исключает повторный вызов в текущем кадре). 
     u64 render_frame_number;
     // @brief Внутренние данные специфичные для API рендера (Не трогать). // TODO: Спрятать!
@@ -237,6 +245,17 @@ KAPI bool shader_system_apply_global();
 */
 KAPI bool shader_system_apply_instance(bool needs_update);
 
+/*
+    @brief Записывает push-константы отрисовки: матрицу модели и индекс материала.
+    NOTE: Действует для используемого шейдера в данный момент. Быстрый путь для цикла отрисовки: смещения
+          локальных uniform переменных 'model' и 'material_index' находятся при создании шейдера, поэтому
+          поиск и проверка uniform переменных не выполняются. Отсутствующие в шейдере значения пропускаются.
+    @param model Указатель на матрицу модели, null чтобы не записывать.
+    @param material_index Индекс материала.
+    @return True в случае успеха, false если есть ошибки.
+*/
+KAPI bool shader_system_draw_constants_push(const mat4* model, u32 material_index);
+
 /*
     @brief Связывает экземпляр с указаным идентификатором для использлвания.
            Необходимо выполнить перед установкой uniform переменых области действия экземпляра.
@@ -245,3 +264,17 @@ KAPI bool shader_system_apply_instance(bool needs_update);
     @return True в случае успеха, false если есть ошибки.
 */
 KAPI bool shader_system_bind_instance(u32 instance_id);
+
+/*
+    @brief Проверяет, применен ли экземпляр используемого шейдера в текущем буфере команд.
+    NOTE: Позволяет пропустить повторную привязку экземпляра, если его uniform переменные не изменились.
+    @param instance_id Идентификатор экземпляра.
+    @return True если экземпляр уже применен, false если требуется привязка.
+*/
+KAPI bool shader_system_instance_is_applied(u32 instance_id);
+
+/*
+    @brief Сбрасывает отслеживание привязанного шейдера и экземпляра.
+    NOTE: Вызывается в начале кадра, так как новый буфер команд не содержит привязок.
+*/
+KAPI void shader_system_bindings_reset();
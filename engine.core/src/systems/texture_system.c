@@ -22,6 +22,10 @@ typedef struct texture_system_state {
     texture* textures;
     // Таблица ссылок на текстуры.
     hashtable* texture_references_table;
+    // Загрузки, ожидающие завершения передачи данных на GPU (не более одной на текстуру).
+    struct texture_pending_upload* pending_uploads;
+    // Количество ожидающих загрузок.
+    u32 pending_upload_count;
 } texture_system_state;
 
 // TODO: Умную выгрузку текстур. Например вугружать те материалы которые можно выгружать
@@ -36,6 +40,14 @@ typedef struct texture_reference {
     bool auto_release;
 } texture_reference;
 
+// Загруженная текстура, которая подменит текстуру назначения после завершения передачи данных на GPU.
+typedef struct texture_pending_upload {
+    // Текстура назначения в массиве текстур.
+    texture* out_texture;
+    // Временная текстура с внутренними данными GPU.
+    texture temp_texture;
+} texture_pending_upload;
+
 typedef struct texture_load_params {
     char* resource_name;
     texture* out_texture;
@@ -96,10 +108,11 @@ bool texture_system_initialize(u64* memory_requirement, void* memory, texture_sy
 
     u64 state_requirement = sizeof(texture_system_state);
     u64 textures_requirement = sizeof(texture) * config->max_texture_count;
+    u64 pending_uploads_requirement = sizeof(texture_pending_upload) * config->max_texture_count;
     u64 hashtable_requirement = 0;
     hashtable_config hconf = { sizeof(texture_reference), config->max_texture_count };
     hashtable_create(&hashtable_requirement, null, &hconf, null);
-    *memory_requirement = state_requirement + textures_requirement + hashtable_requirement;
+    *memory_requirement = state_requirement + textures_requirement + pending_uploads_requirement + hashtable_requirement;
 
     if(!memory)
     {
@@ -117,8 +130,12 @@ bool texture_system_initialize(u64* memory_requirement, void* memory, texture_sy
     void* textures_block =  POINTER_GET_OFFSET(state_ptr, state_requirement);
     state_ptr->textures = textures_block;
 
+    // Получение и запись указателя на ожидающие загрузки.
+    void* pending_uploads_block = POINTER_GET_OFFSET(textures_block, textures_requirement);
+    state_ptr->pending_uploads = pending_uploads_block;
+
     // Получение и запись указателя на хэш-таблицу.
-    void* hashtable_block = POINTER_GET_OFFSET(textures_block, textures_requirement);
+    void* hashtable_block = POINTER_GET_OFFSET(pending_uploads_block, pending_uploads_requirement);
     if(!hashtable_create(&hashtable_requirement, hashtable_block, &hconf, &state_ptr->texture_references_table))
     {
         kerror("Function '%s': Failed to create hashtable of references to textures.", __FUNCTION__);
@@ -152,6 +169,13 @@ void texture_system_shutdown()
     // Уничтожение хэш-таблицы.
     hashtable_destroy(state_ptr->texture_references_table);
 
+    // Уничтожение загрузок, которые не успели завершиться.
+    for(u32 i = 0; i < state_ptr->pending_upload_count; ++i)
+    {
+        renderer_texture_destroy(&state_ptr->pending_uploads[i].temp_texture);
+    }
+    state_ptr->pending_upload_count = 0;
+
     // Уничтожение всех созданых текстур.
     for(u32 i = 0; i < state_ptr->config.max_texture_count; ++i)
     {
@@ -168,6 +192,38 @@ void texture_system_shutdown()
     state_ptr = null;
 }
 
+void texture_system_update()
+{
+    if(!texture_system_status_valid(__FUNCTION__)) return;
+
+    for(u32 i = 0; i < state_ptr->pending_upload_count;)
+    {
+        texture_pending_upload* upload = &state_ptr->pending_uploads[i];
+        if(!renderer_texture_upload_complete(&upload->temp_texture))
+        {
+            ++i;
+            continue;
+        }
+
+        texture* t = upload->out_texture;
+
+        // Уничтожение предыдущих данных GPU при перезагрузке текстуры.
+        // NOTE: Визуализатор откладывает уничтожение до завершения кадров в полете, кадр не блокируется.
+        if(t->generation != INVALID_ID && t->internal_data)
+        {
+            texture old_texture = *t;
+            renderer_texture_destroy(&old_texture);
+        }
+
+        // Подмена: текстура становится действительной только с загруженными данными.
+        *t = upload->temp_texture;
+
+        // Удаление из списка заменой последней загрузкой.
+        state_ptr->pending_upload_count--;
+        state_ptr->pending_uploads[i] = state_ptr->pending_uploads[state_ptr->pending_upload_count];
+    }
+}
+
 texture* texture_system_acquire(const char* name, bool auto_release)
 {
     if(!texture_system_status_valid(__FUNCTION__)) return null;
@@ -563,10 +619,14 @@ void texture_load_job_success(void* params)
     texture_load_params* texture_params = params;
     image_resouce_data* resource_data = texture_params->image_resource.data;
 
-    // Копирование данных текстуры.
-    texture_params->out_texture->width = resource_data->width;
-    texture_params->out_texture->height = resource_data->height;
-    texture_params->out_texture->channel_count = resource_data->channel_count;
+    // NOTE: Данные загружаются во временную текстуру, текстура назначения продолжает указывать на прежние данные
+    //       (или текстуру по умолчанию) до завершения передачи на GPU, см. texture_system_update.
+    texture* out_texture = texture_params->out_texture;
+    texture temp_texture = *out_texture;
+    temp_texture.width = resource_data->width;
+    temp_texture.height = resource_data->height;
+    temp_texture.channel_count = resource_data->channel_count;
+    temp_texture.internal_data = null;
 
     // Проверка прозрачности.
     u64 total_size = resource_data->width * resource_data->height * resource_data->channel_count;
@@ -581,14 +641,32 @@ void texture_load_job_success(void* params)
         }
     }
 
-    string_ncopy(texture_params->out_texture->name, texture_params->resource_name, TEXTURE_NAME_MAX_LENGTH);
-    texture_params->out_texture->generation = 0;
-    texture_params->out_texture->flags |= has_transparency ? TEXTURE_FLAG_HAS_TRANSPARENCY : 0;
+    string_ncopy(temp_texture.name, texture_params->resource_name, TEXTURE_NAME_MAX_LENGTH);
+    temp_texture.generation = 0;
+    temp_texture.flags |= has_transparency ? TEXTURE_FLAG_HAS_TRANSPARENCY : 0;
+
+    // Загрузка текстуры на GPU (без ожидания завершения).
+    renderer_texture_create(&temp_texture, resource_data->pixels);
+
+    // Поиск ожидающей загрузки этой же текстуры, более новые данные заменяют ее.
+    texture_pending_upload* upload = null;
+    for(u32 i = 0; i < state_ptr->pending_upload_count; ++i)
+    {
+        if(state_ptr->pending_uploads[i].out_texture == out_texture)
+        {
+            upload = &state_ptr->pending_uploads[i];
+            renderer_texture_destroy(&upload->temp_texture);
+            break;
+        }
+    }
 
-    // Загрузка текстуры на GPU.
-    renderer_texture_create(texture_params->out_texture, resource_data->pixels);
+    if(!upload)
+    {
+        upload = &state_ptr->pending_uploads[state_ptr->pending_upload_count++];
+    }
 
-    // TODO: Только в этот момент разрешить смену текстуры!
+    upload->out_texture = out_texture;
+    upload->temp_texture = temp_texture;
 
     // Очистка загруженных ресурсов.
     resource_system_unload(&texture_params->image_resource);
@@ -640,6 +718,19 @@ bool texture_load(const char* texture_name, texture* t)
 
 void texture_destroy(texture* t)
 {
+    // Отмена ожидающей загрузки текстуры.
+    for(u32 i = 0; i < state_ptr->pending_upload_count; ++i)
+    {
+        texture_pending_upload* upload = &state_ptr->pending_uploads[i];
+        if(upload->out_texture == t)
+        {
+            renderer_texture_destroy(&upload->temp_texture);
+            state_ptr->pending_upload_count--;
+            *upload = state_ptr->pending_uploads[state_ptr->pending_upload_count];
+            break;
+        }
+    }
+
     // Удаление из памяти графического процессора.
     renderer_texture_destroy(t);
 
@@ -29,6 +29,13 @@ bool texture_system_initialize(u64* memory_requirement, void* memory, texture_sy
 */
 void texture_system_shutdown();
 
+/*
+    @brief Подменяет текстуры, загрузка данных которых на GPU завершена.
+    NOTE: Не блокирует кадр, до завершения загрузки текстура использует прежние данные или текстуру
+          по умолчанию. Вызывается один раз за кадр после обновления системы заданий.
+*/
+void texture_system_update();
+
 /*
     @brief Пытается получить кубическую текстуру с указаным имененм и возвразает ее указатель.
     NOTE:  Если текстура не загружена в память, то выполняет ее загрузку, а если не найдена
@@ -0,0 +1,535 @@
+// Собственные подключения.
+#include "systems/transform_system.h"
+
+// Внутренние подключения.
+#include "logger.h"
+#include "memory/memory.h"
+#include "math/kmath.h"
+#include "math/kmath_simd.h"
+#include "systems/job_system.h"
+#include "debug/profiler.h"
+
+// Количество преобразований в одной части параллельного обновления.
+#define TRANSFORM_UPDATE_BATCH_SIZE 256
+
+// Флаги состояния преобразования.
+typedef enum transform_flag {
+    // Локальная матрица требует пересчета.
+    TRANSFORM_FLAG_LOCAL_DIRTY   = 0x01,
+    // Мировая матрица изменилась при последнем обновлении (потомки тоже пересчитываются).
+    TRANSFORM_FLAG_WORLD_UPDATED = 0x02
+} transform_flag;
+
+typedef struct transform_system_state {
+    // Конфигурация системы преобразований.
+    transform_system_config config;
+    // Количество используемых преобразований.
+    u32 count;
+    // Количество уровней иерархии.
+    u32 level_count;
+    // Порядок хранения нарушен и требует перестроения перед обновлением.
+    bool hierarchy_dirty;
+
+    // NOTE: Массивы ниже индексируются плотным индексом и упорядочены по глубине иерархии.
+    // Позиции.
+    vec3* positions;
+    // Повороты.
+    quat* rotations;
+    // Масштабы.
+    vec3* scales;
+    // Плотные индексы родителей (INVALID_ID для корневых).
+    u32* parents;
+    // Глубина в иерархии (0 для корневых).
+    u32* depths;
+    // Флаги transform_flag.
+    u8* flags;
+    // Локальные матрицы.
+    mat4a* locals;
+    // Мировые матрицы.
+    mat4a* worlds;
+    // Идентификаторы преобразований по плотному индексу.
+    u32* dense_to_id;
+
+    // Плотные индексы по идентификатору (INVALID_ID для свободных).
+    u32* id_to_dense;
+    // Начала уровней иерархии в плотных массивах (level_count + 1 элементов).
+    u32* level_offsets;
+} transform_system_state;
+
+// Контекст обновления одного уровня иерархии.
+typedef struct transform_update_context {
+    // Плотный индекс первого преобразования уровня.
+    u32 first;
+} transform_update_context;
+
+static transform_system_state* state_ptr = null;
+
+static bool system_status_valid(const char* func_name)
+{
+    if(!state_ptr)
+    {
+        if(func_name)
+        {
+            kerror(
+                "Function '%s' requires the transform system to be initialized. Call 'transform_system_initialize' first.",
+                func_name
+            );
+        }
+        return false;
+    }
+    return true;
+}
+
+// Получает плотный индекс преобразования по идентификатору.
+static u32 transform_dense_index(u32 id, const char* func_name)
+{
+    if(!system_status_valid(func_name)) return INVALID_ID;
+
+    if(id >= state_ptr->config.max_transform_count || state_ptr->id_to_dense[id] == INVALID_ID)
+    {
+        kerror("Function '%s': invalid transform id %u.", func_name, id);
+        return INVALID_ID;
+    }
+
+    return state_ptr->id_to_dense[id];
+}
+
+bool transform_system_initialize(u64* memory_requirement, void* memory, transform_system_config* config)
+{
+    if(state_ptr)
+    {
+        kwarng("Function '%s' was called more than once!", __FUNCTION__);
+        return false;
+    }
+
+    if(!memory_requirement || !config)
+    {
+        kerror("Function '%s' requires a valid pointers to memory_requirement and config.", __FUNCTION__);
+        return false;
+    }
+
+    if(!config->max_transform_count || config->max_transform_count == INVALID_ID)
+    {
+        kerror("Function '%s': config.max_transform_count must be greater then zero.", __FUNCTION__);
+        return false;
+    }
+
+    u64 max_count = config->max_transform_count;
+
+    // NOTE: Матрицы идут первыми и выравниваются по 16 байт, запас на выравнивание начала блока.
+    u64 state_requirement = get_aligned(sizeof(transform_system_state), 16);
+    u64 matrix_requirement = sizeof(mat4a) * max_count * 2;
+    u64 array_requirement = (sizeof(vec3) * 2 + sizeof(quat) + sizeof(u32) * 4 + sizeof(u8)) * max_count;
+    u64 level_requirement = sizeof(u32) * (max_count + 1);
+    *memory_requirement = state_requirement + 16 + matrix_requirement + array_requirement + level_requirement;
+
+    if(!memory)
+    {
+        return true;
+    }
+
+    kzero(memory, *memory_requirement);
+    state_ptr = memory;
+    state_ptr->config = *config;
+
+    u8* block = (u8*)get_aligned((u64)memory + state_requirement, 16);
+    state_ptr->locals = (mat4a*)block;
+    block += sizeof(mat4a) * max_count;
+    state_ptr->worlds = (mat4a*)block;
+    block += sizeof(mat4a) * max_count;
+    state_ptr->rotations = (quat*)block;
+    block += sizeof(quat) * max_count;
+    state_ptr->positions = (vec3*)block;
+    block += sizeof(vec3) * max_count;
+    state_ptr->scales = (vec3*)block;
+    block += sizeof(vec3) * max_count;
+    state_ptr->parents = (u32*)block;
+    block += sizeof(u32) * max_count;
+    state_ptr->depths = (u32*)block;
+    block += sizeof(u32) * max_count;
+    state_ptr->dense_to_id = (u32*)block;
+    block += sizeof(u32) * max_count;
+    state_ptr->id_to_dense = (u32*)block;
+    block += sizeof(u32) * max_count;
+    state_ptr->level_offsets = (u32*)block;
+    block += sizeof(u32) * (max_count + 1);
+    state_ptr->flags = block;
+
+    for(u32 i = 0; i < max_count; ++i)
+    {
+        state_ptr->id_to_dense[i] = INVALID_ID;
+    }
+
+    return true;
+}
+
+void transform_system_shutdown()
+{
+    state_ptr = null;
+}
+
+// Переставляет элементы массива по таблице новых индексов.
+static void transform_permute(void* array, u64 stride, u32 count, const u32* old_to_new, void* temp)
+{
+    u8* src = array;
+    u8* dst = temp;
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        kcopy(dst + old_to_new[i] * stride, src + i * stride, stride);
+    }
+
+    kcopy(src, dst, stride * count);
+}
+
+// Восстанавливает упорядочение по глубине после изменения иерархии (сортировка подсчетом, устойчивая).
+static void transform_system_rebuild_levels()
+{
+    KPROFILE_FUNCTION();
+
+    transform_system_state* s = state_ptr;
+    u32 count = s->count;
+    u32 max_depth = 0;
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        u32 depth = 0;
+        for(u32 p = s->parents[i]; p != INVALID_ID; p = s->parents[p])
+        {
+            depth++;
+        }
+        s->depths[i] = depth;
+        max_depth = KMAX(max_depth, depth);
+    }
+
+    s->level_count = count ? max_depth + 1 : 0;
+    kzero_tc(s->level_offsets, u32, s->level_count + 1);
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        s->level_offsets[s->depths[i] + 1]++;
+    }
+
+    for(u32 level = 0; level < s->level_count; ++level)
+    {
+        s->level_offsets[level + 1] += s->level_offsets[level];
+    }
+
+    u32* old_to_new = kallocate_tc(u32, count, MEMORY_TAG_TRANSFORM);
+    u32* cursors = kallocate_tc(u32, s->level_count, MEMORY_TAG_TRANSFORM);
+    kcopy(cursors, s->level_offsets, sizeof(u32) * s->level_count);
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        old_to_new[i] = cursors[s->depths[i]]++;
+    }
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        if(s->parents[i] != INVALID_ID)
+        {
+            s->parents[i] = old_to_new[s->parents[i]];
+        }
+    }
+
+    void* temp = kallocate(sizeof(mat4a) * count, MEMORY_TAG_TRANSFORM);
+    transform_permute(s->positions, sizeof(vec3), count, old_to_new, temp);
+    transform_permute(s->rotations, sizeof(quat), count, old_to_new, temp);
+    transform_permute(s->scales, sizeof(vec3), count, old_to_new, temp);
+    transform_permute(s->parents, sizeof(u32), count, old_to_new, temp);
+    transform_permute(s->depths, sizeof(u32), count, old_to_new, temp);
+    transform_permute(s->flags, sizeof(u8), count, old_to_new, temp);
+    transform_permute(s->locals, sizeof(mat4a), count, old_to_new, temp);
+    transform_permute(s->worlds, sizeof(mat4a), count, old_to_new, temp);
+    transform_permute(s->dense_to_id, sizeof(u32), count, old_to_new, temp);
+
+    for(u32 i = 0; i < count; ++i)
+    {
+        s->id_to_dense[s->dense_to_id[i]] = i;
+    }
+
+    kfree(temp, MEMORY_TAG_TRANSFORM);
+    kfree(cursors, MEMORY_TAG_TRANSFORM);
+    kfree(old_to_new, MEMORY_TAG_TRANSFORM);
+
+    s->hierarchy_dirty = false;
+}
+
+// Обновляет часть преобразований одного уровня иерархии (родители уже обновлены).
+static void transform_update_range(void* context, u32 begin, u32 end)
+{
+    transform_system_state* s = state_ptr;
+    transform_update_context* ctx = context;
+
+    for(u32 i = ctx->first + begin; i < ctx->first + end; ++i)
+    {
+        bool changed = s->flags[i] & TRANSFORM_FLAG_LOCAL_DIRTY;
+
+        if(changed)
+        {
+            s->locals[i] = mat4a_from_position_rotation_scale(s->positions[i], s->rotations[i], s->scales[i]);
+        }
+
+        u32 parent = s->parents[i];
+        if(parent == INVALID_ID)
+        {
+            if(changed)
+            {
+                s->worlds[i] = s->locals[i];
+            }
+        }
+        else if(changed || (s->flags[parent] & TRANSFORM_FLAG_WORLD_UPDATED))
+        {
+            s->worlds[i] = mat4a_mul(s->locals[i], s->worlds[parent]);
+            changed = true;
+        }
+
+        s->flags[i] = changed ? TRANSFORM_FLAG_WORLD_UPDATED : 0;
+    }
+}
+
+void transform_system_update_all()
+{
+    if(!system_status_valid(__FUNCTION__)) return;
+    KPROFILE_FUNCTION();
+
+    if(state_ptr->hierarchy_dirty)
+    {
+        transform_system_rebuild_levels();
+    }
+
+    // NOTE: Следующий уровень читает мировые матрицы предыдущего, поэтому уровни обрабатываются по очереди.
+    for(u32 level = 0; level < state_ptr->level_count; ++level)
+    {
+        transform_update_context context;
+        context.first = state_ptr->level_offsets[level];
+        u32 count = state_ptr->level_offsets[level + 1] - context.first;
+        job_system_parallel_for(count, TRANSFORM_UPDATE_BATCH_SIZE, transform_update_range, &context);
+    }
+}
+
+u32 transform_system_acquire(vec3 position, quat rotation, vec3 scale, u32 parent_id)
+{
+    if(!system_status_valid(__FUNCTION__)) return INVALID_ID;
+
+    transform_system_state* s = state_ptr;
+    u32 parent = INVALID_ID;
+
+    if(parent_id != INVALID_ID)
+    {
+        parent = transform_dense_index(parent_id, __FUNCTION__);
+        if(parent == INVALID_ID) return INVALID_ID;
+    }
+
+    if(s->count >= s->config.max_transform_count)
+    {
+        kerror("Function '%s': transform system is full (max %u). Adjust configuration.", __FUNCTION__, s->config.max_transform_count);
+        return INVALID_ID;
+    }
+
+    u32 id = INVALID_ID;
+    for(u32 i = 0; i < s->config.max_transform_count; ++i)
+    {
+        if(s->id_to_dense[i] == INVALID_ID)
+        {
+            id = i;
+            break;
+        }
+    }
+
+    u32 dense = s->count++;
+    s->positions[dense] = position;
+    s->rotations[dense] = rotation;
+    s->scales[dense] = scale;
+    s->parents[dense] = parent;
+    s->depths[dense] = parent == INVALID_ID ? 0 : s->depths[parent] + 1;
+    s->flags[dense] = TRANSFORM_FLAG_LOCAL_DIRTY;
+    s->locals[dense] = mat4a_identity();
+    s->worlds[dense] = mat4a_identity();
+    s->dense_to_id[dense] = id;
+    s->id_to_dense[id] = dense;
+
+    // Добавление в конец сохраняет упорядочение, если глубина не меньше глубины последнего уровня.
+    if(!s->hierarchy_dirty)
+    {
+        u32 depth = s->depths[dense];
+        if(depth == s->level_count)
+        {
+            s->level_offsets[s->level_count] = dense;
+            s->level_count++;
+            s->level_offsets[s->level_count] = s->count;
+        }
+        else if(depth + 1 == s->level_count)
+        {
+            s->level_offsets[s->level_count] = s->count;
+        }
+        else
+        {
+            s->hierarchy_dirty = true;
+        }
+    }
+
+    return id;
+}
+
+void transform_system_release(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return;
+
+    transform_system_state* s = state_ptr;
+    u32 last = s->count - 1;
+
+    // Потомки становятся корневыми, последний элемент занимает освободившееся место.
+    for(u32 i = 0; i < s->count; ++i)
+    {
+        if(s->parents[i] == dense)
+        {
+            s->parents[i] = INVALID_ID;
+            s->flags[i] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+        }
+        else if(s->parents[i] == last)
+        {
+            s->parents[i] = dense;
+        }
+    }
+
+    if(dense != last)
+    {
+        s->positions[dense] = s->positions[last];
+        s->rotations[dense] = s->rotations[last];
+        s->scales[dense] = s->scales[last];
+        s->parents[dense] = s->parents[last];
+        s->depths[dense] = s->depths[last];
+        s->flags[dense] = s->flags[last];
+        s->locals[dense] = s->locals[last];
+        s->worlds[dense] = s->worlds[last];
+        s->dense_to_id[dense] = s->dense_to_id[last];
+        s->id_to_dense[s->dense_to_id[dense]] = dense;
+    }
+
+    s->id_to_dense[id] = INVALID_ID;
+    s->count--;
+    s->hierarchy_dirty = true;
+}
+
+u32 transform_system_get_parent(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID || state_ptr->parents[dense] == INVALID_ID) return INVALID_ID;
+    return state_ptr->dense_to_id[state_ptr->parents[dense]];
+}
+
+bool transform_system_set_parent(u32 id, u32 parent_id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return false;
+
+    transform_system_state* s = state_ptr;
+    u32 parent = INVALID_ID;
+
+    if(parent_id != INVALID_ID)
+    {
+        parent = transform_dense_index(parent_id, __FUNCTION__);
+        if(parent == INVALID_ID) return false;
+
+        // Проверка на цикл: преобразование не может быть потомком самого себя.
+        for(u32 p = parent; p != INVALID_ID; p = s->parents[p])
+        {
+            if(p == dense)
+            {
+                kerror("Function '%s': transform %u cannot be parented to its own descendant %u.", __FUNCTION__, id, parent_id);
+                return false;
+            }
+        }
+    }
+
+    if(s->parents[dense] == parent) return true;
+
+    s->parents[dense] = parent;
+    s->flags[dense] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+    s->hierarchy_dirty = true;
+    return true;
+}
+
+vec3 transform_system_get_position(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return vec3_zero();
+    return state_ptr->positions[dense];
+}
+
+void transform_system_set_position(u32 id, vec3 position)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return;
+    state_ptr->positions[dense] = position;
+    state_ptr->flags[dense] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+void transform_system_translate(u32 id, vec3 translation)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return;
+    state_ptr->positions[dense] = vec3_add(state_ptr->positions[dense], translation);
+    state_ptr->flags[dense] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+quat transform_system_get_rotation(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return quat_identity();
+    return state_ptr->rotations[dense];
+}
+
+void transform_system_set_rotation(u32 id, quat rotation)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return;
+    state_ptr->rotations[dense] = rotation;
+    state_ptr->flags[dense] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+void transform_system_rotate(u32 id, quat rotation)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return;
+    state_ptr->rotations[dense] = quat_mul(state_ptr->rotations[dense], rotation);
+    state_ptr->flags[dense] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+vec3 transform_system_get_scale(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return vec3_one();
+    return state_ptr->scales[dense];
+}
+
+void transform_system_set_scale(u32 id, vec3 scale)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return;
+    state_ptr->scales[dense] = scale;
+    state_ptr->flags[dense] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+}
+
+mat4 transform_system_get_local(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return mat4_identity();
+    return mat4a_to_mat4(state_ptr->locals[dense]);
+}
+
+mat4 transform_system_get_world(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return mat4_identity();
+    return mat4a_to_mat4(state_ptr->worlds[dense]);
+}
+
+bool transform_system_world_changed(u32 id)
+{
+    u32 dense = transform_dense_index(id, __FUNCTION__);
+    if(dense == INVALID_ID) return false;
+    return (state_ptr->flags[dense] & TRANSFORM_FLAG_WORLD_UPDATED) != 0;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <defines.h>
+#include <math/math_types.h>
+
+// @brief Конфигурация системы преобразований.
+typedef struct transform_system_config {
+    // @brief Максимальное количество преобразований.
+    u32 max_transform_count;
+} transform_system_config;
+
+/*
+    @brief Инициализирует систему преобразований используя предоставленную конфигурацию.
+    NOTE: Позиции, повороты и масштабы хранятся отдельными массивами (SoA), упорядоченными по глубине
+          иерархии, поэтому родитель всегда обрабатывается раньше своих потомков.
+    @param memory_requirement Указатель на переменную для сохранения требований системы к памяти в байтах.
+    @param memory Указатель на выделенный блок памяти, или null для получения требований.
+    @param config Конфигурация используемая для инициализации системы и получения требований к памяти.
+    @return True в случае успеха, false если есть ошибки.
+*/
+bool transform_system_initialize(u64* memory_requirement, void* memory, transform_system_config* config);
+
+/*
+    @brief Завершает работу системы преобразований.
+*/
+void transform_system_shutdown();
+
+/*
+    @brief Пересчитывает мировые матрицы всех измененных преобразований и их потомков (один раз в кадр).
+    NOTE: Уровни иерархии обрабатываются по очереди, преобразования одного уровня - параллельно
+          с помощью системы заданий.
+*/
+KAPI void transform_system_update_all();
+
+/*
+    @brief Создает новое преобразование.
+    @param position Позиция.
+    @param rotation Поворот.
+    @param scale Масштаб.
+    @param parent_id Идентификатор родительского преобразования, INVALID_ID если родителя нет.
+    @return Идентификатор преобразования, INVALID_ID если не удалось.
+*/
+KAPI u32 transform_system_acquire(vec3 position, quat rotation, vec3 scale, u32 parent_id);
+
+/*
+    @brief Удаляет преобразование, его потомки становятся корневыми.
+    @param id Идентификатор преобразования.
+*/
+KAPI void transform_system_release(u32 id);
+
+/*
+    @brief Получает идентификатор родительского преобразования.
+    @param id Идентификатор преобразования.
+    @return Идентификатор родителя, INVALID_ID если родителя нет.
+*/
+KAPI u32 transform_system_get_parent(u32 id);
+
+/*
+    @brief Устанавливает родительское преобразование.
+    @param id Идентификатор преобразования.
+    @param parent_id Идентификатор родителя, INVALID_ID чтобы сделать преобразование корневым.
+    @return True в случае успеха, false если родитель недействителен или образуется цикл.
+*/
+KAPI bool transform_system_set_parent(u32 id, u32 parent_id);
+
+/*
+    @brief Получает позицию преобразования.
+    @param id Идентификатор преобразования.
+    @return Позиция.
+*/
+KAPI vec3 transform_system_get_position(u32 id);
+
+/*
+    @brief Устанавливает позицию преобразования.
+    @param id Идентификатор преобразования.
+    @param position Позиция.
+*/
+KAPI void transform_system_set_position(u32 id, vec3 position);
+
+/*
+    @brief Перемещает преобразование.
+    @param id Идентификатор преобразования.
+    @param translation Смещение.
+*/
+KAPI void transform_system_translate(u32 id, vec3 translation);
+
+/*
+    @brief Получает поворот преобразования.
+    @param id Идентификатор преобразования.
+    @return Поворот.
+*/
+KAPI quat transform_system_get_rotation(u32 id);
+
+/*
+    @brief Устанавливает поворот преобразования.
+    @param id Идентификатор преобразования.
+    @param rotation Поворот.
+*/
+KAPI void transform_system_set_rotation(u32 id, quat rotation);
+
+/*
+    @brief Поворачивает преобразование.
+    @param id Идентификатор преобразования.
+    @param rotation Поворот.
+*/
+KAPI void transform_system_rotate(u32 id, quat rotation);
+
+/*
+    @brief Получает масштаб преобразования.
+    @param id Идентификатор преобразования.
+    @return Масштаб.
+*/
+KAPI vec3 transform_system_get_scale(u32 id);
+
+/*
+    @brief Устанавливает масштаб преобразования.
+    @param id Идентификатор преобразования.
+    @param scale Масштаб.
+*/
+KAPI void transform_system_set_scale(u32 id, vec3 scale);
+
+/*
+    @brief Получает локальную матрицу, вычисленную последним вызовом 'transform_system_update_all'.
+    @param id Идентификатор преобразования.
+    @return Локальная матрица, единичная если идентификатор недействителен.
+*/
+KAPI mat4 transform_system_get_local(u32 id);
+
+/*
+    @brief Получает мировую матрицу, вычисленную последним вызовом 'transform_system_update_all'.
+    @param id Идентификатор преобразования.
+    @return Мировая матрица, единичная если идентификатор недействителен.
+*/
+KAPI mat4 transform_system_get_world(u32 id);
+
+/*
+    @brief Проверяет, изменилась ли мировая матрица при последнем вызове 'transform_system_update_all'.
+    @param id Идентификатор преобразования.
+    @return True если мировая матрица была пересчитана, false если нет или идентификатор недействителен.
+*/
+KAPI bool transform_system_world_changed(u32 id);
@@ -0,0 +1,57 @@
+// Внешние подключения.
+#include <logger.h>
+#include <kstring.h>
+#include <platform/file.h>
+#include <memory/memory.h>
+
+// Файл для вывода текста журнала (null для вывода в консоль).
+static file* output_file = null;
+
+// Записывает сообщение журнала в файл с текстовой меткой уровня.
+static void output_file_write(log_level level, const char* message)
+{
+    const char* levels[LOG_LEVELS_MAX] = {
+        "[FATAL] ", "[ERROR] ", "[WARNG] ", "[INFOR] ", "[DEBUG] ", "[TRACE] "
+    };
+
+    platform_file_write(output_file, 8, levels[level]);
+    platform_file_write(output_file, string_length(message), message);
+}
+
+/*
+    Преобразует двоичный журнал (klog) обратно в текст.
+    Используй так: logdecoder <журнал.klog> [вывод.txt]
+    Без файла вывода сообщения выводятся в консоль.
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 2)
+    {
+        kerror("Usage: logdecoder <input.klog> [output.txt]");
+        return 1;
+    }
+
+    memory_system_config conf;
+    conf.total_allocation_size = 1 MiB;
+    memory_system_initialize(&conf);
+
+    i32 result = 0;
+
+    if(argc > 2 && !platform_file_open(argv[2], FILE_MODE_WRITE, &output_file))
+    {
+        kerror("Unable to open output file '%s'.", argv[2]);
+        result = 2;
+    }
+    else if(!logger_binary_decode(argv[1], output_file ? output_file_write : null))
+    {
+        result = 3;
+    }
+
+    if(output_file)
+    {
+        platform_file_close(output_file);
+    }
+
+    memory_system_shutdown();
+    return result;
+}
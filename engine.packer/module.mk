@@ -0,0 +1,11 @@
+
+# Основные настрокйки модулая.
+module_filename         = packer
+module_source_directory = src/
+
+# Дополнительные флаги модуля.
+module_common_flags     =
+module_define_flags     =
+module_include_flags    = -Iengine.core/src/
+module_object_flags     =
+module_linker_flags     = -lcore
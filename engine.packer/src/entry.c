@@ -0,0 +1,65 @@
+// Внешние подключения.
+#include <logger.h>
+#include <kstring.h>
+#include <memory/memory.h>
+#include <resources/pak.h>
+
+/*
+    Упаковщик ресурсов в архив (pak).
+    Используй так: packer <архив.pak> <каталог ресурсов> <файл>...
+    Имена записей архива - пути файлов относительно каталога ресурсов (например "textures/paving.png").
+*/
+int main(int argc, char** argv)
+{
+    if(argc < 4)
+    {
+        kerror("Usage: packer <output.pak> <asset directory> <file>...");
+        return 1;
+    }
+
+    memory_system_config conf;
+    conf.total_allocation_size = 64 MiB;
+    memory_system_initialize(&conf);
+
+    const char* pak_path = argv[1];
+    const char* base_path = argv[2];
+    u64 base_length = string_length(base_path);
+    u32 file_count = argc - 3;
+
+    const char** names = kallocate_tc(const char*, file_count, MEMORY_TAG_ARRAY);
+    const char** paths = kallocate_tc(const char*, file_count, MEMORY_TAG_ARRAY);
+    i32 result = 0;
+
+    for(u32 i = 0; i < file_count; ++i)
+    {
+        const char* path = argv[i + 3];
+
+        if(!string_nequal(path, base_path, base_length) || path[base_length] != '/')
+        {
+            kerror("File '%s' is outside of asset directory '%s'.", path, base_path);
+            result = 2;
+            break;
+        }
+
+        paths[i] = path;
+        names[i] = &path[base_length + 1];
+    }
+
+    if(!result)
+    {
+        if(pak_write(pak_path, file_count, names, paths))
+        {
+            kinfor("Resource archive '%s' created (%u entries).", pak_path, file_count);
+        }
+        else
+        {
+            result = 3;
+        }
+    }
+
+    kfree(paths, MEMORY_TAG_ARRAY);
+    kfree(names, MEMORY_TAG_ARRAY);
+
+    memory_system_shutdown();
+    return result;
+}